@@ -14,10 +14,14 @@
 #include "LRU.h"
 #include "utils/Log.h"
 
+#include <algorithm>
 #include <atomic>
 #include <mutex>
 #include <set>
 #include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace milvus {
 namespace cache {
@@ -75,6 +79,10 @@ class Cache {
     void
     print();
 
+    // keys with their access count, hottest first; ties keep the lru order
+    std::vector<std::pair<std::string, uint64_t>>
+    hot_keys();
+
     void
     clear();
 
@@ -95,6 +103,7 @@ class Cache {
     double freemem_percent_;
 
     LRU<std::string, ItemObj> lru_;
+    std::unordered_map<std::string, uint64_t> access_count_;
     mutable std::mutex mutex_;
 };
 
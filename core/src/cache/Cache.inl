@@ -54,6 +54,7 @@ Cache<ItemObj>::get(const std::string& key) {
     if (!lru_.exists(key)) {
         return nullptr;
     }
+    ++access_count_[key];
     return lru_.get(key);
 }
 
@@ -91,11 +92,11 @@ void
 Cache<ItemObj>::clear() {
     std::lock_guard<std::mutex> lock(mutex_);
     lru_.clear();
+    access_count_.clear();
     usage_ = 0;
     LOG_SERVER_DEBUG_ << header_ << " Clear cache !";
 }
 
-
 template <typename ItemObj>
 void
 Cache<ItemObj>::print() {
@@ -108,6 +109,22 @@ Cache<ItemObj>::print() {
                      << "MB, [capacity] " << (capacity_ >> 20) << "MB";
 }
 
+template <typename ItemObj>
+std::vector<std::pair<std::string, uint64_t>>
+Cache<ItemObj>::hot_keys() {
+    std::vector<std::pair<std::string, uint64_t>> keys;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        keys.reserve(lru_.size());
+        for (auto it = lru_.begin(); it != lru_.end(); ++it) {
+            auto count = access_count_.find(it->first);
+            keys.emplace_back(it->first, count == access_count_.end() ? 0 : count->second);
+        }
+    }
+    std::stable_sort(keys.begin(), keys.end(), [](auto& a, auto& b) { return a.second > b.second; });
+    return keys;
+}
+
 template <typename ItemObj>
 void
 Cache<ItemObj>::insert_internal(const std::string& key, const ItemObj& item) {
@@ -133,8 +150,13 @@ Cache<ItemObj>::insert_internal(const std::string& key, const ItemObj& item) {
         free_memory_internal(capacity_);
     }
 
-    // insert new item
+    // insert new item, lru may drop its tail when it reaches max count
+    std::string tail_key = lru_.size() > 0 ? lru_.rbegin()->first : "";
     lru_.put(key, item);
+    ++access_count_[key];
+    if (!tail_key.empty() && !lru_.exists(tail_key)) {
+        access_count_.erase(tail_key);
+    }
     LOG_SERVER_DEBUG_ << header_ << " Insert " << key << " size: " << (item_size >> 20) << "MB into cache";
     LOG_SERVER_DEBUG_ << header_ << " Count: " << lru_.size() << ", Usage: " << (usage_ >> 20) << "MB, Capacity: "
                      << (capacity_ >> 20) << "MB";
@@ -151,6 +173,7 @@ Cache<ItemObj>::erase_internal(const std::string& key) {
     size_t item_size = item->Size();
 
     lru_.erase(key);
+    access_count_.erase(key);
 
     usage_ -= item_size;
     LOG_SERVER_DEBUG_ << header_ << " Erase " << key << " size: " << (item_size >> 20) << "MB from cache";
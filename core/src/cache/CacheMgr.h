@@ -14,13 +14,19 @@
 #include "Cache.h"
 #include "metrics/Metrics.h"
 #include "utils/Log.h"
+#include "utils/Status.h"
 
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace milvus {
 namespace cache {
 
+// cached keys with their access count, hottest first
+using CacheManifest = std::vector<std::pair<std::string, uint64_t>>;
+
 template <typename ItemObj>
 class CacheMgr {
  public:
@@ -57,6 +63,15 @@ class CacheMgr {
     void
     SetCapacity(int64_t capacity);
 
+    CacheManifest
+    HotKeys() const;
+
+    Status
+    SaveManifest(const std::string& path) const;
+
+    static Status
+    LoadManifest(const std::string& path, CacheManifest& manifest);
+
  protected:
     CacheMgr();
 
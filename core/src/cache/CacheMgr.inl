@@ -9,6 +9,9 @@
 // is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
+#include <cstdio>
+#include <fstream>
+
 namespace milvus {
 namespace cache {
 
@@ -133,5 +136,64 @@ CacheMgr<ItemObj>::SetCapacity(int64_t capacity) {
     cache_->set_capacity(capacity);
 }
 
+template <typename ItemObj>
+CacheManifest
+CacheMgr<ItemObj>::HotKeys() const {
+    if (cache_ == nullptr) {
+        LOG_SERVER_ERROR_ << "Cache doesn't exist";
+        return CacheManifest();
+    }
+    return cache_->hot_keys();
+}
+
+// manifest format: one "<access count> <key>" line per item, hottest first
+template <typename ItemObj>
+Status
+CacheMgr<ItemObj>::SaveManifest(const std::string& path) const {
+    auto manifest = HotKeys();
+
+    // write to a temp file first so that a crash never leaves a truncated manifest behind
+    std::string temp_path = path + ".tmp";
+    std::ofstream out(temp_path, std::ios::out | std::ios::trunc);
+    if (!out.is_open()) {
+        return Status(SERVER_CANNOT_CREATE_FILE, "Failed to create cache manifest: " + temp_path);
+    }
+    for (auto& item : manifest) {
+        out << item.second << " " << item.first << "\n";
+    }
+    out.close();
+    if (out.fail() || std::rename(temp_path.c_str(), path.c_str()) != 0) {
+        std::remove(temp_path.c_str());
+        return Status(SERVER_CANNOT_CREATE_FILE, "Failed to write cache manifest: " + path);
+    }
+
+    LOG_SERVER_DEBUG_ << "Saved cache manifest with " << manifest.size() << " items to " << path;
+    return Status::OK();
+}
+
+template <typename ItemObj>
+Status
+CacheMgr<ItemObj>::LoadManifest(const std::string& path, CacheManifest& manifest) {
+    manifest.clear();
+    std::ifstream in(path);
+    if (!in.is_open()) {
+        return Status(SERVER_CANNOT_OPEN_FILE, "Failed to open cache manifest: " + path);
+    }
+
+    std::string line;
+    while (std::getline(in, line)) {
+        auto pos = line.find(' ');
+        if (pos == std::string::npos || pos + 1 >= line.size()) {
+            continue;
+        }
+        try {
+            manifest.emplace_back(line.substr(pos + 1), std::stoull(line.substr(0, pos)));
+        } catch (std::exception& ex) {
+            LOG_SERVER_WARNING_ << "Skip invalid cache manifest line: " << line;
+        }
+    }
+    return Status::OK();
+}
+
 }  // namespace cache
 }  // namespace milvus
@@ -17,6 +17,8 @@
 
 #pragma once
 
+#include <memory>
+
 #include "AttrsFormat.h"
 #include "AttrsIndexFormat.h"
 #include "DeletedDocsFormat.h"
@@ -30,6 +32,8 @@ namespace codec {
 
 class Codec {
  public:
+    virtual ~Codec() = default;
+
     virtual VectorsFormatPtr
     GetVectorsFormat() = 0;
 
@@ -59,5 +63,7 @@ class Codec {
     */
 };
 
+using CodecPtr = std::shared_ptr<Codec>;
+
 }  // namespace codec
 }  // namespace milvus
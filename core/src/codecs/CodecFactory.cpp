@@ -0,0 +1,88 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+
+#include "codecs/CodecFactory.h"
+
+#include <atomic>
+#include <memory>
+
+#include <boost/filesystem.hpp>
+
+#include "codecs/container/ContainerCodec.h"
+#include "codecs/container/SegmentContainer.h"
+#include "codecs/default/DefaultCodec.h"
+
+namespace milvus {
+namespace codec {
+
+namespace {
+
+std::atomic<CodecType> codec_type(CodecType::DEFAULT);
+
+// raw vectors and uids are written by every segment of the default codec
+bool
+HasDefaultFiles(const std::string& directory) {
+    boost::system::error_code ec;
+    boost::filesystem::directory_iterator it(directory, ec), it_end;
+    for (; !ec && it != it_end; it.increment(ec)) {
+        auto extension = it->path().extension().string();
+        if (extension == ".rv" || extension == ".uid") {
+            return true;
+        }
+    }
+    return false;
+}
+
+}  // namespace
+
+void
+SetCodecType(CodecType type) {
+    codec_type = type;
+}
+
+CodecType
+GetCodecType() {
+    return codec_type;
+}
+
+CodecType
+DetectCodecType(const std::string& directory) {
+    if (boost::filesystem::exists(ContainerPath(directory))) {
+        return CodecType::CONTAINER;
+    }
+    if (GetCodecType() == CodecType::DEFAULT || HasDefaultFiles(directory)) {
+        return CodecType::DEFAULT;
+    }
+    return CodecType::CONTAINER;
+}
+
+CodecPtr
+CreateCodec(CodecType type) {
+    if (type == CodecType::CONTAINER) {
+        return std::make_shared<ContainerCodec>();
+    }
+    return std::make_shared<DefaultCodec>();
+}
+
+CodecPtr
+CreateCodec(const std::string& directory) {
+    return CreateCodec(DetectCodecType(directory));
+}
+
+}  // namespace codec
+}  // namespace milvus
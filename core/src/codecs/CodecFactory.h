@@ -0,0 +1,51 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+
+#pragma once
+
+#include <string>
+
+#include "codecs/Codec.h"
+
+namespace milvus {
+namespace codec {
+
+enum class CodecType {
+    DEFAULT,
+    CONTAINER,
+};
+
+// process wide, set once from the storage config at startup; only affects segments written afterwards
+void
+SetCodecType(CodecType type);
+
+CodecType
+GetCodecType();
+
+// the codec that wrote the segment in directory, or the configured one for a segment not written yet
+CodecType
+DetectCodecType(const std::string& directory);
+
+CodecPtr
+CreateCodec(CodecType type);
+
+CodecPtr
+CreateCodec(const std::string& directory);
+
+}  // namespace codec
+}  // namespace milvus
@@ -40,6 +40,11 @@ class VectorsFormat {
     virtual void
     read_vectors(const storage::FSHandlerPtr& fs_ptr, off_t offset, size_t num_bytes,
                  std::vector<uint8_t>& raw_vectors) = 0;
+
+    // read num_bytes at each offset, concatenated in the order of offsets
+    virtual void
+    read_vectors(const storage::FSHandlerPtr& fs_ptr, const std::vector<off_t>& offsets, size_t num_bytes,
+                 std::vector<uint8_t>& raw_vectors) = 0;
 };
 
 using VectorsFormatPtr = std::shared_ptr<VectorsFormat>;
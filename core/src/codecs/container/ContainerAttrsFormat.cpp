@@ -0,0 +1,104 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+
+#include "codecs/container/ContainerAttrsFormat.h"
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+#include "codecs/container/SegmentContainer.h"
+#include "utils/Exception.h"
+#include "utils/Log.h"
+#include "utils/TimeRecorder.h"
+
+namespace milvus {
+namespace codec {
+
+void
+ContainerAttrsFormat::read(const storage::FSHandlerPtr& fs_ptr, segment::AttrsPtr& attrs_read) {
+    ContainerReader container(*fs_ptr->reader_ptr_, ContainerPath(fs_ptr->operation_ptr_->GetDirectory()));
+
+    std::vector<int64_t> uids;
+    if (container.Has(CONTAINER_UIDS)) {
+        uids.resize(container.Entry(CONTAINER_UIDS).size_ / sizeof(int64_t));
+        container.Read(CONTAINER_UIDS, uids.data());
+    }
+
+    const std::string prefix = CONTAINER_ATTR_PREFIX;
+    for (auto& pair : container.Index()) {
+        if (pair.first.compare(0, prefix.size(), prefix) != 0) {
+            continue;
+        }
+        auto field_name = pair.first.substr(prefix.size());
+        std::vector<uint8_t> attr_list(pair.second.size_);
+        container.Read(pair.first, attr_list.data());
+        auto attr = std::make_shared<segment::Attr>(attr_list, attr_list.size(), uids, field_name);
+        attrs_read->attrs.insert(std::make_pair(field_name, attr));
+    }
+}
+
+void
+ContainerAttrsFormat::write(const storage::FSHandlerPtr& fs_ptr, const segment::AttrsPtr& attrs_ptr) {
+    if (attrs_ptr->attrs.empty()) {
+        return;
+    }
+
+    TimeRecorder rc("write attributes");
+
+    ContainerWriter container(ContainerPath(fs_ptr->operation_ptr_->GetDirectory()));
+    container.Open();
+    for (auto& pair : attrs_ptr->attrs) {
+        auto& attr = pair.second;
+        container.Put(CONTAINER_ATTR_PREFIX + attr->GetName(), attr->GetData().data(), attr->GetNbytes());
+    }
+    container.Commit();
+
+    rc.RecordSection("write attributes done");
+}
+
+void
+ContainerAttrsFormat::read_attrs(const storage::FSHandlerPtr& fs_ptr, const std::string& field_name, off_t offset,
+                                 size_t num_bytes, std::vector<uint8_t>& raw_attrs) {
+    ContainerReader container(*fs_ptr->reader_ptr_, ContainerPath(fs_ptr->operation_ptr_->GetDirectory()));
+    const std::string name = CONTAINER_ATTR_PREFIX + field_name;
+    if (!container.Has(name)) {
+        return;
+    }
+
+    auto size = container.Entry(name).size_;
+    if (offset < 0 || offset > size) {
+        std::string err_msg = "Invalid offset " + std::to_string(offset) + " of attribute " + field_name;
+        LOG_ENGINE_ERROR_ << err_msg;
+        throw Exception(SERVER_INVALID_ARGUMENT, err_msg);
+    }
+
+    auto num = std::min<int64_t>(num_bytes, size - offset);
+    raw_attrs.resize(num);
+    container.ReadRanges(name, {storage::IORegion{offset, num, raw_attrs.data()}});
+}
+
+void
+ContainerAttrsFormat::read_uids(const storage::FSHandlerPtr& fs_ptr, std::vector<int64_t>& uids) {
+    ContainerReader container(*fs_ptr->reader_ptr_, ContainerPath(fs_ptr->operation_ptr_->GetDirectory()));
+    uids.resize(container.Entry(CONTAINER_UIDS).size_ / sizeof(int64_t));
+    container.Read(CONTAINER_UIDS, uids.data());
+}
+
+}  // namespace codec
+}  // namespace milvus
@@ -0,0 +1,66 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+
+#include "codecs/container/ContainerCodec.h"
+
+#include <memory>
+
+#include "codecs/container/ContainerAttrsFormat.h"
+#include "codecs/container/ContainerDeletedDocsFormat.h"
+#include "codecs/container/ContainerVectorsFormat.h"
+#include "codecs/default/DefaultIdBloomFilterFormat.h"
+#include "codecs/default/DefaultVectorIndexFormat.h"
+
+namespace milvus {
+namespace codec {
+
+ContainerCodec::ContainerCodec() {
+    vectors_format_ptr_ = std::make_shared<ContainerVectorsFormat>();
+    attrs_format_ptr_ = std::make_shared<ContainerAttrsFormat>();
+    vector_index_format_ptr_ = std::make_shared<DefaultVectorIndexFormat>();
+    deleted_docs_format_ptr_ = std::make_shared<ContainerDeletedDocsFormat>();
+    id_bloom_filter_format_ptr_ = std::make_shared<DefaultIdBloomFilterFormat>();
+}
+
+VectorsFormatPtr
+ContainerCodec::GetVectorsFormat() {
+    return vectors_format_ptr_;
+}
+
+AttrsFormatPtr
+ContainerCodec::GetAttrsFormat() {
+    return attrs_format_ptr_;
+}
+
+VectorIndexFormatPtr
+ContainerCodec::GetVectorIndexFormat() {
+    return vector_index_format_ptr_;
+}
+
+DeletedDocsFormatPtr
+ContainerCodec::GetDeletedDocsFormat() {
+    return deleted_docs_format_ptr_;
+}
+
+IdBloomFilterFormatPtr
+ContainerCodec::GetIdBloomFilterFormat() {
+    return id_bloom_filter_format_ptr_;
+}
+
+}  // namespace codec
+}  // namespace milvus
@@ -0,0 +1,70 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+
+#include "codecs/container/ContainerDeletedDocsFormat.h"
+
+#include <memory>
+#include <vector>
+
+#include "codecs/container/SegmentContainer.h"
+#include "segment/Types.h"
+
+namespace milvus {
+namespace codec {
+
+void
+ContainerDeletedDocsFormat::read(const storage::FSHandlerPtr& fs_ptr, segment::DeletedDocsPtr& deleted_docs) {
+    ContainerReader container(*fs_ptr->reader_ptr_, ContainerPath(fs_ptr->operation_ptr_->GetDirectory()));
+
+    std::vector<segment::offset_t> deleted_docs_list;
+    deleted_docs_list.resize(container.Entry(CONTAINER_DELETED_DOCS).size_ / sizeof(segment::offset_t));
+    container.Read(CONTAINER_DELETED_DOCS, deleted_docs_list.data());
+
+    deleted_docs = std::make_shared<segment::DeletedDocs>(deleted_docs_list);
+}
+
+void
+ContainerDeletedDocsFormat::write(const storage::FSHandlerPtr& fs_ptr, const segment::DeletedDocsPtr& deleted_docs) {
+    auto path = ContainerPath(fs_ptr->operation_ptr_->GetDirectory());
+
+    // holding the writer keeps other appends out while the old list is read
+    ContainerWriter writer(path);
+    writer.Open();
+
+    std::vector<segment::offset_t> deleted_docs_list;
+    if (writer.Index().count(CONTAINER_DELETED_DOCS) > 0) {
+        ContainerReader container(*fs_ptr->reader_ptr_, path);
+        deleted_docs_list.resize(container.Entry(CONTAINER_DELETED_DOCS).size_ / sizeof(segment::offset_t));
+        container.Read(CONTAINER_DELETED_DOCS, deleted_docs_list.data());
+    }
+
+    // the list is written whole again, the old copy stays as dead bytes until the segment is merged
+    auto& new_deleted_docs = deleted_docs->GetDeletedDocs();
+    deleted_docs_list.insert(deleted_docs_list.end(), new_deleted_docs.begin(), new_deleted_docs.end());
+    writer.Put(CONTAINER_DELETED_DOCS, deleted_docs_list.data(), deleted_docs_list.size() * sizeof(segment::offset_t));
+    writer.Commit();
+}
+
+void
+ContainerDeletedDocsFormat::readSize(const storage::FSHandlerPtr& fs_ptr, size_t& size) {
+    ContainerReader container(*fs_ptr->reader_ptr_, ContainerPath(fs_ptr->operation_ptr_->GetDirectory()));
+    size = container.Entry(CONTAINER_DELETED_DOCS).size_ / sizeof(segment::offset_t);
+}
+
+}  // namespace codec
+}  // namespace milvus
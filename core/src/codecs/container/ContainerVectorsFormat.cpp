@@ -0,0 +1,101 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+
+#include "codecs/container/ContainerVectorsFormat.h"
+
+#include <algorithm>
+
+#include "codecs/container/SegmentContainer.h"
+#include "utils/Exception.h"
+#include "utils/Log.h"
+#include "utils/TimeRecorder.h"
+
+namespace milvus {
+namespace codec {
+
+void
+ContainerVectorsFormat::read(const storage::FSHandlerPtr& fs_ptr, segment::VectorsPtr& vectors_read) {
+    ContainerReader container(*fs_ptr->reader_ptr_, ContainerPath(fs_ptr->operation_ptr_->GetDirectory()));
+
+    auto& vector_list = vectors_read->GetMutableData();
+    vector_list.resize(container.Entry(CONTAINER_VECTORS).size_);
+    container.Read(CONTAINER_VECTORS, vector_list.data());
+
+    auto& uids = vectors_read->GetMutableUids();
+    uids.resize(container.Entry(CONTAINER_UIDS).size_ / sizeof(segment::doc_id_t));
+    container.Read(CONTAINER_UIDS, uids.data());
+
+    std::string name(container.Entry(CONTAINER_VECTORS_NAME).size_, '\0');
+    container.Read(CONTAINER_VECTORS_NAME, &name[0]);
+    vectors_read->SetName(name);
+}
+
+void
+ContainerVectorsFormat::write(const storage::FSHandlerPtr& fs_ptr, const segment::VectorsPtr& vectors) {
+    TimeRecorder rc("write vectors");
+
+    ContainerWriter container(ContainerPath(fs_ptr->operation_ptr_->GetDirectory()));
+    container.Open();
+    container.Put(CONTAINER_VECTORS, vectors->GetData().data(), vectors->GetData().size());
+    container.Put(CONTAINER_UIDS, vectors->GetUids().data(), vectors->GetUids().size() * sizeof(segment::doc_id_t));
+    container.Put(CONTAINER_VECTORS_NAME, vectors->GetName().data(), vectors->GetName().size());
+    container.Commit();
+
+    rc.RecordSection("write vectors and uids done");
+}
+
+void
+ContainerVectorsFormat::read_uids(const storage::FSHandlerPtr& fs_ptr, std::vector<segment::doc_id_t>& uids) {
+    ContainerReader container(*fs_ptr->reader_ptr_, ContainerPath(fs_ptr->operation_ptr_->GetDirectory()));
+    uids.resize(container.Entry(CONTAINER_UIDS).size_ / sizeof(segment::doc_id_t));
+    container.Read(CONTAINER_UIDS, uids.data());
+}
+
+void
+ContainerVectorsFormat::read_vectors(const storage::FSHandlerPtr& fs_ptr, off_t offset, size_t num_bytes,
+                                     std::vector<uint8_t>& raw_vectors) {
+    ContainerReader container(*fs_ptr->reader_ptr_, ContainerPath(fs_ptr->operation_ptr_->GetDirectory()));
+    auto size = container.Entry(CONTAINER_VECTORS).size_;
+    if (offset < 0 || offset > size) {
+        std::string err_msg = "Invalid offset " + std::to_string(offset) + " of vectors";
+        LOG_ENGINE_ERROR_ << err_msg;
+        throw Exception(SERVER_INVALID_ARGUMENT, err_msg);
+    }
+
+    auto num = std::min<int64_t>(num_bytes, size - offset);
+    raw_vectors.resize(num);
+    container.ReadRanges(CONTAINER_VECTORS, {storage::IORegion{offset, num, raw_vectors.data()}});
+}
+
+void
+ContainerVectorsFormat::read_vectors(const storage::FSHandlerPtr& fs_ptr, const std::vector<off_t>& offsets,
+                                     size_t num_bytes, std::vector<uint8_t>& raw_vectors) {
+    ContainerReader container(*fs_ptr->reader_ptr_, ContainerPath(fs_ptr->operation_ptr_->GetDirectory()));
+
+    raw_vectors.resize(offsets.size() * num_bytes);
+    std::vector<storage::IORegion> regions;
+    regions.reserve(offsets.size());
+    for (size_t i = 0; i < offsets.size(); ++i) {
+        regions.push_back(storage::IORegion{offsets[i], static_cast<int64_t>(num_bytes),
+                                            raw_vectors.data() + i * num_bytes});
+    }
+    container.ReadRanges(CONTAINER_VECTORS, std::move(regions));
+}
+
+}  // namespace codec
+}  // namespace milvus
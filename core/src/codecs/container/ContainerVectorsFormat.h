@@ -0,0 +1,61 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "codecs/VectorsFormat.h"
+#include "segment/Vectors.h"
+
+namespace milvus {
+namespace codec {
+
+class ContainerVectorsFormat : public VectorsFormat {
+ public:
+    ContainerVectorsFormat() = default;
+
+    void
+    read(const storage::FSHandlerPtr& fs_ptr, segment::VectorsPtr& vectors_read) override;
+
+    void
+    write(const storage::FSHandlerPtr& fs_ptr, const segment::VectorsPtr& vectors) override;
+
+    void
+    read_uids(const storage::FSHandlerPtr& fs_ptr, std::vector<segment::doc_id_t>& uids) override;
+
+    void
+    read_vectors(const storage::FSHandlerPtr& fs_ptr, off_t offset, size_t num_bytes,
+                 std::vector<uint8_t>& raw_vectors) override;
+
+    void
+    read_vectors(const storage::FSHandlerPtr& fs_ptr, const std::vector<off_t>& offsets, size_t num_bytes,
+                 std::vector<uint8_t>& raw_vectors) override;
+
+    // No copy and move
+    ContainerVectorsFormat(const ContainerVectorsFormat&) = delete;
+    ContainerVectorsFormat(ContainerVectorsFormat&&) = delete;
+
+    ContainerVectorsFormat&
+    operator=(const ContainerVectorsFormat&) = delete;
+    ContainerVectorsFormat&
+    operator=(ContainerVectorsFormat&&) = delete;
+};
+
+}  // namespace codec
+}  // namespace milvus
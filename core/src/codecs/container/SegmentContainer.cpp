@@ -0,0 +1,458 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "codecs/container/SegmentContainer.h"
+
+#include <fcntl.h>
+#include <fiu-local.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <boost/filesystem.hpp>
+#include <cstring>
+#include <functional>
+
+#include "storage/disk/DiskIOReader.h"
+#include "utils/Exception.h"
+#include "utils/Log.h"
+
+namespace milvus {
+namespace codec {
+
+const char* CONTAINER_FILE_NAME = "segment.container";
+
+const char* CONTAINER_VECTORS = "vectors";
+const char* CONTAINER_VECTORS_NAME = "vectors_name";
+const char* CONTAINER_UIDS = "uids";
+const char* CONTAINER_DELETED_DOCS = "deleted_docs";
+const char* CONTAINER_ATTR_PREFIX = "attr/";
+
+namespace {
+
+constexpr uint64_t CONTAINER_MAGIC = 0x524E544E43534C4DULL;
+constexpr uint32_t FOOTER_MAGIC = 0x52544F46;
+constexpr uint32_t CONTAINER_VERSION = 1;
+
+// footer: magic, version, entry count, entry bytes; then the entries and a crc32 of all of it
+constexpr int64_t FOOTER_HEAD_SIZE = 4 * sizeof(uint32_t);
+// trailer: footer offset, magic
+constexpr int64_t TRAILER_SIZE = sizeof(int64_t) + sizeof(uint64_t);
+
+constexpr size_t CONTAINER_LOCK_STRIPES = 64;
+
+int64_t
+AlignUp(int64_t value) {
+    return (value + CONTAINER_ALIGNMENT - 1) / CONTAINER_ALIGNMENT * CONTAINER_ALIGNMENT;
+}
+
+uint32_t
+Checksum(const void* data, size_t size) {
+    boost::crc_32_type crc;
+    crc.process_bytes(data, size);
+    return crc.checksum();
+}
+
+// appends of all containers are serialized per stripe
+std::mutex&
+ContainerLock(const std::string& path) {
+    static std::mutex locks[CONTAINER_LOCK_STRIPES];
+    return locks[std::hash<std::string>()(path) % CONTAINER_LOCK_STRIPES];
+}
+
+template <typename T>
+void
+Append(std::vector<uint8_t>& buffer, const T& value) {
+    auto bytes = reinterpret_cast<const uint8_t*>(&value);
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+}
+
+template <typename T>
+bool
+Extract(const std::vector<uint8_t>& buffer, size_t& pos, T& value) {
+    if (pos + sizeof(T) > buffer.size()) {
+        return false;
+    }
+    memcpy(&value, buffer.data() + pos, sizeof(T));
+    pos += sizeof(T);
+    return true;
+}
+
+std::vector<uint8_t>
+EncodeFooter(const ContainerIndex& index) {
+    std::vector<uint8_t> entries;
+    for (auto& pair : index) {
+        Append(entries, static_cast<uint32_t>(pair.first.size()));
+        entries.insert(entries.end(), pair.first.begin(), pair.first.end());
+        Append(entries, pair.second.offset_);
+        Append(entries, pair.second.size_);
+        Append(entries, pair.second.crc_);
+    }
+
+    std::vector<uint8_t> footer;
+    Append(footer, FOOTER_MAGIC);
+    Append(footer, CONTAINER_VERSION);
+    Append(footer, static_cast<uint32_t>(index.size()));
+    Append(footer, static_cast<uint32_t>(entries.size()));
+    footer.insert(footer.end(), entries.begin(), entries.end());
+    Append(footer, Checksum(footer.data(), footer.size()));
+    return footer;
+}
+
+// parse the footer at offset, false if there is no intact footer
+bool
+ReadFooter(storage::IOReader& reader, int64_t offset, int64_t length, ContainerIndex& index) {
+    if (offset + FOOTER_HEAD_SIZE + (int64_t)sizeof(uint32_t) > length) {
+        return false;
+    }
+    std::vector<uint8_t> footer(FOOTER_HEAD_SIZE);
+    reader.seekg(offset);
+    reader.read(footer.data(), FOOTER_HEAD_SIZE);
+
+    size_t pos = 0;
+    uint32_t magic = 0, version = 0, count = 0, entry_bytes = 0;
+    Extract(footer, pos, magic);
+    Extract(footer, pos, version);
+    Extract(footer, pos, count);
+    Extract(footer, pos, entry_bytes);
+    if (magic != FOOTER_MAGIC || version != CONTAINER_VERSION ||
+        offset + FOOTER_HEAD_SIZE + entry_bytes + (int64_t)sizeof(uint32_t) > length) {
+        return false;
+    }
+
+    footer.resize(FOOTER_HEAD_SIZE + entry_bytes + sizeof(uint32_t));
+    reader.read(footer.data() + FOOTER_HEAD_SIZE, entry_bytes + sizeof(uint32_t));
+    uint32_t crc = 0;
+    memcpy(&crc, footer.data() + FOOTER_HEAD_SIZE + entry_bytes, sizeof(uint32_t));
+    if (crc != Checksum(footer.data(), FOOTER_HEAD_SIZE + entry_bytes)) {
+        return false;
+    }
+
+    ContainerIndex parsed;
+    for (uint32_t i = 0; i < count; ++i) {
+        uint32_t name_size = 0;
+        if (!Extract(footer, pos, name_size) || pos + name_size > footer.size()) {
+            return false;
+        }
+        std::string name(reinterpret_cast<const char*>(footer.data() + pos), name_size);
+        pos += name_size;
+        ContainerEntry entry;
+        if (!Extract(footer, pos, entry.offset_) || !Extract(footer, pos, entry.size_) ||
+            !Extract(footer, pos, entry.crc_)) {
+            return false;
+        }
+        if (entry.offset_ % CONTAINER_ALIGNMENT != 0 || entry.size_ < 0 || entry.offset_ + entry.size_ > offset) {
+            return false;
+        }
+        parsed[name] = entry;
+    }
+    index.swap(parsed);
+    return true;
+}
+
+}  // namespace
+
+std::string
+ContainerPath(const std::string& directory) {
+    return directory + "/" + CONTAINER_FILE_NAME;
+}
+
+MappedComponent::MappedComponent(void* base, size_t length, int64_t delta, int64_t size)
+    : base_(base), length_(length), delta_(delta), size_(size) {
+}
+
+MappedComponent::~MappedComponent() {
+    if (base_ != nullptr) {
+        munmap(base_, length_);
+    }
+}
+
+void
+LoadContainerIndex(storage::IOReader& reader, const std::string& path, ContainerIndex& index) {
+    int64_t length = reader.length();
+    uint64_t magic = 0;
+    if (length >= CONTAINER_ALIGNMENT + TRAILER_SIZE) {
+        reader.seekg(0);
+        reader.read(&magic, sizeof(magic));
+    }
+    if (magic != CONTAINER_MAGIC) {
+        std::string err_msg = "Not a segment container: " + path;
+        LOG_ENGINE_ERROR_ << err_msg;
+        throw Exception(DB_ERROR, err_msg);
+    }
+
+    int64_t footer_offset = 0;
+    reader.seekg(length - TRAILER_SIZE);
+    reader.read(&footer_offset, sizeof(footer_offset));
+    reader.read(&magic, sizeof(magic));
+    bool trailer_ok = (magic == CONTAINER_MAGIC);
+    fiu_do_on("LoadContainerIndex.torn_trailer", trailer_ok = false);
+    if (trailer_ok && footer_offset >= CONTAINER_ALIGNMENT && footer_offset % CONTAINER_ALIGNMENT == 0 &&
+        ReadFooter(reader, footer_offset, length - TRAILER_SIZE, index)) {
+        return;
+    }
+
+    // an append was cut short, the last intact footer still describes a consistent container
+    for (int64_t offset = (length - 1) / CONTAINER_ALIGNMENT * CONTAINER_ALIGNMENT; offset >= CONTAINER_ALIGNMENT;
+         offset -= CONTAINER_ALIGNMENT) {
+        if (ReadFooter(reader, offset, length, index)) {
+            LOG_ENGINE_WARNING_ << "Torn trailer in " << path << ", recovered footer at " << offset;
+            return;
+        }
+    }
+
+    std::string err_msg = "No intact footer in segment container: " + path;
+    LOG_ENGINE_ERROR_ << err_msg;
+    throw Exception(DB_ERROR, err_msg);
+}
+
+ContainerReader::ContainerReader(storage::IOReader& reader, const std::string& path) : reader_(reader), path_(path) {
+    if (!reader_.open(path_)) {
+        std::string err_msg = "Failed to open file: " + path_ + ", error: " + std::strerror(errno);
+        LOG_ENGINE_ERROR_ << err_msg;
+        throw Exception(SERVER_CANNOT_OPEN_FILE, err_msg);
+    }
+    try {
+        LoadContainerIndex(reader_, path_, index_);
+    } catch (...) {
+        reader_.close();
+        throw;
+    }
+}
+
+ContainerReader::~ContainerReader() {
+    reader_.close();
+}
+
+bool
+ContainerReader::Has(const std::string& name) const {
+    return index_.find(name) != index_.end();
+}
+
+const ContainerEntry&
+ContainerReader::Entry(const std::string& name) const {
+    auto iter = index_.find(name);
+    if (iter == index_.end()) {
+        std::string err_msg = "No component " + name + " in segment container: " + path_;
+        LOG_ENGINE_ERROR_ << err_msg;
+        throw Exception(SERVER_FILE_NOT_FOUND, err_msg);
+    }
+    return iter->second;
+}
+
+void
+ContainerReader::Read(const std::string& name, void* ptr) {
+    auto& entry = Entry(name);
+    reader_.seekg(entry.offset_);
+    reader_.read(ptr, entry.size_);
+    if (Checksum(ptr, entry.size_) != entry.crc_) {
+        std::string err_msg = "Checksum mismatch of component " + name + " in segment container: " + path_;
+        LOG_ENGINE_ERROR_ << err_msg;
+        throw Exception(DB_ERROR, err_msg);
+    }
+}
+
+void
+ContainerReader::ReadRanges(const std::string& name, std::vector<storage::IORegion> regions) {
+    auto& entry = Entry(name);
+    for (auto& region : regions) {
+        if (region.offset_ < 0 || region.size_ < 0 || region.offset_ + region.size_ > entry.size_) {
+            std::string err_msg = "Invalid range " + std::to_string(region.offset_) + "+" +
+                                  std::to_string(region.size_) + " of component " + name + " in: " + path_;
+            LOG_ENGINE_ERROR_ << err_msg;
+            throw Exception(SERVER_INVALID_ARGUMENT, err_msg);
+        }
+        region.offset_ += entry.offset_;
+    }
+    reader_.readv(regions);
+}
+
+MappedComponentPtr
+ContainerReader::Map(const std::string& name, bool verify) {
+    auto& entry = Entry(name);
+    if (entry.size_ == 0) {
+        return std::make_shared<MappedComponent>(nullptr, 0, 0, 0);
+    }
+
+    int fd = ::open(path_.c_str(), O_RDONLY);
+    if (fd == -1) {
+        std::string err_msg = "Failed to open file: " + path_ + ", error: " + std::strerror(errno);
+        LOG_ENGINE_ERROR_ << err_msg;
+        throw Exception(SERVER_CANNOT_OPEN_FILE, err_msg);
+    }
+    // pages may be larger than the container alignment
+    int64_t page_size = sysconf(_SC_PAGESIZE);
+    int64_t map_offset = entry.offset_ / page_size * page_size;
+    int64_t delta = entry.offset_ - map_offset;
+    size_t length = delta + entry.size_;
+    void* base = mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, map_offset);
+    ::close(fd);
+    if (base == MAP_FAILED) {
+        std::string err_msg = "Failed to map component " + name + " of: " + path_ + ", error: " + std::strerror(errno);
+        LOG_ENGINE_ERROR_ << err_msg;
+        throw Exception(SERVER_UNEXPECTED_ERROR, err_msg);
+    }
+
+    auto mapped = std::make_shared<MappedComponent>(base, length, delta, entry.size_);
+    if (verify && Checksum(mapped->data(), mapped->size()) != entry.crc_) {
+        std::string err_msg = "Checksum mismatch of component " + name + " in segment container: " + path_;
+        LOG_ENGINE_ERROR_ << err_msg;
+        throw Exception(DB_ERROR, err_msg);
+    }
+    return mapped;
+}
+
+ContainerWriter::ContainerWriter(const std::string& path) : path_(path), lock_(ContainerLock(path), std::defer_lock) {
+}
+
+ContainerWriter::~ContainerWriter() {
+    if (fd_ != -1) {
+        Rollback();
+    }
+}
+
+void
+ContainerWriter::Open() {
+    lock_.lock();
+
+    created_ = !boost::filesystem::exists(path_);
+    if (!created_) {
+        storage::DiskIOReader reader;
+        if (!reader.open(path_)) {
+            std::string err_msg = "Failed to open file: " + path_ + ", error: " + std::strerror(errno);
+            LOG_ENGINE_ERROR_ << err_msg;
+            throw Exception(SERVER_CANNOT_OPEN_FILE, err_msg);
+        }
+        original_size_ = reader.length();
+        try {
+            LoadContainerIndex(reader, path_, index_);
+        } catch (...) {
+            reader.close();
+            throw;
+        }
+        reader.close();
+    }
+
+    fd_ = ::open(path_.c_str(), O_RDWR | O_CREAT, 00664);
+    if (fd_ == -1) {
+        std::string err_msg = "Failed to open file: " + path_ + ", error: " + std::strerror(errno);
+        LOG_ENGINE_ERROR_ << err_msg;
+        throw Exception(SERVER_CANNOT_CREATE_FILE, err_msg);
+    }
+
+    if (created_) {
+        std::vector<uint8_t> header;
+        Append(header, CONTAINER_MAGIC);
+        Append(header, CONTAINER_VERSION);
+        header.resize(CONTAINER_ALIGNMENT, 0);
+        WriteRaw(header.data(), header.size());
+    } else {
+        pos_ = AlignUp(original_size_);
+    }
+}
+
+void
+ContainerWriter::BeginComponent(const std::string& name) {
+    if (fd_ == -1 || in_component_) {
+        throw Exception(SERVER_UNEXPECTED_ERROR, "Cannot begin component " + name + " in: " + path_);
+    }
+    PadToAlignment();
+    current_name_ = name;
+    current_entry_ = ContainerEntry();
+    current_entry_.offset_ = pos_;
+    current_crc_.reset();
+    in_component_ = true;
+}
+
+void
+ContainerWriter::Write(const void* data, int64_t size) {
+    WriteRaw(data, size);
+    current_crc_.process_bytes(data, size);
+}
+
+void
+ContainerWriter::EndComponent() {
+    current_entry_.size_ = pos_ - current_entry_.offset_;
+    current_entry_.crc_ = current_crc_.checksum();
+    index_[current_name_] = current_entry_;
+    in_component_ = false;
+}
+
+void
+ContainerWriter::Put(const std::string& name, const void* data, int64_t size) {
+    BeginComponent(name);
+    Write(data, size);
+    EndComponent();
+}
+
+void
+ContainerWriter::Commit() {
+    if (fd_ == -1 || in_component_) {
+        throw Exception(SERVER_UNEXPECTED_ERROR, "Cannot commit segment container: " + path_);
+    }
+    PadToAlignment();
+    int64_t footer_offset = pos_;
+    auto footer = EncodeFooter(index_);
+    Append(footer, footer_offset);
+    Append(footer, CONTAINER_MAGIC);
+    WriteRaw(footer.data(), footer.size());
+
+    if (::close(fd_) == -1) {
+        std::string err_msg = "Failed to close file: " + path_ + ", error: " + std::strerror(errno);
+        LOG_ENGINE_ERROR_ << err_msg;
+        fd_ = -1;
+        throw Exception(SERVER_WRITE_ERROR, err_msg);
+    }
+    fd_ = -1;
+    lock_.unlock();
+}
+
+void
+ContainerWriter::WriteRaw(const void* data, int64_t size) {
+    auto ptr = static_cast<const char*>(data);
+    while (size > 0) {
+        ssize_t written = ::pwrite(fd_, ptr, size, pos_);
+        fiu_do_on("ContainerWriter.WriteRaw.fail", written = -1);
+        if (written == -1) {
+            std::string err_msg = "Failed to write to file: " + path_ + ", error: " + std::strerror(errno);
+            LOG_ENGINE_ERROR_ << err_msg;
+            throw Exception(SERVER_WRITE_ERROR, err_msg);
+        }
+        ptr += written;
+        pos_ += written;
+        size -= written;
+    }
+}
+
+void
+ContainerWriter::PadToAlignment() {
+    // the gap is left as a hole, it reads back as zeros
+    pos_ = AlignUp(pos_);
+}
+
+void
+ContainerWriter::Rollback() {
+    if (created_) {
+        ::unlink(path_.c_str());
+    } else if (::ftruncate(fd_, original_size_) == -1) {
+        LOG_ENGINE_ERROR_ << "Failed to roll back " << path_ << ", error: " << std::strerror(errno);
+    }
+    ::close(fd_);
+    fd_ = -1;
+}
+
+}  // namespace codec
+}  // namespace milvus
@@ -0,0 +1,195 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <boost/crc.hpp>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "storage/IOReader.h"
+
+namespace milvus {
+namespace codec {
+
+// the single file holding all components of a segment
+extern const char* CONTAINER_FILE_NAME;
+
+// component names
+extern const char* CONTAINER_VECTORS;
+extern const char* CONTAINER_VECTORS_NAME;
+extern const char* CONTAINER_UIDS;
+extern const char* CONTAINER_DELETED_DOCS;
+extern const char* CONTAINER_ATTR_PREFIX;
+
+// components and footers start on this boundary, so they can be mapped and read with O_DIRECT
+constexpr int64_t CONTAINER_ALIGNMENT = 4096;
+
+struct ContainerEntry {
+    int64_t offset_ = 0;
+    int64_t size_ = 0;
+    uint32_t crc_ = 0;
+};
+
+using ContainerIndex = std::map<std::string, ContainerEntry>;
+
+std::string
+ContainerPath(const std::string& directory);
+
+/*
+ * Layout of a container:
+ *   header block | component | component | ... | footer | trailer
+ * Each component and the footer start on a CONTAINER_ALIGNMENT boundary. The footer lists name, offset,
+ * size and crc32 of every component and ends with a crc32 of itself; the trailer holds the footer offset.
+ * Updates append components and a new footer behind the old one, bytes once written never change, so
+ * readers and mappings stay valid while a writer appends. If the trailer is torn, readers fall back to
+ * the last intact footer.
+ */
+
+// read-only mapping of one component, unmapped on destruction
+class MappedComponent {
+ public:
+    MappedComponent(void* base, size_t length, int64_t delta, int64_t size);
+
+    ~MappedComponent();
+
+    const uint8_t*
+    data() const {
+        return static_cast<const uint8_t*>(base_) + delta_;
+    }
+
+    int64_t
+    size() const {
+        return size_;
+    }
+
+    MappedComponent(const MappedComponent&) = delete;
+    MappedComponent&
+    operator=(const MappedComponent&) = delete;
+
+ private:
+    void* base_;
+    size_t length_;
+    int64_t delta_;
+    int64_t size_;
+};
+
+using MappedComponentPtr = std::shared_ptr<MappedComponent>;
+
+// load the footer index of the container opened by reader, throws Exception if there is none
+void
+LoadContainerIndex(storage::IOReader& reader, const std::string& path, ContainerIndex& index);
+
+class ContainerReader {
+ public:
+    // opens path with reader and loads the index, throws Exception on error
+    ContainerReader(storage::IOReader& reader, const std::string& path);
+
+    ~ContainerReader();
+
+    const ContainerIndex&
+    Index() const {
+        return index_;
+    }
+
+    bool
+    Has(const std::string& name) const;
+
+    const ContainerEntry&
+    Entry(const std::string& name) const;
+
+    // whole component into ptr, which holds at least Entry(name).size_ bytes; the crc is verified
+    void
+    Read(const std::string& name, void* ptr);
+
+    // regions with offsets relative to the start of the component, read in one readv
+    void
+    ReadRanges(const std::string& name, std::vector<storage::IORegion> regions);
+
+    MappedComponentPtr
+    Map(const std::string& name, bool verify);
+
+ private:
+    storage::IOReader& reader_;
+    std::string path_;
+    ContainerIndex index_;
+};
+
+class ContainerWriter {
+ public:
+    explicit ContainerWriter(const std::string& path);
+
+    // an append that was not committed is cut off again
+    ~ContainerWriter();
+
+    // creates the container, or loads the index of an existing one to append to it
+    void
+    Open();
+
+    // a component replaces the one of the same name once committed
+    void
+    BeginComponent(const std::string& name);
+
+    void
+    Write(const void* data, int64_t size);
+
+    void
+    EndComponent();
+
+    void
+    Put(const std::string& name, const void* data, int64_t size);
+
+    // writes the footer and trailer
+    void
+    Commit();
+
+    const ContainerIndex&
+    Index() const {
+        return index_;
+    }
+
+ private:
+    void
+    WriteRaw(const void* data, int64_t size);
+
+    void
+    PadToAlignment();
+
+    void
+    Rollback();
+
+ private:
+    std::string path_;
+    std::unique_lock<std::mutex> lock_;
+    int fd_ = -1;
+    bool created_ = false;
+    int64_t original_size_ = 0;
+    int64_t pos_ = 0;
+    ContainerIndex index_;
+
+    std::string current_name_;
+    ContainerEntry current_entry_;
+    boost::crc_32_type current_crc_;
+    bool in_component_ = false;
+};
+
+}  // namespace codec
+}  // namespace milvus
@@ -53,6 +53,38 @@ DefaultVectorsFormat::read_vectors_internal(const storage::FSHandlerPtr& fs_ptr,
     fs_ptr->reader_ptr_->close();
 }
 
+void
+DefaultVectorsFormat::read_vectors_internal(const storage::FSHandlerPtr& fs_ptr, const std::string& file_path,
+                                            const std::vector<off_t>& offsets, size_t num,
+                                            std::vector<uint8_t>& raw_vectors) {
+    if (!fs_ptr->reader_ptr_->open(file_path.c_str())) {
+        std::string err_msg = "Failed to open file: " + file_path + ", error: " + std::strerror(errno);
+        LOG_ENGINE_ERROR_ << err_msg;
+        throw Exception(SERVER_CANNOT_OPEN_FILE, err_msg);
+    }
+
+    size_t num_bytes;
+    fs_ptr->reader_ptr_->read(&num_bytes, sizeof(size_t));
+
+    // all regions go to the reader at once, so backends can keep them in flight together
+    raw_vectors.resize(offsets.size() * num);
+    std::vector<storage::IORegion> regions;
+    regions.reserve(offsets.size());
+    for (size_t i = 0; i < offsets.size(); ++i) {
+        if (offsets[i] < 0 || offsets[i] + num > num_bytes) {
+            fs_ptr->reader_ptr_->close();
+            std::string err_msg = "Invalid offset " + std::to_string(offsets[i]) + " in file: " + file_path;
+            LOG_ENGINE_ERROR_ << err_msg;
+            throw Exception(SERVER_INVALID_ARGUMENT, err_msg);
+        }
+        regions.push_back(storage::IORegion{static_cast<int64_t>(offsets[i] + sizeof(size_t)),
+                                            static_cast<int64_t>(num), raw_vectors.data() + i * num});
+    }
+    fs_ptr->reader_ptr_->readv(regions);
+
+    fs_ptr->reader_ptr_->close();
+}
+
 void
 DefaultVectorsFormat::read_uids_internal(const storage::FSHandlerPtr& fs_ptr, const std::string& file_path,
                                          std::vector<segment::doc_id_t>& uids) {
@@ -186,5 +218,29 @@ DefaultVectorsFormat::read_vectors(const storage::FSHandlerPtr& fs_ptr, off_t of
     }
 }
 
+void
+DefaultVectorsFormat::read_vectors(const storage::FSHandlerPtr& fs_ptr, const std::vector<off_t>& offsets,
+                                   size_t num_bytes, std::vector<uint8_t>& raw_vectors) {
+    const std::lock_guard<std::mutex> lock(mutex_);
+
+    std::string dir_path = fs_ptr->operation_ptr_->GetDirectory();
+    if (!boost::filesystem::is_directory(dir_path)) {
+        std::string err_msg = "Directory: " + dir_path + "does not exist";
+        LOG_ENGINE_ERROR_ << err_msg;
+        throw Exception(SERVER_INVALID_ARGUMENT, err_msg);
+    }
+
+    boost::filesystem::path target_path(dir_path);
+    typedef boost::filesystem::directory_iterator d_it;
+    d_it it_end;
+    d_it it(target_path);
+    for (; it != it_end; ++it) {
+        const auto& path = it->path();
+        if (path.extension().string() == raw_vector_extension_) {
+            read_vectors_internal(fs_ptr, path.string(), offsets, num_bytes, raw_vectors);
+        }
+    }
+}
+
 }  // namespace codec
 }  // namespace milvus
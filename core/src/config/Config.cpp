@@ -83,6 +83,18 @@ const char* CONFIG_STORAGE_FILE_CLEANUP_TIMEOUT = "file_cleanup_timeout";
 const char* CONFIG_STORAGE_FILE_CLEANUP_TIMEOUT_DEFAULT = "10";
 const int64_t CONFIG_STORAGE_FILE_CLEANUP_TIMEOUT_MIN = 0;
 const int64_t CONFIG_STORAGE_FILE_CLEANUP_TIMEOUT_MAX = 3600;
+const char* CONFIG_STORAGE_MERGE_IO_RATE_LIMIT = "merge_io_rate_limit";
+const char* CONFIG_STORAGE_MERGE_IO_RATE_LIMIT_DEFAULT = "0";
+const char* CONFIG_STORAGE_MERGE_STRATEGY = "merge_strategy";
+const char* CONFIG_STORAGE_MERGE_STRATEGY_DEFAULT = "layered";
+const char* CONFIG_STORAGE_S3_CACHE_CAPACITY = "s3_cache_capacity";
+const char* CONFIG_STORAGE_S3_CACHE_CAPACITY_DEFAULT = "16GB";
+const char* CONFIG_STORAGE_IO_ENGINE = "io_engine";
+const char* CONFIG_STORAGE_IO_ENGINE_DEFAULT = "fstream";
+const char* CONFIG_STORAGE_DIRECT_IO = "direct_io";
+const char* CONFIG_STORAGE_DIRECT_IO_DEFAULT = "false";
+const char* CONFIG_STORAGE_CODEC = "codec";
+const char* CONFIG_STORAGE_CODEC_DEFAULT = "default";
 
 /* cache config */
 const char* CONFIG_CACHE = "cache";
@@ -96,6 +108,8 @@ const char* CONFIG_CACHE_CACHE_INSERT_DATA = "cache_insert_data";
 const char* CONFIG_CACHE_CACHE_INSERT_DATA_DEFAULT = "false";
 const char* CONFIG_CACHE_PRELOAD_COLLECTION = "preload_collection";
 const char* CONFIG_CACHE_PRELOAD_COLLECTION_DEFAULT = "";
+const char* CONFIG_CACHE_PRELOAD_PARALLELISM = "preload_parallelism";
+const char* CONFIG_CACHE_PRELOAD_PARALLELISM_DEFAULT = "4";
 
 /* metric config */
 const char* CONFIG_METRIC = "metric";
@@ -114,6 +128,12 @@ const char* CONFIG_ENGINE_OMP_THREAD_NUM = "omp_thread_num";
 const char* CONFIG_ENGINE_OMP_THREAD_NUM_DEFAULT = "0";
 const char* CONFIG_ENGINE_SIMD_TYPE = "simd_type";
 const char* CONFIG_ENGINE_SIMD_TYPE_DEFAULT = "auto";
+const char* CONFIG_ENGINE_SEARCH_BATCH_WINDOW = "search_batch_window_us";
+const char* CONFIG_ENGINE_SEARCH_BATCH_WINDOW_DEFAULT = "0";
+const char* CONFIG_ENGINE_SEARCH_BATCH_MAX_NQ = "search_batch_max_nq";
+const char* CONFIG_ENGINE_SEARCH_BATCH_MAX_NQ_DEFAULT = "200";
+const char* CONFIG_ENGINE_MAX_LOAD_DEPTH = "max_load_depth";
+const char* CONFIG_ENGINE_MAX_LOAD_DEPTH_DEFAULT = "4";
 
 /* gpu resource config */
 const char* CONFIG_GPU_RESOURCE = "gpu";
@@ -158,6 +178,8 @@ const char* CONFIG_LOGS_LEVEL = "level";
 const char* CONFIG_LOGS_LEVEL_DEFAULT = "debug";
 const char* CONFIG_LOGS_TRACE_ENABLE = "trace.enable";
 const char* CONFIG_LOGS_TRACE_ENABLE_DEFAULT = "true";
+const char* CONFIG_LOGS_TRACE_SAMPLE_INTERVAL = "trace.sample_interval";
+const char* CONFIG_LOGS_TRACE_SAMPLE_INTERVAL_DEFAULT = "100";
 const char* CONFIG_LOGS_PATH = "path";
 const char* CONFIG_LOGS_PATH_DEFAULT = "/tmp/milvus/logs";
 const char* CONFIG_LOGS_MAX_LOG_FILE_SIZE = "max_log_file_size";
@@ -290,6 +312,24 @@ Config::ValidateConfig() {
     int64_t auto_flush_interval;
     STATUS_CHECK(GetStorageConfigAutoFlushInterval(auto_flush_interval));
 
+    int64_t merge_io_rate_limit;
+    STATUS_CHECK(GetStorageConfigMergeIORateLimit(merge_io_rate_limit));
+
+    std::string merge_strategy;
+    STATUS_CHECK(GetStorageConfigMergeStrategy(merge_strategy));
+
+    int64_t s3_cache_capacity;
+    STATUS_CHECK(GetStorageConfigS3CacheCapacity(s3_cache_capacity));
+
+    std::string io_engine;
+    STATUS_CHECK(GetStorageConfigIOEngine(io_engine));
+
+    bool direct_io;
+    STATUS_CHECK(GetStorageConfigDirectIO(direct_io));
+
+    std::string codec;
+    STATUS_CHECK(GetStorageConfigCodec(codec));
+
     // bool storage_s3_enable;
     // STATUS_CHECK(GetStorageConfigS3Enable(storage_s3_enable));
     // // std::cout << "S3 " << (storage_s3_enable ? "ENABLED !" : "DISABLED !") << std::endl;
@@ -335,6 +375,9 @@ Config::ValidateConfig() {
     std::string cache_preload_collection;
     STATUS_CHECK(GetCacheConfigPreloadCollection(cache_preload_collection));
 
+    int64_t cache_preload_parallelism;
+    STATUS_CHECK(GetCacheConfigPreloadParallelism(cache_preload_parallelism));
+
     /* engine config */
     int64_t engine_use_blas_threshold;
     STATUS_CHECK(GetEngineConfigUseBlasThreshold(engine_use_blas_threshold));
@@ -345,6 +388,15 @@ Config::ValidateConfig() {
     std::string engine_simd_type;
     STATUS_CHECK(GetEngineConfigSimdType(engine_simd_type));
 
+    int64_t engine_search_batch_window;
+    STATUS_CHECK(GetEngineConfigSearchBatchWindow(engine_search_batch_window));
+
+    int64_t engine_search_batch_max_nq;
+    STATUS_CHECK(GetEngineConfigSearchBatchMaxNq(engine_search_batch_max_nq));
+
+    int64_t engine_max_load_depth;
+    STATUS_CHECK(GetEngineConfigMaxLoadDepth(engine_max_load_depth));
+
     /* gpu resource config */
 #ifdef MILVUS_GPU_VERSION
     bool gpu_resource_enable;
@@ -393,6 +445,9 @@ Config::ValidateConfig() {
     bool trace_enable;
     STATUS_CHECK(GetLogsTraceEnable(trace_enable));
 
+    int64_t trace_sample_interval;
+    STATUS_CHECK(GetLogsTraceSampleInterval(trace_sample_interval));
+
     std::string logs_path;
     STATUS_CHECK(GetLogsPath(logs_path));
 
@@ -429,6 +484,12 @@ Config::ResetDefaultConfig() {
     STATUS_CHECK(SetStorageConfigPath(CONFIG_STORAGE_PATH_DEFAULT));
     STATUS_CHECK(SetStorageConfigAutoFlushInterval(CONFIG_STORAGE_AUTO_FLUSH_INTERVAL_DEFAULT));
     STATUS_CHECK(SetStorageConfigFileCleanupTimeout(CONFIG_STORAGE_FILE_CLEANUP_TIMEOUT_DEFAULT));
+    STATUS_CHECK(SetStorageConfigMergeIORateLimit(CONFIG_STORAGE_MERGE_IO_RATE_LIMIT_DEFAULT));
+    STATUS_CHECK(SetStorageConfigMergeStrategy(CONFIG_STORAGE_MERGE_STRATEGY_DEFAULT));
+    STATUS_CHECK(SetStorageConfigS3CacheCapacity(CONFIG_STORAGE_S3_CACHE_CAPACITY_DEFAULT));
+    STATUS_CHECK(SetStorageConfigIOEngine(CONFIG_STORAGE_IO_ENGINE_DEFAULT));
+    STATUS_CHECK(SetStorageConfigDirectIO(CONFIG_STORAGE_DIRECT_IO_DEFAULT));
+    STATUS_CHECK(SetStorageConfigCodec(CONFIG_STORAGE_CODEC_DEFAULT));
     // STATUS_CHECK(SetStorageConfigS3Enable(CONFIG_STORAGE_S3_ENABLE_DEFAULT));
     // STATUS_CHECK(SetStorageConfigS3Address(CONFIG_STORAGE_S3_ADDRESS_DEFAULT));
     // STATUS_CHECK(SetStorageConfigS3Port(CONFIG_STORAGE_S3_PORT_DEFAULT));
@@ -447,11 +508,15 @@ Config::ResetDefaultConfig() {
     STATUS_CHECK(SetCacheConfigInsertBufferSize(CONFIG_CACHE_INSERT_BUFFER_SIZE_DEFAULT));
     STATUS_CHECK(SetCacheConfigCacheInsertData(CONFIG_CACHE_CACHE_INSERT_DATA_DEFAULT));
     STATUS_CHECK(SetCacheConfigPreloadCollection(CONFIG_CACHE_PRELOAD_COLLECTION_DEFAULT));
+    STATUS_CHECK(SetCacheConfigPreloadParallelism(CONFIG_CACHE_PRELOAD_PARALLELISM_DEFAULT));
 
     /* engine config */
     STATUS_CHECK(SetEngineConfigUseBlasThreshold(CONFIG_ENGINE_USE_BLAS_THRESHOLD_DEFAULT));
     STATUS_CHECK(SetEngineConfigOmpThreadNum(CONFIG_ENGINE_OMP_THREAD_NUM_DEFAULT));
     STATUS_CHECK(SetEngineConfigSimdType(CONFIG_ENGINE_SIMD_TYPE_DEFAULT));
+    STATUS_CHECK(SetEngineConfigSearchBatchWindow(CONFIG_ENGINE_SEARCH_BATCH_WINDOW_DEFAULT));
+    STATUS_CHECK(SetEngineConfigSearchBatchMaxNq(CONFIG_ENGINE_SEARCH_BATCH_MAX_NQ_DEFAULT));
+    STATUS_CHECK(SetEngineConfigMaxLoadDepth(CONFIG_ENGINE_MAX_LOAD_DEPTH_DEFAULT));
 
     /* gpu resource config */
 #ifdef MILVUS_GPU_VERSION
@@ -472,6 +537,7 @@ Config::ResetDefaultConfig() {
     /* logs config */
     STATUS_CHECK(SetLogsLevel(CONFIG_LOGS_LEVEL_DEFAULT));
     STATUS_CHECK(SetLogsTraceEnable(CONFIG_LOGS_TRACE_ENABLE_DEFAULT));
+    STATUS_CHECK(SetLogsTraceSampleInterval(CONFIG_LOGS_TRACE_SAMPLE_INTERVAL_DEFAULT));
     STATUS_CHECK(SetLogsPath(CONFIG_LOGS_PATH_DEFAULT));
     STATUS_CHECK(SetLogsMaxLogFileSize(CONFIG_LOGS_MAX_LOG_FILE_SIZE_DEFAULT));
     STATUS_CHECK(SetLogsLogRotateNum(CONFIG_LOGS_LOG_ROTATE_NUM_DEFAULT));
@@ -533,6 +599,18 @@ Config::SetConfigCli(const std::string& parent_key, const std::string& child_key
             status = SetStorageConfigPath(value);
         } else if (child_key == CONFIG_STORAGE_AUTO_FLUSH_INTERVAL) {
             status = SetStorageConfigAutoFlushInterval(value);
+        } else if (child_key == CONFIG_STORAGE_MERGE_IO_RATE_LIMIT) {
+            status = SetStorageConfigMergeIORateLimit(value);
+        } else if (child_key == CONFIG_STORAGE_MERGE_STRATEGY) {
+            status = SetStorageConfigMergeStrategy(value);
+        } else if (child_key == CONFIG_STORAGE_S3_CACHE_CAPACITY) {
+            status = SetStorageConfigS3CacheCapacity(value);
+        } else if (child_key == CONFIG_STORAGE_IO_ENGINE) {
+            status = SetStorageConfigIOEngine(value);
+        } else if (child_key == CONFIG_STORAGE_DIRECT_IO) {
+            status = SetStorageConfigDirectIO(value);
+        } else if (child_key == CONFIG_STORAGE_CODEC) {
+            status = SetStorageConfigCodec(value);
             // } else if (child_key == CONFIG_STORAGE_S3_ENABLE) {
             //     status = SetStorageConfigS3Enable(value);
             // } else if (child_key == CONFIG_STORAGE_S3_ADDRESS) {
@@ -569,6 +647,8 @@ Config::SetConfigCli(const std::string& parent_key, const std::string& child_key
             status = SetCacheConfigInsertBufferSize(value);
         } else if (child_key == CONFIG_CACHE_PRELOAD_COLLECTION) {
             status = SetCacheConfigPreloadCollection(value);
+        } else if (child_key == CONFIG_CACHE_PRELOAD_PARALLELISM) {
+            status = SetCacheConfigPreloadParallelism(value);
         } else {
             status = Status(SERVER_UNEXPECTED_ERROR, invalid_node_str);
         }
@@ -579,6 +659,12 @@ Config::SetConfigCli(const std::string& parent_key, const std::string& child_key
             status = SetEngineConfigOmpThreadNum(value);
         } else if (child_key == CONFIG_ENGINE_SIMD_TYPE) {
             status = SetEngineConfigSimdType(value);
+        } else if (child_key == CONFIG_ENGINE_SEARCH_BATCH_WINDOW) {
+            status = SetEngineConfigSearchBatchWindow(value);
+        } else if (child_key == CONFIG_ENGINE_SEARCH_BATCH_MAX_NQ) {
+            status = SetEngineConfigSearchBatchMaxNq(value);
+        } else if (child_key == CONFIG_ENGINE_MAX_LOAD_DEPTH) {
+            status = SetEngineConfigMaxLoadDepth(value);
         } else {
             status = Status(SERVER_UNEXPECTED_ERROR, invalid_node_str);
         }
@@ -623,6 +709,8 @@ Config::SetConfigCli(const std::string& parent_key, const std::string& child_key
             status = SetLogsLevel(value);
         } else if (child_key == CONFIG_LOGS_TRACE_ENABLE) {
             status = SetLogsTraceEnable(value);
+        } else if (child_key == CONFIG_LOGS_TRACE_SAMPLE_INTERVAL) {
+            status = SetLogsTraceSampleInterval(value);
         } else if (child_key == CONFIG_LOGS_PATH) {
             status = SetLogsPath(value);
         } else if (child_key == CONFIG_LOGS_MAX_LOG_FILE_SIZE) {
@@ -747,7 +835,7 @@ Config::UpdateFileConfigFromMem(const std::string& parent_key, const std::string
 
     // convert value string to standard string stored in yaml file
     std::string value_str;
-    if (child_key == CONFIG_CACHE_CACHE_INSERT_DATA ||
+    if (child_key == CONFIG_CACHE_CACHE_INSERT_DATA || child_key == CONFIG_STORAGE_DIRECT_IO ||
         // child_key == CONFIG_STORAGE_S3_ENABLE ||
         child_key == CONFIG_METRIC_ENABLE_MONITOR || child_key == CONFIG_GPU_RESOURCE_ENABLE ||
         child_key == CONFIG_WAL_ENABLE || child_key == CONFIG_WAL_RECOVERY_ERROR_IGNORE) {
@@ -1056,6 +1144,64 @@ Config::CheckStorageConfigFileCleanupTimeout(const std::string& value) {
     return Status::OK();
 }
 
+Status
+Config::CheckStorageConfigMergeIORateLimit(const std::string& value) {
+    std::string err;
+    int64_t rate = parse_bytes(value, err);
+    if (!err.empty() || rate < 0) {
+        std::string msg = "Invalid merge io rate limit: " + value +
+                          ". Possible reason: storage.merge_io_rate_limit is not a size in bytes per second.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckStorageConfigMergeStrategy(const std::string& value) {
+    if (value != "simple" && value != "layered" && value != "adaptive" && value != "cost") {
+        return Status(SERVER_INVALID_ARGUMENT,
+                      "storage.merge_strategy is not one of simple, layered, adaptive and cost.");
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckStorageConfigS3CacheCapacity(const std::string& value) {
+    std::string err;
+    int64_t capacity = parse_bytes(value, err);
+    if (!err.empty() || capacity < 0) {
+        std::string msg = "Invalid s3 cache capacity: " + value +
+                          ". Possible reason: storage.s3_cache_capacity is not a size in bytes.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckStorageConfigIOEngine(const std::string& value) {
+    if (value != "fstream" && value != "uring") {
+        return Status(SERVER_INVALID_ARGUMENT, "storage.io_engine is not one of fstream and uring.");
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckStorageConfigDirectIO(const std::string& value) {
+    if (!ValidationUtil::ValidateStringIsBool(value).ok()) {
+        std::string msg = "Invalid storage config: " + value + ". Possible reason: storage.direct_io is not a boolean.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckStorageConfigCodec(const std::string& value) {
+    if (value != "default" && value != "container") {
+        return Status(SERVER_INVALID_ARGUMENT, "storage.codec is not one of default and container.");
+    }
+    return Status::OK();
+}
+
 // Status
 // Config::CheckStorageConfigS3Enable(const std::string& value) {
 //    if (!ValidationUtil::ValidateStringIsBool(value).ok()) {
@@ -1298,6 +1444,24 @@ Config::CheckCacheConfigPreloadCollection(const std::string& value) {
     return Status::OK();
 }
 
+Status
+Config::CheckCacheConfigPreloadParallelism(const std::string& value) {
+    if (!ValidationUtil::ValidateStringIsNumber(value).ok()) {
+        std::string msg = "Invalid preload parallelism: " + value +
+                          ". Possible reason: cache_config.preload_parallelism is not a positive integer.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    // preload is bound by disk rather than cpu, so allow more loaders than cores
+    constexpr int64_t MAX_PRELOAD_PARALLELISM = 64;
+    int64_t parallelism = std::stoll(value);
+    if (parallelism <= 0 || parallelism > MAX_PRELOAD_PARALLELISM) {
+        std::string msg = "Invalid preload parallelism: " + value +
+                          ". Possible reason: cache_config.preload_parallelism is not in range [1, 64].";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    return Status::OK();
+}
+
 /* engine config */
 Status
 Config::CheckEngineConfigUseBlasThreshold(const std::string& value) {
@@ -1343,6 +1507,42 @@ Config::CheckEngineConfigSimdType(const std::string& value) {
     return Status::OK();
 }
 
+Status
+Config::CheckEngineConfigSearchBatchWindow(const std::string& value) {
+    if (!ValidationUtil::ValidateStringIsNumber(value).ok()) {
+        std::string msg = "Invalid search batch window: " + value +
+                          ". Possible reason: engine_config.search_batch_window_us is not a positive integer.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckEngineConfigSearchBatchMaxNq(const std::string& value) {
+    if (!ValidationUtil::ValidateStringIsNumber(value).ok() || std::stoll(value) <= 0) {
+        std::string msg = "Invalid search batch max nq: " + value +
+                          ". Possible reason: engine_config.search_batch_max_nq is not a positive integer.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckEngineConfigMaxLoadDepth(const std::string& value) {
+    if (!ValidationUtil::ValidateStringIsNumber(value).ok()) {
+        std::string msg = "Invalid max load depth: " + value +
+                          ". Possible reason: engine_config.max_load_depth is not a positive integer.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    int64_t depth = std::stoll(value);
+    if (depth <= 0 || depth > 32) {
+        std::string msg = "Invalid max load depth: " + value +
+                          ". Possible reason: engine_config.max_load_depth is not in range [1, 32].";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    return Status::OK();
+}
+
 /* gpu resource config */
 #ifdef MILVUS_GPU_VERSION
 Status
@@ -1585,6 +1785,19 @@ Config::CheckLogsTraceEnable(const std::string& value) {
     return Status::OK();
 }
 
+Status
+Config::CheckLogsTraceSampleInterval(const std::string& value) {
+    auto exist_error = !ValidationUtil::ValidateStringIsNumber(value).ok();
+    fiu_do_on("check_logs_trace_sample_interval_fail", exist_error = true);
+
+    if (exist_error) {
+        std::string msg = "Invalid trace.sample_interval: " + value +
+                          ". Possible reason: logs.trace.sample_interval is not a non-negative integer.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    return Status::OK();
+}
+
 Status
 Config::CheckLogsPath(const std::string& value) {
     fiu_return_on("check_logs_path_fail", Status(SERVER_INVALID_ARGUMENT, ""));
@@ -1835,6 +2048,52 @@ Config::GetStorageConfigFileCleanupTimeup(int64_t& value) {
     return Status::OK();
 }
 
+Status
+Config::GetStorageConfigMergeIORateLimit(int64_t& value) {
+    std::string str =
+        GetConfigStr(CONFIG_STORAGE, CONFIG_STORAGE_MERGE_IO_RATE_LIMIT, CONFIG_STORAGE_MERGE_IO_RATE_LIMIT_DEFAULT);
+    STATUS_CHECK(CheckStorageConfigMergeIORateLimit(str));
+    std::string err;
+    value = parse_bytes(str, err);
+    return Status::OK();
+}
+
+Status
+Config::GetStorageConfigMergeStrategy(std::string& value) {
+    value = GetConfigStr(CONFIG_STORAGE, CONFIG_STORAGE_MERGE_STRATEGY, CONFIG_STORAGE_MERGE_STRATEGY_DEFAULT);
+    return CheckStorageConfigMergeStrategy(value);
+}
+
+Status
+Config::GetStorageConfigS3CacheCapacity(int64_t& value) {
+    std::string str =
+        GetConfigStr(CONFIG_STORAGE, CONFIG_STORAGE_S3_CACHE_CAPACITY, CONFIG_STORAGE_S3_CACHE_CAPACITY_DEFAULT);
+    STATUS_CHECK(CheckStorageConfigS3CacheCapacity(str));
+    std::string err;
+    value = parse_bytes(str, err);
+    return Status::OK();
+}
+
+Status
+Config::GetStorageConfigIOEngine(std::string& value) {
+    value = GetConfigStr(CONFIG_STORAGE, CONFIG_STORAGE_IO_ENGINE, CONFIG_STORAGE_IO_ENGINE_DEFAULT);
+    return CheckStorageConfigIOEngine(value);
+}
+
+Status
+Config::GetStorageConfigDirectIO(bool& value) {
+    std::string str = GetConfigStr(CONFIG_STORAGE, CONFIG_STORAGE_DIRECT_IO, CONFIG_STORAGE_DIRECT_IO_DEFAULT);
+    STATUS_CHECK(CheckStorageConfigDirectIO(str));
+    STATUS_CHECK(StringHelpFunctions::ConvertToBoolean(str, value));
+    return Status::OK();
+}
+
+Status
+Config::GetStorageConfigCodec(std::string& value) {
+    value = GetConfigStr(CONFIG_STORAGE, CONFIG_STORAGE_CODEC, CONFIG_STORAGE_CODEC_DEFAULT);
+    return CheckStorageConfigCodec(value);
+}
+
 // Status
 // Config::GetStorageConfigS3Enable(bool& value) {
 //    std::string str = GetConfigStr(CONFIG_STORAGE, CONFIG_STORAGE_S3_ENABLE, CONFIG_STORAGE_S3_ENABLE_DEFAULT);
@@ -1942,6 +2201,15 @@ Config::GetCacheConfigPreloadCollection(std::string& value) {
     return Status::OK();
 }
 
+Status
+Config::GetCacheConfigPreloadParallelism(int64_t& value) {
+    std::string str =
+        GetConfigStr(CONFIG_CACHE, CONFIG_CACHE_PRELOAD_PARALLELISM, CONFIG_CACHE_PRELOAD_PARALLELISM_DEFAULT);
+    STATUS_CHECK(CheckCacheConfigPreloadParallelism(str));
+    value = std::stoll(str);
+    return Status::OK();
+}
+
 /* engine config */
 Status
 Config::GetEngineConfigUseBlasThreshold(int64_t& value) {
@@ -1966,6 +2234,33 @@ Config::GetEngineConfigSimdType(std::string& value) {
     return CheckEngineConfigSimdType(value);
 }
 
+Status
+Config::GetEngineConfigSearchBatchWindow(int64_t& value) {
+    std::string str =
+        GetConfigStr(CONFIG_ENGINE, CONFIG_ENGINE_SEARCH_BATCH_WINDOW, CONFIG_ENGINE_SEARCH_BATCH_WINDOW_DEFAULT);
+    STATUS_CHECK(CheckEngineConfigSearchBatchWindow(str));
+    value = std::stoll(str);
+    return Status::OK();
+}
+
+Status
+Config::GetEngineConfigSearchBatchMaxNq(int64_t& value) {
+    std::string str =
+        GetConfigStr(CONFIG_ENGINE, CONFIG_ENGINE_SEARCH_BATCH_MAX_NQ, CONFIG_ENGINE_SEARCH_BATCH_MAX_NQ_DEFAULT);
+    STATUS_CHECK(CheckEngineConfigSearchBatchMaxNq(str));
+    value = std::stoll(str);
+    return Status::OK();
+}
+
+Status
+Config::GetEngineConfigMaxLoadDepth(int64_t& value) {
+    std::string str =
+        GetConfigStr(CONFIG_ENGINE, CONFIG_ENGINE_MAX_LOAD_DEPTH, CONFIG_ENGINE_MAX_LOAD_DEPTH_DEFAULT);
+    STATUS_CHECK(CheckEngineConfigMaxLoadDepth(str));
+    value = std::stoll(str);
+    return Status::OK();
+}
+
 /* gpu resource config */
 #ifdef MILVUS_GPU_VERSION
 Status
@@ -2135,6 +2430,15 @@ Config::GetLogsTraceEnable(bool& value) {
     return Status::OK();
 }
 
+Status
+Config::GetLogsTraceSampleInterval(int64_t& value) {
+    std::string str =
+        GetConfigStr(CONFIG_LOGS, CONFIG_LOGS_TRACE_SAMPLE_INTERVAL, CONFIG_LOGS_TRACE_SAMPLE_INTERVAL_DEFAULT);
+    STATUS_CHECK(CheckLogsTraceSampleInterval(str));
+    value = std::stoll(str);
+    return Status::OK();
+}
+
 Status
 Config::GetLogsPath(std::string& value) {
     value = GetConfigStr(CONFIG_LOGS, CONFIG_LOGS_PATH, CONFIG_LOGS_PATH_DEFAULT);
@@ -2250,6 +2554,42 @@ Config::SetStorageConfigFileCleanupTimeout(const std::string& value) {
     return SetConfigValueInMem(CONFIG_STORAGE, CONFIG_STORAGE_FILE_CLEANUP_TIMEOUT, value);
 }
 
+Status
+Config::SetStorageConfigMergeIORateLimit(const std::string& value) {
+    STATUS_CHECK(CheckStorageConfigMergeIORateLimit(value));
+    return SetConfigValueInMem(CONFIG_STORAGE, CONFIG_STORAGE_MERGE_IO_RATE_LIMIT, value);
+}
+
+Status
+Config::SetStorageConfigMergeStrategy(const std::string& value) {
+    STATUS_CHECK(CheckStorageConfigMergeStrategy(value));
+    return SetConfigValueInMem(CONFIG_STORAGE, CONFIG_STORAGE_MERGE_STRATEGY, value);
+}
+
+Status
+Config::SetStorageConfigS3CacheCapacity(const std::string& value) {
+    STATUS_CHECK(CheckStorageConfigS3CacheCapacity(value));
+    return SetConfigValueInMem(CONFIG_STORAGE, CONFIG_STORAGE_S3_CACHE_CAPACITY, value);
+}
+
+Status
+Config::SetStorageConfigIOEngine(const std::string& value) {
+    STATUS_CHECK(CheckStorageConfigIOEngine(value));
+    return SetConfigValueInMem(CONFIG_STORAGE, CONFIG_STORAGE_IO_ENGINE, value);
+}
+
+Status
+Config::SetStorageConfigDirectIO(const std::string& value) {
+    STATUS_CHECK(CheckStorageConfigDirectIO(value));
+    return SetConfigValueInMem(CONFIG_STORAGE, CONFIG_STORAGE_DIRECT_IO, value);
+}
+
+Status
+Config::SetStorageConfigCodec(const std::string& value) {
+    STATUS_CHECK(CheckStorageConfigCodec(value));
+    return SetConfigValueInMem(CONFIG_STORAGE, CONFIG_STORAGE_CODEC, value);
+}
+
 // Status
 // Config::SetStorageConfigS3Enable(const std::string& value) {
 //    STATUS_CHECK(CheckStorageConfigS3Enable(value));
@@ -2340,6 +2680,12 @@ Config::SetCacheConfigPreloadCollection(const std::string& value) {
     return SetConfigValueInMem(CONFIG_CACHE, CONFIG_CACHE_PRELOAD_COLLECTION, cor_value);
 }
 
+Status
+Config::SetCacheConfigPreloadParallelism(const std::string& value) {
+    STATUS_CHECK(CheckCacheConfigPreloadParallelism(value));
+    return SetConfigValueInMem(CONFIG_CACHE, CONFIG_CACHE_PRELOAD_PARALLELISM, value);
+}
+
 /* engine config */
 Status
 Config::SetEngineConfigUseBlasThreshold(const std::string& value) {
@@ -2360,6 +2706,24 @@ Config::SetEngineConfigSimdType(const std::string& value) {
     return SetConfigValueInMem(CONFIG_ENGINE, CONFIG_ENGINE_SIMD_TYPE, value);
 }
 
+Status
+Config::SetEngineConfigSearchBatchWindow(const std::string& value) {
+    STATUS_CHECK(CheckEngineConfigSearchBatchWindow(value));
+    return SetConfigValueInMem(CONFIG_ENGINE, CONFIG_ENGINE_SEARCH_BATCH_WINDOW, value);
+}
+
+Status
+Config::SetEngineConfigSearchBatchMaxNq(const std::string& value) {
+    STATUS_CHECK(CheckEngineConfigSearchBatchMaxNq(value));
+    return SetConfigValueInMem(CONFIG_ENGINE, CONFIG_ENGINE_SEARCH_BATCH_MAX_NQ, value);
+}
+
+Status
+Config::SetEngineConfigMaxLoadDepth(const std::string& value) {
+    STATUS_CHECK(CheckEngineConfigMaxLoadDepth(value));
+    return SetConfigValueInMem(CONFIG_ENGINE, CONFIG_ENGINE_MAX_LOAD_DEPTH, value);
+}
+
 /* gpu resource config */
 #ifdef MILVUS_GPU_VERSION
 Status
@@ -2453,6 +2817,12 @@ Config::SetLogsTraceEnable(const std::string& value) {
     return SetConfigValueInMem(CONFIG_LOGS, CONFIG_LOGS_TRACE_ENABLE, value);
 }
 
+Status
+Config::SetLogsTraceSampleInterval(const std::string& value) {
+    STATUS_CHECK(CheckLogsTraceSampleInterval(value));
+    return SetConfigValueInMem(CONFIG_LOGS, CONFIG_LOGS_TRACE_SAMPLE_INTERVAL, value);
+}
+
 Status
 Config::SetLogsPath(const std::string& value) {
     STATUS_CHECK(CheckLogsPath(value));
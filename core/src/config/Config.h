@@ -69,6 +69,18 @@ extern const char* CONFIG_STORAGE_AUTO_FLUSH_INTERVAL_DEFAULT;
 extern const char* CONFIG_STORAGE_FILE_CLEANUP_TIMEOUT;
 extern const int64_t CONFIG_STORAGE_FILE_CLEANUP_TIMEOUT_MIN;
 extern const int64_t CONFIG_STORAGE_FILE_CLEANUP_TIMEOUT_MAX;
+extern const char* CONFIG_STORAGE_MERGE_IO_RATE_LIMIT;
+extern const char* CONFIG_STORAGE_MERGE_IO_RATE_LIMIT_DEFAULT;
+extern const char* CONFIG_STORAGE_MERGE_STRATEGY;
+extern const char* CONFIG_STORAGE_MERGE_STRATEGY_DEFAULT;
+extern const char* CONFIG_STORAGE_S3_CACHE_CAPACITY;
+extern const char* CONFIG_STORAGE_S3_CACHE_CAPACITY_DEFAULT;
+extern const char* CONFIG_STORAGE_IO_ENGINE;
+extern const char* CONFIG_STORAGE_IO_ENGINE_DEFAULT;
+extern const char* CONFIG_STORAGE_DIRECT_IO;
+extern const char* CONFIG_STORAGE_DIRECT_IO_DEFAULT;
+extern const char* CONFIG_STORAGE_CODEC;
+extern const char* CONFIG_STORAGE_CODEC_DEFAULT;
 
 /* cache config */
 extern const char* CONFIG_CACHE;
@@ -82,6 +94,8 @@ extern const char* CONFIG_CACHE_CACHE_INSERT_DATA;
 extern const char* CONFIG_CACHE_CACHE_INSERT_DATA_DEFAULT;
 extern const char* CONFIG_CACHE_PRELOAD_COLLECTION;
 extern const char* CONFIG_CACHE_PRELOAD_COLLECTION_DEFAULT;
+extern const char* CONFIG_CACHE_PRELOAD_PARALLELISM;
+extern const char* CONFIG_CACHE_PRELOAD_PARALLELISM_DEFAULT;
 
 /* metric config */
 extern const char* CONFIG_METRIC;
@@ -100,6 +114,12 @@ extern const char* CONFIG_ENGINE_OMP_THREAD_NUM;
 extern const char* CONFIG_ENGINE_OMP_THREAD_NUM_DEFAULT;
 extern const char* CONFIG_ENGINE_SIMD_TYPE;
 extern const char* CONFIG_ENGINE_SIMD_TYPE_DEFAULT;
+extern const char* CONFIG_ENGINE_SEARCH_BATCH_WINDOW;
+extern const char* CONFIG_ENGINE_SEARCH_BATCH_WINDOW_DEFAULT;
+extern const char* CONFIG_ENGINE_SEARCH_BATCH_MAX_NQ;
+extern const char* CONFIG_ENGINE_SEARCH_BATCH_MAX_NQ_DEFAULT;
+extern const char* CONFIG_ENGINE_MAX_LOAD_DEPTH;
+extern const char* CONFIG_ENGINE_MAX_LOAD_DEPTH_DEFAULT;
 
 /* gpu resource config */
 extern const char* CONFIG_GPU_RESOURCE;
@@ -140,6 +160,8 @@ extern const char* CONFIG_LOGS_LEVEL;
 extern const char* CONFIG_LOGS_LEVEL_DEFAULT;
 extern const char* CONFIG_LOGS_TRACE_ENABLE;
 extern const char* CONFIG_LOGS_TRACE_ENABLE_DEFAULT;
+extern const char* CONFIG_LOGS_TRACE_SAMPLE_INTERVAL;
+extern const char* CONFIG_LOGS_TRACE_SAMPLE_INTERVAL_DEFAULT;
 extern const char* CONFIG_LOGS_PATH;
 extern const char* CONFIG_LOGS_MAX_LOG_FILE_SIZE;
 extern const char* CONFIG_LOGS_MAX_LOG_FILE_SIZE_DEFAULT;
@@ -236,6 +258,18 @@ class Config {
     CheckStorageConfigAutoFlushInterval(const std::string& value);
     Status
     CheckStorageConfigFileCleanupTimeout(const std::string& value);
+    Status
+    CheckStorageConfigMergeIORateLimit(const std::string& value);
+    Status
+    CheckStorageConfigMergeStrategy(const std::string& value);
+    Status
+    CheckStorageConfigS3CacheCapacity(const std::string& value);
+    Status
+    CheckStorageConfigIOEngine(const std::string& value);
+    Status
+    CheckStorageConfigDirectIO(const std::string& value);
+    Status
+    CheckStorageConfigCodec(const std::string& value);
 
     /* metric config */
     Status
@@ -256,6 +290,8 @@ class Config {
     CheckCacheConfigCacheInsertData(const std::string& value);
     Status
     CheckCacheConfigPreloadCollection(const std::string& value);
+    Status
+    CheckCacheConfigPreloadParallelism(const std::string& value);
 
     /* engine config */
     Status
@@ -264,6 +300,12 @@ class Config {
     CheckEngineConfigOmpThreadNum(const std::string& value);
     Status
     CheckEngineConfigSimdType(const std::string& value);
+    Status
+    CheckEngineConfigSearchBatchWindow(const std::string& value);
+    Status
+    CheckEngineConfigSearchBatchMaxNq(const std::string& value);
+    Status
+    CheckEngineConfigMaxLoadDepth(const std::string& value);
 
     /* gpu resource config */
 #ifdef MILVUS_GPU_VERSION
@@ -301,6 +343,8 @@ class Config {
     Status
     CheckLogsTraceEnable(const std::string& value);
     Status
+    CheckLogsTraceSampleInterval(const std::string& value);
+    Status
     CheckLogsPath(const std::string& value);
     Status
     CheckLogsMaxLogFileSize(const std::string& value);
@@ -354,6 +398,18 @@ class Config {
     GetStorageConfigAutoFlushInterval(int64_t& value);
     Status
     GetStorageConfigFileCleanupTimeup(int64_t& value);
+    Status
+    GetStorageConfigMergeIORateLimit(int64_t& value);
+    Status
+    GetStorageConfigMergeStrategy(std::string& value);
+    Status
+    GetStorageConfigS3CacheCapacity(int64_t& value);
+    Status
+    GetStorageConfigIOEngine(std::string& value);
+    Status
+    GetStorageConfigDirectIO(bool& value);
+    Status
+    GetStorageConfigCodec(std::string& value);
 
     /* metric config */
     Status
@@ -374,6 +430,8 @@ class Config {
     GetCacheConfigCacheInsertData(bool& value);
     Status
     GetCacheConfigPreloadCollection(std::string& value);
+    Status
+    GetCacheConfigPreloadParallelism(int64_t& value);
 
     /* engine config */
     Status
@@ -382,6 +440,12 @@ class Config {
     GetEngineConfigOmpThreadNum(int64_t& value);
     Status
     GetEngineConfigSimdType(std::string& value);
+    Status
+    GetEngineConfigSearchBatchWindow(int64_t& value);
+    Status
+    GetEngineConfigSearchBatchMaxNq(int64_t& value);
+    Status
+    GetEngineConfigMaxLoadDepth(int64_t& value);
 
     /* gpu resource config */
 #ifdef MILVUS_GPU_VERSION
@@ -419,6 +483,8 @@ class Config {
     Status
     GetLogsTraceEnable(bool& value);
     Status
+    GetLogsTraceSampleInterval(int64_t& value);
+    Status
     GetLogsPath(std::string& value);
     Status
     GetLogsMaxLogFileSize(int64_t& value);
@@ -464,6 +530,18 @@ class Config {
     SetStorageConfigAutoFlushInterval(const std::string& value);
     Status
     SetStorageConfigFileCleanupTimeout(const std::string& value);
+    Status
+    SetStorageConfigMergeIORateLimit(const std::string& value);
+    Status
+    SetStorageConfigMergeStrategy(const std::string& value);
+    Status
+    SetStorageConfigS3CacheCapacity(const std::string& value);
+    Status
+    SetStorageConfigIOEngine(const std::string& value);
+    Status
+    SetStorageConfigDirectIO(const std::string& value);
+    Status
+    SetStorageConfigCodec(const std::string& value);
 
     /* metric config */
     Status
@@ -484,6 +562,8 @@ class Config {
     SetCacheConfigCacheInsertData(const std::string& value);
     Status
     SetCacheConfigPreloadCollection(const std::string& value);
+    Status
+    SetCacheConfigPreloadParallelism(const std::string& value);
 
     /* engine config */
     Status
@@ -492,6 +572,12 @@ class Config {
     SetEngineConfigOmpThreadNum(const std::string& value);
     Status
     SetEngineConfigSimdType(const std::string& value);
+    Status
+    SetEngineConfigSearchBatchWindow(const std::string& value);
+    Status
+    SetEngineConfigSearchBatchMaxNq(const std::string& value);
+    Status
+    SetEngineConfigMaxLoadDepth(const std::string& value);
 
     /* gpu resource config */
 #ifdef MILVUS_GPU_VERSION
@@ -529,6 +615,8 @@ class Config {
     Status
     SetLogsTraceEnable(const std::string& value);
     Status
+    SetLogsTraceSampleInterval(const std::string& value);
+    Status
     SetLogsPath(const std::string& value);
     Status
     SetLogsMaxLogFileSize(const std::string& value);
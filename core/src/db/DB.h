@@ -99,6 +99,11 @@ class DB {
     virtual Status
     InsertVectors(const std::string& collection_id, const std::string& partition_tag, VectorsData& vectors) = 0;
 
+    // Moves the float/binary payload of vectors down to the mem table instead of copying it,
+    // id_array_ (including generated ids) stays readable by the caller
+    virtual Status
+    InsertVectors(const std::string& collection_id, const std::string& partition_tag, VectorsData&& vectors) = 0;
+
     virtual Status
     DeleteVector(const std::string& collection_id, IDNumber vector_id) = 0;
 
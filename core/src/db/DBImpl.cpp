@@ -19,8 +19,10 @@
 #include <chrono>
 #include <cstring>
 #include <functional>
+#include <future>
 #include <iostream>
 #include <limits>
+#include <memory>
 #include <mutex>
 #include <queue>
 #include <set>
@@ -37,6 +39,7 @@
 #include "index/knowhere/knowhere/index/vector_index/helpers/BuilderSuspend.h"
 #include "index/thirdparty/faiss/utils/distances.h"
 #include "insert/MemManagerFactory.h"
+#include "meta/CollectionStatsTracker.h"
 #include "meta/MetaConsts.h"
 #include "meta/MetaFactory.h"
 #include "meta/SqliteMetaImpl.h"
@@ -48,6 +51,7 @@
 #include "scheduler/job/SearchJob.h"
 #include "segment/SegmentReader.h"
 #include "segment/SegmentWriter.h"
+#include "utils/CommonUtil.h"
 #include "utils/Exception.h"
 #include "utils/Log.h"
 #include "utils/StringHelpFunctions.h"
@@ -64,6 +68,10 @@ namespace {
 constexpr uint64_t BACKGROUND_METRIC_INTERVAL = 1;
 constexpr uint64_t BACKGROUND_INDEX_INTERVAL = 1;
 constexpr uint64_t WAIT_BUILD_INDEX_INTERVAL = 5;
+constexpr uint64_t BACKGROUND_CACHE_MANIFEST_INTERVAL = 60;
+
+constexpr const char* CACHE_MANIFEST_NAME = "cache_manifest";
+constexpr const char* ID_MARK_NAME = "id_mark";
 
 constexpr const char* JSON_ROW_COUNT = "row_count";
 constexpr const char* JSON_PARTITIONS = "partitions";
@@ -72,9 +80,78 @@ constexpr const char* JSON_SEGMENTS = "segments";
 constexpr const char* JSON_SEGMENT_NAME = "name";
 constexpr const char* JSON_INDEX_NAME = "index_name";
 constexpr const char* JSON_DATA_SIZE = "data_size";
+constexpr const char* JSON_DELETED_ROW_COUNT = "deleted_row_count";
 
 static const Status SHUTDOWN_ERROR = Status(DB_ERROR, "Milvus server is shutdown!");
 
+// Cache state around a sampled query goes to the debug log and onto the query span
+class SampledQueryTrace {
+ public:
+    SampledQueryTrace(const std::shared_ptr<server::Context>& context, bool sampled)
+        : context_(context), sampled_(sampled) {
+        if (sampled_) {
+            cache_usage_ = cache::CpuCacheMgr::GetInstance()->CacheUsage();
+            cache::CpuCacheMgr::GetInstance()->PrintInfo();
+        }
+    }
+
+    ~SampledQueryTrace() {
+        if (!sampled_) {
+            return;
+        }
+        cache::CpuCacheMgr::GetInstance()->PrintInfo();
+        if (context_ != nullptr && context_->GetTraceContext() != nullptr) {
+            auto& span = context_->GetTraceContext()->GetSpan();
+            span->SetTag("sampled", true);
+            span->SetTag("cache_usage_before", cache_usage_);
+            span->SetTag("cache_usage_after", cache::CpuCacheMgr::GetInstance()->CacheUsage());
+        }
+    }
+
+ private:
+    std::shared_ptr<server::Context> context_;
+    bool sampled_;
+    int64_t cache_usage_ = 0;
+};
+
+// Time spent in each stage of a query goes to the per-collection histograms and the profile if one was asked for
+class QueryStageRecorder {
+ public:
+    QueryStageRecorder(const std::shared_ptr<server::Context>& context, const std::string& collection_id)
+        : collection_id_(collection_id), start_(std::chrono::steady_clock::now()), last_(start_) {
+        if (context != nullptr) {
+            profile_ = context->GetQueryProfile();
+        }
+    }
+
+    ~QueryStageRecorder() {
+        Record("total", std::chrono::steady_clock::now() - start_);
+    }
+
+    void
+    Finish(const std::string& stage) {
+        auto now = std::chrono::steady_clock::now();
+        Record(stage, now - last_);
+        last_ = now;
+    }
+
+ private:
+    void
+    Record(const std::string& stage, std::chrono::steady_clock::duration span) {
+        double seconds = std::chrono::duration<double>(span).count();
+        server::Metrics::GetInstance().CollectionQueryDurationObserve(collection_id_, stage, seconds);
+        if (profile_ != nullptr) {
+            profile_->AddStage(stage, seconds * 1000);
+        }
+    }
+
+ private:
+    std::string collection_id_;
+    server::QueryProfilePtr profile_;
+    std::chrono::steady_clock::time_point start_;
+    std::chrono::steady_clock::time_point last_;
+};
+
 }  // namespace
 
 DBImpl::DBImpl(const DBOptions& options)
@@ -112,9 +189,20 @@ DBImpl::Start() {
         return Status::OK();
     }
 
+    // readonly nodes share the db path with the writable one and never generate ids
+    if (options_.mode_ != DBOptions::MODE::CLUSTER_READONLY) {
+        auto status = SafeIDGenerator::GetInstance().Init(options_.meta_.path_ + "/" + ID_MARK_NAME);
+        if (!status.ok()) {
+            return status;
+        }
+    }
+
     // LOG_ENGINE_TRACE_ << "DB service start";
     initialized_.store(true, std::memory_order_release);
 
+    // hot files of last run, used to order preload
+    LoadCacheManifest();
+
     // server may be closed unexpected, these un-merge files need to be merged when server restart
     // and soft-delete files need to be deleted when server restart
     std::set<std::string> merge_collection_ids;
@@ -206,6 +294,8 @@ DBImpl::Stop() {
         bg_index_thread_.join();
 
         meta_ptr_->CleanUpShadowFiles();
+
+        SaveCacheManifest();
     }
 
     // wait metric thread exit
@@ -300,6 +390,7 @@ DBImpl::DropCollection(const std::string& collection_id) {
         return status;
     }
 
+    server::Metrics::GetInstance().CollectionQueryDurationRemove(collection_id);
     return Status::OK();
 }
 
@@ -358,67 +449,58 @@ DBImpl::GetCollectionInfo(const std::string& collection_id, std::string& collect
         return SHUTDOWN_ERROR;
     }
 
-    // step1: get all partition ids
-    std::vector<meta::CollectionSchema> partition_array;
-    auto status = meta_ptr_->ShowPartitions(collection_id, partition_array);
-
-    std::vector<int> file_types{meta::SegmentSchema::FILE_TYPE::RAW, meta::SegmentSchema::FILE_TYPE::TO_INDEX,
-                                meta::SegmentSchema::FILE_TYPE::INDEX};
+    // statistics are maintained by meta on every flush, delete, merge and index build
+    meta::CollectionStats stats;
+    std::vector<meta::CollectionStats> partitions_stats;
+    auto status = meta_ptr_->GetCollectionStats(collection_id, stats, partitions_stats);
+    if (!status.ok()) {
+        std::string err_msg = "Failed to get collection info: " + status.ToString();
+        LOG_ENGINE_ERROR_ << err_msg;
+        return Status(DB_ERROR, err_msg);
+    }
 
     milvus::json json_info;
     milvus::json json_partitions;
-    size_t total_row_count = 0;
-
-    auto get_info = [&](const std::string& col_id, const std::string& tag) {
-        meta::FilesHolder files_holder;
-        status = meta_ptr_->FilesByType(col_id, file_types, files_holder);
+    for (auto& partition_stats : partitions_stats) {
+        meta::SegmentsStats segments_stats;
+        status = meta_ptr_->GetSegmentsStats(partition_stats.collection_id_, segments_stats);
         if (!status.ok()) {
             std::string err_msg = "Failed to get collection info: " + status.ToString();
             LOG_ENGINE_ERROR_ << err_msg;
             return Status(DB_ERROR, err_msg);
         }
 
-        milvus::json json_partition;
-        json_partition[JSON_PARTITION_TAG] = tag;
-
         milvus::json json_segments;
-        size_t row_count = 0;
-        milvus::engine::meta::SegmentsSchema& collection_files = files_holder.HoldFiles();
-        for (auto& file : collection_files) {
+        for (auto& segment : segments_stats) {
+            if (!meta::CollectionStatsTracker::IsSearchable(segment.file_type_)) {
+                continue;
+            }
             milvus::json json_segment;
-            json_segment[JSON_SEGMENT_NAME] = file.segment_id_;
-            json_segment[JSON_ROW_COUNT] = file.row_count_;
-            json_segment[JSON_INDEX_NAME] = utils::GetIndexName(file.engine_type_);
-            json_segment[JSON_DATA_SIZE] = (int64_t)file.file_size_;
+            json_segment[JSON_SEGMENT_NAME] = segment.segment_id_;
+            json_segment[JSON_ROW_COUNT] = segment.row_count_;
+            json_segment[JSON_INDEX_NAME] = utils::GetIndexName(segment.engine_type_);
+            json_segment[JSON_DATA_SIZE] = (int64_t)segment.data_size_;
             json_segments.push_back(json_segment);
+        }
 
-            row_count += file.row_count_;
-            total_row_count += file.row_count_;
+        // the collection itself is listed first as the default partition
+        std::string tag = partition_stats.partition_tag_;
+        if (tag.empty()) {
+            tag = milvus::engine::DEFAULT_PARTITON_TAG;
         }
 
-        json_partition[JSON_ROW_COUNT] = row_count;
+        milvus::json json_partition;
+        json_partition[JSON_PARTITION_TAG] = tag;
+        json_partition[JSON_ROW_COUNT] = partition_stats.row_count_;
+        json_partition[JSON_DELETED_ROW_COUNT] = partition_stats.deleted_row_count_;
+        json_partition[JSON_DATA_SIZE] = partition_stats.data_size_;
         json_partition[JSON_SEGMENTS] = json_segments;
-
         json_partitions.push_back(json_partition);
-
-        return Status::OK();
-    };
-
-    // step2: get default partition info
-    status = get_info(collection_id, milvus::engine::DEFAULT_PARTITON_TAG);
-    if (!status.ok()) {
-        return status;
-    }
-
-    // step3: get partitions info
-    for (auto& schema : partition_array) {
-        status = get_info(schema.collection_id_, schema.partition_tag_);
-        if (!status.ok()) {
-            return status;
-        }
     }
 
-    json_info[JSON_ROW_COUNT] = total_row_count;
+    json_info[JSON_ROW_COUNT] = stats.row_count_;
+    json_info[JSON_DELETED_ROW_COUNT] = stats.deleted_row_count_;
+    json_info[JSON_DATA_SIZE] = stats.data_size_;
     json_info[JSON_PARTITIONS] = json_partitions;
 
     collection_info = json_info.dump();
@@ -467,21 +549,47 @@ DBImpl::PreloadCollection(const std::shared_ptr<server::Context>& context, const
     }
 #endif
 
-    int64_t size = 0;
     int64_t cache_total = cache::CpuCacheMgr::GetInstance()->CacheCapacity();
     int64_t cache_usage = cache::CpuCacheMgr::GetInstance()->CacheUsage();
     int64_t available_size = cache_total - cache_usage;
 
-    // step 3: load file one by one
+    // step 3: files that were hot before the last shutdown are loaded first
     milvus::engine::meta::SegmentsSchema& files_array = files_holder.HoldFiles();
+    {
+        std::lock_guard<std::mutex> lock(cache_manifest_mutex_);
+        if (!cache_manifest_rank_.empty()) {
+            auto rank = [&](const meta::SegmentSchema& file) {
+                auto iter = cache_manifest_rank_.find(file.location_);
+                return iter == cache_manifest_rank_.end() ? std::numeric_limits<size_t>::max() : iter->second;
+            };
+            std::stable_sort(files_array.begin(), files_array.end(),
+                             [&](const meta::SegmentSchema& a, const meta::SegmentSchema& b) {
+                                 return rank(a) < rank(b);
+                             });
+        }
+    }
+
+    // step 4: load files concurrently, so that disk reads of some files overlap with the deserialization
+    // of others; the bounded pool queue caps the number of files in flight
     LOG_ENGINE_DEBUG_ << "Begin pre-load collection:" + collection_id + ", totally " << files_array.size()
                       << " files need to be pre-loaded";
     TimeRecorderAuto rc("Pre-load collection:" + collection_id);
-    for (auto& file : files_array) {
-        // client break the connection, no need to continue
-        if (context && context->IsConnectionBroken()) {
-            LOG_ENGINE_DEBUG_ << "Client connection broken, stop load collection";
-            break;
+
+    std::atomic<int64_t> size(0);
+    std::atomic_bool stop(false);
+    std::mutex status_mutex;
+    Status load_status;
+    auto set_status = [&](const Status& s) {
+        std::lock_guard<std::mutex> lock(status_mutex);
+        if (load_status.ok()) {
+            load_status = s;
+        }
+        stop = true;
+    };
+
+    auto load_file = [&](const meta::SegmentSchema& file) {
+        if (stop.load()) {
+            return;
         }
 
         EngineType engine_type;
@@ -494,39 +602,62 @@ DBImpl::PreloadCollection(const std::shared_ptr<server::Context>& context, const
             engine_type = (EngineType)file.engine_type_;
         }
 
-        auto json = milvus::json::parse(file.index_params_);
-        ExecutionEnginePtr engine =
-            EngineFactory::Build(file.dimension_, file.location_, engine_type, (MetricType)file.metric_type_, json);
-        fiu_do_on("DBImpl.PreloadCollection.null_engine", engine = nullptr);
-        if (engine == nullptr) {
-            LOG_ENGINE_ERROR_ << "Invalid engine type";
-            return Status(DB_ERROR, "Invalid engine type");
-        }
+        try {
+            auto json = milvus::json::parse(file.index_params_);
+            ExecutionEnginePtr engine =
+                EngineFactory::Build(file.dimension_, file.location_, engine_type, (MetricType)file.metric_type_, json);
+            fiu_do_on("DBImpl.PreloadCollection.null_engine", engine = nullptr);
+            if (engine == nullptr) {
+                LOG_ENGINE_ERROR_ << "Invalid engine type";
+                set_status(Status(DB_ERROR, "Invalid engine type"));
+                return;
+            }
 
-        fiu_do_on("DBImpl.PreloadCollection.exceed_cache", size = available_size + 1);
+            fiu_do_on("DBImpl.PreloadCollection.exceed_cache", size = available_size + 1);
 
-        try {
             fiu_do_on("DBImpl.PreloadCollection.engine_throw_exception", throw std::exception());
             std::string msg = "Pre-loaded file: " + file.file_id_ + " size: " + std::to_string(file.file_size_);
             TimeRecorderAuto rc_1(msg);
-            status = engine->Load(true);
+            auto status = engine->Load(true);
             if (!status.ok()) {
-                return status;
+                set_status(status);
+                return;
             }
 
-            size += engine->Size();
-            if (!force && size > available_size) {
+            int64_t loaded_size = (size += engine->Size());
+            if (!force && loaded_size > available_size) {
                 LOG_ENGINE_DEBUG_ << "Pre-load cancelled since cache is almost full";
-                return Status(SERVER_CACHE_FULL, "Cache is full");
+                set_status(Status(SERVER_CACHE_FULL, "Cache is full"));
             }
         } catch (std::exception& ex) {
             std::string msg = "Pre-load collection encounter exception: " + std::string(ex.what());
             LOG_ENGINE_ERROR_ << msg;
-            return Status(DB_ERROR, msg);
+            set_status(Status(DB_ERROR, msg));
+        }
+    };
+
+    size_t parallelism = std::max<int64_t>(options_.preload_parallelism_, 1);
+    parallelism = std::max<size_t>(std::min(parallelism, files_array.size()), 1);
+    {
+        ThreadPool load_pool(parallelism, parallelism);
+        std::vector<std::future<void>> load_results;
+        for (auto& file : files_array) {
+            // client break the connection, no need to continue
+            if (context && context->IsConnectionBroken()) {
+                LOG_ENGINE_DEBUG_ << "Client connection broken, stop load collection";
+                stop = true;
+            }
+            if (stop.load()) {
+                break;
+            }
+            load_results.emplace_back(load_pool.enqueue(load_file, std::cref(file)));
+        }
+        for (auto& result : load_results) {
+            result.wait();
         }
     }
 
-    return Status::OK();
+    return load_status;
 }
 
 Status
@@ -692,13 +823,19 @@ DBImpl::ShowPartitions(const std::string& collection_id, std::vector<meta::Colle
 
 Status
 DBImpl::InsertVectors(const std::string& collection_id, const std::string& partition_tag, VectorsData& vectors) {
-    //    LOG_ENGINE_DEBUG_ << "Insert " << n << " vectors to cache";
+    // the caller keeps its vectors, insert a copy and hand back the ids
+    VectorsData copy = vectors;
+    auto status = InsertVectors(collection_id, partition_tag, std::move(copy));
+    vectors.id_array_.swap(copy.id_array_);
+    return status;
+}
+
+Status
+DBImpl::InsertVectors(const std::string& collection_id, const std::string& partition_tag, VectorsData&& vectors) {
     if (!initialized_.load(std::memory_order_acquire)) {
         return SHUTDOWN_ERROR;
     }
 
-    // insert vectors into target collection
-    // (zhiru): generate ids
     if (vectors.id_array_.empty()) {
         SafeIDGenerator& id_generator = SafeIDGenerator::GetInstance();
         Status status = id_generator.GetNextIDNumbers(vectors.vector_count_, vectors.id_array_);
@@ -708,6 +845,13 @@ DBImpl::InsertVectors(const std::string& collection_id, const std::string& parti
         }
     }
 
+    // take over the vector data, ids are copied since the caller returns them
+    auto payload = std::make_shared<VectorsData>();
+    payload->vector_count_ = vectors.vector_count_;
+    payload->float_data_.swap(vectors.float_data_);
+    payload->binary_data_.swap(vectors.binary_data_);
+    payload->id_array_ = vectors.id_array_;
+
     Status status;
     if (options_.wal_enable_) {
         std::string target_collection_name;
@@ -717,30 +861,25 @@ DBImpl::InsertVectors(const std::string& collection_id, const std::string& parti
             return status;
         }
 
-        if (!vectors.float_data_.empty()) {
-            wal_mgr_->Insert(collection_id, partition_tag, vectors.id_array_, vectors.float_data_);
-        } else if (!vectors.binary_data_.empty()) {
-            wal_mgr_->Insert(collection_id, partition_tag, vectors.id_array_, vectors.binary_data_);
-        }
+        wal_mgr_->Insert(collection_id, partition_tag, std::move(*payload));
         swn_wal_.Notify();
     } else {
         wal::MXLogRecord record;
         record.lsn = 0;  // need to get from meta ?
         record.collection_id = collection_id;
         record.partition_tag = partition_tag;
-        record.ids = vectors.id_array_.data();
-        record.length = vectors.vector_count_;
-        if (vectors.binary_data_.empty()) {
+        record.ids = payload->id_array_.data();
+        record.length = payload->vector_count_;
+        if (payload->binary_data_.empty()) {
             record.type = wal::MXLogType::InsertVector;
-            record.data = vectors.float_data_.data();
-            record.data_size = vectors.float_data_.size() * sizeof(float);
+            record.data = payload->float_data_.data();
+            record.data_size = payload->float_data_.size() * sizeof(float);
         } else {
             record.type = wal::MXLogType::InsertBinary;
-            record.ids = vectors.id_array_.data();
-            record.length = vectors.vector_count_;
-            record.data = vectors.binary_data_.data();
-            record.data_size = vectors.binary_data_.size() * sizeof(uint8_t);
+            record.data = payload->binary_data_.data();
+            record.data_size = payload->binary_data_.size() * sizeof(uint8_t);
         }
+        record.payload = payload;
 
         status = ExecWalRecord(record);
     }
@@ -1156,6 +1295,12 @@ DBImpl::Compact(const std::shared_ptr<server::Context>& context, const std::stri
             compact_status = status;
             break;  // meta error, could not go on
         }
+
+        for (auto& f : files_to_update) {
+            if (f.file_type_ == (int32_t)meta::SegmentSchema::TO_DELETE) {
+                cache::CpuCacheMgr::GetInstance()->EraseItem(f.location_);
+            }
+        }
     }
 
     if (compact_status.ok()) {
@@ -1205,11 +1350,10 @@ DBImpl::CompactFile(const meta::SegmentSchema& file, double threshold, meta::Seg
     auto segment_writer_ptr = std::make_shared<segment::SegmentWriter>(new_segment_dir);
 
     LOG_ENGINE_DEBUG_ << "Compacting begin...";
-    segment_writer_ptr->Merge(segment_dir_to_merge, compacted_file.file_id_);
-
-    // Serialize
-    LOG_ENGINE_DEBUG_ << "Serializing compacted segment...";
-    status = segment_writer_ptr->Serialize();
+    size_t merged_count = 0;
+    status = segment_writer_ptr->Merge({segment_dir_to_merge}, compacted_file.file_id_,
+                                       std::numeric_limits<int64_t>::max(), options_.merge_io_rate_limit_,
+                                       merged_count);
     if (!status.ok()) {
         LOG_ENGINE_ERROR_ << "Failed to serialize compacted segment: " << status.message();
         compacted_file.file_type_ = meta::SegmentSchema::TO_DELETE;
@@ -1224,6 +1368,7 @@ DBImpl::CompactFile(const meta::SegmentSchema& file, double threshold, meta::Seg
     // Update compacted file state, if origin file is backup or to_index, set compacted file to to_index
     compacted_file.file_size_ = segment_writer_ptr->Size();
     compacted_file.row_count_ = segment_writer_ptr->VectorCount();
+    server::Metrics::GetInstance().MergeBytesWrittenIncrement(compacted_file.file_size_);
     if ((file.file_type_ == (int32_t)meta::SegmentSchema::BACKUP ||
          file.file_type_ == (int32_t)meta::SegmentSchema::TO_INDEX) &&
         (compacted_file.row_count_ > meta::BUILD_INDEX_THRESHOLD)) {
@@ -1237,17 +1382,36 @@ DBImpl::CompactFile(const meta::SegmentSchema& file, double threshold, meta::Seg
         compacted_file.file_type_ = meta::SegmentSchema::TO_DELETE;
     }
 
-    files_to_update.emplace_back(compacted_file);
-
-    // Set all files in segment to TO_DELETE
     auto& segment_id = file.segment_id_;
     meta::FilesHolder files_holder;
     status = meta_ptr_->GetCollectionFilesBySegmentId(segment_id, files_holder);
     if (!status.ok()) {
         return status;
     }
-
     milvus::engine::meta::SegmentsSchema& segment_files = files_holder.HoldFiles();
+
+    // an indexed segment keeps its index, deleted entries are dropped from it instead of rebuilding
+    if (file.file_type_ == (int32_t)meta::SegmentSchema::BACKUP && compacted_file.row_count_ > 0) {
+        for (auto& f : segment_files) {
+            if (f.file_type_ != (int32_t)meta::SegmentSchema::INDEX) {
+                continue;
+            }
+            meta::SegmentSchema compacted_index_file;
+            auto index_status = CompactIndexFile(f, compacted_file, compacted_index_file);
+            if (index_status.ok()) {
+                compacted_file.file_type_ = meta::SegmentSchema::BACKUP;
+                files_to_update.emplace_back(compacted_index_file);
+            } else {
+                LOG_ENGINE_DEBUG_ << "Index of segment " << segment_id
+                                  << " will be rebuilt: " << index_status.message();
+            }
+            break;
+        }
+    }
+
+    files_to_update.emplace_back(compacted_file);
+
+    // Set all files in segment to TO_DELETE
     for (auto& f : segment_files) {
         f.file_type_ = meta::SegmentSchema::FILE_TYPE::TO_DELETE;
         files_to_update.emplace_back(f);
@@ -1265,6 +1429,81 @@ DBImpl::CompactFile(const meta::SegmentSchema& file, double threshold, meta::Seg
     return status;
 }
 
+Status
+DBImpl::CompactIndexFile(const meta::SegmentSchema& index_file, const meta::SegmentSchema& compacted_file,
+                         meta::SegmentSchema& compacted_index_file) {
+    std::string segment_dir;
+    utils::GetParentPath(index_file.location_, segment_dir);
+    segment::SegmentReader segment_reader(segment_dir);
+
+    knowhere::VecIndexPtr index;
+    segment::DeletedDocsPtr deleted_docs_ptr;
+    std::vector<segment::doc_id_t> uids;
+    try {
+        segment::SegmentPtr segment_ptr;
+        segment_reader.GetSegment(segment_ptr);
+        STATUS_CHECK(segment_reader.LoadVectorIndex(index_file.location_, segment_ptr->vector_index_ptr_));
+        index = segment_ptr->vector_index_ptr_->GetVectorIndex();
+        STATUS_CHECK(segment_reader.LoadDeletedDocs(deleted_docs_ptr));
+        STATUS_CHECK(segment_reader.LoadUids(uids));
+    } catch (std::exception& ex) {
+        return Status(DB_ERROR, ex.what());
+    }
+    if (index == nullptr) {
+        return Status(DB_ERROR, "Failed to load index from " + index_file.location_);
+    }
+
+    // compact the index with the same deleted docs the raw data was compacted with
+    auto deleted = std::make_shared<faiss::ConcurrentBitset>(index->Count());
+    for (auto offset : deleted_docs_ptr->GetDeletedDocs()) {
+        if (offset >= 0 && offset < index->Count()) {
+            deleted->set(offset);
+        }
+    }
+    index->SetUids(uids);
+    if (!index->Compact(deleted)) {
+        return Status(DB_ERROR, "Index type " + index->index_type() + " can not be compacted in place");
+    }
+    if (index->Count() != (int64_t)compacted_file.row_count_) {
+        return Status(DB_ERROR, "Compacted index does not match compacted segment");
+    }
+
+    compacted_index_file.collection_id_ = compacted_file.collection_id_;
+    compacted_index_file.segment_id_ = compacted_file.file_id_;
+    compacted_index_file.date_ = compacted_file.date_;
+    compacted_index_file.file_type_ = meta::SegmentSchema::NEW_INDEX;
+    auto status = meta_ptr_->CreateCollectionFile(compacted_index_file);
+    if (!status.ok()) {
+        return status;
+    }
+
+    std::string new_segment_dir;
+    utils::GetParentPath(compacted_index_file.location_, new_segment_dir);
+    segment::SegmentWriter segment_writer(new_segment_dir);
+    segment_writer.SetVectorIndex(index);
+    status = segment_writer.WriteVectorIndex(compacted_index_file.location_);
+    if (!status.ok()) {
+        compacted_index_file.file_type_ = meta::SegmentSchema::TO_DELETE;
+        meta_ptr_->UpdateCollectionFile(compacted_index_file);
+        return status;
+    }
+
+    compacted_index_file.file_type_ = meta::SegmentSchema::INDEX;
+    compacted_index_file.file_size_ = server::CommonUtil::GetFileSize(compacted_index_file.location_);
+    compacted_index_file.row_count_ = index->Count();
+    index->SetIndexSize(compacted_index_file.file_size_);
+
+    // keep the segment warm, the old entry is erased once meta points to the new files
+    auto cpu_cache_mgr = cache::CpuCacheMgr::GetInstance();
+    if (cpu_cache_mgr->ItemExists(index_file.location_)) {
+        cpu_cache_mgr->InsertItem(compacted_index_file.location_, std::static_pointer_cast<cache::DataObj>(index));
+    }
+
+    LOG_ENGINE_DEBUG_ << "Compacted index " << index_file.file_id_ << " to " << compacted_index_file.file_id_
+                      << " with " << compacted_index_file.row_count_ << " rows";
+    return Status::OK();
+}
+
 Status
 DBImpl::GetVectorsByID(const engine::meta::CollectionSchema& collection, const IDNumbers& id_array,
                        std::vector<engine::VectorsData>& vectors) {
@@ -1292,9 +1531,10 @@ DBImpl::GetVectorsByID(const engine::meta::CollectionSchema& collection, const I
         return Status(DB_NOT_FOUND, "Collection is empty");
     }
 
-    cache::CpuCacheMgr::GetInstance()->PrintInfo();
-    status = GetVectorsByIdHelper(id_array, vectors, files_holder);
-    cache::CpuCacheMgr::GetInstance()->PrintInfo();
+    {
+        SampledQueryTrace sampled_trace(nullptr, SampleQuery());
+        status = GetVectorsByIdHelper(id_array, vectors, files_holder);
+    }
 
     if (vectors.empty()) {
         std::string msg = "Vectors not found in collection " + collection.collection_id_;
@@ -1368,11 +1608,8 @@ DBImpl::GetEntitiesByID(const std::string& collection_id, const milvus::engine::
         return Status(DB_NOT_FOUND, "Collection is empty");
     }
 
-    cache::CpuCacheMgr::GetInstance()->PrintInfo();
-    status = GetEntitiesByIdHelper(collection_id, id_array, attr_type, vectors, attrs, files_holder);
-    cache::CpuCacheMgr::GetInstance()->PrintInfo();
-
-    return status;
+    SampledQueryTrace sampled_trace(nullptr, SampleQuery());
+    return GetEntitiesByIdHelper(collection_id, id_array, attr_type, vectors, attrs, files_holder);
 }
 
 Status
@@ -1479,63 +1716,70 @@ DBImpl::GetVectorsByIdHelper(const IDNumbers& id_array, std::vector<engine::Vect
             return status;
         }
 
-        for (IDNumbers::iterator it = temp_ids.begin(); it != temp_ids.end();) {
-            int64_t vector_id = *it;
-            // each id must has a VectorsData
-            // if vector not found for an id, its VectorsData's vector_count = 0, else 1
-            VectorsData& vector_ref = map_id2vector[vector_id];
-
-            // Check if the id is present in bloom filter.
+        // ids that may be in this segment, by the bloom filter
+        IDNumbers candidates;
+        for (auto vector_id : temp_ids) {
             if (id_bloom_filter_ptr->Check(vector_id)) {
-                // Load uids and check if the id is indeed present. If yes, find its offset.
-                std::vector<segment::doc_id_t> uids;
-                auto status = segment_reader.LoadUids(uids);
-                if (!status.ok()) {
-                    return status;
-                }
+                candidates.push_back(vector_id);
+            }
+        }
 
-                auto found = std::find(uids.begin(), uids.end(), vector_id);
-                if (found != uids.end()) {
-                    auto offset = std::distance(uids.begin(), found);
+        if (!candidates.empty()) {
+            // Load uids and deleted docs once, then find the offsets of the live ids
+            std::vector<segment::doc_id_t> uids;
+            status = segment_reader.LoadUids(uids);
+            if (!status.ok()) {
+                return status;
+            }
+            segment::DeletedDocsPtr deleted_docs_ptr;
+            status = segment_reader.LoadDeletedDocs(deleted_docs_ptr);
+            if (!status.ok()) {
+                LOG_ENGINE_ERROR_ << status.message();
+                return status;
+            }
+            auto& deleted_docs = deleted_docs_ptr->GetDeletedDocs();
 
-                    // Check whether the id has been deleted
-                    segment::DeletedDocsPtr deleted_docs_ptr;
-                    status = segment_reader.LoadDeletedDocs(deleted_docs_ptr);
-                    if (!status.ok()) {
-                        LOG_ENGINE_ERROR_ << status.message();
-                        return status;
-                    }
-                    auto& deleted_docs = deleted_docs_ptr->GetDeletedDocs();
+            bool is_binary = utils::IsBinaryMetricType(file.metric_type_);
+            size_t single_vector_bytes = is_binary ? file.dimension_ / 8 : file.dimension_ * sizeof(float);
+            IDNumbers found_ids;
+            std::vector<off_t> offsets;
+            for (auto vector_id : candidates) {
+                auto found = std::find(uids.begin(), uids.end(), vector_id);
+                if (found == uids.end()) {
+                    continue;
+                }
+                auto offset = std::distance(uids.begin(), found);
+                if (std::find(deleted_docs.begin(), deleted_docs.end(), offset) != deleted_docs.end()) {
+                    continue;
+                }
+                found_ids.push_back(vector_id);
+                offsets.push_back(offset * single_vector_bytes);
+            }
 
-                    auto deleted = std::find(deleted_docs.begin(), deleted_docs.end(), offset);
-                    if (deleted == deleted_docs.end()) {
-                        // Load raw vector
-                        bool is_binary = utils::IsBinaryMetricType(file.metric_type_);
-                        size_t single_vector_bytes = is_binary ? file.dimension_ / 8 : file.dimension_ * sizeof(float);
-                        std::vector<uint8_t> raw_vector;
-                        status =
-                            segment_reader.LoadVectors(offset * single_vector_bytes, single_vector_bytes, raw_vector);
-                        if (!status.ok()) {
-                            LOG_ENGINE_ERROR_ << status.message();
-                            return status;
-                        }
+            if (!found_ids.empty()) {
+                // Load all raw vectors of this segment in one batch
+                std::vector<uint8_t> raw_vectors;
+                status = segment_reader.LoadVectors(offsets, single_vector_bytes, raw_vectors);
+                if (!status.ok()) {
+                    LOG_ENGINE_ERROR_ << status.message();
+                    return status;
+                }
 
-                        vector_ref.vector_count_ = 1;
-                        if (is_binary) {
-                            vector_ref.binary_data_.swap(raw_vector);
-                        } else {
-                            std::vector<float> float_vector;
-                            float_vector.resize(file.dimension_);
-                            memcpy(float_vector.data(), raw_vector.data(), single_vector_bytes);
-                            vector_ref.float_data_.swap(float_vector);
-                        }
-                        temp_ids.erase(it);
-                        continue;
+                for (size_t i = 0; i < found_ids.size(); ++i) {
+                    // each id must has a VectorsData
+                    // if vector not found for an id, its VectorsData's vector_count = 0, else 1
+                    VectorsData& vector_ref = map_id2vector[found_ids[i]];
+                    vector_ref.vector_count_ = 1;
+                    const uint8_t* raw = raw_vectors.data() + i * single_vector_bytes;
+                    if (is_binary) {
+                        vector_ref.binary_data_.assign(raw, raw + single_vector_bytes);
+                    } else {
+                        vector_ref.float_data_.resize(file.dimension_);
+                        memcpy(vector_ref.float_data_.data(), raw, single_vector_bytes);
                     }
+                    temp_ids.erase(std::find(temp_ids.begin(), temp_ids.end(), found_ids[i]));
                 }
             }
-
-            it++;
         }
 
         // unmark file, allow the file to be deleted
@@ -1928,6 +2172,7 @@ DBImpl::HybridQuery(const std::shared_ptr<server::Context>& context, const std::
         return SHUTDOWN_ERROR;
     }
 
+    QueryStageRecorder stage_recorder(query_ctx, collection_id);
     Status status;
     meta::FilesHolder files_holder;
     if (partition_tags.empty()) {
@@ -1970,13 +2215,16 @@ DBImpl::HybridQuery(const std::shared_ptr<server::Context>& context, const std::
         }
     }
 
-    cache::CpuCacheMgr::GetInstance()->PrintInfo();  // print cache info before query
-    status = HybridQueryAsync(query_ctx, collection_id, files_holder, general_query, query_ptr, field_names, attr_type,
-                              result);
-    if (!status.ok()) {
-        return status;
+    stage_recorder.Finish("meta");
+    {
+        SampledQueryTrace sampled_trace(query_ctx, SampleQuery());
+        status = HybridQueryAsync(query_ctx, collection_id, files_holder, general_query, query_ptr, field_names,
+                                  attr_type, result);
+        stage_recorder.Finish("execute");
+        if (!status.ok()) {
+            return status;
+        }
     }
-    cache::CpuCacheMgr::GetInstance()->PrintInfo();  // print cache info after query
 
     query_ctx->GetTraceContext()->GetSpan()->Finish();
 
@@ -1993,6 +2241,7 @@ DBImpl::Query(const std::shared_ptr<server::Context>& context, const std::string
         return SHUTDOWN_ERROR;
     }
 
+    QueryStageRecorder stage_recorder(context, collection_id);
     Status status;
     meta::FilesHolder files_holder;
     if (partition_tags.empty()) {
@@ -2065,9 +2314,10 @@ DBImpl::Query(const std::shared_ptr<server::Context>& context, const std::string
         }
     }
 
-    cache::CpuCacheMgr::GetInstance()->PrintInfo();  // print cache info before query
+    stage_recorder.Finish("meta");
+    SampledQueryTrace sampled_trace(tracer.Context(), SampleQuery());
     status = QueryAsync(tracer.Context(), files_holder, k, extra_params, vectors, result_ids, result_distances);
-    cache::CpuCacheMgr::GetInstance()->PrintInfo();  // print cache info after query
+    stage_recorder.Finish("execute");
 
     return status;
 }
@@ -2100,11 +2350,8 @@ DBImpl::QueryByFileID(const std::shared_ptr<server::Context>& context, const std
         return Status(DB_ERROR, "Invalid file id");
     }
 
-    cache::CpuCacheMgr::GetInstance()->PrintInfo();  // print cache info before query
-    status = QueryAsync(tracer.Context(), files_holder, k, extra_params, vectors, result_ids, result_distances);
-    cache::CpuCacheMgr::GetInstance()->PrintInfo();  // print cache info after query
-
-    return status;
+    SampledQueryTrace sampled_trace(tracer.Context(), SampleQuery());
+    return QueryAsync(tracer.Context(), files_holder, k, extra_params, vectors, result_ids, result_distances);
 }
 
 Status
@@ -2126,7 +2373,8 @@ DBImpl::QueryAsync(const std::shared_ptr<server::Context>& context, meta::FilesH
     milvus::server::ContextChild tracer(context, "Query Async");
     server::CollectQueryMetrics metrics(vectors.vector_count_);
 
-    milvus::engine::meta::SegmentsSchema& files = files_holder.HoldFiles();
+    // files are moved into the job, they stay marked in files_holder until the job is done
+    auto files = files_holder.ShareFiles();
     if (files.size() > milvus::scheduler::TASK_TABLE_MAX_COUNT) {
         std::string msg =
             "Search files count exceed scheduler limit: " + std::to_string(milvus::scheduler::TASK_TABLE_MAX_COUNT);
@@ -2134,14 +2382,17 @@ DBImpl::QueryAsync(const std::shared_ptr<server::Context>& context, meta::FilesH
         return Status(DB_ERROR, msg);
     }
 
+    if (context != nullptr && context->IsCancelled()) {
+        return Status(SERVER_REQUEST_CANCELLED, "Search cancelled or deadline exceeded");
+    }
+
     TimeRecorder rc("");
 
     // step 1: construct search job
     LOG_ENGINE_DEBUG_ << LogOut("Engine query begin, index file count: %ld", files.size());
     scheduler::SearchJobPtr job = std::make_shared<scheduler::SearchJob>(tracer.Context(), k, extra_params, vectors);
     for (auto& file : files) {
-        scheduler::SegmentSchemaPtr file_ptr = std::make_shared<meta::SegmentSchema>(file);
-        job->AddIndexFile(file_ptr);
+        job->AddIndexFile(file);
     }
 
     // Suspend builder
@@ -2155,6 +2406,10 @@ DBImpl::QueryAsync(const std::shared_ptr<server::Context>& context, meta::FilesH
     ResumeIfLast();
 
     files_holder.ReleaseFiles();
+    if (job->IsCancelled()) {
+        LOG_ENGINE_DEBUG_ << LogOut("[%s][%ld] SearchJob %ld cancelled", "search", 0, job->id());
+        return Status(SERVER_REQUEST_CANCELLED, "Search cancelled or deadline exceeded");
+    }
     if (!job->GetStatus().ok()) {
         return job->GetStatus();
     }
@@ -2164,6 +2419,13 @@ DBImpl::QueryAsync(const std::shared_ptr<server::Context>& context, meta::FilesH
     result_distances = job->GetResultDistances();
     rc.ElapseFromBegin("Engine query totally cost");
 
+    if (context != nullptr && context->GetQueryProfile() != nullptr) {
+        auto& time_stat = job->time_stat();
+        context->GetQueryProfile()->AddStage("index_search", time_stat.query_time);
+        context->GetQueryProfile()->AddStage("map_uids", time_stat.map_uids_time);
+        context->GetQueryProfile()->AddStage("reduce", time_stat.reduce_time);
+    }
+
     return Status::OK();
 }
 
@@ -2197,13 +2459,12 @@ DBImpl::HybridQueryAsync(const std::shared_ptr<server::Context>& context, const
 
     // step 1: construct search job
     VectorsData vectors;
-    milvus::engine::meta::SegmentsSchema& files = files_holder.HoldFiles();
-    LOG_ENGINE_DEBUG_ << LogOut("Engine query begin, index file count: %ld", files_holder.HoldFiles().size());
+    auto files = files_holder.ShareFiles();
+    LOG_ENGINE_DEBUG_ << LogOut("Engine query begin, index file count: %ld", files.size());
     scheduler::SearchJobPtr job =
         std::make_shared<scheduler::SearchJob>(query_async_ctx, general_query, query_ptr, attr_type, vectors);
     for (auto& file : files) {
-        scheduler::SegmentSchemaPtr file_ptr = std::make_shared<meta::SegmentSchema>(file);
-        job->AddIndexFile(file_ptr);
+        job->AddIndexFile(file);
     }
 
     // step 2: put search job to scheduler and wait result
@@ -2255,6 +2516,7 @@ void
 DBImpl::BackgroundIndexThread() {
     SetThreadName("index_thread");
     server::SystemInfo::GetInstance().Init();
+    auto manifest_saved = std::chrono::steady_clock::now();
     while (true) {
         if (!initialized_.load(std::memory_order_acquire)) {
             WaitMergeFileFinish();
@@ -2268,6 +2530,12 @@ DBImpl::BackgroundIndexThread() {
 
         WaitMergeFileFinish();
         StartBuildIndexTask();
+
+        auto now = std::chrono::steady_clock::now();
+        if (now - manifest_saved >= std::chrono::seconds(BACKGROUND_CACHE_MANIFEST_INTERVAL)) {
+            SaveCacheManifest();
+            manifest_saved = now;
+        }
     }
 }
 
@@ -2449,6 +2717,7 @@ DBImpl::BackgroundMerge(std::set<std::string> collection_ids, bool force_merge_a
     // LOG_ENGINE_TRACE_ << " Background merge thread start";
 
     Status status;
+    uint64_t merge_candidates = 0;
     for (auto& collection_id : collection_ids) {
         const std::lock_guard<std::mutex> lock(flush_merge_compact_mutex_);
 
@@ -2457,7 +2726,7 @@ DBImpl::BackgroundMerge(std::set<std::string> collection_ids, bool force_merge_a
             merge_mgr_ptr_->UseStrategy(MergeStrategyType::ADAPTIVE);
         }
 
-        auto status = merge_mgr_ptr_->MergeFiles(collection_id);
+        auto status = merge_mgr_ptr_->MergeFiles(collection_id, merge_candidates);
         merge_mgr_ptr_->UseStrategy(old_strategy);
         if (!status.ok()) {
             LOG_ENGINE_ERROR_ << "Failed to get merge files for collection: " << collection_id
@@ -2469,6 +2738,7 @@ DBImpl::BackgroundMerge(std::set<std::string> collection_ids, bool force_merge_a
             break;
         }
     }
+    server::Metrics::GetInstance().MergeCandidateSegmentsGaugeSet(merge_candidates);
 
     //    meta_ptr_->Archive();
 
@@ -2762,26 +3032,18 @@ DBImpl::DropCollectionIndexRecursively(const std::string& collection_id) {
 Status
 DBImpl::GetCollectionRowCountRecursively(const std::string& collection_id, uint64_t& row_count) {
     row_count = 0;
-    auto status = meta_ptr_->Count(collection_id, row_count);
+
+    // the collection statistics already include all partitions
+    meta::CollectionStats stats;
+    std::vector<meta::CollectionStats> partitions_stats;
+    auto status = meta_ptr_->GetCollectionStats(collection_id, stats, partitions_stats);
+    fiu_do_on("DBImpl.GetCollectionRowCountRecursively.fail_get_collection_rowcount_for_partition",
+              status = Status(DB_ERROR, ""));
     if (!status.ok()) {
         return status;
     }
 
-    // get partition row count
-    std::vector<meta::CollectionSchema> partition_array;
-    status = meta_ptr_->ShowPartitions(collection_id, partition_array);
-    for (auto& schema : partition_array) {
-        uint64_t partition_row_count = 0;
-        status = GetCollectionRowCountRecursively(schema.collection_id_, partition_row_count);
-        fiu_do_on("DBImpl.GetCollectionRowCountRecursively.fail_get_collection_rowcount_for_partition",
-                  status = Status(DB_ERROR, ""));
-        if (!status.ok()) {
-            return status;
-        }
-
-        row_count += partition_row_count;
-    }
-
+    row_count = stats.row_count_;
     return Status::OK();
 }
 
@@ -2855,9 +3117,14 @@ DBImpl::ExecWalRecord(const wal::MXLogRecord& record) {
             }
 
             std::set<std::string> flushed_collections;
-            status = mem_mgr_->InsertVectors(target_collection_name, record.length, record.ids,
-                                             (record.data_size / record.length / sizeof(uint8_t)),
-                                             (const u_int8_t*)record.data, record.lsn, flushed_collections);
+            if (record.payload != nullptr) {
+                status = mem_mgr_->InsertVectors(target_collection_name, std::move(*record.payload), record.lsn,
+                                                 flushed_collections);
+            } else {
+                status = mem_mgr_->InsertVectors(target_collection_name, record.length, record.ids,
+                                                 (record.data_size / record.length / sizeof(uint8_t)),
+                                                 (const u_int8_t*)record.data, record.lsn, flushed_collections);
+            }
             // even though !status.ok, run
             if (!flushed_collections.empty()) {
                 partition_flushed(record.collection_id, record.partition_tag, target_collection_name);
@@ -2877,9 +3144,14 @@ DBImpl::ExecWalRecord(const wal::MXLogRecord& record) {
             }
 
             std::set<std::string> flushed_collections;
-            status = mem_mgr_->InsertVectors(target_collection_name, record.length, record.ids,
-                                             (record.data_size / record.length / sizeof(float)),
-                                             (const float*)record.data, record.lsn, flushed_collections);
+            if (record.payload != nullptr) {
+                status = mem_mgr_->InsertVectors(target_collection_name, std::move(*record.payload), record.lsn,
+                                                 flushed_collections);
+            } else {
+                status = mem_mgr_->InsertVectors(target_collection_name, record.length, record.ids,
+                                                 (record.data_size / record.length / sizeof(float)),
+                                                 (const float*)record.data, record.lsn, flushed_collections);
+            }
             // even though !status.ok, run
             if (!flushed_collections.empty()) {
                 partition_flushed(record.collection_id, record.partition_tag, target_collection_name);
@@ -3073,6 +3345,42 @@ DBImpl::BackgroundMetricThread() {
     }
 }
 
+void
+DBImpl::LoadCacheManifest() {
+    std::string path = options_.meta_.path_ + "/" + CACHE_MANIFEST_NAME;
+    if (!boost::filesystem::exists(path)) {
+        return;
+    }
+
+    cache::CacheManifest manifest;
+    auto status = cache::CpuCacheMgr::LoadManifest(path, manifest);
+    if (!status.ok()) {
+        LOG_ENGINE_WARNING_ << status.message();
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(cache_manifest_mutex_);
+    cache_manifest_rank_.clear();
+    for (size_t i = 0; i < manifest.size(); ++i) {
+        cache_manifest_rank_.insert(std::make_pair(manifest[i].first, i));
+    }
+    LOG_ENGINE_DEBUG_ << "Loaded cache manifest with " << cache_manifest_rank_.size() << " items";
+}
+
+void
+DBImpl::SaveCacheManifest() {
+    // an empty cache usually means nothing was searched yet, keep the previous manifest in that case
+    if (cache::CpuCacheMgr::GetInstance()->ItemCount() == 0) {
+        return;
+    }
+
+    std::string path = options_.meta_.path_ + "/" + CACHE_MANIFEST_NAME;
+    auto status = cache::CpuCacheMgr::GetInstance()->SaveManifest(path);
+    if (!status.ok()) {
+        LOG_ENGINE_WARNING_ << status.message();
+    }
+}
+
 void
 DBImpl::OnCacheInsertDataChanged(bool value) {
     options_.insert_cache_immediately_ = value;
@@ -3101,5 +3409,14 @@ DBImpl::ResumeIfLast() {
     }
 }
 
+bool
+DBImpl::SampleQuery() {
+    if (options_.trace_sample_interval_ <= 0) {
+        return false;
+    }
+    auto count = query_sample_count_.fetch_add(1, std::memory_order_relaxed);
+    return count % static_cast<uint64_t>(options_.trace_sample_interval_) == 0;
+}
+
 }  // namespace engine
 }  // namespace milvus
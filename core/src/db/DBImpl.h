@@ -110,6 +110,9 @@ class DBImpl : public DB, public server::CacheConfigHandler, public server::Engi
     Status
     InsertVectors(const std::string& collection_id, const std::string& partition_tag, VectorsData& vectors) override;
 
+    Status
+    InsertVectors(const std::string& collection_id, const std::string& partition_tag, VectorsData&& vectors) override;
+
     Status
     DeleteVector(const std::string& collection_id, IDNumber vector_id) override;
 
@@ -242,6 +245,12 @@ class DBImpl : public DB, public server::CacheConfigHandler, public server::Engi
     void
     StartMetricTask();
 
+    void
+    LoadCacheManifest();
+
+    void
+    SaveCacheManifest();
+
     void
     StartMergeTask(const std::set<std::string>& merge_collection_ids, bool force_merge_all = false);
 
@@ -260,6 +269,10 @@ class DBImpl : public DB, public server::CacheConfigHandler, public server::Engi
     Status
     CompactFile(const meta::SegmentSchema& file, double threshold, meta::SegmentsSchema& files_to_update);
 
+    Status
+    CompactIndexFile(const meta::SegmentSchema& index_file, const meta::SegmentSchema& compacted_file,
+                     meta::SegmentSchema& compacted_index_file);
+
     Status
     GetFilesToBuildIndex(const std::string& collection_id, const std::vector<int>& file_types,
                          meta::FilesHolder& files_holder);
@@ -293,10 +306,15 @@ class DBImpl : public DB, public server::CacheConfigHandler, public server::Engi
     void
     ResumeIfLast();
 
+    // true for one in every trace_sample_interval_ queries
+    bool
+    SampleQuery();
+
  private:
     DBOptions options_;
 
     std::atomic<bool> initialized_;
+    std::atomic<uint64_t> query_sample_count_{0};
 
     meta::MetaPtr meta_ptr_;
     MemManagerPtr mem_mgr_;
@@ -374,6 +392,10 @@ class DBImpl : public DB, public server::CacheConfigHandler, public server::Engi
 
     int64_t live_search_num_ = 0;
     std::mutex suspend_build_mutex_;
+
+    // cache key -> rank in the manifest saved by last run
+    std::unordered_map<std::string, size_t> cache_manifest_rank_;
+    std::mutex cache_manifest_mutex_;
 };  // DBImpl
 
 }  // namespace engine
@@ -10,12 +10,20 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include "db/IDGenerator.h"
+#include "utils/Exception.h"
 #include "utils/Log.h"
 
 #include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
 #include <fiu-local.h>
+#include <algorithm>
+#include <boost/filesystem.hpp>
 #include <chrono>
 #include <iostream>
+#include <numeric>
 #include <string>
 
 namespace milvus {
@@ -61,63 +69,200 @@ SimpleIDGenerator::GetNextIDNumbers(size_t n, IDNumbers& ids) {
     return Status::OK();
 }
 
-IDNumber
-SafeIDGenerator::GetNextIDNumber() {
+namespace {
+
+// ranges taken by this thread, dropped when the generator is re-initialized
+struct IDRangeCache {
+    uint64_t generation_ = 0;
+    IDNumber next_ = 0;
+    IDNumber end_ = 0;
+};
+
+thread_local IDRangeCache id_range_cache;
+
+Status
+LoadMark(const std::string& path, int64_t& mark) {
+    mark = 0;
+    if (!boost::filesystem::exists(path)) {
+        return Status::OK();
+    }
+
+    // the mark is stored twice, a torn write shows up as a mismatch
+    int64_t marks[2] = {0, 0};
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return Status(DB_ERROR, "Failed to open id mark file " + path + ": " + strerror(errno));
+    }
+    auto size = ::read(fd, marks, sizeof(marks));
+    ::close(fd);
+    if (size != sizeof(marks) || marks[0] != marks[1]) {
+        return Status(DB_ERROR, "Id mark file " + path + " is corrupted");
+    }
+
+    mark = marks[0];
+    return Status::OK();
+}
+
+Status
+StoreMark(const std::string& path, int64_t mark) {
+    fiu_return_on("SafeIDGenerator.StoreMark.fail", Status(DB_ERROR, "Failed to write id mark file " + path));
+
+    int64_t marks[2] = {mark, mark};
+    auto tmp_path = path + ".tmp";
+    int fd = ::open(tmp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        return Status(DB_ERROR, "Failed to create id mark file " + tmp_path + ": " + strerror(errno));
+    }
+    bool ok = ::write(fd, marks, sizeof(marks)) == sizeof(marks) && fsync(fd) == 0;
+    ::close(fd);
+    if (!ok || ::rename(tmp_path.c_str(), path.c_str()) != 0) {
+        ::unlink(tmp_path.c_str());
+        return Status(DB_ERROR, "Failed to write id mark file " + path + ": " + strerror(errno));
+    }
+
+    auto dir = boost::filesystem::path(path).parent_path().string();
+    int dir_fd = ::open(dir.empty() ? "." : dir.c_str(), O_RDONLY);
+    if (dir_fd >= 0) {
+        fsync(dir_fd);
+        ::close(dir_fd);
+    }
+    return Status::OK();
+}
+
+int64_t
+TimestampID() {
     auto now = std::chrono::system_clock::now();
-    auto micros = std::chrono::duration_cast<std::chrono::microseconds>(now.time_since_epoch()).count();
+    return std::chrono::duration_cast<std::chrono::microseconds>(now.time_since_epoch()).count();
+}
+
+}  // namespace
+
+SafeIDGenerator::SafeIDGenerator() {
+    // start above the timestamp based ids handed out by earlier versions
+    next_id_ = TimestampID() * MAX_IDS_PER_MICRO;
+    reserved_id_ = next_id_.load();
+}
+
+Status
+SafeIDGenerator::Init(const std::string& mark_path) {
     std::lock_guard<std::mutex> lock(mtx_);
-    if (micros <= time_stamp_ms_) {
-        time_stamp_ms_ += 1;
-    } else {
-        time_stamp_ms_ = micros;
+    int64_t mark = 0;
+    if (!mark_path.empty()) {
+        auto status = LoadMark(mark_path, mark);
+        if (!status.ok()) {
+            LOG_ENGINE_ERROR_ << status.message();
+            return status;
+        }
+    }
+
+    // ids below the stored mark may have been handed out by the last run
+    int64_t start = std::max({mark, TimestampID() * (int64_t)MAX_IDS_PER_MICRO, reserved_id_.load(), next_id_.load()});
+    auto last_path = mark_path_;
+    auto last_reserved = reserved_id_.load();
+    mark_path_ = mark_path;
+    reserved_id_ = 0;  // a new file always gets a mark
+    auto status = Reserve(start);
+    if (!status.ok()) {
+        mark_path_ = last_path;
+        reserved_id_ = last_reserved;
+        LOG_ENGINE_ERROR_ << status.message();
+        return status;
     }
-    return time_stamp_ms_ * MAX_IDS_PER_MICRO;
+
+    // the counter never moves backwards, concurrent callers may have advanced it meanwhile
+    int64_t current = next_id_.load();
+    while (current < start && !next_id_.compare_exchange_weak(current, start)) {
+    }
+    generation_.fetch_add(1);
+
+    LOG_ENGINE_DEBUG_ << "Id generator starts from " << start << ", mark file: " << mark_path;
+    return Status::OK();
+}
+
+IDNumber
+SafeIDGenerator::GetNextIDNumber() {
+    IDNumbers ids;
+    auto status = GetNextIDNumbers(1, ids);
+    if (status.ok()) {
+        return ids[0];
+    }
+
+    // the cached range could not be refilled, try once more for a single id, NextIDRange stores a mark above it
+    // before the id is handed out
+    LOG_ENGINE_WARNING_ << "Failed to reserve id range: " << status.message();
+    IDNumber id = 0;
+    status = NextIDRange(1, id);
+    if (!status.ok()) {
+        // an id above the stored mark could be handed out again after a restart
+        std::string msg = "Failed to reserve id: " + status.message();
+        LOG_ENGINE_ERROR_ << msg;
+        throw Exception(status.code(), msg);
+    }
+    return id;
 }
 
 Status
 SafeIDGenerator::GetNextIDNumbers(size_t n, IDNumbers& ids) {
     ids.clear();
-    std::lock_guard<std::mutex> lock(mtx_);
-    while (n > 0) {
-        if (n > MAX_IDS_PER_MICRO) {
-            Status status = NextIDNumbers(MAX_IDS_PER_MICRO, ids);
-            if (!status.ok()) {
-                return status;
-            }
-            n -= MAX_IDS_PER_MICRO;
-        } else {
-            Status status = NextIDNumbers(n, ids);
+    if (n == 0) {
+        return Status::OK();
+    }
+
+    IDNumber begin = 0;
+    if (n >= THREAD_CACHE_SIZE) {
+        auto status = NextIDRange(n, begin);
+        if (!status.ok()) {
+            return status;
+        }
+    } else {
+        auto& cache = id_range_cache;
+        auto generation = generation_.load();
+        if (cache.generation_ != generation || cache.end_ - cache.next_ < (IDNumber)n) {
+            // the rest of the cached range is dropped, ids of one call stay contiguous
+            auto status = NextIDRange(THREAD_CACHE_SIZE, begin);
             if (!status.ok()) {
                 return status;
             }
-            break;
+            cache.generation_ = generation;
+            cache.next_ = begin;
+            cache.end_ = begin + THREAD_CACHE_SIZE;
         }
+        begin = cache.next_;
+        cache.next_ += n;
     }
+
+    ids.resize(n);
+    std::iota(ids.begin(), ids.end(), begin);
     return Status::OK();
 }
 
 Status
-SafeIDGenerator::NextIDNumbers(size_t n, IDNumbers& ids) {
-    if (n <= 0 || n > MAX_IDS_PER_MICRO) {
-        std::string msg = "Invalid ID number: " + std::to_string(n);
-        LOG_ENGINE_ERROR_ << msg;
-        return Status(SERVER_UNEXPECTED_ERROR, msg);
-    }
-
-    auto now = std::chrono::system_clock::now();
-    int64_t micros = std::chrono::duration_cast<std::chrono::microseconds>(now.time_since_epoch()).count();
-    if (micros <= time_stamp_ms_) {
-        time_stamp_ms_ += 1;
-    } else {
-        time_stamp_ms_ = micros;
+SafeIDGenerator::NextIDRange(size_t n, IDNumber& begin) {
+    begin = next_id_.fetch_add(n);
+    IDNumber end = begin + n;
+    if (end <= reserved_id_.load()) {
+        return Status::OK();
     }
 
-    int64_t ID_high_part = time_stamp_ms_ * MAX_IDS_PER_MICRO;
+    // only callers crossing the mark wait for the next one to be stored
+    std::lock_guard<std::mutex> lock(mtx_);
+    return Reserve(end);
+}
 
-    for (size_t pos = 0; pos < n; ++pos) {
-        ids.push_back(ID_high_part + pos);
+Status
+SafeIDGenerator::Reserve(IDNumber end) {
+    if (end <= reserved_id_.load()) {
+        return Status::OK();
     }
 
+    IDNumber mark = end + RESERVE_STEP;
+    if (!mark_path_.empty()) {
+        auto status = StoreMark(mark_path_, mark);
+        if (!status.ok()) {
+            return status;
+        }
+    }
+    reserved_id_ = mark;
     return Status::OK();
 }
 
@@ -14,7 +14,10 @@
 #include "Types.h"
 #include "utils/Status.h"
 
+#include <atomic>
 #include <cstddef>
+#include <mutex>
+#include <string>
 #include <vector>
 
 namespace milvus {
@@ -48,6 +51,9 @@ class SimpleIDGenerator : public IDGenerator {
     static constexpr size_t MAX_IDS_PER_MICRO = 1000;
 };  // SimpleIDGenerator
 
+// Hands out contiguous id ranges with an atomic fetch-add on a shared counter. A high-water mark is persisted
+// ahead of the counter, ids are only returned once the mark covers them, so ids are never reused after a restart.
+// Small requests are served from a range cached by the calling thread.
 class SafeIDGenerator : public IDGenerator {
  public:
     static SafeIDGenerator&
@@ -58,22 +64,39 @@ class SafeIDGenerator : public IDGenerator {
 
     ~SafeIDGenerator() override = default;
 
+    // Persist the high-water mark in the given file and continue after the mark stored there, an empty path keeps
+    // the mark in memory only
+    Status
+    Init(const std::string& mark_path);
+
+    // Throws when no id below a stored mark can be handed out, GetNextIDNumbers reports that as a status instead
     IDNumber
     GetNextIDNumber() override;
 
+    // A failed call still consumes its ids: the range is taken before the mark is stored, so the next call continues
+    // after it and the skipped ids are never handed out
     Status
     GetNextIDNumbers(size_t n, IDNumbers& ids) override;
 
  private:
-    SafeIDGenerator() = default;
+    SafeIDGenerator();
 
     Status
-    NextIDNumbers(size_t n, IDNumbers& ids);
+    NextIDRange(size_t n, IDNumber& begin);
+
+    Status
+    Reserve(IDNumber end);
 
     static constexpr size_t MAX_IDS_PER_MICRO = 1000;
+    static constexpr size_t THREAD_CACHE_SIZE = 4096;
+    static constexpr int64_t RESERVE_STEP = 1 << 24;
+
+    std::atomic<int64_t> next_id_;
+    std::atomic<int64_t> reserved_id_;
+    std::atomic<uint64_t> generation_{0};
 
     std::mutex mtx_;
-    int64_t time_stamp_ms_ = 0;
+    std::string mark_path_;
 };
 
 }  // namespace engine
@@ -70,11 +70,15 @@ struct DBOptions {
 
     size_t insert_buffer_size_ = 4 * GB;
     bool insert_cache_immediately_ = false;
+    int64_t preload_parallelism_ = 4;
 
     int64_t auto_flush_interval_ = 1;
     int64_t file_cleanup_timeout_ = 10;
+    int64_t merge_io_rate_limit_ = 0;         // bytes per second, 0 means no limit
+    std::string merge_strategy_ = "layered";  // simple, layered, adaptive or cost
 
     bool metric_enable_ = false;
+    int64_t trace_sample_interval_ = 100;  // one in N queries logs diagnostics, 0 means never
 
     // wal relative configurations
     bool wal_enable_ = true;
@@ -254,7 +254,8 @@ GetIndexName(int32_t index_type) {
         {(int32_t)engine::EngineType::FAISS_BIN_IDMAP, "IDMAP"},
         {(int32_t)engine::EngineType::FAISS_BIN_IVFFLAT, "IVFFLAT"},
         {(int32_t)engine::EngineType::HNSW, "HNSW"},
-        {(int32_t)engine::EngineType::ANNOY, "ANNOY"}};
+        {(int32_t)engine::EngineType::ANNOY, "ANNOY"},
+        {(int32_t)engine::EngineType::FAISS_BIN_HNSW, "HNSW"}};
 
     if (index_type_name.find(index_type) == index_type_name.end()) {
         return "Unknow";
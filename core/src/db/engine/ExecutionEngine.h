@@ -46,7 +46,8 @@ enum class EngineType {
     FAISS_BIN_IVFFLAT,
     HNSW,
     ANNOY,
-    MAX_VALUE = ANNOY,
+    FAISS_BIN_HNSW,
+    MAX_VALUE = FAISS_BIN_HNSW,
 };
 
 enum class MetricType {
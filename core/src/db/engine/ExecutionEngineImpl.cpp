@@ -89,7 +89,8 @@ MappingMetricType(MetricType metric_type, milvus::json& conf) {
 
 bool
 IsBinaryIndexType(knowhere::IndexType type) {
-    return type == knowhere::IndexEnum::INDEX_FAISS_BIN_IDMAP || type == knowhere::IndexEnum::INDEX_FAISS_BIN_IVFFLAT;
+    return type == knowhere::IndexEnum::INDEX_FAISS_BIN_IDMAP || type == knowhere::IndexEnum::INDEX_FAISS_BIN_IVFFLAT ||
+           type == knowhere::IndexEnum::INDEX_FAISS_BIN_HNSW;
 }
 
 }  // namespace
@@ -204,6 +205,10 @@ ExecutionEngineImpl::CreatetVecIndex(EngineType type) {
             index = vec_index_factory.CreateVecIndex(knowhere::IndexEnum::INDEX_FAISS_BIN_IVFFLAT, mode);
             break;
         }
+        case EngineType::FAISS_BIN_HNSW: {
+            index = vec_index_factory.CreateVecIndex(knowhere::IndexEnum::INDEX_FAISS_BIN_HNSW, mode);
+            break;
+        }
         case EngineType::NSG_MIX: {
             index = vec_index_factory.CreateVecIndex(knowhere::IndexEnum::INDEX_NSG, mode);
             break;
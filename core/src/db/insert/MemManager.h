@@ -33,6 +33,11 @@ class MemManager {
     InsertVectors(const std::string& collection_id, int64_t length, const IDNumber* vector_ids, int64_t dim,
                   const uint8_t* vectors, uint64_t lsn, std::set<std::string>& flushed_tables) = 0;
 
+    // Takes over the ids and float/binary payload of vectors instead of copying them
+    virtual Status
+    InsertVectors(const std::string& collection_id, VectorsData&& vectors, uint64_t lsn,
+                  std::set<std::string>& flushed_tables) = 0;
+
     virtual Status
     InsertEntities(const std::string& table_id, int64_t length, const IDNumber* vector_ids, int64_t dim,
                    const float* vectors, const std::unordered_map<std::string, uint64_t>& attr_nbytes,
@@ -13,6 +13,7 @@
 
 #include <fiu-local.h>
 #include <thread>
+#include <utility>
 
 #include "VectorSource.h"
 #include "db/Constants.h"
@@ -51,7 +52,7 @@ MemManagerImpl::InsertVectors(const std::string& collection_id, int64_t length,
     memcpy(vectors_data.float_data_.data(), vectors, length * dim * sizeof(float));
     vectors_data.id_array_.resize(length);
     memcpy(vectors_data.id_array_.data(), vector_ids, length * sizeof(IDNumber));
-    VectorSourcePtr source = std::make_shared<VectorSource>(vectors_data);
+    VectorSourcePtr source = std::make_shared<VectorSource>(std::move(vectors_data));
 
     std::unique_lock<std::mutex> lock(mutex_);
 
@@ -79,7 +80,28 @@ MemManagerImpl::InsertVectors(const std::string& collection_id, int64_t length,
     memcpy(vectors_data.binary_data_.data(), vectors, length * dim * sizeof(uint8_t));
     vectors_data.id_array_.resize(length);
     memcpy(vectors_data.id_array_.data(), vector_ids, length * sizeof(IDNumber));
-    VectorSourcePtr source = std::make_shared<VectorSource>(vectors_data);
+    VectorSourcePtr source = std::make_shared<VectorSource>(std::move(vectors_data));
+
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    return InsertVectorsNoLock(collection_id, source, lsn);
+}
+
+Status
+MemManagerImpl::InsertVectors(const std::string& collection_id, VectorsData&& vectors, uint64_t lsn,
+                              std::set<std::string>& flushed_tables) {
+    flushed_tables.clear();
+    if (GetCurrentMem() > options_.insert_buffer_size_) {
+        LOG_ENGINE_DEBUG_ << LogOut("[%s][%ld] ", "insert", 0)
+                          << "Insert buffer size exceeds limit. Performing force flush";
+        auto status = Flush(flushed_tables, false);
+        if (!status.ok()) {
+            LOG_ENGINE_DEBUG_ << LogOut("[%s][%ld] ", "insert", 0) << "Flush fail: " << status.message();
+            return status;
+        }
+    }
+
+    VectorSourcePtr source = std::make_shared<VectorSource>(std::move(vectors));
 
     std::unique_lock<std::mutex> lock(mutex_);
 
@@ -110,7 +132,7 @@ MemManagerImpl::InsertEntities(const std::string& table_id, int64_t length, cons
     vectors_data.id_array_.resize(length);
     memcpy(vectors_data.id_array_.data(), vector_ids, length * sizeof(IDNumber));
 
-    VectorSourcePtr source = std::make_shared<VectorSource>(vectors_data, attr_nbytes, attr_size, attr_data);
+    VectorSourcePtr source = std::make_shared<VectorSource>(std::move(vectors_data), attr_nbytes, attr_size, attr_data);
 
     std::unique_lock<std::mutex> lock(mutex_);
 
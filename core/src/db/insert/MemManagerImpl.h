@@ -49,6 +49,10 @@ class MemManagerImpl : public MemManager, public server::CacheConfigHandler {
     InsertVectors(const std::string& collection_id, int64_t length, const IDNumber* vector_ids, int64_t dim,
                   const uint8_t* vectors, uint64_t lsn, std::set<std::string>& flushed_tables) override;
 
+    Status
+    InsertVectors(const std::string& collection_id, VectorsData&& vectors, uint64_t lsn,
+                  std::set<std::string>& flushed_tables) override;
+
     Status
     InsertEntities(const std::string& table_id, int64_t length, const IDNumber* vector_ids, int64_t dim,
                    const float* vectors, const std::unordered_map<std::string, uint64_t>& attr_nbytes,
@@ -373,6 +373,7 @@ MemTable::ApplyDeletes() {
                 segment_file.file_type_ == meta::SegmentSchema::INDEX ||
                 segment_file.file_type_ == meta::SegmentSchema::BACKUP) {
                 segment_file.row_count_ -= delete_count;
+                segment_file.deleted_row_count_ += delete_count;
                 files_to_update.emplace_back(segment_file);
             }
         }
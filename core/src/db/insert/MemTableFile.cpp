@@ -208,6 +208,7 @@ MemTableFile::Serialize(uint64_t wal_lsn) {
     //    table_file_schema_.row_count_ = execution_engine_->Count();
     table_file_schema_.file_size_ = segment_writer_ptr_->Size();
     table_file_schema_.row_count_ = segment_writer_ptr_->VectorCount();
+    server::Metrics::GetInstance().FlushBytesWrittenIncrement(table_file_schema_.file_size_);
 
     // if index type isn't IDMAP, set file type to TO_INDEX if file size exceed index_file_size
     // else set file type to RAW, no need to build index
@@ -67,11 +67,16 @@ VectorSource::Add(const segment::SegmentWriterPtr& segment_writer_ptr, const met
         status = segment_writer_ptr->AddVectors(table_file_schema.file_id_, (uint8_t*)ptr, size, vector_ids_to_add);
     } else if (!vectors_.binary_data_.empty()) {
         LOG_ENGINE_DEBUG_ << LogOut("[%s][%ld]", "insert", 0) << "Insert binary data into segment";
-        std::vector<uint8_t> vectors;
-        auto size = num_vectors_added * SingleVectorSize(table_file_schema.dimension_) * sizeof(uint8_t);
-        uint8_t* ptr =
-            vectors_.binary_data_.data() + current_num_vectors_added * SingleVectorSize(table_file_schema.dimension_);
-        status = segment_writer_ptr->AddVectors(table_file_schema.file_id_, ptr, size, vector_ids_to_add);
+        if (current_num_vectors_added == 0 && num_vectors_added == n) {
+            // the whole source fits into this segment, hand the buffer over instead of copying it
+            status = segment_writer_ptr->AddVectors(table_file_schema.file_id_, std::move(vectors_.binary_data_),
+                                                    vector_ids_to_add);
+        } else {
+            auto size = num_vectors_added * SingleVectorSize(table_file_schema.dimension_) * sizeof(uint8_t);
+            uint8_t* ptr = vectors_.binary_data_.data() +
+                           current_num_vectors_added * SingleVectorSize(table_file_schema.dimension_);
+            status = segment_writer_ptr->AddVectors(table_file_schema.file_id_, ptr, size, vector_ids_to_add);
+        }
     }
 
     // Clear vector data
@@ -0,0 +1,157 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+
+#include "db/merge/MergeCostStrategy.h"
+#include "db/Utils.h"
+#include "segment/SegmentReader.h"
+#include "utils/Log.h"
+
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace milvus {
+namespace engine {
+
+namespace {
+
+constexpr std::chrono::seconds MERGE_BUDGET_WINDOW(60);
+
+// large segments with few deletes are left to index building, rewriting them gains little
+constexpr double LARGE_SEGMENT_RATIO = 0.5;
+constexpr double TOMBSTONE_RATIO_THRESHOLD = 0.2;
+
+// a merge must remove at least one segment, or its equivalent in tombstones, per full segment rewritten
+constexpr double MIN_MERGE_SCORE = 1.0;
+constexpr double MIN_MERGE_COST = 0.01;
+
+}  // namespace
+
+MergeCostStrategy::MergeCostStrategy(int64_t io_rate_limit)
+    : io_budget_(io_rate_limit * MERGE_BUDGET_WINDOW.count()), window_start_(std::chrono::steady_clock::now()) {
+}
+
+double
+MergeCostStrategy::Score(const CandidateGroup& group, int64_t index_file_size) {
+    if (group.empty() || index_file_size <= 0) {
+        return 0.0;
+    }
+
+    double gain = group.size() - 1;
+    int64_t rewrite_bytes = 0;
+    for (auto& candidate : group) {
+        gain += candidate.deleted_ratio;
+        rewrite_bytes += candidate.live_size;
+    }
+    double cost = std::max((double)rewrite_bytes / index_file_size, MIN_MERGE_COST);
+    return gain / cost;
+}
+
+double
+MergeCostStrategy::DeletedRatio(const meta::SegmentSchema& file) {
+    std::string segment_dir;
+    utils::GetParentPath(file.location_, segment_dir);
+    segment::SegmentReader segment_reader(segment_dir);
+    size_t deleted_count = 0;
+    auto status = segment_reader.ReadDeletedDocsSize(deleted_count);
+    if (!status.ok() || deleted_count == 0) {
+        return 0.0;
+    }
+
+    // row_count_ of meta excludes deleted rows
+    return (double)deleted_count / (file.row_count_ + deleted_count);
+}
+
+Status
+MergeCostStrategy::RegroupFiles(meta::FilesHolder& files_holder, MergeFilesGroups& files_groups) {
+    meta::SegmentsSchema ignore_files;
+    std::vector<Candidate> candidates;
+    int64_t index_file_size = 0;
+    for (auto& file : files_holder.HoldFiles()) {
+        Candidate candidate;
+        candidate.file = file;
+        candidate.deleted_ratio = DeletedRatio(file);
+        candidate.live_size = (int64_t)(file.file_size_ * (1.0 - candidate.deleted_ratio));
+
+        bool settled = candidate.live_size >= file.index_file_size_ * LARGE_SEGMENT_RATIO &&
+                       candidate.deleted_ratio < TOMBSTONE_RATIO_THRESHOLD;
+        if (file.file_type_ != meta::SegmentSchema::RAW || settled) {
+            ignore_files.push_back(file);
+            continue;
+        }
+        index_file_size = file.index_file_size_;
+        candidates.emplace_back(std::move(candidate));
+    }
+
+    // smallest segments first, they remove the most fan-out per byte rewritten
+    std::sort(candidates.begin(), candidates.end(),
+              [](const Candidate& left, const Candidate& right) { return left.live_size < right.live_size; });
+
+    std::vector<std::pair<double, CandidateGroup>> scored_groups;
+    CandidateGroup group;
+    int64_t group_size = 0;
+    auto close_group = [&]() {
+        if (!group.empty()) {
+            scored_groups.emplace_back(Score(group, index_file_size), std::move(group));
+            group.clear();
+            group_size = 0;
+        }
+    };
+    for (auto& candidate : candidates) {
+        if (!group.empty() && group_size + candidate.live_size > index_file_size) {
+            close_group();
+        }
+        group_size += candidate.live_size;
+        group.emplace_back(std::move(candidate));
+    }
+    close_group();
+
+    std::stable_sort(scored_groups.begin(), scored_groups.end(),
+                     [](const std::pair<double, CandidateGroup>& left, const std::pair<double, CandidateGroup>& right) {
+                         return left.first > right.first;
+                     });
+
+    std::lock_guard<std::mutex> lock(budget_mutex_);
+    auto now = std::chrono::steady_clock::now();
+    if (now - window_start_ >= MERGE_BUDGET_WINDOW) {
+        window_start_ = now;
+        window_bytes_ = 0;
+    }
+
+    for (auto& scored_group : scored_groups) {
+        int64_t rewrite_bytes = 0;
+        meta::SegmentsSchema files;
+        for (auto& candidate : scored_group.second) {
+            rewrite_bytes += candidate.live_size;
+            files.push_back(candidate.file);
+        }
+
+        // the first group of a window always runs, so a small budget cannot stall merging
+        bool over_budget = io_budget_ > 0 && window_bytes_ > 0 && window_bytes_ + rewrite_bytes > io_budget_;
+        if (scored_group.first < MIN_MERGE_SCORE || over_budget) {
+            ignore_files.insert(ignore_files.end(), files.begin(), files.end());
+            continue;
+        }
+
+        LOG_ENGINE_DEBUG_ << "Merge " << files.size() << " files, score " << scored_group.first << ", rewrite "
+                          << rewrite_bytes << " bytes";
+        window_bytes_ += rewrite_bytes;
+        files_groups.emplace_back(std::move(files));
+    }
+
+    files_holder.UnmarkFiles(ignore_files);
+    return Status::OK();
+}
+
+}  // namespace engine
+}  // namespace milvus
@@ -0,0 +1,58 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <chrono>
+#include <mutex>
+#include <vector>
+
+#include "db/merge/MergeStrategy.h"
+#include "utils/Status.h"
+
+namespace milvus {
+namespace engine {
+
+// Scores candidate merges by segments removed from query fan-out and tombstones reclaimed,
+// against bytes rewritten, and keeps the rewritten bytes of each time window under a budget.
+class MergeCostStrategy : public MergeStrategy {
+ public:
+    struct Candidate {
+        meta::SegmentSchema file;
+        double deleted_ratio = 0.0;
+        int64_t live_size = 0;
+    };
+    using CandidateGroup = std::vector<Candidate>;
+
+    // io_rate_limit: bytes per second allowed to be rewritten, averaged over a window, 0 means no limit
+    explicit MergeCostStrategy(int64_t io_rate_limit = 0);
+
+    Status
+    RegroupFiles(meta::FilesHolder& files_holder, MergeFilesGroups& files_groups) override;
+
+    static double
+    Score(const CandidateGroup& group, int64_t index_file_size);
+
+ protected:
+    // ratio of deleted rows in the segment, read from its deleted docs file
+    virtual double
+    DeletedRatio(const meta::SegmentSchema& file);
+
+ private:
+    int64_t io_budget_ = 0;
+
+    std::mutex budget_mutex_;
+    std::chrono::steady_clock::time_point window_start_;
+    int64_t window_bytes_ = 0;
+};  // MergeCostStrategy
+
+}  // namespace engine
+}  // namespace milvus
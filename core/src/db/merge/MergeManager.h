@@ -42,6 +42,7 @@ enum class MergeStrategyType {
     SIMPLE = 1,
     LAYERED = 2,
     ADAPTIVE = 3,
+    COST = 4,
 };
 
 class MergeManager {
@@ -52,8 +53,9 @@ class MergeManager {
     virtual Status
     UseStrategy(MergeStrategyType type) = 0;
 
+    // adds the number of raw segments below index_file_size found for the collection to merge_candidates
     virtual Status
-    MergeFiles(const std::string& collection_id) = 0;
+    MergeFiles(const std::string& collection_id, uint64_t& merge_candidates) = 0;
 };  // MergeManager
 
 using MergeManagerPtr = std::shared_ptr<MergeManager>;
@@ -19,7 +19,16 @@ namespace engine {
 
 MergeManagerPtr
 MergeManagerFactory::Build(const meta::MetaPtr& meta_ptr, const DBOptions& options) {
-    return std::make_shared<MergeManagerImpl>(meta_ptr, options, MergeStrategyType::LAYERED);
+    MergeStrategyType type = MergeStrategyType::LAYERED;
+    if (options.merge_strategy_ == "simple") {
+        type = MergeStrategyType::SIMPLE;
+    } else if (options.merge_strategy_ == "adaptive") {
+        type = MergeStrategyType::ADAPTIVE;
+    } else if (options.merge_strategy_ == "cost") {
+        type = MergeStrategyType::COST;
+    }
+
+    return std::make_shared<MergeManagerImpl>(meta_ptr, options, type);
 }
 
 }  // namespace engine
@@ -11,6 +11,7 @@
 
 #include "db/merge/MergeManagerImpl.h"
 #include "db/merge/MergeAdaptiveStrategy.h"
+#include "db/merge/MergeCostStrategy.h"
 #include "db/merge/MergeLayeredStrategy.h"
 #include "db/merge/MergeSimpleStrategy.h"
 #include "db/merge/MergeStrategy.h"
@@ -41,6 +42,13 @@ MergeManagerImpl::UseStrategy(MergeStrategyType type) {
             strategy_ = std::make_shared<MergeAdaptiveStrategy>();
             break;
         }
+        case MergeStrategyType::COST: {
+            if (cost_strategy_ == nullptr) {
+                cost_strategy_ = std::make_shared<MergeCostStrategy>(options_.merge_io_rate_limit_);
+            }
+            strategy_ = cost_strategy_;
+            break;
+        }
         default: {
             std::string msg = "Unsupported merge strategy type: " + std::to_string((int32_t)type);
             LOG_ENGINE_ERROR_ << msg;
@@ -53,7 +61,7 @@ MergeManagerImpl::UseStrategy(MergeStrategyType type) {
 }
 
 Status
-MergeManagerImpl::MergeFiles(const std::string& collection_id) {
+MergeManagerImpl::MergeFiles(const std::string& collection_id, uint64_t& merge_candidates) {
     if (strategy_ == nullptr) {
         std::string msg = "No merge strategy specified";
         LOG_ENGINE_ERROR_ << msg;
@@ -67,6 +75,7 @@ MergeManagerImpl::MergeFiles(const std::string& collection_id) {
         return status;
     }
 
+    merge_candidates += files_holder.HoldFiles().size();
     if (files_holder.HoldFiles().size() < 2) {
         return Status::OK();
     }
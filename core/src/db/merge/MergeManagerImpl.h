@@ -40,7 +40,7 @@ class MergeManagerImpl : public MergeManager {
     UseStrategy(MergeStrategyType type) override;
 
     Status
-    MergeFiles(const std::string& collection_id) override;
+    MergeFiles(const std::string& collection_id, uint64_t& merge_candidates) override;
 
  private:
     meta::MetaPtr meta_ptr_;
@@ -48,6 +48,9 @@ class MergeManagerImpl : public MergeManager {
 
     MergeStrategyType strategy_type_ = MergeStrategyType::SIMPLE;
     MergeStrategyPtr strategy_;
+
+    // kept across strategy switches, it holds the merge io budget of current window
+    MergeStrategyPtr cost_strategy_;
 };  // MergeManagerImpl
 
 }  // namespace engine
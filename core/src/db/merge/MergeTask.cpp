@@ -18,6 +18,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace milvus {
 namespace engine {
@@ -57,36 +58,39 @@ MergeTask::Execute() {
     utils::GetParentPath(collection_file.location_, new_segment_dir);
     auto segment_writer_ptr = std::make_shared<segment::SegmentWriter>(new_segment_dir);
 
-    // attention: here is a copy, not reference, since files_holder.UnmarkFile will change the array internal
+    // step 2: merge files, rows are streamed to disk so memory stays bounded by the chunk size
+    std::vector<std::string> segment_dirs_to_merge;
     std::string info = "Merge task files size info:";
     for (auto& file : files_) {
         info += std::to_string(file.file_size_);
         info += ", ";
 
-        server::CollectMergeFilesMetrics metrics;
         std::string segment_dir_to_merge;
         utils::GetParentPath(file.location_, segment_dir_to_merge);
-        segment_writer_ptr->Merge(segment_dir_to_merge, collection_file.file_id_);
-
-        auto file_schema = file;
-        file_schema.file_type_ = meta::SegmentSchema::TO_DELETE;
-        updated.push_back(file_schema);
-        int64_t size = segment_writer_ptr->Size();
-        if (size >= file_schema.index_file_size_) {
-            break;
-        }
+        segment_dirs_to_merge.push_back(segment_dir_to_merge);
     }
     LOG_ENGINE_DEBUG_ << info;
 
-    // step 3: serialize to disk
+    // step 3: write merged segment to disk
+    size_t merged_count = 0;
     try {
-        status = segment_writer_ptr->Serialize();
+        server::CollectMergeFilesMetrics metrics;
+        status = segment_writer_ptr->Merge(segment_dirs_to_merge, collection_file.file_id_,
+                                           files_.front().index_file_size_, options_.merge_io_rate_limit_,
+                                           merged_count);
     } catch (std::exception& ex) {
-        std::string msg = "Serialize merged index encounter exception: " + std::string(ex.what());
+        std::string msg = "Merge files encounter exception: " + std::string(ex.what());
         LOG_ENGINE_ERROR_ << msg;
         status = Status(DB_ERROR, msg);
     }
 
+    // attention: here is a copy, not reference, since files_holder.UnmarkFile will change the array internal
+    for (size_t i = 0; i < merged_count && i < files_.size(); ++i) {
+        auto file_schema = files_[i];
+        file_schema.file_type_ = meta::SegmentSchema::TO_DELETE;
+        updated.push_back(file_schema);
+    }
+
     if (!status.ok()) {
         LOG_ENGINE_ERROR_ << "Failed to persist merged segment: " << new_segment_dir << ". Error: " << status.message();
 
@@ -112,6 +116,7 @@ MergeTask::Execute() {
     }
     collection_file.file_size_ = segment_writer_ptr->Size();
     collection_file.row_count_ = segment_writer_ptr->VectorCount();
+    server::Metrics::GetInstance().MergeBytesWrittenIncrement(collection_file.file_size_);
     updated.push_back(collection_file);
     status = meta_ptr_->UpdateCollectionFiles(updated);
     LOG_ENGINE_DEBUG_ << "New merged segment " << collection_file.segment_id_ << " of size "
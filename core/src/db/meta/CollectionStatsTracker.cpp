@@ -0,0 +1,304 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "db/meta/CollectionStatsTracker.h"
+
+#include <algorithm>
+
+namespace milvus {
+namespace engine {
+namespace meta {
+
+namespace {
+
+void
+Adjust(uint64_t& value, uint64_t delta, bool add) {
+    if (add) {
+        value += delta;
+    } else {
+        value = (value > delta) ? value - delta : 0;
+    }
+}
+
+void
+AccumulateFile(CollectionStats& stats, const SegmentStats& file, bool add) {
+    if (CollectionStatsTracker::IsSearchable(file.file_type_)) {
+        Adjust(stats.row_count_, file.row_count_, add);
+        Adjust(stats.deleted_row_count_, file.deleted_row_count_, add);
+        Adjust(stats.data_size_, file.data_size_, add);
+    }
+
+    auto& count = stats.segment_count_[file.file_type_];
+    Adjust(count, 1, add);
+    if (count == 0) {
+        stats.segment_count_.erase(file.file_type_);
+    }
+}
+
+void
+AccumulateStats(CollectionStats& stats, const CollectionStats& delta, bool add) {
+    Adjust(stats.row_count_, delta.row_count_, add);
+    Adjust(stats.deleted_row_count_, delta.deleted_row_count_, add);
+    Adjust(stats.data_size_, delta.data_size_, add);
+    for (auto& pair : delta.segment_count_) {
+        auto& count = stats.segment_count_[pair.first];
+        Adjust(count, pair.second, add);
+        if (count == 0) {
+            stats.segment_count_.erase(pair.first);
+        }
+    }
+}
+
+SegmentStats
+ToSegmentStats(const SegmentSchema& file) {
+    SegmentStats stats;
+    stats.segment_id_ = file.segment_id_;
+    stats.file_id_ = file.file_id_;
+    stats.file_type_ = file.file_type_;
+    stats.engine_type_ = file.engine_type_;
+    stats.row_count_ = file.row_count_;
+    stats.deleted_row_count_ = file.deleted_row_count_;
+    stats.data_size_ = file.file_size_;
+    return stats;
+}
+
+}  // namespace
+
+bool
+CollectionStatsTracker::IsSearchable(int32_t file_type) {
+    return file_type == (int32_t)SegmentSchema::RAW || file_type == (int32_t)SegmentSchema::TO_INDEX ||
+           file_type == (int32_t)SegmentSchema::INDEX;
+}
+
+void
+CollectionStatsTracker::AddCollection(const CollectionSchema& collection_schema) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    RemoveCollectionNoLock(collection_schema.collection_id_);
+
+    Entry& entry = entries_[collection_schema.collection_id_];
+    entry.owner_ = collection_schema.owner_collection_;
+    entry.own_.collection_id_ = collection_schema.collection_id_;
+    entry.own_.partition_tag_ = collection_schema.partition_tag_;
+    entry.total_ = entry.own_;
+
+    if (!entry.owner_.empty()) {
+        auto iter = entries_.find(entry.owner_);
+        if (iter != entries_.end()) {
+            iter->second.partitions_.push_back(collection_schema.collection_id_);
+        }
+    }
+}
+
+void
+CollectionStatsTracker::RemoveCollection(const std::string& collection_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    RemoveCollectionNoLock(collection_id);
+}
+
+bool
+CollectionStatsTracker::HasCollection(const std::string& collection_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.find(collection_id) != entries_.end();
+}
+
+void
+CollectionStatsTracker::UpdateFile(const SegmentSchema& file) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = entries_.find(file.collection_id_);
+    if (iter == entries_.end()) {
+        return;
+    }
+
+    SetFileNoLock(iter->second, ToSegmentStats(file));
+}
+
+void
+CollectionStatsTracker::UpdateFileRowCount(const std::string& collection_id, const std::string& file_id,
+                                           uint64_t row_count, uint64_t deleted_row_count) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = entries_.find(collection_id);
+    if (iter == entries_.end()) {
+        return;
+    }
+
+    auto file_iter = iter->second.files_.find(file_id);
+    if (file_iter == iter->second.files_.end()) {
+        return;
+    }
+
+    SegmentStats file = file_iter->second;
+    file.row_count_ = row_count;
+    file.deleted_row_count_ = deleted_row_count;
+    SetFileNoLock(iter->second, file);
+}
+
+void
+CollectionStatsTracker::RemoveFile(const std::string& collection_id, const std::string& file_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = entries_.find(collection_id);
+    if (iter == entries_.end()) {
+        return;
+    }
+
+    Entry& entry = iter->second;
+    auto file_iter = entry.files_.find(file_id);
+    if (file_iter != entry.files_.end()) {
+        ApplyFile(entry, file_iter->second, false);
+        entry.files_.erase(file_iter);
+    }
+}
+
+void
+CollectionStatsTracker::ResetFiles(const std::string& collection_id, const SegmentsStats& files) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = entries_.find(collection_id);
+    if (iter == entries_.end()) {
+        return;
+    }
+
+    Entry& entry = iter->second;
+    std::unordered_map<std::string, SegmentStats> new_files;
+    for (auto& file : files) {
+        new_files[file.file_id_] = file;
+    }
+
+    for (auto& pair : entry.files_) {
+        ApplyFile(entry, pair.second, false);
+    }
+    entry.files_.swap(new_files);
+    for (auto& pair : entry.files_) {
+        ApplyFile(entry, pair.second, true);
+    }
+}
+
+std::vector<std::string>
+CollectionStatsTracker::Collections() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<std::string> collection_ids;
+    collection_ids.reserve(entries_.size());
+    for (auto& pair : entries_) {
+        collection_ids.push_back(pair.first);
+    }
+    return collection_ids;
+}
+
+void
+CollectionStatsTracker::Clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+}
+
+bool
+CollectionStatsTracker::GetCollectionStats(const std::string& collection_id, CollectionStats& stats) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = entries_.find(collection_id);
+    if (iter == entries_.end()) {
+        return false;
+    }
+
+    stats = iter->second.own_;
+    return true;
+}
+
+bool
+CollectionStatsTracker::GetCollectionStats(const std::string& collection_id, CollectionStats& stats,
+                                           std::vector<CollectionStats>& partitions_stats) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = entries_.find(collection_id);
+    if (iter == entries_.end()) {
+        return false;
+    }
+
+    Entry& entry = iter->second;
+    stats = entry.owner_.empty() ? entry.total_ : entry.own_;
+
+    partitions_stats.clear();
+    partitions_stats.push_back(entry.own_);
+    for (auto& partition_id : entry.partitions_) {
+        auto partition_iter = entries_.find(partition_id);
+        if (partition_iter != entries_.end()) {
+            partitions_stats.push_back(partition_iter->second.own_);
+        }
+    }
+    return true;
+}
+
+bool
+CollectionStatsTracker::GetSegmentsStats(const std::string& collection_id, SegmentsStats& segments_stats) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = entries_.find(collection_id);
+    if (iter == entries_.end()) {
+        return false;
+    }
+
+    segments_stats.clear();
+    segments_stats.reserve(iter->second.files_.size());
+    for (auto& pair : iter->second.files_) {
+        segments_stats.push_back(pair.second);
+    }
+    std::sort(segments_stats.begin(), segments_stats.end(),
+              [](const SegmentStats& a, const SegmentStats& b) { return a.file_id_ < b.file_id_; });
+    return true;
+}
+
+void
+CollectionStatsTracker::ApplyFile(Entry& entry, const SegmentStats& file, bool add) {
+    AccumulateFile(entry.own_, file, add);
+    if (entry.owner_.empty()) {
+        AccumulateFile(entry.total_, file, add);
+        return;
+    }
+
+    auto iter = entries_.find(entry.owner_);
+    if (iter != entries_.end()) {
+        AccumulateFile(iter->second.total_, file, add);
+    }
+}
+
+void
+CollectionStatsTracker::SetFileNoLock(Entry& entry, const SegmentStats& file) {
+    auto iter = entry.files_.find(file.file_id_);
+    if (iter != entry.files_.end()) {
+        ApplyFile(entry, iter->second, false);
+    }
+
+    ApplyFile(entry, file, true);
+    entry.files_[file.file_id_] = file;
+}
+
+void
+CollectionStatsTracker::RemoveCollectionNoLock(const std::string& collection_id) {
+    auto iter = entries_.find(collection_id);
+    if (iter == entries_.end()) {
+        return;
+    }
+
+    Entry& entry = iter->second;
+    if (entry.owner_.empty()) {
+        for (auto& partition_id : entry.partitions_) {
+            entries_.erase(partition_id);
+        }
+    } else {
+        auto owner_iter = entries_.find(entry.owner_);
+        if (owner_iter != entries_.end()) {
+            Entry& owner = owner_iter->second;
+            AccumulateStats(owner.total_, entry.own_, false);
+            owner.partitions_.erase(std::remove(owner.partitions_.begin(), owner.partitions_.end(), collection_id),
+                                    owner.partitions_.end());
+        }
+    }
+
+    entries_.erase(collection_id);
+}
+
+}  // namespace meta
+}  // namespace engine
+}  // namespace milvus
@@ -0,0 +1,99 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "db/meta/MetaTypes.h"
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace milvus {
+namespace engine {
+namespace meta {
+
+// In-memory mirror of per-collection file statistics. The meta implementation feeds it every file change
+// right after the change is persisted, so row counts and segment counts can be served without a query.
+// A root collection also keeps the totals of its partitions.
+class CollectionStatsTracker {
+ public:
+    void
+    AddCollection(const CollectionSchema& collection_schema);
+
+    // drop a collection, its partitions are dropped together
+    void
+    RemoveCollection(const std::string& collection_id);
+
+    bool
+    HasCollection(const std::string& collection_id);
+
+    // insert or update a file
+    void
+    UpdateFile(const SegmentSchema& file);
+
+    void
+    UpdateFileRowCount(const std::string& collection_id, const std::string& file_id, uint64_t row_count,
+                       uint64_t deleted_row_count);
+
+    void
+    RemoveFile(const std::string& collection_id, const std::string& file_id);
+
+    // replace all files of a collection
+    void
+    ResetFiles(const std::string& collection_id, const SegmentsStats& files);
+
+    std::vector<std::string>
+    Collections();
+
+    void
+    Clear();
+
+    bool
+    GetCollectionStats(const std::string& collection_id, CollectionStats& stats);
+
+    bool
+    GetCollectionStats(const std::string& collection_id, CollectionStats& stats,
+                       std::vector<CollectionStats>& partitions_stats);
+
+    bool
+    GetSegmentsStats(const std::string& collection_id, SegmentsStats& segments_stats);
+
+    static bool
+    IsSearchable(int32_t file_type);
+
+ private:
+    struct Entry {
+        std::string owner_;
+        std::vector<std::string> partitions_;
+        CollectionStats own_;
+        CollectionStats total_;                                // own_ plus partitions, for root collections
+        std::unordered_map<std::string, SegmentStats> files_;  // file id mapping to file stats
+    };
+
+    void
+    ApplyFile(Entry& entry, const SegmentStats& file, bool add);
+
+    void
+    SetFileNoLock(Entry& entry, const SegmentStats& file);
+
+    void
+    RemoveCollectionNoLock(const std::string& collection_id);
+
+ private:
+    std::mutex mutex_;
+    std::unordered_map<std::string, Entry> entries_;
+};
+
+}  // namespace meta
+}  // namespace engine
+}  // namespace milvus
@@ -44,16 +44,21 @@ FilesHolder::OngoingFileChecker::MarkOngoingFiles(const meta::SegmentsSchema& ta
 
 Status
 FilesHolder::OngoingFileChecker::UnmarkOngoingFile(const meta::SegmentSchema& table_file) {
+    if (table_file.collection_id_.empty() || table_file.file_id_.empty()) {
+        return Status(DB_ERROR, "Invalid collection files");
+    }
+
     std::lock_guard<std::mutex> lck(mutex_);
-    return UnmarkOngoingFileNoLock(table_file);
+    UnmarkOngoingFileNoLock(table_file.collection_id_, table_file.id_);
+    return Status::OK();
 }
 
 Status
-FilesHolder::OngoingFileChecker::UnmarkOngoingFiles(const meta::SegmentsSchema& table_files) {
+FilesHolder::OngoingFileChecker::UnmarkOngoingFiles(const std::map<uint64_t, std::string>& files) {
     std::lock_guard<std::mutex> lck(mutex_);
 
-    for (auto& table_file : table_files) {
-        UnmarkOngoingFileNoLock(table_file);
+    for (auto& pair : files) {
+        UnmarkOngoingFileNoLock(pair.second, pair.first);
     }
 
     return Status::OK();
@@ -113,30 +118,24 @@ FilesHolder::OngoingFileChecker::MarkOngoingFileNoLock(const meta::SegmentSchema
     return Status::OK();
 }
 
-Status
-FilesHolder::OngoingFileChecker::UnmarkOngoingFileNoLock(const meta::SegmentSchema& table_file) {
-    if (table_file.collection_id_.empty() || table_file.file_id_.empty()) {
-        return Status(DB_ERROR, "Invalid collection files");
-    }
-
-    auto iter = ongoing_files_.find(table_file.collection_id_);
+void
+FilesHolder::OngoingFileChecker::UnmarkOngoingFileNoLock(const std::string& collection_id, uint64_t file_id) {
+    auto iter = ongoing_files_.find(collection_id);
     if (iter != ongoing_files_.end()) {
-        auto it_file = iter->second.find(table_file.id_);
+        auto it_file = iter->second.find(file_id);
         if (it_file != iter->second.end()) {
             it_file->second--;
 
-            LOG_ENGINE_DEBUG_ << "Unmark ongoing file:" << table_file.file_id_ << " refcount:" << it_file->second;
+            LOG_ENGINE_DEBUG_ << "Unmark ongoing file id:" << file_id << " refcount:" << it_file->second;
 
             if (it_file->second <= 0) {
-                iter->second.erase(table_file.id_);
+                iter->second.erase(it_file);
                 if (iter->second.empty()) {
-                    ongoing_files_.erase(table_file.collection_id_);
+                    ongoing_files_.erase(iter);
                 }
             }
         }
     }
-
-    return Status::OK();
 }
 
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -153,6 +152,12 @@ FilesHolder::MarkFile(const meta::SegmentSchema& file) {
     return MarkFileInternal(file);
 }
 
+Status
+FilesHolder::MarkFile(meta::SegmentSchema&& file) {
+    std::lock_guard<std::mutex> lck(mutex_);
+    return MarkFileInternal(std::move(file));
+}
+
 Status
 FilesHolder::MarkFiles(const meta::SegmentsSchema& files) {
     std::lock_guard<std::mutex> lck(mutex_);
@@ -179,12 +184,24 @@ FilesHolder::UnmarkFiles(const meta::SegmentsSchema& files) {
     return Status::OK();
 }
 
+std::vector<SegmentSchemaPtr>
+FilesHolder::ShareFiles() {
+    std::lock_guard<std::mutex> lck(mutex_);
+    std::vector<SegmentSchemaPtr> files;
+    files.reserve(hold_files_.size());
+    for (auto& file : hold_files_) {
+        files.emplace_back(std::make_shared<meta::SegmentSchema>(std::move(file)));
+    }
+    hold_files_.clear();
+    return files;
+}
+
 void
 FilesHolder::ReleaseFiles() {
     std::lock_guard<std::mutex> lck(mutex_);
-    OngoingFileChecker::GetInstance().UnmarkOngoingFiles(hold_files_);
+    OngoingFileChecker::GetInstance().UnmarkOngoingFiles(marked_files_);
     hold_files_.clear();
-    unique_ids_.clear();
+    marked_files_.clear();
 }
 
 bool
@@ -197,16 +214,17 @@ FilesHolder::PrintInfo() {
     return OngoingFileChecker::GetInstance().PrintInfo();
 }
 
+template <typename FileT>
 Status
-FilesHolder::MarkFileInternal(const meta::SegmentSchema& file) {
-    if (unique_ids_.find(file.id_) != unique_ids_.end()) {
+FilesHolder::MarkFileInternal(FileT&& file) {
+    if (marked_files_.find(file.id_) != marked_files_.end()) {
         return Status::OK();  // already marked
     }
 
     auto status = OngoingFileChecker::GetInstance().MarkOngoingFile(file);
     if (status.ok()) {
-        unique_ids_.insert(file.id_);
-        hold_files_.push_back(file);
+        marked_files_.insert(std::make_pair(file.id_, file.collection_id_));
+        hold_files_.emplace_back(std::forward<FileT>(file));
     }
 
     return status;
@@ -214,7 +232,7 @@ FilesHolder::MarkFileInternal(const meta::SegmentSchema& file) {
 
 Status
 FilesHolder::UnmarkFileInternal(const meta::SegmentSchema& file) {
-    if (unique_ids_.find(file.id_) == unique_ids_.end()) {
+    if (marked_files_.find(file.id_) == marked_files_.end()) {
         return Status::OK();  // no such file
     }
 
@@ -227,7 +245,7 @@ FilesHolder::UnmarkFileInternal(const meta::SegmentSchema& file) {
             }
         }
 
-        unique_ids_.erase(file.id_);
+        marked_files_.erase(file.id_);
     }
     return status;
 }
@@ -16,8 +16,9 @@
 
 #include <map>
 #include <mutex>
-#include <set>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace milvus {
 namespace engine {
@@ -31,6 +32,9 @@ class FilesHolder {
     Status
     MarkFile(const meta::SegmentSchema& file);
 
+    Status
+    MarkFile(meta::SegmentSchema&& file);
+
     Status
     MarkFiles(const meta::SegmentsSchema& files);
 
@@ -50,6 +54,11 @@ class FilesHolder {
         return hold_files_;
     }
 
+    // Moves the held files out as shared pointers without copying them, e.g. to hand them to a search job.
+    // The files stay marked, by id, until UnmarkFile or ReleaseFiles.
+    std::vector<SegmentSchemaPtr>
+    ShareFiles();
+
     void
     ReleaseFiles();
 
@@ -75,7 +84,7 @@ class FilesHolder {
         UnmarkOngoingFile(const meta::SegmentSchema& file);
 
         Status
-        UnmarkOngoingFiles(const meta::SegmentsSchema& files);
+        UnmarkOngoingFiles(const std::map<uint64_t, std::string>& files);
 
         bool
         CanBeDeleted(const meta::SegmentSchema& file);
@@ -87,8 +96,8 @@ class FilesHolder {
         Status
         MarkOngoingFileNoLock(const meta::SegmentSchema& file);
 
-        Status
-        UnmarkOngoingFileNoLock(const meta::SegmentSchema& file);
+        void
+        UnmarkOngoingFileNoLock(const std::string& collection_id, uint64_t file_id);
 
      private:
         std::mutex mutex_;
@@ -96,8 +105,9 @@ class FilesHolder {
     };
 
  private:
+    template <typename FileT>
     Status
-    MarkFileInternal(const meta::SegmentSchema& file);
+    MarkFileInternal(FileT&& file);
 
     Status
     UnmarkFileInternal(const meta::SegmentSchema& file);
@@ -105,7 +115,7 @@ class FilesHolder {
  private:
     std::mutex mutex_;
     milvus::engine::meta::SegmentsSchema hold_files_;
-    std::set<uint64_t> unique_ids_;
+    std::map<uint64_t, std::string> marked_files_;  // file id mapping to collection id
 };
 
 }  // namespace meta
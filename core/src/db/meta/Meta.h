@@ -163,6 +163,14 @@ class Meta {
     virtual Status
     Count(const std::string& collection_id, uint64_t& result) = 0;
 
+    // stats covers the collection and all its partitions, partitions_stats lists the collection itself first
+    virtual Status
+    GetCollectionStats(const std::string& collection_id, CollectionStats& stats,
+                       std::vector<CollectionStats>& partitions_stats) = 0;
+
+    virtual Status
+    GetSegmentsStats(const std::string& collection_id, SegmentsStats& segments_stats) = 0;
+
     virtual Status
     SetGlobalLastLSN(uint64_t lsn) = 0;
 
@@ -80,6 +80,7 @@ struct SegmentSchema {
     int32_t file_type_ = NEW;
     size_t file_size_ = 0;
     size_t row_count_ = 0;
+    uint64_t deleted_row_count_ = 0;  // rows deleted since the file was written, not counted in row_count_
     DateT date_ = EmptyDate;
     uint16_t dimension_ = 0;
     // TODO(zhiru)
@@ -96,6 +97,27 @@ struct SegmentSchema {
 using SegmentSchemaPtr = std::shared_ptr<meta::SegmentSchema>;
 using SegmentsSchema = std::vector<SegmentSchema>;
 
+struct SegmentStats {
+    std::string segment_id_;
+    std::string file_id_;
+    int32_t file_type_ = SegmentSchema::NEW;
+    int32_t engine_type_ = DEFAULT_ENGINE_TYPE;
+    uint64_t row_count_ = 0;
+    uint64_t deleted_row_count_ = 0;  // rows deleted since the file was written
+    uint64_t data_size_ = 0;
+};  // SegmentStats
+
+using SegmentsStats = std::vector<SegmentStats>;
+
+struct CollectionStats {
+    std::string collection_id_;
+    std::string partition_tag_;
+    uint64_t row_count_ = 0;  // rows of RAW, TO_INDEX and INDEX files
+    uint64_t deleted_row_count_ = 0;
+    uint64_t data_size_ = 0;
+    std::map<int32_t, uint64_t> segment_count_;  // file type mapping to file count
+};  // CollectionStats
+
 using File2RefCount = std::map<uint64_t, int64_t>;
 using Table2FileRef = std::map<std::string, File2RefCount>;
 
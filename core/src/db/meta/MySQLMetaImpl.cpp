@@ -33,6 +33,7 @@
 #include "MetaConsts.h"
 #include "db/IDGenerator.h"
 #include "db/Utils.h"
+#include "db/meta/CollectionStatsTracker.h"
 #include "metrics/Metrics.h"
 #include "utils/CommonUtil.h"
 #include "utils/Exception.h"
@@ -203,6 +204,8 @@ static const MetaSchema TABLEFILES_SCHEMA(META_TABLEFILES, {
                                                                MetaField("created_on", "BIGINT", "NOT NULL"),
                                                                MetaField("date", "INT", "DEFAULT -1 NOT NULL"),
                                                                MetaField("flush_lsn", "BIGINT", "DEFAULT 0 NOT NULL"),
+                                                               MetaField("deleted_row_count", "BIGINT",
+                                                                         "DEFAULT 0 NOT NULL"),
                                                            });
 
 // Fields schema
@@ -226,21 +229,26 @@ MySQLMetaImpl::~MySQLMetaImpl() {
 Status
 MySQLMetaImpl::NextCollectionId(std::string& collection_id) {
     std::lock_guard<std::mutex> lock(genid_mutex_);  // avoid duplicated id
-    std::stringstream ss;
     SafeIDGenerator& id_generator = SafeIDGenerator::GetInstance();
-    ss << id_generator.GetNextIDNumber();
-    collection_id = ss.str();
+    IDNumbers ids;
+    auto status = id_generator.GetNextIDNumbers(1, ids);
+    if (!status.ok()) {
+        return status;
+    }
+    collection_id = std::to_string(ids[0]);
     return Status::OK();
 }
 
 Status
 MySQLMetaImpl::NextFileId(std::string& file_id) {
     std::lock_guard<std::mutex> lock(genid_mutex_);  // avoid duplicated id
-    std::stringstream ss;
-
     SafeIDGenerator& id_generator = SafeIDGenerator::GetInstance();
-    ss << id_generator.GetNextIDNumber();
-    file_id = ss.str();
+    IDNumbers ids;
+    auto status = id_generator.GetNextIDNumbers(1, ids);
+    if (!status.ok()) {
+        return status;
+    }
+    file_id = std::to_string(ids[0]);
     return Status::OK();
 }
 
@@ -295,6 +303,27 @@ MySQLMetaImpl::ValidateMetaSchema() {
         throw Exception(DB_INCOMPATIB_META, "Meta Tables schema is created by Milvus old version");
     }
 
+    // TableFiles written before deleted_row_count existed only lack that column, add it instead of rejecting them
+    bool add_column_failed = false;
+    try {
+        mysqlpp::Query show_statement = connectionPtr->query();
+        show_statement << "SHOW COLUMNS FROM " << META_TABLEFILES << " LIKE " << mysqlpp::quote << "deleted_row_count"
+                       << ";";
+        mysqlpp::StoreQueryResult res = show_statement.store();
+        if (res.num_rows() == 0) {
+            mysqlpp::Query alter_statement = connectionPtr->query();
+            alter_statement << "ALTER TABLE " << META_TABLEFILES
+                            << " ADD COLUMN deleted_row_count BIGINT DEFAULT 0 NOT NULL;";
+            LOG_ENGINE_DEBUG_ << "ValidateMetaSchema: " << alter_statement.str();
+            add_column_failed = !alter_statement.exec();
+        }
+    } catch (std::exception& e) {
+        LOG_ENGINE_DEBUG_ << "Meta collection '" << META_TABLEFILES << "' not exist and will be created";
+    }
+    if (add_column_failed) {
+        throw Exception(DB_META_TRANSACTION_FAILED, "Failed to add deleted_row_count to meta TableFiles");
+    }
+
     // verify TableFiles
     if (!validate_func(TABLEFILES_SCHEMA)) {
         throw Exception(DB_INCOMPATIB_META, "Meta TableFiles schema is created by Milvus old version");
@@ -448,7 +477,10 @@ MySQLMetaImpl::CreateCollection(CollectionSchema& collection_schema) {
             mysqlpp::Query statement = connectionPtr->query();
 
             if (collection_schema.collection_id_.empty()) {
-                NextCollectionId(collection_schema.collection_id_);
+                auto status = NextCollectionId(collection_schema.collection_id_);
+                if (!status.ok()) {
+                    return status;
+                }
             } else {
                 statement << "SELECT state FROM " << META_TABLES << " WHERE table_id = " << mysqlpp::quote
                           << collection_schema.collection_id_ << ";";
@@ -775,13 +807,17 @@ MySQLMetaImpl::CreateCollectionFile(SegmentSchema& file_schema) {
     try {
         server::MetricCollector metric;
 
-        NextFileId(file_schema.file_id_);
+        status = NextFileId(file_schema.file_id_);
+        if (!status.ok()) {
+            return status;
+        }
         if (file_schema.segment_id_.empty()) {
             file_schema.segment_id_ = file_schema.file_id_;
         }
         file_schema.dimension_ = collection_schema.dimension_;
         file_schema.file_size_ = 0;
         file_schema.row_count_ = 0;
+        file_schema.deleted_row_count_ = 0;
         file_schema.created_on_ = utils::GetMicroSecTimeStamp();
         file_schema.updated_time_ = file_schema.created_on_;
         file_schema.index_file_size_ = collection_schema.index_file_size_;
@@ -801,6 +837,7 @@ MySQLMetaImpl::CreateCollectionFile(SegmentSchema& file_schema) {
         std::string created_on = std::to_string(file_schema.created_on_);
         std::string date = std::to_string(file_schema.date_);
         std::string flush_lsn = std::to_string(file_schema.flush_lsn_);
+        std::string deleted_row_count = std::to_string(file_schema.deleted_row_count_);
 
         {
             mysqlpp::ScopedConnection connectionPtr(*mysql_connection_pool_, safe_grab_);
@@ -820,7 +857,8 @@ MySQLMetaImpl::CreateCollectionFile(SegmentSchema& file_schema) {
             statement << "INSERT INTO " << META_TABLEFILES << " VALUES(" << id << ", " << mysqlpp::quote
                       << collection_id << ", " << mysqlpp::quote << segment_id << ", " << engine_type << ", "
                       << mysqlpp::quote << file_id << ", " << file_type << ", " << file_size << ", " << row_count
-                      << ", " << updated_time << ", " << created_on << ", " << date << ", " << flush_lsn << ");";
+                      << ", " << updated_time << ", " << created_on << ", " << date << ", " << flush_lsn << ", "
+                      << deleted_row_count << ");";
 
             LOG_ENGINE_DEBUG_ << "CreateCollectionFile: " << statement.str();
 
@@ -871,7 +909,8 @@ MySQLMetaImpl::GetCollectionFiles(const std::string& collection_id, const std::v
 
             mysqlpp::Query statement = connectionPtr->query();
             statement
-                << "SELECT id, segment_id, engine_type, file_id, file_type, file_size, row_count, date, created_on"
+                << "SELECT id, segment_id, engine_type, file_id, file_type, file_size, row_count, date, created_on,"
+                << " deleted_row_count"
                 << " FROM " << META_TABLEFILES << " WHERE table_id = " << mysqlpp::quote << collection_id << " AND ("
                 << idStr << ")"
                 << " AND file_type <> " << std::to_string(SegmentSchema::TO_DELETE) << ";";
@@ -899,6 +938,7 @@ MySQLMetaImpl::GetCollectionFiles(const std::string& collection_id, const std::v
             file_schema.file_type_ = resRow["file_type"];
             file_schema.file_size_ = resRow["file_size"];
             file_schema.row_count_ = resRow["row_count"];
+            file_schema.deleted_row_count_ = resRow["deleted_row_count"];
             file_schema.date_ = resRow["date"];
             file_schema.created_on_ = resRow["created_on"];
             file_schema.dimension_ = collection_schema.dimension_;
@@ -930,7 +970,7 @@ MySQLMetaImpl::GetCollectionFilesBySegmentId(const std::string& segment_id, File
 
             mysqlpp::Query statement = connectionPtr->query();
             statement << "SELECT id, table_id, segment_id, engine_type, file_id, file_type, file_size, "
-                      << "row_count, date, created_on"
+                      << "row_count, date, created_on, deleted_row_count"
                       << " FROM " << META_TABLEFILES << " WHERE segment_id = " << mysqlpp::quote << segment_id
                       << " AND file_type <> " << std::to_string(SegmentSchema::TO_DELETE) << ";";
 
@@ -960,6 +1000,7 @@ MySQLMetaImpl::GetCollectionFilesBySegmentId(const std::string& segment_id, File
                 file_schema.file_type_ = resRow["file_type"];
                 file_schema.file_size_ = resRow["file_size"];
                 file_schema.row_count_ = resRow["row_count"];
+                file_schema.deleted_row_count_ = resRow["deleted_row_count"];
                 file_schema.date_ = resRow["date"];
                 file_schema.created_on_ = resRow["created_on"];
                 file_schema.dimension_ = collection_schema.dimension_;
@@ -1175,6 +1216,7 @@ MySQLMetaImpl::UpdateCollectionFile(SegmentSchema& file_schema) {
             std::string file_type = std::to_string(file_schema.file_type_);
             std::string file_size = std::to_string(file_schema.file_size_);
             std::string row_count = std::to_string(file_schema.row_count_);
+            std::string deleted_row_count = std::to_string(file_schema.deleted_row_count_);
             std::string updated_time = std::to_string(file_schema.updated_time_);
             std::string created_on = std::to_string(file_schema.created_on_);
             std::string date = std::to_string(file_schema.date_);
@@ -1182,8 +1224,8 @@ MySQLMetaImpl::UpdateCollectionFile(SegmentSchema& file_schema) {
             statement << "UPDATE " << META_TABLEFILES << " SET table_id = " << mysqlpp::quote << collection_id
                       << " ,engine_type = " << engine_type << " ,file_id = " << mysqlpp::quote << file_id
                       << " ,file_type = " << file_type << " ,file_size = " << file_size << " ,row_count = " << row_count
-                      << " ,updated_time = " << updated_time << " ,created_on = " << created_on << " ,date = " << date
-                      << " WHERE id = " << id << ";";
+                      << " ,deleted_row_count = " << deleted_row_count << " ,updated_time = " << updated_time
+                      << " ,created_on = " << created_on << " ,date = " << date << " WHERE id = " << id << ";";
 
             LOG_ENGINE_DEBUG_ << "UpdateCollectionFile: " << statement.str();
 
@@ -1291,6 +1333,7 @@ MySQLMetaImpl::UpdateCollectionFiles(SegmentsSchema& files) {
                 std::string file_type = std::to_string(file_schema.file_type_);
                 std::string file_size = std::to_string(file_schema.file_size_);
                 std::string row_count = std::to_string(file_schema.row_count_);
+                std::string deleted_row_count = std::to_string(file_schema.deleted_row_count_);
                 std::string updated_time = std::to_string(file_schema.updated_time_);
                 std::string created_on = std::to_string(file_schema.created_on_);
                 std::string date = std::to_string(file_schema.date_);
@@ -1298,7 +1341,8 @@ MySQLMetaImpl::UpdateCollectionFiles(SegmentsSchema& files) {
                 statement << "UPDATE " << META_TABLEFILES << " SET table_id = " << mysqlpp::quote << collection_id
                           << " ,engine_type = " << engine_type << " ,file_id = " << mysqlpp::quote << file_id
                           << " ,file_type = " << file_type << " ,file_size = " << file_size
-                          << " ,row_count = " << row_count << " ,updated_time = " << updated_time
+                          << " ,row_count = " << row_count << " ,deleted_row_count = " << deleted_row_count
+                          << " ,updated_time = " << updated_time
                           << " ,created_on = " << created_on << " ,date = " << date << " WHERE id = " << id << ";";
 
                 LOG_ENGINE_DEBUG_ << "UpdateCollectionFiles: " << statement.str();
@@ -1334,12 +1378,15 @@ MySQLMetaImpl::UpdateCollectionFilesRowCount(SegmentsSchema& files) {
 
             mysqlpp::Query statement = connectionPtr->query();
 
+            // the deleted row count goes in the same statement as the row count, so both change atomically
             for (auto& file : files) {
                 std::string row_count = std::to_string(file.row_count_);
+                std::string deleted_row_count = std::to_string(file.deleted_row_count_);
                 std::string updated_time = std::to_string(utils::GetMicroSecTimeStamp());
 
                 statement << "UPDATE " << META_TABLEFILES << " SET row_count = " << row_count
-                          << " , updated_time = " << updated_time << " WHERE file_id = " << file.file_id_ << ";";
+                          << " , deleted_row_count = " << deleted_row_count << " , updated_time = " << updated_time
+                          << " WHERE file_id = " << file.file_id_ << ";";
 
                 LOG_ENGINE_DEBUG_ << "UpdateCollectionFilesRowCount: " << statement.str();
 
@@ -1497,7 +1544,10 @@ MySQLMetaImpl::CreatePartition(const std::string& collection_id, const std::stri
 
     if (partition_name == "") {
         // generate unique partition name
-        NextCollectionId(collection_schema.collection_id_);
+        status = NextCollectionId(collection_schema.collection_id_);
+        if (!status.ok()) {
+            return status;
+        }
     } else {
         collection_schema.collection_id_ = partition_name;
     }
@@ -1681,7 +1731,7 @@ MySQLMetaImpl::FilesToSearch(const std::string& collection_id, FilesHolder& file
 
             mysqlpp::Query statement = connectionPtr->query();
             statement << "SELECT id, table_id, segment_id, file_id, file_type, file_size, row_count, date,"
-                      << " engine_type, created_on, updated_time"
+                      << " engine_type, created_on, updated_time, deleted_row_count"
                       << " FROM " << META_TABLEFILES << " WHERE table_id = " << mysqlpp::quote << collection_id;
 
             // End
@@ -1713,6 +1763,7 @@ MySQLMetaImpl::FilesToSearch(const std::string& collection_id, FilesHolder& file
             collection_file.file_type_ = resRow["file_type"];
             collection_file.file_size_ = resRow["file_size"];
             collection_file.row_count_ = resRow["row_count"];
+            collection_file.deleted_row_count_ = resRow["deleted_row_count"];
             collection_file.date_ = resRow["date"];
             collection_file.engine_type_ = resRow["engine_type"];
             collection_file.created_on_ = resRow["created_on"];
@@ -1729,7 +1780,7 @@ MySQLMetaImpl::FilesToSearch(const std::string& collection_id, FilesHolder& file
                 continue;
             }
 
-            files_holder.MarkFile(collection_file);
+            files_holder.MarkFile(std::move(collection_file));
             files_count++;
         }
 
@@ -1782,7 +1833,7 @@ MySQLMetaImpl::FilesToSearchEx(const std::string& root_collection, const std::se
 
                 mysqlpp::Query statement = connectionPtr->query();
                 statement << "SELECT id, table_id, segment_id, file_id, file_type, file_size, row_count, date,"
-                          << " engine_type, created_on, updated_time"
+                          << " engine_type, created_on, updated_time, deleted_row_count"
                           << " FROM " << META_TABLEFILES << " WHERE table_id in (";
                 for (size_t i = 0; i < group.size(); i++) {
                     statement << mysqlpp::quote << group[i];
@@ -1812,6 +1863,7 @@ MySQLMetaImpl::FilesToSearchEx(const std::string& root_collection, const std::se
                 collection_file.file_type_ = resRow["file_type"];
                 collection_file.file_size_ = resRow["file_size"];
                 collection_file.row_count_ = resRow["row_count"];
+                collection_file.deleted_row_count_ = resRow["deleted_row_count"];
                 collection_file.date_ = resRow["date"];
                 collection_file.engine_type_ = resRow["engine_type"];
                 collection_file.created_on_ = resRow["created_on"];
@@ -1828,7 +1880,7 @@ MySQLMetaImpl::FilesToSearchEx(const std::string& root_collection, const std::se
                     continue;
                 }
 
-                files_holder.MarkFile(collection_file);
+                files_holder.MarkFile(std::move(collection_file));
                 files_count++;
             }
         }
@@ -1873,7 +1925,7 @@ MySQLMetaImpl::FilesToMerge(const std::string& collection_id, FilesHolder& files
 
             mysqlpp::Query statement = connectionPtr->query();
             statement << "SELECT id, table_id, segment_id, file_id, file_type, file_size, row_count, date,"
-                         " engine_type, created_on, updated_time"
+                         " engine_type, created_on, updated_time, deleted_row_count"
                       << " FROM " << META_TABLEFILES << " WHERE table_id = " << mysqlpp::quote << collection_id
                       << " AND file_type = " << std::to_string(SegmentSchema::RAW) << " ORDER BY row_count DESC;";
 
@@ -1898,6 +1950,7 @@ MySQLMetaImpl::FilesToMerge(const std::string& collection_id, FilesHolder& files
             collection_file.file_type_ = resRow["file_type"];
             collection_file.file_size_ = resRow["file_size"];
             collection_file.row_count_ = resRow["row_count"];
+            collection_file.deleted_row_count_ = resRow["deleted_row_count"];
             collection_file.date_ = resRow["date"];
             collection_file.engine_type_ = resRow["engine_type"];
             collection_file.created_on_ = resRow["created_on"];
@@ -1950,7 +2003,7 @@ MySQLMetaImpl::FilesToIndex(FilesHolder& files_holder) {
 
             mysqlpp::Query statement = connectionPtr->query();
             statement << "SELECT id, table_id, segment_id, file_id, file_type, file_size, row_count, date,"
-                      << " engine_type, created_on, updated_time"
+                      << " engine_type, created_on, updated_time, deleted_row_count"
                       << " FROM " << META_TABLEFILES << " WHERE file_type = " << std::to_string(SegmentSchema::TO_INDEX)
                       << ";";
 
@@ -1971,6 +2024,7 @@ MySQLMetaImpl::FilesToIndex(FilesHolder& files_holder) {
             collection_file.file_type_ = resRow["file_type"];
             collection_file.file_size_ = resRow["file_size"];
             collection_file.row_count_ = resRow["row_count"];
+            collection_file.deleted_row_count_ = resRow["deleted_row_count"];
             collection_file.date_ = resRow["date"];
             collection_file.engine_type_ = resRow["engine_type"];
             collection_file.created_on_ = resRow["created_on"];
@@ -2043,7 +2097,7 @@ MySQLMetaImpl::FilesByType(const std::string& collection_id, const std::vector<i
             mysqlpp::Query statement = connectionPtr->query();
             // since collection_id is a unique column we just need to check whether it exists or not
             statement << "SELECT id, table_id, segment_id, file_id, file_type, file_size, row_count, date,"
-                      << " engine_type, created_on, updated_time"
+                      << " engine_type, created_on, updated_time, deleted_row_count"
                       << " FROM " << META_TABLEFILES << " WHERE table_id = " << mysqlpp::quote << collection_id
                       << " AND file_type in (" << types << ");";
 
@@ -2071,6 +2125,7 @@ MySQLMetaImpl::FilesByType(const std::string& collection_id, const std::vector<i
                 file_schema.file_type_ = resRow["file_type"];
                 file_schema.file_size_ = resRow["file_size"];
                 file_schema.row_count_ = resRow["row_count"];
+                file_schema.deleted_row_count_ = resRow["deleted_row_count"];
                 file_schema.date_ = resRow["date"];
                 file_schema.engine_type_ = resRow["engine_type"];
                 file_schema.created_on_ = resRow["created_on"];
@@ -2206,7 +2261,7 @@ MySQLMetaImpl::FilesByTypeEx(const std::vector<meta::CollectionSchema>& collecti
                 mysqlpp::Query statement = connectionPtr->query();
                 // since collection_id is a unique column we just need to check whether it exists or not
                 statement << "SELECT id, table_id, segment_id, file_id, file_type, file_size, row_count, date,"
-                          << " engine_type, created_on, updated_time"
+                          << " engine_type, created_on, updated_time, deleted_row_count"
                           << " FROM " << META_TABLEFILES << " WHERE table_id in (";
                 for (size_t i = 0; i < group.size(); i++) {
                     statement << mysqlpp::quote << group[i];
@@ -2230,6 +2285,7 @@ MySQLMetaImpl::FilesByTypeEx(const std::vector<meta::CollectionSchema>& collecti
                 file_schema.file_type_ = resRow["file_type"];
                 file_schema.file_size_ = resRow["file_size"];
                 file_schema.row_count_ = resRow["row_count"];
+                file_schema.deleted_row_count_ = resRow["deleted_row_count"];
                 file_schema.date_ = resRow["date"];
                 file_schema.engine_type_ = resRow["engine_type"];
                 file_schema.created_on_ = resRow["created_on"];
@@ -2337,7 +2393,7 @@ MySQLMetaImpl::FilesByID(const std::vector<size_t>& ids, FilesHolder& files_hold
 
             mysqlpp::Query statement = connectionPtr->query();
             statement << "SELECT id, table_id, segment_id, file_id, file_type, file_size, row_count, date,"
-                      << " engine_type, created_on, updated_time"
+                      << " engine_type, created_on, updated_time, deleted_row_count"
                       << " FROM " << META_TABLEFILES;
 
             std::stringstream idSS;
@@ -2366,6 +2422,7 @@ MySQLMetaImpl::FilesByID(const std::vector<size_t>& ids, FilesHolder& files_hold
             collection_file.file_type_ = resRow["file_type"];
             collection_file.file_size_ = resRow["file_size"];
             collection_file.row_count_ = resRow["row_count"];
+            collection_file.deleted_row_count_ = resRow["deleted_row_count"];
             collection_file.date_ = resRow["date"];
             collection_file.engine_type_ = resRow["engine_type"];
             collection_file.created_on_ = resRow["created_on"];
@@ -2387,7 +2444,7 @@ MySQLMetaImpl::FilesByID(const std::vector<size_t>& ids, FilesHolder& files_hold
                 continue;
             }
 
-            files_holder.MarkFile(collection_file);
+            files_holder.MarkFile(std::move(collection_file));
             files_count++;
         }
 
@@ -2852,6 +2909,101 @@ MySQLMetaImpl::Count(const std::string& collection_id, uint64_t& result) {
     return Status::OK();
 }
 
+Status
+MySQLMetaImpl::GetCollectionStats(const std::string& collection_id, CollectionStats& stats,
+                                  std::vector<CollectionStats>& partitions_stats) {
+    // MySQL meta may be shared by several nodes, so the statistics are calculated from meta on demand
+    CollectionSchema collection_schema;
+    collection_schema.collection_id_ = collection_id;
+    auto status = DescribeCollection(collection_schema);
+    if (!status.ok()) {
+        return status;
+    }
+
+    std::vector<CollectionSchema> collections = {collection_schema};
+    if (collection_schema.owner_collection_.empty()) {
+        status = ShowPartitions(collection_id, collections);
+        if (!status.ok()) {
+            return status;
+        }
+    }
+
+    stats = CollectionStats();
+    stats.collection_id_ = collection_id;
+    stats.partition_tag_ = collection_schema.partition_tag_;
+    partitions_stats.clear();
+    for (auto& schema : collections) {
+        SegmentsStats segments_stats;
+        status = GetSegmentsStats(schema.collection_id_, segments_stats);
+        if (!status.ok()) {
+            return status;
+        }
+
+        CollectionStats partition_stats;
+        partition_stats.collection_id_ = schema.collection_id_;
+        partition_stats.partition_tag_ = schema.partition_tag_;
+        for (auto& segment : segments_stats) {
+            partition_stats.segment_count_[segment.file_type_]++;
+            stats.segment_count_[segment.file_type_]++;
+            if (CollectionStatsTracker::IsSearchable(segment.file_type_)) {
+                partition_stats.row_count_ += segment.row_count_;
+                partition_stats.deleted_row_count_ += segment.deleted_row_count_;
+                partition_stats.data_size_ += segment.data_size_;
+            }
+        }
+        stats.row_count_ += partition_stats.row_count_;
+        stats.deleted_row_count_ += partition_stats.deleted_row_count_;
+        stats.data_size_ += partition_stats.data_size_;
+        partitions_stats.emplace_back(partition_stats);
+    }
+
+    return Status::OK();
+}
+
+Status
+MySQLMetaImpl::GetSegmentsStats(const std::string& collection_id, SegmentsStats& segments_stats) {
+    try {
+        server::MetricCollector metric;
+        mysqlpp::StoreQueryResult res;
+        {
+            mysqlpp::ScopedConnection connectionPtr(*mysql_connection_pool_, safe_grab_);
+
+            bool is_null_connection = (connectionPtr == nullptr);
+            fiu_do_on("MySQLMetaImpl.GetSegmentsStats.null_connection", is_null_connection = true);
+            fiu_do_on("MySQLMetaImpl.GetSegmentsStats.throw_exception", throw std::exception(););
+            if (is_null_connection) {
+                return Status(DB_ERROR, "Failed to connect to meta server(mysql)");
+            }
+
+            mysqlpp::Query statement = connectionPtr->query();
+            statement << "SELECT segment_id, file_id, file_type, engine_type, row_count, deleted_row_count, file_size"
+                      << " FROM " << META_TABLEFILES << " WHERE table_id = " << mysqlpp::quote << collection_id
+                      << " ORDER BY file_id;";
+
+            LOG_ENGINE_DEBUG_ << "GetSegmentsStats: " << statement.str();
+
+            res = statement.store();
+        }  // Scoped Connection
+
+        segments_stats.clear();
+        for (auto& resRow : res) {
+            SegmentStats segment_stats;
+            resRow["segment_id"].to_string(segment_stats.segment_id_);
+            resRow["file_id"].to_string(segment_stats.file_id_);
+            segment_stats.file_type_ = resRow["file_type"];
+            segment_stats.engine_type_ = resRow["engine_type"];
+            segment_stats.row_count_ = resRow["row_count"];
+            segment_stats.deleted_row_count_ = resRow["deleted_row_count"];
+            segment_stats.data_size_ = resRow["file_size"];
+            segments_stats.emplace_back(segment_stats);
+        }
+    } catch (std::exception& e) {
+        return HandleException("Failed to get segments statistics", e.what());
+    }
+
+    return Status::OK();
+}
+
 Status
 MySQLMetaImpl::DropAll() {
     try {
@@ -3044,7 +3196,10 @@ MySQLMetaImpl::CreateHybridCollection(CollectionSchema& collection_schema, hybri
             mysqlpp::Query statement = connectionPtr->query();
 
             if (collection_schema.collection_id_.empty()) {
-                NextCollectionId(collection_schema.collection_id_);
+                auto status = NextCollectionId(collection_schema.collection_id_);
+                if (!status.ok()) {
+                    return status;
+                }
             } else {
                 statement << "SELECT state FROM " << META_TABLES << " WHERE table_id = " << mysqlpp::quote
                           << collection_schema.collection_id_ << ";";
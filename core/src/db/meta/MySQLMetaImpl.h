@@ -149,6 +149,13 @@ class MySQLMetaImpl : public Meta {
     Status
     Count(const std::string& collection_id, uint64_t& result) override;
 
+    Status
+    GetCollectionStats(const std::string& collection_id, CollectionStats& stats,
+                       std::vector<CollectionStats>& partitions_stats) override;
+
+    Status
+    GetSegmentsStats(const std::string& collection_id, SegmentsStats& segments_stats) override;
+
     Status
     SetGlobalLastLSN(uint64_t lsn) override;
 
@@ -15,6 +15,7 @@
 #include <unistd.h>
 
 #include <fiu-local.h>
+#include <algorithm>
 #include <boost/filesystem.hpp>
 #include <chrono>
 #include <fstream>
@@ -24,6 +25,8 @@
 #include <set>
 #include <sstream>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "MetaConsts.h"
 #include "db/IDGenerator.h"
@@ -114,12 +117,48 @@ StoragePrototype(const std::string& path) {
                    make_column("row_count", &SegmentSchema::row_count_, default_value(0)),
                    make_column("updated_time", &SegmentSchema::updated_time_),
                    make_column("created_on", &SegmentSchema::created_on_), make_column("date", &SegmentSchema::date_),
-                   make_column("flush_lsn", &SegmentSchema::flush_lsn_)));
+                   make_column("flush_lsn", &SegmentSchema::flush_lsn_),
+                   make_column("deleted_row_count", &SegmentSchema::deleted_row_count_, default_value(0))));
 }
 
 using ConnectorT = decltype(StoragePrototype("table"));
 static std::unique_ptr<ConnectorT> ConnectorPtr;
 
+// read-only queries go through a second connection, in WAL mode they are served from the last commit and never
+// wait for a writer
+static std::unique_ptr<ConnectorT> ReaderPtr;
+
+inline auto
+DescribeCollectionStatement(ConnectorT& connector) {
+    return connector.prepare(
+        select(columns(&CollectionSchema::id_, &CollectionSchema::state_, &CollectionSchema::dimension_,
+                       &CollectionSchema::created_on_, &CollectionSchema::flag_, &CollectionSchema::index_file_size_,
+                       &CollectionSchema::engine_type_, &CollectionSchema::index_params_,
+                       &CollectionSchema::metric_type_, &CollectionSchema::owner_collection_,
+                       &CollectionSchema::partition_tag_, &CollectionSchema::version_, &CollectionSchema::flush_lsn_),
+               where(c(&CollectionSchema::collection_id_) == std::string() and
+                     c(&CollectionSchema::state_) != (int)CollectionSchema::TO_DELETE)));
+}
+
+inline auto
+FilesToSearchStatement(ConnectorT& connector) {
+    std::vector<int> file_types = {(int)SegmentSchema::RAW, (int)SegmentSchema::TO_INDEX, (int)SegmentSchema::INDEX};
+    return connector.prepare(
+        select(columns(&SegmentSchema::id_, &SegmentSchema::collection_id_, &SegmentSchema::segment_id_,
+                       &SegmentSchema::file_id_, &SegmentSchema::file_type_, &SegmentSchema::file_size_,
+                       &SegmentSchema::row_count_, &SegmentSchema::date_, &SegmentSchema::engine_type_,
+                       &SegmentSchema::created_on_, &SegmentSchema::updated_time_, &SegmentSchema::deleted_row_count_),
+               where(c(&SegmentSchema::collection_id_) == std::string() and
+                     in(&SegmentSchema::file_type_, file_types))));
+}
+
+// statements of the hottest read paths are compiled once on the reader connection, the first bound value is the
+// collection id, guarded by reader_mutex_
+using DescribeCollectionStatementT = decltype(DescribeCollectionStatement(std::declval<ConnectorT&>()));
+using FilesToSearchStatementT = decltype(FilesToSearchStatement(std::declval<ConnectorT&>()));
+static std::unique_ptr<DescribeCollectionStatementT> DescribeCollectionStmt;
+static std::unique_ptr<FilesToSearchStatementT> FilesToSearchStmt;
+
 SqliteMetaImpl::SqliteMetaImpl(const DBMetaOptions& options) : options_(options) {
     Initialize();
 }
@@ -130,20 +169,26 @@ SqliteMetaImpl::~SqliteMetaImpl() {
 Status
 SqliteMetaImpl::NextCollectionId(std::string& collection_id) {
     std::lock_guard<std::mutex> lock(genid_mutex_);  // avoid duplicated id
-    std::stringstream ss;
     SafeIDGenerator& id_generator = SafeIDGenerator::GetInstance();
-    ss << id_generator.GetNextIDNumber();
-    collection_id = ss.str();
+    IDNumbers ids;
+    auto status = id_generator.GetNextIDNumbers(1, ids);
+    if (!status.ok()) {
+        return status;
+    }
+    collection_id = std::to_string(ids[0]);
     return Status::OK();
 }
 
 Status
 SqliteMetaImpl::NextFileId(std::string& file_id) {
     std::lock_guard<std::mutex> lock(genid_mutex_);  // avoid duplicated id
-    std::stringstream ss;
     SafeIDGenerator& id_generator = SafeIDGenerator::GetInstance();
-    ss << id_generator.GetNextIDNumber();
-    file_id = ss.str();
+    IDNumbers ids;
+    auto status = id_generator.GetNextIDNumbers(1, ids);
+    if (!status.ok()) {
+        return status;
+    }
+    file_id = std::to_string(ids[0]);
     return Status::OK();
 }
 
@@ -183,6 +228,10 @@ SqliteMetaImpl::Initialize() {
         }
     }
 
+    // statements belong to the connection they were prepared on
+    DescribeCollectionStmt = nullptr;
+    FilesToSearchStmt = nullptr;
+    ReaderPtr = nullptr;
     ConnectorPtr = std::make_unique<ConnectorT>(StoragePrototype(options_.path_ + "/meta.sqlite"));
 
     ValidateMetaSchema();
@@ -191,11 +240,82 @@ SqliteMetaImpl::Initialize() {
     ConnectorPtr->open_forever();                          // thread safe option
     ConnectorPtr->pragma.journal_mode(journal_mode::WAL);  // WAL => write ahead log
 
+    ReaderPtr = std::make_unique<ConnectorT>(StoragePrototype(options_.path_ + "/meta.sqlite"));
+    ReaderPtr->open_forever();
+    DescribeCollectionStmt.reset(new DescribeCollectionStatementT(DescribeCollectionStatement(*ReaderPtr)));
+    FilesToSearchStmt.reset(new FilesToSearchStatementT(FilesToSearchStatement(*ReaderPtr)));
+
     CleanUpShadowFiles();
+    LoadStats();
 
     return Status::OK();
 }
 
+void
+SqliteMetaImpl::LoadStats() {
+    std::lock_guard<std::mutex> meta_lock(meta_mutex_);
+    stats_tracker_.Clear();
+
+    auto collections = ConnectorPtr->select(
+        columns(&CollectionSchema::collection_id_, &CollectionSchema::owner_collection_,
+                &CollectionSchema::partition_tag_),
+        where(c(&CollectionSchema::state_) != (int)CollectionSchema::TO_DELETE), order_by(&CollectionSchema::id_));
+
+    // root collections first, so that partitions can be attached to their owners
+    for (bool root : {true, false}) {
+        for (auto& collection : collections) {
+            CollectionSchema schema;
+            schema.collection_id_ = std::get<0>(collection);
+            schema.owner_collection_ = std::get<1>(collection);
+            schema.partition_tag_ = std::get<2>(collection);
+            if (schema.owner_collection_.empty() == root) {
+                stats_tracker_.AddCollection(schema);
+            }
+        }
+    }
+
+    ReloadStats({});
+    LOG_ENGINE_DEBUG_ << "Load statistics of " << collections.size() << " collections";
+}
+
+void
+SqliteMetaImpl::ReloadStats(const std::vector<std::string>& collection_ids) {
+    auto select_columns =
+        columns(&SegmentSchema::collection_id_, &SegmentSchema::segment_id_, &SegmentSchema::file_id_,
+                &SegmentSchema::file_type_, &SegmentSchema::engine_type_, &SegmentSchema::row_count_,
+                &SegmentSchema::file_size_, &SegmentSchema::deleted_row_count_);
+    decltype(ConnectorPtr->select(select_columns)) selected;
+
+    std::map<std::string, SegmentsStats> collection_files;
+    if (collection_ids.empty()) {
+        selected = ConnectorPtr->select(select_columns);
+        for (auto& collection_id : stats_tracker_.Collections()) {
+            collection_files[collection_id];
+        }
+    } else {
+        selected = ConnectorPtr->select(select_columns, where(in(&SegmentSchema::collection_id_, collection_ids)));
+        for (auto& collection_id : collection_ids) {
+            collection_files[collection_id];
+        }
+    }
+
+    for (auto& file : selected) {
+        SegmentStats stats;
+        stats.segment_id_ = std::get<1>(file);
+        stats.file_id_ = std::get<2>(file);
+        stats.file_type_ = std::get<3>(file);
+        stats.engine_type_ = std::get<4>(file);
+        stats.row_count_ = std::get<5>(file);
+        stats.deleted_row_count_ = std::get<7>(file);
+        stats.data_size_ = std::get<6>(file);
+        collection_files[std::get<0>(file)].emplace_back(stats);
+    }
+
+    for (auto& pair : collection_files) {
+        stats_tracker_.ResetFiles(pair.first, pair.second);
+    }
+}
+
 Status
 SqliteMetaImpl::CreateCollection(CollectionSchema& collection_schema) {
     USING_SQLITE_WARNING
@@ -206,7 +326,10 @@ SqliteMetaImpl::CreateCollection(CollectionSchema& collection_schema) {
         std::lock_guard<std::mutex> meta_lock(meta_mutex_);
 
         if (collection_schema.collection_id_ == "") {
-            NextCollectionId(collection_schema.collection_id_);
+            auto status = NextCollectionId(collection_schema.collection_id_);
+            if (!status.ok()) {
+                return status;
+            }
         } else {
             fiu_do_on("SqliteMetaImpl.CreateCollection.throw_exception", throw std::exception());
             auto collection =
@@ -234,6 +357,7 @@ SqliteMetaImpl::CreateCollection(CollectionSchema& collection_schema) {
             return HandleException("Encounter exception when create collection", e.what());
         }
 
+        stats_tracker_.AddCollection(collection_schema);
         LOG_ENGINE_DEBUG_ << "Successfully create collection: " << collection_schema.collection_id_;
 
         return utils::CreateCollectionPath(options_, collection_schema.collection_id_);
@@ -247,17 +371,10 @@ SqliteMetaImpl::DescribeCollection(CollectionSchema& collection_schema) {
     try {
         server::MetricCollector metric;
 
-        // multi-threads call sqlite update may get exception('bad logic', etc), so we add a lock here
-        std::lock_guard<std::mutex> meta_lock(meta_mutex_);
+        std::lock_guard<std::mutex> reader_lock(reader_mutex_);
         fiu_do_on("SqliteMetaImpl.DescribeCollection.throw_exception", throw std::exception());
-        auto groups = ConnectorPtr->select(
-            columns(&CollectionSchema::id_, &CollectionSchema::state_, &CollectionSchema::dimension_,
-                    &CollectionSchema::created_on_, &CollectionSchema::flag_, &CollectionSchema::index_file_size_,
-                    &CollectionSchema::engine_type_, &CollectionSchema::index_params_, &CollectionSchema::metric_type_,
-                    &CollectionSchema::owner_collection_, &CollectionSchema::partition_tag_,
-                    &CollectionSchema::version_, &CollectionSchema::flush_lsn_),
-            where(c(&CollectionSchema::collection_id_) == collection_schema.collection_id_ and
-                  c(&CollectionSchema::state_) != (int)CollectionSchema::TO_DELETE));
+        sqlite_orm::get<0>(*DescribeCollectionStmt) = collection_schema.collection_id_;
+        auto groups = ReaderPtr->execute(*DescribeCollectionStmt);
 
         if (groups.size() == 1) {
             collection_schema.id_ = std::get<0>(groups[0]);
@@ -291,20 +408,19 @@ SqliteMetaImpl::HasCollection(const std::string& collection_id, bool& has_or_not
         fiu_do_on("SqliteMetaImpl.HasCollection.throw_exception", throw std::exception());
         server::MetricCollector metric;
 
-        // multi-threads call sqlite update may get exception('bad logic', etc), so we add a lock here
-        std::lock_guard<std::mutex> meta_lock(meta_mutex_);
+        std::lock_guard<std::mutex> reader_lock(reader_mutex_);
 
         auto select_columns = columns(&CollectionSchema::id_, &CollectionSchema::owner_collection_);
-        decltype(ConnectorPtr->select(select_columns)) selected;
+        decltype(ReaderPtr->select(select_columns)) selected;
         if (is_root) {
-            selected = ConnectorPtr->select(select_columns,
-                                            where(c(&CollectionSchema::collection_id_) == collection_id and
-                                                  c(&CollectionSchema::state_) != (int)CollectionSchema::TO_DELETE and
-                                                  c(&CollectionSchema::owner_collection_) == ""));
+            selected = ReaderPtr->select(select_columns,
+                                         where(c(&CollectionSchema::collection_id_) == collection_id and
+                                               c(&CollectionSchema::state_) != (int)CollectionSchema::TO_DELETE and
+                                               c(&CollectionSchema::owner_collection_) == ""));
         } else {
-            selected = ConnectorPtr->select(select_columns,
-                                            where(c(&CollectionSchema::collection_id_) == collection_id and
-                                                  c(&CollectionSchema::state_) != (int)CollectionSchema::TO_DELETE));
+            selected = ReaderPtr->select(select_columns,
+                                         where(c(&CollectionSchema::collection_id_) == collection_id and
+                                               c(&CollectionSchema::state_) != (int)CollectionSchema::TO_DELETE));
         }
 
         if (selected.size() == 1) {
@@ -325,23 +441,22 @@ SqliteMetaImpl::AllCollections(std::vector<CollectionSchema>& collection_schema_
         fiu_do_on("SqliteMetaImpl.AllCollections.throw_exception", throw std::exception());
         server::MetricCollector metric;
 
-        // multi-threads call sqlite update may get exception('bad logic', etc), so we add a lock here
-        std::lock_guard<std::mutex> meta_lock(meta_mutex_);
+        std::lock_guard<std::mutex> reader_lock(reader_mutex_);
         auto select_columns =
             columns(&CollectionSchema::id_, &CollectionSchema::collection_id_, &CollectionSchema::dimension_,
                     &CollectionSchema::created_on_, &CollectionSchema::flag_, &CollectionSchema::index_file_size_,
                     &CollectionSchema::engine_type_, &CollectionSchema::index_params_, &CollectionSchema::metric_type_,
                     &CollectionSchema::owner_collection_, &CollectionSchema::partition_tag_,
                     &CollectionSchema::version_, &CollectionSchema::flush_lsn_);
-        decltype(ConnectorPtr->select(select_columns)) selected;
+        decltype(ReaderPtr->select(select_columns)) selected;
 
         if (is_root) {
-            selected = ConnectorPtr->select(select_columns,
-                                            where(c(&CollectionSchema::state_) != (int)CollectionSchema::TO_DELETE and
-                                                  c(&CollectionSchema::owner_collection_) == ""));
+            selected = ReaderPtr->select(select_columns,
+                                         where(c(&CollectionSchema::state_) != (int)CollectionSchema::TO_DELETE and
+                                               c(&CollectionSchema::owner_collection_) == ""));
         } else {
-            selected = ConnectorPtr->select(select_columns,
-                                            where(c(&CollectionSchema::state_) != (int)CollectionSchema::TO_DELETE));
+            selected = ReaderPtr->select(select_columns,
+                                         where(c(&CollectionSchema::state_) != (int)CollectionSchema::TO_DELETE));
         }
 
         for (auto& collection : selected) {
@@ -390,6 +505,10 @@ SqliteMetaImpl::DropCollections(const std::vector<std::string>& collection_id_ar
                                          where(in(&CollectionSchema::collection_id_, group) and
                                                c(&CollectionSchema::state_) != (int)CollectionSchema::TO_DELETE));
             }
+
+            for (auto& collection_id : collection_id_array) {
+                stats_tracker_.RemoveCollection(collection_id);
+            }
         }
 
         auto status = DeleteCollectionFiles(collection_id_array);
@@ -422,6 +541,7 @@ SqliteMetaImpl::DeleteCollectionFiles(const std::vector<std::string>& collection
                                          c(&SegmentSchema::updated_time_) = utils::GetMicroSecTimeStamp()),
                                      where(in(&SegmentSchema::collection_id_, group) and
                                            c(&SegmentSchema::file_type_) != (int)SegmentSchema::TO_DELETE));
+            ReloadStats(group);
         }
 
         LOG_ENGINE_DEBUG_ << "Successfully delete collection files";
@@ -449,13 +569,17 @@ SqliteMetaImpl::CreateCollectionFile(SegmentSchema& file_schema) {
         fiu_do_on("SqliteMetaImpl.CreateCollectionFile.throw_exception", throw std::exception());
         server::MetricCollector metric;
 
-        NextFileId(file_schema.file_id_);
+        status = NextFileId(file_schema.file_id_);
+        if (!status.ok()) {
+            return status;
+        }
         if (file_schema.segment_id_.empty()) {
             file_schema.segment_id_ = file_schema.file_id_;
         }
         file_schema.dimension_ = collection_schema.dimension_;
         file_schema.file_size_ = 0;
         file_schema.row_count_ = 0;
+        file_schema.deleted_row_count_ = 0;
         file_schema.created_on_ = utils::GetMicroSecTimeStamp();
         file_schema.updated_time_ = file_schema.created_on_;
         file_schema.index_file_size_ = collection_schema.index_file_size_;
@@ -468,6 +592,7 @@ SqliteMetaImpl::CreateCollectionFile(SegmentSchema& file_schema) {
 
         auto id = ConnectorPtr->insert(file_schema);
         file_schema.id_ = id;
+        stats_tracker_.UpdateFile(file_schema);
 
         LOG_ENGINE_DEBUG_ << "Successfully create collection file, file id = " << file_schema.file_id_;
         return utils::CreateCollectionFilePath(options_, file_schema);
@@ -494,12 +619,12 @@ SqliteMetaImpl::GetCollectionFiles(const std::string& collection_id, const std::
         auto select_columns =
             columns(&SegmentSchema::id_, &SegmentSchema::segment_id_, &SegmentSchema::file_id_,
                     &SegmentSchema::file_type_, &SegmentSchema::file_size_, &SegmentSchema::row_count_,
-                    &SegmentSchema::date_, &SegmentSchema::engine_type_, &SegmentSchema::created_on_);
-        decltype(ConnectorPtr->select(select_columns)) selected;
+                    &SegmentSchema::date_, &SegmentSchema::engine_type_, &SegmentSchema::created_on_,
+                    &SegmentSchema::deleted_row_count_);
+        decltype(ReaderPtr->select(select_columns)) selected;
         {
-            // multi-threads call sqlite update may get exception('bad logic', etc), so we add a lock here
-            std::lock_guard<std::mutex> meta_lock(meta_mutex_);
-            selected = ConnectorPtr->select(
+            std::lock_guard<std::mutex> reader_lock(reader_mutex_);
+            selected = ReaderPtr->select(
                 select_columns,
                 where(c(&SegmentSchema::collection_id_) == collection_id and in(&SegmentSchema::id_, ids) and
                       c(&SegmentSchema::file_type_) != (int)SegmentSchema::TO_DELETE));
@@ -515,6 +640,7 @@ SqliteMetaImpl::GetCollectionFiles(const std::string& collection_id, const std::
             file_schema.file_type_ = std::get<3>(file);
             file_schema.file_size_ = std::get<4>(file);
             file_schema.row_count_ = std::get<5>(file);
+            file_schema.deleted_row_count_ = std::get<9>(file);
             file_schema.date_ = std::get<6>(file);
             file_schema.engine_type_ = std::get<7>(file);
             file_schema.created_on_ = std::get<8>(file);
@@ -541,14 +667,13 @@ SqliteMetaImpl::GetCollectionFilesBySegmentId(const std::string& segment_id, Fil
         auto select_columns = columns(&SegmentSchema::id_, &SegmentSchema::collection_id_, &SegmentSchema::segment_id_,
                                       &SegmentSchema::file_id_, &SegmentSchema::file_type_, &SegmentSchema::file_size_,
                                       &SegmentSchema::row_count_, &SegmentSchema::date_, &SegmentSchema::engine_type_,
-                                      &SegmentSchema::created_on_);
-        decltype(ConnectorPtr->select(select_columns)) selected;
+                                      &SegmentSchema::created_on_, &SegmentSchema::deleted_row_count_);
+        decltype(ReaderPtr->select(select_columns)) selected;
         {
-            // multi-threads call sqlite update may get exception('bad logic', etc), so we add a lock here
-            std::lock_guard<std::mutex> meta_lock(meta_mutex_);
-            selected = ConnectorPtr->select(select_columns,
-                                            where(c(&SegmentSchema::segment_id_) == segment_id and
-                                                  c(&SegmentSchema::file_type_) != (int)SegmentSchema::TO_DELETE));
+            std::lock_guard<std::mutex> reader_lock(reader_mutex_);
+            selected = ReaderPtr->select(select_columns,
+                                         where(c(&SegmentSchema::segment_id_) == segment_id and
+                                               c(&SegmentSchema::file_type_) != (int)SegmentSchema::TO_DELETE));
         }
 
         if (!selected.empty()) {
@@ -568,6 +693,7 @@ SqliteMetaImpl::GetCollectionFilesBySegmentId(const std::string& segment_id, Fil
                 file_schema.file_type_ = std::get<4>(file);
                 file_schema.file_size_ = std::get<5>(file);
                 file_schema.row_count_ = std::get<6>(file);
+                file_schema.deleted_row_count_ = std::get<10>(file);
                 file_schema.date_ = std::get<7>(file);
                 file_schema.engine_type_ = std::get<8>(file);
                 file_schema.created_on_ = std::get<9>(file);
@@ -634,11 +760,10 @@ SqliteMetaImpl::GetCollectionFlushLSN(const std::string& collection_id, uint64_t
     try {
         server::MetricCollector metric;
 
-        // multi-threads call sqlite update may get exception('bad logic', etc), so we add a lock here
-        std::lock_guard<std::mutex> meta_lock(meta_mutex_);
+        std::lock_guard<std::mutex> reader_lock(reader_mutex_);
 
-        auto selected = ConnectorPtr->select(columns(&CollectionSchema::flush_lsn_),
-                                             where(c(&CollectionSchema::collection_id_) == collection_id));
+        auto selected = ReaderPtr->select(columns(&CollectionSchema::flush_lsn_),
+                                          where(c(&CollectionSchema::collection_id_) == collection_id));
 
         if (selected.size() > 0) {
             flush_lsn = std::get<0>(selected[0]);
@@ -674,6 +799,7 @@ SqliteMetaImpl::UpdateCollectionFile(SegmentSchema& file_schema) {
         }
 
         ConnectorPtr->update(file_schema);
+        stats_tracker_.UpdateFile(file_schema);
 
         LOG_ENGINE_DEBUG_ << "Update single collection file, file id = " << file_schema.file_id_;
     } catch (std::exception& e) {
@@ -693,30 +819,61 @@ SqliteMetaImpl::UpdateCollectionFiles(SegmentsSchema& files) {
         // multi-threads call sqlite update may get exception('bad logic', etc), so we add a lock here
         std::lock_guard<std::mutex> meta_lock(meta_mutex_);
 
+        // look up all owner collections with a few IN queries instead of one query per collection
         std::map<std::string, bool> has_collections;
         for (auto& file : files) {
-            if (has_collections.find(file.collection_id_) != has_collections.end()) {
-                continue;
-            }
+            has_collections[file.collection_id_] = false;
+        }
+        std::vector<std::string> collection_ids;
+        for (auto& pair : has_collections) {
+            collection_ids.push_back(pair.first);
+        }
+        std::vector<std::vector<std::string>> id_groups;
+        DistributeBatch(collection_ids, id_groups);
+        for (auto& group : id_groups) {
             auto collections =
-                ConnectorPtr->select(columns(&CollectionSchema::id_),
-                                     where(c(&CollectionSchema::collection_id_) == file.collection_id_ and
+                ConnectorPtr->select(columns(&CollectionSchema::collection_id_),
+                                     where(in(&CollectionSchema::collection_id_, group) and
                                            c(&CollectionSchema::state_) != (int)CollectionSchema::TO_DELETE));
-            if (collections.size() >= 1) {
-                has_collections[file.collection_id_] = true;
-            } else {
-                has_collections[file.collection_id_] = false;
+            for (auto& collection : collections) {
+                has_collections[std::get<0>(collection)] = true;
             }
         }
 
+        auto now = utils::GetMicroSecTimeStamp();
+        for (auto& file : files) {
+            if (!has_collections[file.collection_id_]) {
+                file.file_type_ = SegmentSchema::TO_DELETE;
+            }
+            file.updated_time_ = now;
+        }
+
+        // rewrite the rows with one multi-row REPLACE per batch instead of one UPDATE per file, rows that are gone
+        // meanwhile are skipped, REPLACE would bring them back while UPDATE left them alone
+        SegmentsSchema updated_files;
         auto commited = ConnectorPtr->transaction([&]() mutable {
-            for (auto& file : files) {
-                if (!has_collections[file.collection_id_]) {
-                    file.file_type_ = SegmentSchema::TO_DELETE;
+            updated_files.clear();
+            for (size_t begin = 0; begin < files.size(); begin += SQL_BATCH_SIZE) {
+                size_t end = std::min(files.size(), begin + (size_t)SQL_BATCH_SIZE);
+                std::vector<size_t> ids;
+                for (size_t i = begin; i < end; ++i) {
+                    ids.push_back(files[i].id_);
+                }
+                std::set<size_t> exist_ids;
+                for (auto& id : ConnectorPtr->select(&SegmentSchema::id_, where(in(&SegmentSchema::id_, ids)))) {
+                    exist_ids.insert(id);
                 }
 
-                file.updated_time_ = utils::GetMicroSecTimeStamp();
-                ConnectorPtr->update(file);
+                SegmentsSchema batch;
+                for (size_t i = begin; i < end; ++i) {
+                    if (exist_ids.find(files[i].id_) != exist_ids.end()) {
+                        batch.push_back(files[i]);
+                    }
+                }
+                if (!batch.empty()) {
+                    ConnectorPtr->replace_range(batch.begin(), batch.end());
+                    updated_files.insert(updated_files.end(), batch.begin(), batch.end());
+                }
             }
             return true;
         });
@@ -726,7 +883,11 @@ SqliteMetaImpl::UpdateCollectionFiles(SegmentsSchema& files) {
             return HandleException("UpdateCollectionFiles error: sqlite transaction failed");
         }
 
-        LOG_ENGINE_DEBUG_ << "Update " << files.size() << " collection files";
+        for (auto& file : updated_files) {
+            stats_tracker_.UpdateFile(file);
+        }
+
+        LOG_ENGINE_DEBUG_ << "Update " << updated_files.size() << " collection files";
     } catch (std::exception& e) {
         return HandleException("Encounter exception when update collection files", e.what());
     }
@@ -741,10 +902,26 @@ SqliteMetaImpl::UpdateCollectionFilesRowCount(SegmentsSchema& files) {
         // multi-threads call sqlite update may get exception('bad logic', etc), so we add a lock here
         std::lock_guard<std::mutex> meta_lock(meta_mutex_);
 
+        // one transaction for all files, otherwise every update is synced on its own, the deleted row count is
+        // written together with the row count so both survive a restart
+        auto commited = ConnectorPtr->transaction([&]() mutable {
+            auto now = utils::GetMicroSecTimeStamp();
+            for (auto& file : files) {
+                ConnectorPtr->update_all(set(c(&SegmentSchema::row_count_) = file.row_count_,
+                                             c(&SegmentSchema::deleted_row_count_) = file.deleted_row_count_,
+                                             c(&SegmentSchema::updated_time_) = now),
+                                         where(c(&SegmentSchema::file_id_) == file.file_id_));
+            }
+            return true;
+        });
+
+        if (!commited) {
+            return HandleException("UpdateCollectionFilesRowCount error: sqlite transaction failed");
+        }
+
         for (auto& file : files) {
-            ConnectorPtr->update_all(set(c(&SegmentSchema::row_count_) = file.row_count_,
-                                         c(&SegmentSchema::updated_time_) = utils::GetMicroSecTimeStamp()),
-                                     where(c(&SegmentSchema::file_id_) == file.file_id_));
+            stats_tracker_.UpdateFileRowCount(file.collection_id_, file.file_id_, file.row_count_,
+                                              file.deleted_row_count_);
             LOG_ENGINE_DEBUG_ << "Update file " << file.file_id_ << " row count to " << file.row_count_;
         }
     } catch (std::exception& e) {
@@ -798,6 +975,7 @@ SqliteMetaImpl::UpdateCollectionIndex(const std::string& collection_id, const Co
                                      c(&SegmentSchema::updated_time_) = utils::GetMicroSecTimeStamp()),
                                  where(c(&SegmentSchema::collection_id_) == collection_id and
                                        c(&SegmentSchema::file_type_) == (int)SegmentSchema::BACKUP));
+        ReloadStats({collection_id});
 
         LOG_ENGINE_DEBUG_ << "Successfully update collection index, collection id = " << collection_id;
     } catch (std::exception& e) {
@@ -821,6 +999,7 @@ SqliteMetaImpl::UpdateCollectionFilesToIndex(const std::string& collection_id) {
                                  where(c(&SegmentSchema::collection_id_) == collection_id and
                                        c(&SegmentSchema::row_count_) >= meta::BUILD_INDEX_THRESHOLD and
                                        c(&SegmentSchema::file_type_) == (int)SegmentSchema::RAW));
+        ReloadStats({collection_id});
 
         LOG_ENGINE_DEBUG_ << "Update files to to_index, collection id = " << collection_id;
     } catch (std::exception& e) {
@@ -890,6 +1069,7 @@ SqliteMetaImpl::DropCollectionIndex(const std::string& collection_id) {
         ConnectorPtr->update_all(
             set(c(&CollectionSchema::engine_type_) = raw_engine_type, c(&CollectionSchema::index_params_) = "{}"),
             where(c(&CollectionSchema::collection_id_) == collection_id));
+        ReloadStats({collection_id});
 
         LOG_ENGINE_DEBUG_ << "Successfully drop collection index, collection id = " << collection_id;
     } catch (std::exception& e) {
@@ -931,7 +1111,10 @@ SqliteMetaImpl::CreatePartition(const std::string& collection_id, const std::str
 
     if (partition_name == "") {
         // generate unique partition name
-        NextCollectionId(collection_schema.collection_id_);
+        status = NextCollectionId(collection_schema.collection_id_);
+        if (!status.ok()) {
+            return status;
+        }
     } else {
         collection_schema.collection_id_ = partition_name;
     }
@@ -1065,22 +1248,11 @@ SqliteMetaImpl::FilesToSearch(const std::string& collection_id, FilesHolder& fil
         }
 
         // perform query
-        auto select_columns = columns(&SegmentSchema::id_, &SegmentSchema::collection_id_, &SegmentSchema::segment_id_,
-                                      &SegmentSchema::file_id_, &SegmentSchema::file_type_, &SegmentSchema::file_size_,
-                                      &SegmentSchema::row_count_, &SegmentSchema::date_, &SegmentSchema::engine_type_,
-                                      &SegmentSchema::created_on_, &SegmentSchema::updated_time_);
-
-        auto match_collectionid = c(&SegmentSchema::collection_id_) == collection_id;
-
-        std::vector<int> file_types = {(int)SegmentSchema::RAW, (int)SegmentSchema::TO_INDEX,
-                                       (int)SegmentSchema::INDEX};
-        auto match_type = in(&SegmentSchema::file_type_, file_types);
-        decltype(ConnectorPtr->select(select_columns)) selected;
+        decltype(ReaderPtr->execute(*FilesToSearchStmt)) selected;
         {
-            // multi-threads call sqlite update may get exception('bad logic', etc), so we add a lock here
-            std::lock_guard<std::mutex> meta_lock(meta_mutex_);
-            auto filter = where(match_collectionid and match_type);
-            selected = ConnectorPtr->select(select_columns, filter);
+            std::lock_guard<std::mutex> reader_lock(reader_mutex_);
+            sqlite_orm::get<0>(*FilesToSearchStmt) = collection_id;
+            selected = ReaderPtr->execute(*FilesToSearchStmt);
         }
 
         Status ret;
@@ -1094,6 +1266,7 @@ SqliteMetaImpl::FilesToSearch(const std::string& collection_id, FilesHolder& fil
             collection_file.file_type_ = std::get<4>(file);
             collection_file.file_size_ = std::get<5>(file);
             collection_file.row_count_ = std::get<6>(file);
+            collection_file.deleted_row_count_ = std::get<11>(file);
             collection_file.date_ = std::get<7>(file);
             collection_file.engine_type_ = std::get<8>(file);
             collection_file.created_on_ = std::get<9>(file);
@@ -1110,7 +1283,7 @@ SqliteMetaImpl::FilesToSearch(const std::string& collection_id, FilesHolder& fil
                 continue;
             }
 
-            files_holder.MarkFile(collection_file);
+            files_holder.MarkFile(std::move(collection_file));
             files_count++;
         }
         if (files_count == 0) {
@@ -1163,19 +1336,18 @@ SqliteMetaImpl::FilesToSearchEx(const std::string& root_collection, const std::s
                 columns(&SegmentSchema::id_, &SegmentSchema::collection_id_, &SegmentSchema::segment_id_,
                         &SegmentSchema::file_id_, &SegmentSchema::file_type_, &SegmentSchema::file_size_,
                         &SegmentSchema::row_count_, &SegmentSchema::date_, &SegmentSchema::engine_type_,
-                        &SegmentSchema::created_on_, &SegmentSchema::updated_time_);
+                        &SegmentSchema::created_on_, &SegmentSchema::updated_time_, &SegmentSchema::deleted_row_count_);
 
             auto match_collectionid = in(&SegmentSchema::collection_id_, group);
 
             std::vector<int> file_types = {(int)SegmentSchema::RAW, (int)SegmentSchema::TO_INDEX,
                                            (int)SegmentSchema::INDEX};
             auto match_type = in(&SegmentSchema::file_type_, file_types);
-            decltype(ConnectorPtr->select(select_columns)) selected;
+            decltype(ReaderPtr->select(select_columns)) selected;
             {
-                // multi-threads call sqlite update may get exception('bad logic', etc), so we add a lock here
-                std::lock_guard<std::mutex> meta_lock(meta_mutex_);
+                std::lock_guard<std::mutex> reader_lock(reader_mutex_);
                 auto filter = where(match_collectionid and match_type);
-                selected = ConnectorPtr->select(select_columns, filter);
+                selected = ReaderPtr->select(select_columns, filter);
             }
 
             for (auto& file : selected) {
@@ -1187,6 +1359,7 @@ SqliteMetaImpl::FilesToSearchEx(const std::string& root_collection, const std::s
                 collection_file.file_type_ = std::get<4>(file);
                 collection_file.file_size_ = std::get<5>(file);
                 collection_file.row_count_ = std::get<6>(file);
+                collection_file.deleted_row_count_ = std::get<11>(file);
                 collection_file.date_ = std::get<7>(file);
                 collection_file.engine_type_ = std::get<8>(file);
                 collection_file.created_on_ = std::get<9>(file);
@@ -1202,7 +1375,7 @@ SqliteMetaImpl::FilesToSearchEx(const std::string& root_collection, const std::s
                     continue;
                 }
 
-                files_holder.MarkFile(collection_file);
+                files_holder.MarkFile(std::move(collection_file));
                 files_count++;
             }
         }
@@ -1236,15 +1409,15 @@ SqliteMetaImpl::FilesToMerge(const std::string& collection_id, FilesHolder& file
         auto select_columns = columns(&SegmentSchema::id_, &SegmentSchema::collection_id_, &SegmentSchema::segment_id_,
                                       &SegmentSchema::file_id_, &SegmentSchema::file_type_, &SegmentSchema::file_size_,
                                       &SegmentSchema::row_count_, &SegmentSchema::date_, &SegmentSchema::engine_type_,
-                                      &SegmentSchema::created_on_, &SegmentSchema::updated_time_);
-        decltype(ConnectorPtr->select(select_columns)) selected;
+                                      &SegmentSchema::created_on_, &SegmentSchema::updated_time_,
+                                      &SegmentSchema::deleted_row_count_);
+        decltype(ReaderPtr->select(select_columns)) selected;
         {
-            // multi-threads call sqlite update may get exception('bad logic', etc), so we add a lock here
-            std::lock_guard<std::mutex> meta_lock(meta_mutex_);
-            selected = ConnectorPtr->select(select_columns,
-                                            where(c(&SegmentSchema::file_type_) == (int)SegmentSchema::RAW and
-                                                  c(&SegmentSchema::collection_id_) == collection_id),
-                                            order_by(&SegmentSchema::file_size_).desc());
+            std::lock_guard<std::mutex> reader_lock(reader_mutex_);
+            selected = ReaderPtr->select(select_columns,
+                                         where(c(&SegmentSchema::file_type_) == (int)SegmentSchema::RAW and
+                                               c(&SegmentSchema::collection_id_) == collection_id),
+                                         order_by(&SegmentSchema::file_size_).desc());
         }
 
         Status result;
@@ -1262,6 +1435,7 @@ SqliteMetaImpl::FilesToMerge(const std::string& collection_id, FilesHolder& file
             collection_file.file_id_ = std::get<3>(file);
             collection_file.file_type_ = std::get<4>(file);
             collection_file.row_count_ = std::get<6>(file);
+            collection_file.deleted_row_count_ = std::get<11>(file);
             collection_file.date_ = std::get<7>(file);
             collection_file.engine_type_ = std::get<8>(file);
             collection_file.created_on_ = std::get<9>(file);
@@ -1303,13 +1477,13 @@ SqliteMetaImpl::FilesToIndex(FilesHolder& files_holder) {
         auto select_columns = columns(&SegmentSchema::id_, &SegmentSchema::collection_id_, &SegmentSchema::segment_id_,
                                       &SegmentSchema::file_id_, &SegmentSchema::file_type_, &SegmentSchema::file_size_,
                                       &SegmentSchema::row_count_, &SegmentSchema::date_, &SegmentSchema::engine_type_,
-                                      &SegmentSchema::created_on_, &SegmentSchema::updated_time_);
-        decltype(ConnectorPtr->select(select_columns)) selected;
+                                      &SegmentSchema::created_on_, &SegmentSchema::updated_time_,
+                                      &SegmentSchema::deleted_row_count_);
+        decltype(ReaderPtr->select(select_columns)) selected;
         {
-            // multi-threads call sqlite update may get exception('bad logic', etc), so we add a lock here
-            std::lock_guard<std::mutex> meta_lock(meta_mutex_);
-            selected = ConnectorPtr->select(select_columns,
-                                            where(c(&SegmentSchema::file_type_) == (int)SegmentSchema::TO_INDEX));
+            std::lock_guard<std::mutex> reader_lock(reader_mutex_);
+            selected = ReaderPtr->select(select_columns,
+                                         where(c(&SegmentSchema::file_type_) == (int)SegmentSchema::TO_INDEX));
         }
 
         Status ret;
@@ -1324,6 +1498,7 @@ SqliteMetaImpl::FilesToIndex(FilesHolder& files_holder) {
             collection_file.file_type_ = std::get<4>(file);
             collection_file.file_size_ = std::get<5>(file);
             collection_file.row_count_ = std::get<6>(file);
+            collection_file.deleted_row_count_ = std::get<11>(file);
             collection_file.date_ = std::get<7>(file);
             collection_file.engine_type_ = std::get<8>(file);
             collection_file.created_on_ = std::get<9>(file);
@@ -1386,13 +1561,13 @@ SqliteMetaImpl::FilesByType(const std::string& collection_id, const std::vector<
         auto select_columns = columns(&SegmentSchema::id_, &SegmentSchema::segment_id_, &SegmentSchema::file_id_,
                                       &SegmentSchema::file_type_, &SegmentSchema::file_size_,
                                       &SegmentSchema::row_count_, &SegmentSchema::date_, &SegmentSchema::engine_type_,
-                                      &SegmentSchema::created_on_, &SegmentSchema::updated_time_);
-        decltype(ConnectorPtr->select(select_columns)) selected;
+                                      &SegmentSchema::created_on_, &SegmentSchema::updated_time_,
+                                      &SegmentSchema::deleted_row_count_);
+        decltype(ReaderPtr->select(select_columns)) selected;
         {
-            // multi-threads call sqlite update may get exception('bad logic', etc), so we add a lock here
-            std::lock_guard<std::mutex> meta_lock(meta_mutex_);
-            selected = ConnectorPtr->select(select_columns, where(in(&SegmentSchema::file_type_, file_types) and
-                                                                  c(&SegmentSchema::collection_id_) == collection_id));
+            std::lock_guard<std::mutex> reader_lock(reader_mutex_);
+            selected = ReaderPtr->select(select_columns, where(in(&SegmentSchema::file_type_, file_types) and
+                                                               c(&SegmentSchema::collection_id_) == collection_id));
         }
 
         if (selected.size() >= 1) {
@@ -1407,6 +1582,7 @@ SqliteMetaImpl::FilesByType(const std::string& collection_id, const std::vector<
                 file_schema.file_type_ = std::get<3>(file);
                 file_schema.file_size_ = std::get<4>(file);
                 file_schema.row_count_ = std::get<5>(file);
+                file_schema.deleted_row_count_ = std::get<10>(file);
                 file_schema.date_ = std::get<6>(file);
                 file_schema.engine_type_ = std::get<7>(file);
                 file_schema.created_on_ = std::get<8>(file);
@@ -1527,8 +1703,8 @@ SqliteMetaImpl::FilesByTypeEx(const std::vector<meta::CollectionSchema>& collect
                 columns(&SegmentSchema::id_, &SegmentSchema::collection_id_, &SegmentSchema::segment_id_,
                         &SegmentSchema::file_id_, &SegmentSchema::file_type_, &SegmentSchema::file_size_,
                         &SegmentSchema::row_count_, &SegmentSchema::date_, &SegmentSchema::engine_type_,
-                        &SegmentSchema::created_on_, &SegmentSchema::updated_time_);
-            decltype(ConnectorPtr->select(select_columns)) selected;
+                        &SegmentSchema::created_on_, &SegmentSchema::updated_time_, &SegmentSchema::deleted_row_count_);
+            decltype(ReaderPtr->select(select_columns)) selected;
 
             auto match_collectionid = in(&SegmentSchema::collection_id_, group);
 
@@ -1536,10 +1712,9 @@ SqliteMetaImpl::FilesByTypeEx(const std::vector<meta::CollectionSchema>& collect
                                            (int)SegmentSchema::INDEX};
             auto match_type = in(&SegmentSchema::file_type_, file_types);
             {
-                // multi-threads call sqlite update may get exception('bad logic', etc), so we add a lock here
-                std::lock_guard<std::mutex> meta_lock(meta_mutex_);
+                std::lock_guard<std::mutex> reader_lock(reader_mutex_);
                 auto filter = where(match_collectionid and match_type);
-                selected = ConnectorPtr->select(select_columns, filter);
+                selected = ReaderPtr->select(select_columns, filter);
             }
 
             for (auto& file : selected) {
@@ -1551,6 +1726,7 @@ SqliteMetaImpl::FilesByTypeEx(const std::vector<meta::CollectionSchema>& collect
                 file_schema.file_type_ = std::get<4>(file);
                 file_schema.file_size_ = std::get<5>(file);
                 file_schema.row_count_ = std::get<6>(file);
+                file_schema.deleted_row_count_ = std::get<11>(file);
                 file_schema.date_ = std::get<7>(file);
                 file_schema.engine_type_ = std::get<8>(file);
                 file_schema.created_on_ = std::get<9>(file);
@@ -1646,16 +1822,16 @@ SqliteMetaImpl::FilesByID(const std::vector<size_t>& ids, FilesHolder& files_hol
         auto select_columns = columns(&SegmentSchema::id_, &SegmentSchema::collection_id_, &SegmentSchema::segment_id_,
                                       &SegmentSchema::file_id_, &SegmentSchema::file_type_, &SegmentSchema::file_size_,
                                       &SegmentSchema::row_count_, &SegmentSchema::date_, &SegmentSchema::engine_type_,
-                                      &SegmentSchema::created_on_, &SegmentSchema::updated_time_);
+                                      &SegmentSchema::created_on_, &SegmentSchema::updated_time_,
+                                      &SegmentSchema::deleted_row_count_);
 
         // perform query
-        decltype(ConnectorPtr->select(select_columns)) selected;
+        decltype(ReaderPtr->select(select_columns)) selected;
         auto match_fileid = in(&SegmentSchema::id_, ids);
         auto filter = where(match_fileid);
         {
-            // multi-threads call sqlite update may get exception('bad logic', etc), so we add a lock here
-            std::lock_guard<std::mutex> meta_lock(meta_mutex_);
-            selected = ConnectorPtr->select(select_columns, filter);
+            std::lock_guard<std::mutex> reader_lock(reader_mutex_);
+            selected = ReaderPtr->select(select_columns, filter);
         }
 
         std::map<std::string, meta::CollectionSchema> collections;
@@ -1670,6 +1846,7 @@ SqliteMetaImpl::FilesByID(const std::vector<size_t>& ids, FilesHolder& files_hol
             collection_file.file_type_ = std::get<4>(file);
             collection_file.file_size_ = std::get<5>(file);
             collection_file.row_count_ = std::get<6>(file);
+            collection_file.deleted_row_count_ = std::get<11>(file);
             collection_file.date_ = std::get<7>(file);
             collection_file.engine_type_ = std::get<8>(file);
             collection_file.created_on_ = std::get<9>(file);
@@ -1690,7 +1867,7 @@ SqliteMetaImpl::FilesByID(const std::vector<size_t>& ids, FilesHolder& files_hol
                 ret = status;
             }
 
-            files_holder.MarkFile(collection_file);
+            files_holder.MarkFile(std::move(collection_file));
             files_count++;
         }
 
@@ -1739,6 +1916,7 @@ SqliteMetaImpl::Archive() {
                 ConnectorPtr->update_all(set(c(&SegmentSchema::file_type_) = (int)SegmentSchema::TO_DELETE),
                                          where(c(&SegmentSchema::created_on_) < (int64_t)(now - usecs) and
                                                c(&SegmentSchema::file_type_) != (int)SegmentSchema::TO_DELETE));
+                ReloadStats({});
             } catch (std::exception& e) {
                 return HandleException("Encounter exception when update collection files", e.what());
             }
@@ -1806,6 +1984,7 @@ SqliteMetaImpl::CleanUpShadowFiles() {
         if (!commited) {
             return HandleException("CleanUp error: sqlite transaction failed");
         }
+        ReloadStats({});
 
         if (files.size() > 0) {
             LOG_ENGINE_DEBUG_ << "Clean " << files.size() << " files";
@@ -1822,6 +2001,7 @@ SqliteMetaImpl::CleanUpFilesWithTTL(uint64_t seconds /*, CleanUpFilter* filter*/
     auto now = utils::GetMicroSecTimeStamp();
     std::set<std::string> collection_ids;
     std::map<std::string, SegmentSchema> segment_ids;
+    SegmentsSchema removed_files;
 
     // remove to_delete files
     try {
@@ -1834,19 +2014,19 @@ SqliteMetaImpl::CleanUpFilesWithTTL(uint64_t seconds /*, CleanUpFilter* filter*/
             (int)SegmentSchema::BACKUP,
         };
 
-        // multi-threads call sqlite update may get exception('bad logic', etc), so we add a lock here
-        std::lock_guard<std::mutex> meta_lock(meta_mutex_);
+        {
+            // multi-threads call sqlite update may get exception('bad logic', etc), so we add a lock here
+            std::lock_guard<std::mutex> meta_lock(meta_mutex_);
 
-        // collect files to be deleted
-        auto files =
-            ConnectorPtr->select(columns(&SegmentSchema::id_, &SegmentSchema::collection_id_,
-                                         &SegmentSchema::segment_id_, &SegmentSchema::engine_type_,
-                                         &SegmentSchema::file_id_, &SegmentSchema::file_type_, &SegmentSchema::date_),
-                                 where(in(&SegmentSchema::file_type_, file_types) and
-                                       c(&SegmentSchema::updated_time_) < now - seconds * US_PS));
+            // collect files to be deleted
+            auto files = ConnectorPtr->select(
+                columns(&SegmentSchema::id_, &SegmentSchema::collection_id_, &SegmentSchema::segment_id_,
+                        &SegmentSchema::engine_type_, &SegmentSchema::file_id_, &SegmentSchema::file_type_,
+                        &SegmentSchema::date_),
+                where(in(&SegmentSchema::file_type_, file_types) and
+                      c(&SegmentSchema::updated_time_) < now - seconds * US_PS));
 
-        int64_t clean_files = 0;
-        auto commited = ConnectorPtr->transaction([&]() mutable {
+            std::vector<size_t> removed_ids;
             SegmentSchema collection_file;
             for (auto& file : files) {
                 collection_file.id_ = std::get<0>(file);
@@ -1871,26 +2051,41 @@ SqliteMetaImpl::CleanUpFilesWithTTL(uint64_t seconds /*, CleanUpFilter* filter*/
                 server::CommonUtil::EraseFromCache(collection_file.location_);
 
                 if (collection_file.file_type_ == (int)SegmentSchema::TO_DELETE) {
-                    // delete file from meta
-                    ConnectorPtr->remove<SegmentSchema>(collection_file.id_);
+                    removed_ids.push_back(collection_file.id_);
+                    removed_files.push_back(collection_file);
+                }
+            }
 
-                    // delete file from disk storage
-                    utils::DeleteCollectionFilePath(options_, collection_file);
+            // delete files from meta, a batch of rows per statement
+            auto commited = ConnectorPtr->transaction([&]() mutable {
+                for (size_t i = 0; i < removed_ids.size(); i += SQL_BATCH_SIZE) {
+                    auto last = std::min(removed_ids.size(), i + SQL_BATCH_SIZE);
+                    std::vector<size_t> group(removed_ids.begin() + i, removed_ids.begin() + last);
+                    ConnectorPtr->remove_all<SegmentSchema>(where(in(&SegmentSchema::id_, group)));
+                }
+                return true;
+            });
+            fiu_do_on("SqliteMetaImpl.CleanUpFilesWithTTL.RemoveFile_FailCommited", commited = false);
 
-                    LOG_ENGINE_DEBUG_ << "Remove file id:" << collection_file.file_id_
-                                      << " location:" << collection_file.location_;
-                    collection_ids.insert(collection_file.collection_id_);
-                    segment_ids.insert(std::make_pair(collection_file.segment_id_, collection_file));
+            if (!commited) {
+                return HandleException("CleanUpFilesWithTTL error: sqlite transaction failed");
+            }
 
-                    ++clean_files;
-                }
+            for (auto& file : removed_files) {
+                stats_tracker_.RemoveFile(file.collection_id_, file.file_id_);
             }
-            return true;
-        });
-        fiu_do_on("SqliteMetaImpl.CleanUpFilesWithTTL.RemoveFile_FailCommited", commited = false);
+        }
 
-        if (!commited) {
-            return HandleException("CleanUpFilesWithTTL error: sqlite transaction failed");
+        // delete files from disk storage, meta no longer refers to them so the lock isn't needed
+        int64_t clean_files = 0;
+        for (auto& file : removed_files) {
+            utils::DeleteCollectionFilePath(options_, file);
+
+            LOG_ENGINE_DEBUG_ << "Remove file id:" << file.file_id_ << " location:" << file.location_;
+            collection_ids.insert(file.collection_id_);
+            segment_ids.insert(std::make_pair(file.segment_id_, file));
+
+            ++clean_files;
         }
 
         if (clean_files > 0) {
@@ -1990,37 +2185,39 @@ SqliteMetaImpl::Count(const std::string& collection_id, uint64_t& result) {
     try {
         fiu_do_on("SqliteMetaImpl.Count.throw_exception", throw std::exception());
 
-        server::MetricCollector metric;
-
-        std::vector<int> file_types = {(int)SegmentSchema::RAW, (int)SegmentSchema::TO_INDEX,
-                                       (int)SegmentSchema::INDEX};
-        auto select_columns = columns(&SegmentSchema::row_count_);
-        decltype(ConnectorPtr->select(select_columns)) selected;
-        {
-            // multi-threads call sqlite update may get exception('bad logic', etc), so we add a lock here
-            std::lock_guard<std::mutex> meta_lock(meta_mutex_);
-            selected = ConnectorPtr->select(select_columns, where(in(&SegmentSchema::file_type_, file_types) and
-                                                                  c(&SegmentSchema::collection_id_) == collection_id));
-        }
-
-        CollectionSchema collection_schema;
-        collection_schema.collection_id_ = collection_id;
-        auto status = DescribeCollection(collection_schema);
-
-        if (!status.ok()) {
-            return status;
+        CollectionStats stats;
+        if (!stats_tracker_.GetCollectionStats(collection_id, stats)) {
+            return Status(DB_NOT_FOUND, "Collection " + collection_id + " not found");
         }
 
-        result = 0;
-        for (auto& file : selected) {
-            result += std::get<0>(file);
-        }
+        result = stats.row_count_;
     } catch (std::exception& e) {
         return HandleException("Encounter exception when calculate collection file size", e.what());
     }
     return Status::OK();
 }
 
+Status
+SqliteMetaImpl::GetCollectionStats(const std::string& collection_id, CollectionStats& stats,
+                                   std::vector<CollectionStats>& partitions_stats) {
+    fiu_return_on("SqliteMetaImpl.GetCollectionStats.not_found",
+                  Status(DB_NOT_FOUND, "Collection " + collection_id + " not found"));
+    if (!stats_tracker_.GetCollectionStats(collection_id, stats, partitions_stats)) {
+        return Status(DB_NOT_FOUND, "Collection " + collection_id + " not found");
+    }
+
+    return Status::OK();
+}
+
+Status
+SqliteMetaImpl::GetSegmentsStats(const std::string& collection_id, SegmentsStats& segments_stats) {
+    if (!stats_tracker_.GetSegmentsStats(collection_id, segments_stats)) {
+        return Status(DB_NOT_FOUND, "Collection " + collection_id + " not found");
+    }
+
+    return Status::OK();
+}
+
 Status
 SqliteMetaImpl::DropAll() {
     LOG_ENGINE_DEBUG_ << "Drop all sqlite meta";
@@ -2030,6 +2227,7 @@ SqliteMetaImpl::DropAll() {
         ConnectorPtr->drop_table(META_TABLEFILES);
         ConnectorPtr->drop_table(META_ENVIRONMENT);
         ConnectorPtr->drop_table(META_FIELDS);
+        stats_tracker_.Clear();
     } catch (std::exception& e) {
         return HandleException("Encounter exception when drop all meta", e.what());
     }
@@ -2086,6 +2284,7 @@ SqliteMetaImpl::DiscardFiles(int64_t to_discard_size) {
         if (!commited) {
             return HandleException("DiscardFiles error: sqlite transaction failed");
         }
+        ReloadStats({});
     } catch (std::exception& e) {
         return HandleException("Encounter exception when discard collection file", e.what());
     }
@@ -2153,7 +2352,10 @@ SqliteMetaImpl::CreateHybridCollection(meta::CollectionSchema& collection_schema
         std::lock_guard<std::mutex> meta_lock(meta_mutex_);
 
         if (collection_schema.collection_id_ == "") {
-            NextCollectionId(collection_schema.collection_id_);
+            auto status = NextCollectionId(collection_schema.collection_id_);
+            if (!status.ok()) {
+                return status;
+            }
         } else {
             fiu_do_on("SqliteMetaImpl.CreateCollection.throw_exception", throw std::exception());
             auto collection =
@@ -2181,6 +2383,7 @@ SqliteMetaImpl::CreateHybridCollection(meta::CollectionSchema& collection_schema
             return HandleException("Encounter exception when create collection", e.what());
         }
 
+        stats_tracker_.AddCollection(collection_schema);
         LOG_ENGINE_DEBUG_ << "Successfully create collection collection: " << collection_schema.collection_id_;
 
         Status status = utils::CreateCollectionPath(options_, collection_schema.collection_id_);
@@ -18,6 +18,7 @@
 
 #include "Meta.h"
 #include "db/Options.h"
+#include "db/meta/CollectionStatsTracker.h"
 
 namespace milvus {
 namespace engine {
@@ -151,6 +152,13 @@ class SqliteMetaImpl : public Meta {
     Status
     Count(const std::string& collection_id, uint64_t& result) override;
 
+    Status
+    GetCollectionStats(const std::string& collection_id, CollectionStats& stats,
+                       std::vector<CollectionStats>& partitions_stats) override;
+
+    Status
+    GetSegmentsStats(const std::string& collection_id, SegmentsStats& segments_stats) override;
+
     Status
     SetGlobalLastLSN(uint64_t lsn) override;
 
@@ -176,10 +184,19 @@ class SqliteMetaImpl : public Meta {
     Status
     Initialize();
 
+    void
+    LoadStats();
+    // refresh tracked files of the given collections from meta, all collections if empty, meta_mutex_ must be held
+    void
+    ReloadStats(const std::vector<std::string>& collection_ids);
+
  private:
     const DBMetaOptions options_;
     std::mutex meta_mutex_;
+    // serializes use of the reader connection and its prepared statements, writers don't take it
+    std::mutex reader_mutex_;
     std::mutex genid_mutex_;
+    CollectionStatsTracker stats_tracker_;
 };  // DBMetaImpl
 
 }  // namespace meta
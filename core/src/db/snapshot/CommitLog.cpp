@@ -0,0 +1,304 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "db/snapshot/CommitLog.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <fiu-local.h>
+#include <algorithm>
+#include <boost/crc.hpp>
+#include <boost/filesystem.hpp>
+
+#include "utils/Log.h"
+
+namespace milvus {
+namespace engine {
+namespace snapshot {
+
+namespace {
+
+constexpr const char* LOG_FILE_NAME = "snapshot.log";
+constexpr const char* CHECKPOINT_FILE_NAME = "snapshot.ckpt";
+constexpr uint32_t FRAME_MAGIC = 0x53534C47;  // "SSLG"
+constexpr size_t FRAME_HEADER_SIZE = 3 * sizeof(uint32_t);
+constexpr size_t CHECKPOINT_ENTRIES_PER_FRAME = 4096;
+
+uint32_t
+Crc32(const char* data, size_t size) {
+    boost::crc_32_type crc;
+    crc.process_bytes(data, size);
+    return crc.checksum();
+}
+
+Status
+IOError(const std::string& what, const std::string& path) {
+    std::string msg = what + " " + path + ": " + strerror(errno);
+    LOG_ENGINE_ERROR_ << msg;
+    return Status(SS_ERROR, msg);
+}
+
+std::string
+EncodeFrame(const LogEntries& entries, size_t begin, size_t end) {
+    std::string frame(FRAME_HEADER_SIZE, '\0');
+    for (size_t i = begin; i < end; ++i) {
+        frame.push_back((char)entries[i].op_);
+        frame.push_back((char)entries[i].type_);
+        EncodeRecord(entries[i].record_, frame);
+    }
+
+    uint32_t payload_size = frame.size() - FRAME_HEADER_SIZE;
+    uint32_t header[3] = {FRAME_MAGIC, payload_size, Crc32(frame.data() + FRAME_HEADER_SIZE, payload_size)};
+    memcpy(&frame[0], header, FRAME_HEADER_SIZE);
+    return frame;
+}
+
+bool
+WriteAll(int fd, const char* data, size_t size) {
+    while (size > 0) {
+        auto written = ::write(fd, data, size);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        data += written;
+        size -= written;
+    }
+    return true;
+}
+
+}  // namespace
+
+CommitLog::~CommitLog() {
+    Close();
+}
+
+Status
+CommitLog::Open(const std::string& dir) {
+    Close();
+
+    boost::system::error_code err;
+    boost::filesystem::create_directories(dir, err);
+    if (err) {
+        return Status(SS_ERROR, "Failed to create snapshot store directory " + dir + ": " + err.message());
+    }
+
+    dir_ = dir;
+    auto path = dir_ + "/" + LOG_FILE_NAME;
+    fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_APPEND, 0644);
+    if (fd_ < 0) {
+        return IOError("Failed to open snapshot commit log", path);
+    }
+    frames_ = 0;
+    return Status::OK();
+}
+
+void
+CommitLog::Close() {
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+}
+
+Status
+CommitLog::Replay(const LogEntryHandler& handler) {
+    if (!IsOpen()) {
+        return Status(SS_ERROR, "Snapshot commit log is not open");
+    }
+
+    int64_t valid_size = 0;
+    auto checkpoint_path = dir_ + "/" + CHECKPOINT_FILE_NAME;
+    if (boost::filesystem::exists(checkpoint_path)) {
+        auto status = ReadFrames(checkpoint_path, handler, valid_size);
+        if (!status.ok()) {
+            return status;
+        }
+        if (valid_size != (int64_t)boost::filesystem::file_size(checkpoint_path)) {
+            return Status(SS_ERROR, "Snapshot checkpoint " + checkpoint_path + " is corrupted");
+        }
+    }
+
+    auto log_path = dir_ + "/" + LOG_FILE_NAME;
+    auto status = ReadFrames(log_path, handler, valid_size);
+    if (!status.ok()) {
+        return status;
+    }
+
+    struct stat st;
+    if (fstat(fd_, &st) != 0) {
+        return IOError("Failed to stat snapshot commit log", log_path);
+    }
+    if (st.st_size > valid_size) {
+        LOG_ENGINE_WARNING_ << "Drop " << st.st_size - valid_size << " bytes of incomplete commits from " << log_path;
+        if (ftruncate(fd_, valid_size) != 0 || fdatasync(fd_) != 0) {
+            return IOError("Failed to truncate snapshot commit log", log_path);
+        }
+    }
+    return Status::OK();
+}
+
+Status
+CommitLog::ReadFrames(const std::string& path, const LogEntryHandler& handler, int64_t& valid_size) {
+    valid_size = 0;
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return IOError("Failed to open", path);
+    }
+
+    std::string content;
+    char buf[64 * 1024];
+    while (true) {
+        auto n = ::read(fd, buf, sizeof(buf));
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            break;
+        }
+        content.append(buf, n);
+    }
+    ::close(fd);
+
+    bool is_log = (path == dir_ + "/" + LOG_FILE_NAME);
+    const char* data = content.data();
+    const char* end = data + content.size();
+    while (end - data >= (int64_t)FRAME_HEADER_SIZE) {
+        uint32_t header[3];
+        memcpy(header, data, FRAME_HEADER_SIZE);
+        const char* payload = data + FRAME_HEADER_SIZE;
+        if (header[0] != FRAME_MAGIC || end - payload < (int64_t)header[1] || Crc32(payload, header[1]) != header[2]) {
+            break;
+        }
+
+        LogEntries entries;
+        const char* p = payload;
+        const char* payload_end = payload + header[1];
+        while (p < payload_end) {
+            LogEntry entry;
+            if (payload_end - p < 2) {
+                break;
+            }
+            entry.op_ = (LogOp)p[0];
+            entry.type_ = (uint8_t)p[1];
+            p += 2;
+            if (!DecodeRecord(p, payload_end, entry.record_)) {
+                break;
+            }
+            entries.emplace_back(std::move(entry));
+        }
+        if (p != payload_end) {
+            // checksum matched but the content doesn't parse, written by an incompatible version
+            return Status(SS_ERROR, "Unrecognized frame in " + path);
+        }
+
+        // a frame is one commit, it is applied entirely or not at all
+        for (auto& entry : entries) {
+            handler(entry);
+        }
+        data = payload_end;
+        if (is_log) {
+            ++frames_;
+        }
+    }
+
+    valid_size = data - content.data();
+    return Status::OK();
+}
+
+Status
+CommitLog::WriteFrames(int fd, const LogEntries& entries) {
+    for (size_t begin = 0; begin < entries.size(); begin += CHECKPOINT_ENTRIES_PER_FRAME) {
+        auto frame = EncodeFrame(entries, begin, std::min(entries.size(), begin + CHECKPOINT_ENTRIES_PER_FRAME));
+        bool fail = !WriteAll(fd, frame.data(), frame.size());
+        fiu_do_on("CommitLog.WriteFrames.fail", fail = true);
+        if (fail) {
+            return IOError("Failed to write snapshot commits to", dir_);
+        }
+    }
+    return Status::OK();
+}
+
+Status
+CommitLog::Append(const LogEntries& entries) {
+    if (!IsOpen()) {
+        return Status(SS_ERROR, "Snapshot commit log is not open");
+    }
+    if (entries.empty()) {
+        return Status::OK();
+    }
+
+    // a commit is always a single frame, however many entries it has
+    auto frame = EncodeFrame(entries, 0, entries.size());
+    auto offset = lseek(fd_, 0, SEEK_END);
+    bool fail = !WriteAll(fd_, frame.data(), frame.size()) || fdatasync(fd_) != 0;
+    fiu_do_on("CommitLog.Append.fail", fail = true);
+    if (fail) {
+        // cut a partially written frame, otherwise replay would stop there and lose every later commit
+        if (offset >= 0 && ftruncate(fd_, offset) != 0) {
+            LOG_ENGINE_ERROR_ << "Failed to cut partial frame from snapshot commit log " << dir_;
+        }
+        return IOError("Failed to append snapshot commits to", dir_ + "/" + LOG_FILE_NAME);
+    }
+
+    ++frames_;
+    return Status::OK();
+}
+
+Status
+CommitLog::Checkpoint(const LogEntries& entries) {
+    if (!IsOpen()) {
+        return Status(SS_ERROR, "Snapshot commit log is not open");
+    }
+
+    auto path = dir_ + "/" + CHECKPOINT_FILE_NAME;
+    auto tmp_path = path + ".tmp";
+    int fd = ::open(tmp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        return IOError("Failed to create snapshot checkpoint", tmp_path);
+    }
+
+    auto status = WriteFrames(fd, entries);
+    if (status.ok() && fsync(fd) != 0) {
+        status = IOError("Failed to sync snapshot checkpoint", tmp_path);
+    }
+    ::close(fd);
+    if (!status.ok()) {
+        ::unlink(tmp_path.c_str());
+        return status;
+    }
+
+    if (::rename(tmp_path.c_str(), path.c_str()) != 0) {
+        return IOError("Failed to install snapshot checkpoint", path);
+    }
+    int dir_fd = ::open(dir_.c_str(), O_RDONLY);
+    if (dir_fd >= 0) {
+        fsync(dir_fd);
+        ::close(dir_fd);
+    }
+
+    // entries still in the log are already part of the checkpoint, replaying them again is harmless
+    if (ftruncate(fd_, 0) != 0 || fdatasync(fd_) != 0) {
+        return IOError("Failed to reset snapshot commit log", dir_ + "/" + LOG_FILE_NAME);
+    }
+    frames_ = 0;
+    return Status::OK();
+}
+
+}  // namespace snapshot
+}  // namespace engine
+}  // namespace milvus
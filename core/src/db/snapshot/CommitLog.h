@@ -0,0 +1,92 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "db/snapshot/ResourceRecord.h"
+#include "utils/Status.h"
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace milvus {
+namespace engine {
+namespace snapshot {
+
+enum class LogOp : uint8_t {
+    PUT = 1,
+    REMOVE = 2,
+    SEQUENCE = 3,  // id high-water mark of a resource type, only found in checkpoints
+};
+
+struct LogEntry {
+    LogOp op_ = LogOp::PUT;
+    uint8_t type_ = 0;  // index of the resource type in the store
+    ResourceRecord record_;
+};
+
+using LogEntries = std::vector<LogEntry>;
+using LogEntryHandler = std::function<void(const LogEntry&)>;
+
+// Append-only log of store mutations. Every Append writes one frame (magic, payload size, crc32, payload) and syncs
+// it; a checkpoint writes the whole store to a separate file and starts an empty log. Replay stops at the first
+// torn or corrupted frame and cuts the log there.
+class CommitLog {
+ public:
+    CommitLog() = default;
+    ~CommitLog();
+
+    CommitLog(const CommitLog&) = delete;
+    CommitLog&
+    operator=(const CommitLog&) = delete;
+
+    Status
+    Open(const std::string& dir);
+
+    void
+    Close();
+
+    bool
+    IsOpen() const {
+        return fd_ >= 0;
+    }
+
+    Status
+    Replay(const LogEntryHandler& handler);
+
+    Status
+    Append(const LogEntries& entries);
+
+    Status
+    Checkpoint(const LogEntries& entries);
+
+    uint64_t
+    FramesSinceCheckpoint() const {
+        return frames_;
+    }
+
+ private:
+    Status
+    ReadFrames(const std::string& path, const LogEntryHandler& handler, int64_t& valid_size);
+
+    Status
+    WriteFrames(int fd, const LogEntries& entries);
+
+ private:
+    std::string dir_;
+    int fd_ = -1;
+    uint64_t frames_ = 0;
+};
+
+}  // namespace snapshot
+}  // namespace engine
+}  // namespace milvus
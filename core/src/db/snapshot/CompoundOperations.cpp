@@ -219,13 +219,28 @@ MergeOperation::CommitNewSegmentFile(const SegmentFileContext& context, SegmentF
     return status;
 }
 
+Status
+MergeOperation::CheckSegmentsStale(ScopedSnapshotT& latest_snapshot) const {
+    for (auto& segment : context_.stale_segments) {
+        if (!latest_snapshot->GetResource<Segment>(segment->GetID())) {
+            return Status(SS_STALE_ERROR, "MergeOperation source segment is stale");
+        }
+    }
+    return Status::OK();
+}
+
 Status
 MergeOperation::DoExecute(Store& store) {
     // PXU TODO:
     // 1. Check all requried field elements have related segment files
     // 2. Check Stale and others
+    // another merge committed in between may already have replaced some of the source segments
+    auto status = CheckStale(std::bind(&MergeOperation::CheckSegmentsStale, this, std::placeholders::_1));
+    if (!status.ok())
+        return status;
+
     SegmentCommitOperation op(context_, context_.prev_ss);
-    auto status = op(store);
+    status = op(store);
     if (!status.ok())
         return status;
 
@@ -104,6 +104,10 @@ class MergeOperation : public CompoundBaseOperation<MergeOperation> {
     CommitNewSegment(SegmentPtr&);
     Status
     CommitNewSegmentFile(const SegmentFileContext& context, SegmentFilePtr&);
+
+ protected:
+    Status
+    CheckSegmentsStale(ScopedSnapshotT& latest_snapshot) const;
 };
 
 class CreateCollectionOperation : public CompoundBaseOperation<CreateCollectionOperation> {
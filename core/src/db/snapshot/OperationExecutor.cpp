@@ -11,12 +11,17 @@
 
 #include "db/snapshot/OperationExecutor.h"
 #include <iostream>
+#include <vector>
 
 namespace milvus {
 namespace engine {
 namespace snapshot {
 
 OperationExecutor::OperationExecutor() {
+    // commits mostly wait on the commit log sync rather than on cpu, so the count doesn't follow the core count
+    for (size_t i = 0; i < WORKER_COUNT; ++i) {
+        queues_.push_back(std::make_shared<OperationQueue>());
+    }
 }
 
 OperationExecutor::~OperationExecutor() {
@@ -37,13 +42,15 @@ OperationExecutor::Submit(OperationsPtr operation, bool sync) {
     /* return true; */
     Enqueue(operation);
     if (sync)
-        return operation->WaitToFinish();
+        return operation->WaitToCommit();
     return Status::OK();
 }
 
 void
 OperationExecutor::Start() {
-    thread_ = std::thread(&OperationExecutor::ThreadMain, this);
+    for (auto& queue : queues_) {
+        threads_.emplace_back(&OperationExecutor::ThreadMain, this, queue);
+    }
     running_ = true;
     /* std::cout << "OperationExecutor Started" << std::endl; */
 }
@@ -53,8 +60,13 @@ OperationExecutor::Stop() {
     if (!running_)
         return;
 
-    Enqueue(nullptr);
-    thread_.join();
+    for (auto& queue : queues_) {
+        queue->Put(nullptr);
+    }
+    for (auto& thread : threads_) {
+        thread.join();
+    }
+    threads_.clear();
     running_ = false;
     std::cout << "OperationExecutor Stopped" << std::endl;
 }
@@ -62,21 +74,42 @@ OperationExecutor::Stop() {
 void
 OperationExecutor::Enqueue(OperationsPtr operation) {
     /* std::cout << std::this_thread::get_id() << " Enqueue Operation " << operation->GetID() << std::endl; */
-    queue_.Put(operation);
+    auto collection_id = operation->GetCollectionId();
+    queues_[collection_id % queues_.size()]->Put(operation);
 }
 
 void
-OperationExecutor::ThreadMain() {
-    while (true) {
-        OperationsPtr operation = queue_.Take();
-        if (!operation) {
-            std::cout << "Stopping operation executor thread " << std::this_thread::get_id() << std::endl;
-            break;
+OperationExecutor::ThreadMain(OperationQueuePtr queue) {
+    auto& store = Store::GetInstance();
+    std::vector<OperationsPtr> batch;
+    bool stopping = false;
+    while (!stopping) {
+        // take whatever has queued up behind the first operation, the whole batch is committed with one sync
+        OperationsPtr operation = queue->Take();
+        while (operation) {
+            batch.push_back(operation);
+            if (batch.size() >= MAX_BATCH_SIZE || queue->Empty()) {
+                break;
+            }
+            operation = queue->Take();
         }
-        /* std::cout << std::this_thread::get_id() << " Dequeue Operation " << operation->GetID() << std::endl; */
+        stopping = !operation;
 
-        Store::GetInstance().Apply(*operation);
+        if (!batch.empty()) {
+            store.StartTransanction();
+            for (auto& op : batch) {
+                /* std::cout << std::this_thread::get_id() << " Dequeue Operation " << op->GetID() << std::endl; */
+                store.Apply(*op);
+            }
+            auto status = store.FinishTransaction();
+            for (auto& op : batch) {
+                op->MarkCommitted(status);
+            }
+            // operations pin their snapshots, don't keep them until the next batch arrives
+            batch.clear();
+        }
     }
+    std::cout << "Stopping operation executor thread " << std::this_thread::get_id() << std::endl;
 }
 
 }  // namespace snapshot
@@ -13,6 +13,7 @@
 #include <memory>
 #include <mutex>
 #include <thread>
+#include <vector>
 #include "Operations.h"
 #include "Store.h"
 #include "utils/BlockingQueue.h"
@@ -25,6 +26,8 @@ using ThreadPtr = std::shared_ptr<std::thread>;
 using OperationQueue = server::BlockingQueue<OperationsPtr>;
 using OperationQueuePtr = std::shared_ptr<OperationQueue>;
 
+// Operations are executed by several threads, each with its own queue. Operations of one collection always go to
+// the same queue so they are applied in the order they were submitted, while other collections commit concurrently.
 class OperationExecutor {
  public:
     using Ptr = std::shared_ptr<OperationExecutor>;
@@ -49,16 +52,19 @@ class OperationExecutor {
     OperationExecutor();
 
     void
-    ThreadMain();
+    ThreadMain(OperationQueuePtr queue);
 
     void
     Enqueue(OperationsPtr operation);
 
  protected:
+    static constexpr size_t MAX_BATCH_SIZE = 64;
+    static constexpr size_t WORKER_COUNT = 8;
+
     mutable std::mutex mtx_;
     bool running_ = false;
-    std::thread thread_;
-    OperationQueue queue_;
+    std::vector<std::thread> threads_;
+    std::vector<OperationQueuePtr> queues_;
 };
 
 }  // namespace snapshot
@@ -92,6 +92,23 @@ Operations::WaitToFinish() {
     return status_;
 }
 
+Status
+Operations::WaitToCommit() {
+    std::unique_lock<std::mutex> lock(finish_mtx_);
+    finish_cond_.wait(lock, [this] { return committed_; });
+    return status_;
+}
+
+void
+Operations::MarkCommitted(const Status& status) {
+    std::unique_lock<std::mutex> lock(finish_mtx_);
+    committed_ = true;
+    if (status_.ok() && !status.ok()) {
+        status_ = status;
+    }
+    finish_cond_.notify_all();
+}
+
 void
 Operations::Done(Store& store) {
     std::unique_lock<std::mutex> lock(finish_mtx_);
@@ -79,6 +79,12 @@ class Operations : public std::enable_shared_from_this<Operations> {
         return type_;
     }
 
+    // Operations of the same collection are executed in the order they were pushed
+    virtual ID_TYPE
+    GetCollectionId() const {
+        return prev_ss_ ? prev_ss_->GetCollectionId() : 0;
+    }
+
     virtual Status
     OnExecute(Store&);
     virtual Status
@@ -105,9 +111,16 @@ class Operations : public std::enable_shared_from_this<Operations> {
     Status
     WaitToFinish();
 
+    // Waits until the executor has made the operation durable, which may be some time after it is done
+    Status
+    WaitToCommit();
+
     void
     Done(Store& store);
 
+    void
+    MarkCommitted(const Status& status);
+
     void
     SetStatus(const Status& status);
 
@@ -160,6 +173,7 @@ class Operations : public std::enable_shared_from_this<Operations> {
     StepsT steps_;
     std::vector<ID_TYPE> ids_;
     bool done_ = false;
+    bool committed_ = false;
     Status status_;
     mutable std::mutex finish_mtx_;
     std::condition_variable finish_cond_;
@@ -0,0 +1,172 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "db/snapshot/ResourceRecord.h"
+
+#include <string.h>
+
+namespace milvus {
+namespace engine {
+namespace snapshot {
+
+namespace {
+
+template <typename T>
+void
+Put(std::string& buffer, const T& value) {
+    buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+bool
+Get(const char*& data, const char* end, T& value) {
+    if (end - data < (int64_t)sizeof(T)) {
+        return false;
+    }
+    memcpy(&value, data, sizeof(T));
+    data += sizeof(T);
+    return true;
+}
+
+}  // namespace
+
+void
+EncodeRecord(const ResourceRecord& record, std::string& buffer) {
+    Put(buffer, (uint32_t)record.name_.size());
+    buffer.append(record.name_);
+    Put(buffer, record.id_);
+    Put(buffer, record.collection_id_);
+    Put(buffer, record.schema_id_);
+    Put(buffer, record.field_id_);
+    Put(buffer, record.partition_id_);
+    Put(buffer, record.segment_id_);
+    Put(buffer, record.field_element_id_);
+    Put(buffer, record.num_);
+    Put(buffer, record.ftype_);
+    Put(buffer, record.lsn_);
+    Put(buffer, record.status_);
+    Put(buffer, record.created_on_);
+    Put(buffer, record.updated_on_);
+    Put(buffer, (uint32_t)record.mappings_.size());
+    for (auto id : record.mappings_) {
+        Put(buffer, id);
+    }
+}
+
+bool
+DecodeRecord(const char*& data, const char* end, ResourceRecord& record) {
+    uint32_t name_size = 0;
+    if (!Get(data, end, name_size) || end - data < (int64_t)name_size) {
+        return false;
+    }
+    record.name_.assign(data, name_size);
+    data += name_size;
+
+    bool ok = Get(data, end, record.id_) && Get(data, end, record.collection_id_) &&
+              Get(data, end, record.schema_id_) && Get(data, end, record.field_id_) &&
+              Get(data, end, record.partition_id_) && Get(data, end, record.segment_id_) &&
+              Get(data, end, record.field_element_id_) && Get(data, end, record.num_) &&
+              Get(data, end, record.ftype_) && Get(data, end, record.lsn_) && Get(data, end, record.status_) &&
+              Get(data, end, record.created_on_) && Get(data, end, record.updated_on_);
+    uint32_t mapping_count = 0;
+    if (!ok || !Get(data, end, mapping_count)) {
+        return false;
+    }
+
+    record.mappings_.clear();
+    for (uint32_t i = 0; i < mapping_count; ++i) {
+        ID_TYPE id = 0;
+        if (!Get(data, end, id)) {
+            return false;
+        }
+        record.mappings_.insert(id);
+    }
+    return true;
+}
+
+template <>
+CollectionPtr
+FromRecord<Collection>(const ResourceRecord& r) {
+    return std::make_shared<Collection>(r.name_, r.id_, r.lsn_, (State)r.status_, r.created_on_, r.updated_on_);
+}
+
+template <>
+SchemaCommitPtr
+FromRecord<SchemaCommit>(const ResourceRecord& r) {
+    return std::make_shared<SchemaCommit>(r.collection_id_, r.mappings_, r.id_, r.lsn_, (State)r.status_,
+                                          r.created_on_, r.updated_on_);
+}
+
+template <>
+FieldCommitPtr
+FromRecord<FieldCommit>(const ResourceRecord& r) {
+    return std::make_shared<FieldCommit>(r.collection_id_, r.field_id_, r.mappings_, r.id_, r.lsn_, (State)r.status_,
+                                         r.created_on_, r.updated_on_);
+}
+
+template <>
+FieldPtr
+FromRecord<Field>(const ResourceRecord& r) {
+    return std::make_shared<Field>(r.name_, r.num_, r.id_, r.lsn_, (State)r.status_, r.created_on_, r.updated_on_);
+}
+
+template <>
+FieldElementPtr
+FromRecord<FieldElement>(const ResourceRecord& r) {
+    return std::make_shared<FieldElement>(r.collection_id_, r.field_id_, r.name_, r.ftype_, r.id_, r.lsn_,
+                                          (State)r.status_, r.created_on_, r.updated_on_);
+}
+
+template <>
+CollectionCommitPtr
+FromRecord<CollectionCommit>(const ResourceRecord& r) {
+    return std::make_shared<CollectionCommit>(r.collection_id_, r.schema_id_, r.mappings_, r.id_, r.lsn_,
+                                              (State)r.status_, r.created_on_, r.updated_on_);
+}
+
+template <>
+PartitionPtr
+FromRecord<Partition>(const ResourceRecord& r) {
+    return std::make_shared<Partition>(r.name_, r.collection_id_, r.id_, r.lsn_, (State)r.status_, r.created_on_,
+                                       r.updated_on_);
+}
+
+template <>
+PartitionCommitPtr
+FromRecord<PartitionCommit>(const ResourceRecord& r) {
+    return std::make_shared<PartitionCommit>(r.collection_id_, r.partition_id_, r.mappings_, r.id_, r.lsn_,
+                                             (State)r.status_, r.created_on_, r.updated_on_);
+}
+
+template <>
+SegmentPtr
+FromRecord<Segment>(const ResourceRecord& r) {
+    return std::make_shared<Segment>(r.partition_id_, r.num_, r.id_, r.lsn_, (State)r.status_, r.created_on_,
+                                     r.updated_on_);
+}
+
+template <>
+SegmentCommitPtr
+FromRecord<SegmentCommit>(const ResourceRecord& r) {
+    return std::make_shared<SegmentCommit>(r.schema_id_, r.partition_id_, r.segment_id_, r.mappings_, r.id_, r.lsn_,
+                                           (State)r.status_, r.created_on_, r.updated_on_);
+}
+
+template <>
+SegmentFilePtr
+FromRecord<SegmentFile>(const ResourceRecord& r) {
+    return std::make_shared<SegmentFile>(r.partition_id_, r.segment_id_, r.field_element_id_, r.id_, r.lsn_,
+                                         (State)r.status_, r.created_on_, r.updated_on_);
+}
+
+}  // namespace snapshot
+}  // namespace engine
+}  // namespace milvus
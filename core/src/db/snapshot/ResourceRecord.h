@@ -0,0 +1,130 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "db/snapshot/ResourceTypes.h"
+#include "db/snapshot/Resources.h"
+
+#include <string>
+#include <type_traits>
+
+namespace milvus {
+namespace engine {
+namespace snapshot {
+
+// Flat form of a snapshot resource as written to the commit log. Fields a resource type doesn't carry stay zero.
+struct ResourceRecord {
+    std::string name_;
+    ID_TYPE id_ = 0;
+    ID_TYPE collection_id_ = 0;
+    ID_TYPE schema_id_ = 0;
+    ID_TYPE field_id_ = 0;
+    ID_TYPE partition_id_ = 0;
+    ID_TYPE segment_id_ = 0;
+    ID_TYPE field_element_id_ = 0;
+    NUM_TYPE num_ = 0;
+    FTYPE_TYPE ftype_ = 0;
+    LSN_TYPE lsn_ = 0;
+    int32_t status_ = PENDING;
+    TS_TYPE created_on_ = 0;
+    TS_TYPE updated_on_ = 0;
+    MappingT mappings_;
+};
+
+void
+EncodeRecord(const ResourceRecord& record, std::string& buffer);
+
+// returns false if the buffer ends before the record does
+bool
+DecodeRecord(const char*& data, const char* end, ResourceRecord& record);
+
+template <typename ResourceT>
+void
+ToRecord(const ResourceT& resource, ResourceRecord& record) {
+    record.id_ = resource.GetID();
+    record.lsn_ = resource.GetLsn();
+    record.status_ = resource.GetStatus();
+    record.created_on_ = resource.GetCreatedTime();
+    record.updated_on_ = resource.GetUpdatedTime();
+    if constexpr (std::is_base_of<NameField, ResourceT>::value) {
+        record.name_ = resource.GetName();
+    }
+    if constexpr (std::is_base_of<CollectionIdField, ResourceT>::value) {
+        record.collection_id_ = resource.GetCollectionId();
+    }
+    if constexpr (std::is_base_of<SchemaIdField, ResourceT>::value) {
+        record.schema_id_ = resource.GetSchemaId();
+    }
+    if constexpr (std::is_base_of<FieldIdField, ResourceT>::value) {
+        record.field_id_ = resource.GetFieldId();
+    }
+    if constexpr (std::is_base_of<PartitionIdField, ResourceT>::value) {
+        record.partition_id_ = resource.GetPartitionId();
+    }
+    if constexpr (std::is_base_of<SegmentIdField, ResourceT>::value) {
+        record.segment_id_ = resource.GetSegmentId();
+    }
+    if constexpr (std::is_base_of<FieldElementIdField, ResourceT>::value) {
+        record.field_element_id_ = resource.GetFieldElementId();
+    }
+    if constexpr (std::is_base_of<NumField, ResourceT>::value) {
+        record.num_ = resource.GetNum();
+    }
+    if constexpr (std::is_base_of<FtypeField, ResourceT>::value) {
+        record.ftype_ = resource.GetFtype();
+    }
+    if constexpr (std::is_base_of<MappingsField, ResourceT>::value) {
+        record.mappings_ = resource.GetMappings();
+    }
+}
+
+template <typename ResourceT>
+typename ResourceT::Ptr
+FromRecord(const ResourceRecord& record);
+
+template <>
+CollectionPtr
+FromRecord<Collection>(const ResourceRecord& record);
+template <>
+SchemaCommitPtr
+FromRecord<SchemaCommit>(const ResourceRecord& record);
+template <>
+FieldCommitPtr
+FromRecord<FieldCommit>(const ResourceRecord& record);
+template <>
+FieldPtr
+FromRecord<Field>(const ResourceRecord& record);
+template <>
+FieldElementPtr
+FromRecord<FieldElement>(const ResourceRecord& record);
+template <>
+CollectionCommitPtr
+FromRecord<CollectionCommit>(const ResourceRecord& record);
+template <>
+PartitionPtr
+FromRecord<Partition>(const ResourceRecord& record);
+template <>
+PartitionCommitPtr
+FromRecord<PartitionCommit>(const ResourceRecord& record);
+template <>
+SegmentPtr
+FromRecord<Segment>(const ResourceRecord& record);
+template <>
+SegmentCommitPtr
+FromRecord<SegmentCommit>(const ResourceRecord& record);
+template <>
+SegmentFilePtr
+FromRecord<SegmentFile>(const ResourceRecord& record);
+
+}  // namespace snapshot
+}  // namespace engine
+}  // namespace milvus
@@ -59,7 +59,7 @@ Field::Field(const std::string& name, NUM_TYPE num, ID_TYPE id, LSN_TYPE lsn, St
       LsnField(lsn),
       StatusField(status),
       CreatedOnField(created_on),
-      UpdatedOnField(updated_on_) {
+      UpdatedOnField(updated_on) {
 }
 
 FieldElement::FieldElement(ID_TYPE collection_id, ID_TYPE field_id, const std::string& name, FTYPE_TYPE ftype,
@@ -12,10 +12,17 @@
 #include "db/snapshot/Snapshots.h"
 #include "db/snapshot/CompoundOperations.h"
 
+#include <algorithm>
+#include <iostream>
+
 namespace milvus {
 namespace engine {
 namespace snapshot {
 
+namespace {
+constexpr size_t MAX_LOAD_WORKERS = 8;
+}  // namespace
+
 Status
 Snapshots::DropCollection(ID_TYPE collection_id, const LSN_TYPE& lsn) {
     ScopedSnapshotT ss;
@@ -136,12 +143,29 @@ Snapshots::Init() {
     auto op = std::make_shared<GetCollectionIDsOperation>();
     op->Push();
     auto& collection_ids = op->GetIDs();
-    SnapshotHolderPtr holder;
-    // TODO
-    for (auto collection_id : collection_ids) {
-        /* GetHolder(collection_id, holder); */
-        auto& store = Store::GetInstance();
-        LoadHolder(store, collection_id, holder);
+    auto& store = Store::GetInstance();
+
+    // collections are independent of each other, load them from several threads
+    std::atomic<size_t> next(0);
+    auto loader = [&]() {
+        SnapshotHolderPtr holder;
+        for (auto i = next++; i < collection_ids.size(); i = next++) {
+            auto status = LoadHolder(store, collection_ids[i], holder);
+            if (!status.ok()) {
+                std::cerr << "Failed to load snapshots of collection " << collection_ids[i] << ": "
+                          << status.message() << std::endl;
+            }
+        }
+    };
+
+    size_t worker_count = std::min<size_t>(collection_ids.size(), MAX_LOAD_WORKERS);
+    std::vector<std::thread> workers;
+    for (size_t i = 1; i < worker_count; ++i) {
+        workers.emplace_back(loader);
+    }
+    loader();
+    for (auto& worker : workers) {
+        worker.join();
     }
 }
 
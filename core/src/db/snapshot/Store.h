@@ -11,24 +11,30 @@
 
 #pragma once
 
+#include "db/snapshot/CommitLog.h"
 #include "db/snapshot/ResourceTypes.h"
 #include "db/snapshot/Resources.h"
 #include "db/snapshot/Utils.h"
+#include "utils/Log.h"
 #include "utils/Status.h"
 
 #include <stdlib.h>
 #include <time.h>
+#include <algorithm>
 #include <any>
+#include <condition_variable>
 #include <functional>
 #include <iomanip>
 #include <iostream>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <shared_mutex>
 #include <sstream>
 #include <string>
 #include <thread>
 #include <tuple>
+#include <type_traits>
 #include <typeindex>
 #include <typeinfo>
 #include <unordered_map>
@@ -53,27 +59,79 @@ class Store {
         return store;
     }
 
+    // Makes the store durable: replaces the in-memory state with what was committed under path and logs every
+    // later mutation there. Without Open the store only lives in memory.
+    Status
+    Open(const std::string& path) {
+        std::unique_lock<std::shared_timed_mutex> lock(mutex_);
+        std::lock_guard<std::mutex> log_lock(log_mutex_);
+        DoReset();
+        pending_.clear();
+        ReleaseCheckpointNoLock();
+        auto status = log_.Open(path);
+        if (!status.ok()) {
+            return status;
+        }
+        status = log_.Replay([this](const LogEntry& entry) {
+            ReplayEntry(entry, std::make_index_sequence<std::tuple_size<MockResourcesT>::value>{});
+        });
+        if (!status.ok()) {
+            log_.Close();
+        }
+        return status;
+    }
+
+    void
+    Close() {
+        std::lock_guard<std::mutex> log_lock(log_mutex_);
+        log_.Close();
+        pending_.clear();
+        ReleaseCheckpointNoLock();
+    }
+
+    // Writes all resources to a new checkpoint and empties the commit log
+    Status
+    Checkpoint() {
+        std::shared_lock<std::shared_timed_mutex> lock(mutex_);
+        std::lock_guard<std::mutex> log_lock(log_mutex_);
+        if (!log_.IsOpen()) {
+            return Status::OK();
+        }
+        if (open_txns_ > 0) {
+            return Status(SS_ERROR, "Cannot checkpoint the store while transactions are open");
+        }
+        return CheckpointNoLock();
+    }
+
+    // Creates the resources in one transaction, stops at the first failure
     template <typename... ResourceT>
-    bool
+    Status
     DoCommit(ResourceT&&... resources) {
-        auto t = std::make_tuple(std::forward<ResourceT>(resources)...);
-        auto& t_size = std::tuple_size<decltype(t)>::value;
-        if (t_size == 0)
-            return false;
+        if (sizeof...(resources) == 0) {
+            return Status(SS_INVALID_ARGUMENT_ERROR, "No resource to commit");
+        }
         StartTransanction();
-        std::apply([this](auto&&... resource) { ((std::cout << CommitResource(resource) << "\n"), ...); }, t);
-        FinishTransaction();
-        return true;
+        Status status;
+        auto commit = [&](auto&& resource) {
+            if (status.ok()) {
+                status = CommitResource(std::forward<decltype(resource)>(resource));
+            }
+        };
+        (commit(std::forward<ResourceT>(resources)), ...);
+        auto finish_status = FinishTransaction();
+        return status.ok() ? finish_status : status;
     }
 
     template <typename OpT>
     Status
     DoCommitOperation(OpT& op) {
+        // all steps of an operation land in the same log frame
+        StartTransanction();
         for (auto& step_v : op.GetSteps()) {
             auto id = ProcessOperationStep(step_v);
             op.SetStepResult(id);
         }
-        return Status::OK();
+        return FinishTransaction();
     }
 
     template <typename OpT>
@@ -82,21 +140,51 @@ class Store {
         op.ApplyToStore(*this);
     }
 
+    // Mutations made by this thread until the outermost FinishTransaction are written to the commit log as one
+    // frame with a single sync. Nested transactions join the outer one, other threads keep their own.
+    // A new outermost transaction waits while a checkpoint is draining the open ones.
     void
     StartTransanction() {
+        auto& txn = CurrentTransaction();
+        if (txn.depth_++ == 0) {
+            std::unique_lock<std::mutex> log_lock(log_mutex_);
+            checkpoint_cv_.wait(log_lock, [this] { return !checkpoint_pending_; });
+            ++open_txns_;
+        }
     }
-    void
+
+    Status
     FinishTransaction() {
+        auto& txn = CurrentTransaction();
+        if (txn.depth_ == 0 || --txn.depth_ > 0) {
+            return Status::OK();
+        }
+
+        Status status;
+        bool checkpoint = false;
+        {
+            std::lock_guard<std::mutex> log_lock(log_mutex_);
+            --open_txns_;
+            if (!txn.entries_.empty() && log_.IsOpen()) {
+                status = log_.Append(txn.entries_);
+            }
+            txn.entries_.clear();
+            checkpoint = (status.ok() && log_.FramesSinceCheckpoint() >= CHECKPOINT_INTERVAL) ||
+                         (checkpoint_pending_ && open_txns_ == 0);
+        }
+        return checkpoint ? MaybeCheckpoint() : status;
     }
 
     template <typename ResourceT>
-    bool
+    Status
     CommitResource(ResourceT&& resource) {
-        std::cout << "Commit " << resource.Name << " " << resource.GetID() << std::endl;
-        auto res = CreateResource<typename std::remove_reference<ResourceT>::type>(std::move(resource));
-        if (!res)
-            return false;
-        return true;
+        using T = typename std::remove_cv<typename std::remove_reference<ResourceT>::type>::type;
+        typename T::Ptr res;
+        auto status = CreateResource<T>(T(std::forward<ResourceT>(resource)), res);
+        if (status.ok() && res) {
+            LOG_ENGINE_DEBUG_ << "Commit " << T::Name << " " << res->GetID();
+        }
+        return status;
     }
 
     template <typename ResourceT>
@@ -142,10 +230,12 @@ class Store {
         }
 
         auto name = it->second->GetName();
+        RecordNoLock(LogOp::REMOVE, *it->second);
         resources.erase(it);
         name_ids_.erase(name);
+        lock.unlock();
         /* std::cout << ">>> [Remove] Collection " << id << std::endl; */
-        return Status::OK();
+        return Flush();
     }
 
     template <typename ResourceT>
@@ -158,9 +248,11 @@ class Store {
             return Status(SS_NOT_FOUND_ERROR, "DB resource not found");
         }
 
+        RecordNoLock(LogOp::REMOVE, *it->second);
         resources.erase(it);
+        lock.unlock();
         /* std::cout << ">>> [Remove] " << ResourceT::Name << " " << id << std::endl; */
-        return Status::OK();
+        return Flush();
     }
 
     IDS_TYPE
@@ -215,9 +307,10 @@ class Store {
         c->ResetCnt();
         resources[c->GetID()] = c;
         name_ids_[c->GetName()] = c->GetID();
+        RecordNoLock(LogOp::PUT, *c);
         lock.unlock();
         GetResource<Collection>(c->GetID(), return_v);
-        return Status::OK();
+        return Flush();
     }
 
     template <typename ResourceT>
@@ -229,9 +322,10 @@ class Store {
         auto& id = std::get<Index<typename ResourceT::MapT, MockResourcesT>::value>(ids_);
         res->ResetCnt();
         resources[res->GetID()] = res;
+        RecordNoLock(LogOp::PUT, *res);
         lock.unlock();
         GetResource<ResourceT>(res->GetID(), return_v);
-        return Status::OK();
+        return Flush();
     }
 
     template <typename ResourceT>
@@ -247,10 +341,11 @@ class Store {
         res->SetID(++id);
         res->ResetCnt();
         resources[res->GetID()] = res;
+        RecordNoLock(LogOp::PUT, *res);
         lock.unlock();
         auto status = GetResource<ResourceT>(res->GetID(), return_v);
         /* std::cout << ">>> [Create] " << ResourceT::Name << " " << id << std::endl; */
-        return Status::OK();
+        return Flush();
     }
 
     void
@@ -263,10 +358,177 @@ class Store {
     void
     Mock() {
         DoReset();
+        StartTransanction();
         DoMock();
+        FinishTransaction();
     }
 
  private:
+    static constexpr uint64_t CHECKPOINT_INTERVAL = 1024;
+
+    struct Transaction {
+        int depth_ = 0;
+        LogEntries entries_;
+    };
+
+    static Transaction&
+    CurrentTransaction() {
+        thread_local Transaction txn;
+        return txn;
+    }
+
+    // Queues a mutation for the commit log, called with mutex_ held so the log keeps the order of the map updates.
+    // Inside a transaction it is kept with the transaction instead, resources of one collection are only written
+    // by one thread at a time so transactions of different threads don't reorder each other's updates.
+    template <typename ResourceT>
+    void
+    RecordNoLock(LogOp op, const ResourceT& resource) {
+        std::lock_guard<std::mutex> log_lock(log_mutex_);
+        if (!log_.IsOpen()) {
+            return;
+        }
+        LogEntry entry;
+        entry.op_ = op;
+        entry.type_ = Index<typename ResourceT::MapT, MockResourcesT>::value;
+        if (op == LogOp::REMOVE) {
+            entry.record_.id_ = resource.GetID();
+        } else {
+            ToRecord(resource, entry.record_);
+        }
+        auto& txn = CurrentTransaction();
+        if (txn.depth_ > 0) {
+            txn.entries_.emplace_back(std::move(entry));
+        } else {
+            pending_.emplace_back(std::move(entry));
+        }
+    }
+
+    // Writes mutations made outside of transactions
+    Status
+    Flush() {
+        if (CurrentTransaction().depth_ > 0) {
+            return Status::OK();
+        }
+        {
+            std::lock_guard<std::mutex> log_lock(log_mutex_);
+            if (pending_.empty()) {
+                return Status::OK();
+            }
+            auto status = log_.Append(pending_);
+            pending_.clear();
+            if (!status.ok() || log_.FramesSinceCheckpoint() < CHECKPOINT_INTERVAL) {
+                return status;
+            }
+        }
+        return MaybeCheckpoint();
+    }
+
+    // Checkpoints once the log has grown long enough. A checkpoint must not catch a transaction with half of its
+    // changes in memory, so while transactions are open new ones are held back and the last one to finish
+    // writes the checkpoint. Otherwise busy collections would keep the log from ever being checkpointed.
+    Status
+    MaybeCheckpoint() {
+        std::shared_lock<std::shared_timed_mutex> lock(mutex_);
+        std::lock_guard<std::mutex> log_lock(log_mutex_);
+        if (!log_.IsOpen() || log_.FramesSinceCheckpoint() < CHECKPOINT_INTERVAL) {
+            ReleaseCheckpointNoLock();
+            return Status::OK();
+        }
+        if (open_txns_ > 0) {
+            checkpoint_pending_ = true;
+            return Status::OK();
+        }
+        return CheckpointNoLock();
+    }
+
+    Status
+    CheckpointNoLock() {
+        LogEntries entries;
+        std::apply([&](auto&... resources) { (CollectEntries(resources, entries), ...); }, resources_);
+        CollectSequences(entries, std::make_index_sequence<std::tuple_size<MockIDST>::value>{});
+        auto status = log_.Checkpoint(entries);
+        if (status.ok()) {
+            // whatever is still queued is part of the checkpoint already
+            pending_.clear();
+        }
+        // a failed checkpoint is retried by a later commit, don't keep transactions waiting for it
+        ReleaseCheckpointNoLock();
+        return status;
+    }
+
+    void
+    ReleaseCheckpointNoLock() {
+        if (checkpoint_pending_) {
+            checkpoint_pending_ = false;
+            checkpoint_cv_.notify_all();
+        }
+    }
+
+    template <typename MapT>
+    void
+    CollectEntries(const MapT& resources, LogEntries& entries) const {
+        for (auto& kv : resources) {
+            LogEntry entry;
+            entry.type_ = Index<MapT, MockResourcesT>::value;
+            ToRecord(*kv.second, entry.record_);
+            entries.emplace_back(std::move(entry));
+        }
+    }
+
+    // ids are never reused, so the id counters are kept even when the latest resources are gone
+    template <size_t... Is>
+    void
+    CollectSequences(LogEntries& entries, std::index_sequence<Is...>) const {
+        ID_TYPE ids[] = {std::get<Is>(ids_)...};
+        for (size_t i = 0; i < sizeof...(Is); ++i) {
+            LogEntry entry;
+            entry.op_ = LogOp::SEQUENCE;
+            entry.type_ = i;
+            entry.record_.id_ = ids[i];
+            entries.emplace_back(std::move(entry));
+        }
+    }
+
+    template <size_t... Is>
+    void
+    ReplayEntry(const LogEntry& entry, std::index_sequence<Is...>) {
+        ((entry.type_ == Is ? ReplayEntry<Is>(entry) : void()), ...);
+    }
+
+    template <size_t I>
+    void
+    ReplayEntry(const LogEntry& entry) {
+        using ResourceT = typename std::tuple_element<I, MockResourcesT>::type::mapped_type::element_type;
+        auto& resources = std::get<I>(resources_);
+        auto& id = std::get<I>(ids_);
+        switch (entry.op_) {
+            case LogOp::PUT: {
+                auto res = FromRecord<ResourceT>(entry.record_);
+                res->ResetCnt();
+                resources[res->GetID()] = res;
+                id = std::max(id, res->GetID());
+                if constexpr (std::is_same<ResourceT, Collection>::value) {
+                    name_ids_[res->GetName()] = res->GetID();
+                }
+                break;
+            }
+            case LogOp::REMOVE: {
+                auto it = resources.find(entry.record_.id_);
+                if (it == resources.end()) {
+                    break;
+                }
+                if constexpr (std::is_same<ResourceT, Collection>::value) {
+                    name_ids_.erase(it->second->GetName());
+                }
+                resources.erase(it);
+                break;
+            }
+            case LogOp::SEQUENCE:
+                id = std::max(id, entry.record_.id_);
+                break;
+        }
+    }
+
     ID_TYPE
     ProcessOperationStep(const std::any& step_v) {
         if (const auto it = any_flush_vistors_.find(std::type_index(step_v.type())); it != any_flush_vistors_.cend()) {
@@ -478,6 +740,13 @@ class Store {
     std::map<std::string, ID_TYPE> name_ids_;
     std::unordered_map<std::type_index, std::function<ID_TYPE(std::any const&)>> any_flush_vistors_;
     mutable std::shared_timed_mutex mutex_;
+
+    CommitLog log_;
+    LogEntries pending_;
+    int open_txns_ = 0;
+    bool checkpoint_pending_ = false;  // new transactions wait until the open ones finish and the log is checkpointed
+    std::condition_variable checkpoint_cv_;
+    std::mutex log_mutex_;
 };
 
 }  // namespace snapshot
@@ -47,6 +47,8 @@ struct MXLogRecord {
     std::unordered_map<std::string, uint64_t> attr_nbytes;
     std::unordered_map<std::string, uint64_t> attr_data_size;
     std::unordered_map<std::string, std::vector<uint8_t>> attr_data;
+    // set when the inserted vectors are still held in memory, ids/data then point into it
+    std::shared_ptr<VectorsData> payload;
 };
 
 struct MXLogConfiguration {
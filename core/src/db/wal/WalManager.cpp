@@ -264,6 +264,20 @@ WalManager::GetNextRecord(MXLogRecord& record) {
         LOG_WAL_INFO_ << "record type " << (int32_t)record.type << " collection " << record.collection_id << " lsn "
                       << record.lsn;
     }
+
+    if (record.type == MXLogType::InsertVector || record.type == MXLogType::InsertBinary) {
+        std::lock_guard<std::mutex> lck(pending_mutex_);
+        // drop payloads of records skipped above, they are already flushed
+        auto it = pending_payloads_.begin();
+        while (it != pending_payloads_.end() && it->first <= record.lsn) {
+            auto& payload = it->second;
+            pending_bytes_ -= payload->float_data_.size() * sizeof(float) + payload->binary_data_.size();
+            if (it->first == record.lsn) {
+                record.payload = payload;
+            }
+            it = pending_payloads_.erase(it);
+        }
+    }
     return error_code;
 }
 
@@ -426,7 +440,7 @@ WalManager::PartitionUpdated(const std::string& collection_id, const std::string
 template <typename T>
 bool
 WalManager::Insert(const std::string& collection_id, const std::string& partition_tag, const IDNumbers& vector_ids,
-                   const std::vector<T>& vectors) {
+                   const std::vector<T>& vectors, std::vector<uint64_t>* record_lsns) {
     MXLogType log_type;
     if (std::is_same<T, float>::value) {
         log_type = MXLogType::InsertVector;
@@ -476,6 +490,9 @@ WalManager::Insert(const std::string& collection_id, const std::string& partitio
             return false;
         }
         new_lsn = record.lsn;
+        if (record_lsns != nullptr) {
+            record_lsns->push_back(new_lsn);
+        }
     }
 
     last_applied_lsn_ = new_lsn;
@@ -487,6 +504,32 @@ WalManager::Insert(const std::string& collection_id, const std::string& partitio
     return p_meta_handler_->SetMXLogInternalMeta(new_lsn);
 }
 
+bool
+WalManager::Insert(const std::string& collection_id, const std::string& partition_tag, VectorsData&& vectors) {
+    auto payload = std::make_shared<VectorsData>(std::move(vectors));
+    uint64_t payload_bytes = payload->float_data_.size() * sizeof(float) + payload->binary_data_.size();
+
+    // hold the lock across the append so the background thread cannot pick up the record
+    // before its payload is registered
+    std::lock_guard<std::mutex> lck(pending_mutex_);
+    std::vector<uint64_t> record_lsns;
+    bool ret = false;
+    if (!payload->float_data_.empty()) {
+        ret = Insert(collection_id, partition_tag, payload->id_array_, payload->float_data_, &record_lsns);
+    } else if (!payload->binary_data_.empty()) {
+        ret = Insert(collection_id, partition_tag, payload->id_array_, payload->binary_data_, &record_lsns);
+    }
+
+    // a payload split over several records is read back from the buffer as usual, and the
+    // in-memory backlog is bounded by the buffer size so a slow consumer cannot pin unbounded memory
+    if (ret && record_lsns.size() == 1 && pending_bytes_ + payload_bytes <= mxlog_config_.buffer_size) {
+        pending_payloads_[record_lsns[0]] = payload;
+        pending_bytes_ += payload_bytes;
+    }
+
+    return ret;
+}
+
 template <typename T>
 bool
 WalManager::InsertEntities(const std::string& collection_id, const std::string& partition_tag,
@@ -673,11 +716,13 @@ WalManager::RemoveOldFiles(uint64_t flushed_lsn) {
 
 template bool
 WalManager::Insert<float>(const std::string& collection_id, const std::string& partition_tag,
-                          const IDNumbers& vector_ids, const std::vector<float>& vectors);
+                          const IDNumbers& vector_ids, const std::vector<float>& vectors,
+                          std::vector<uint64_t>* record_lsns);
 
 template bool
 WalManager::Insert<uint8_t>(const std::string& collection_id, const std::string& partition_tag,
-                            const IDNumbers& vector_ids, const std::vector<uint8_t>& vectors);
+                            const IDNumbers& vector_ids, const std::vector<uint8_t>& vectors,
+                            std::vector<uint64_t>* record_lsns);
 
 template bool
 WalManager::InsertEntities<float>(const std::string& collection_id, const std::string& partition_tag,
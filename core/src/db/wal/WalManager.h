@@ -13,6 +13,7 @@
 
 #include <atomic>
 #include <map>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -146,11 +147,25 @@ class WalManager {
      * @param collection_id: partition tag
      * @param vector_ids: vector ids
      * @param vectors: vectors
+     * @param record_lsns[out]: lsn of every record the vectors were logged as (optional)
      */
     template <typename T>
     bool
     Insert(const std::string& collection_id, const std::string& partition_tag, const IDNumbers& vector_ids,
-           const std::vector<T>& vectors);
+           const std::vector<T>& vectors, std::vector<uint64_t>* record_lsns = nullptr);
+
+    /*
+     * Insert and keep the payload for the background thread
+     * @param collection_id: collection id
+     * @param partition_tag: partition tag
+     * @param vectors: ids and vectors, taken over by the wal manager
+     * @retval bool
+     *
+     * When the vectors fit into one log record, GetNextRecord attaches them to that
+     * record so they can be moved into the mem table instead of copied out of the buffer.
+     */
+    bool
+    Insert(const std::string& collection_id, const std::string& partition_tag, VectorsData&& vectors);
 
     /*
      * Insert
@@ -219,15 +234,22 @@ class WalManager {
         }
     };
     FlushInfo flush_info_;
+
+    // payloads of Insert(VectorsData&&) waiting for the background thread, keyed by record lsn
+    std::mutex pending_mutex_;
+    std::map<uint64_t, std::shared_ptr<VectorsData>> pending_payloads_;
+    uint64_t pending_bytes_ = 0;
 };
 
 extern template bool
 WalManager::Insert<float>(const std::string& collection_id, const std::string& partition_tag,
-                          const IDNumbers& vector_ids, const std::vector<float>& vectors);
+                          const IDNumbers& vector_ids, const std::vector<float>& vectors,
+                          std::vector<uint64_t>* record_lsns);
 
 extern template bool
 WalManager::Insert<uint8_t>(const std::string& collection_id, const std::string& partition_tag,
-                            const IDNumbers& vector_ids, const std::vector<uint8_t>& vectors);
+                            const IDNumbers& vector_ids, const std::vector<uint8_t>& vectors,
+                            std::vector<uint64_t>* record_lsns);
 
 }  // namespace wal
 }  // namespace engine
@@ -291,6 +291,24 @@ BinIVFConfAdapter::CheckTrain(Config& oricfg, const IndexMode mode) {
     return true;
 }
 
+bool
+BinHNSWConfAdapter::CheckTrain(Config& oricfg, const IndexMode mode) {
+    static std::vector<std::string> METRICS{knowhere::Metric::HAMMING, knowhere::Metric::JACCARD,
+                                            knowhere::Metric::TANIMOTO};
+    static int64_t MIN_EFCONSTRUCTION = 100;
+    static int64_t MAX_EFCONSTRUCTION = 800;
+    static int64_t MIN_M = 5;
+    static int64_t MAX_M = 48;
+
+    CheckIntByRange(knowhere::meta::ROWS, DEFAULT_MIN_ROWS, DEFAULT_MAX_ROWS);
+    CheckIntByRange(knowhere::meta::DIM, DEFAULT_MIN_DIM, DEFAULT_MAX_DIM);
+    CheckIntByRange(knowhere::IndexParams::efConstruction, MIN_EFCONSTRUCTION, MAX_EFCONSTRUCTION);
+    CheckIntByRange(knowhere::IndexParams::M, MIN_M, MAX_M);
+    CheckStrByValues(knowhere::Metric::TYPE, METRICS);
+
+    return true;
+}
+
 bool
 ANNOYConfAdapter::CheckTrain(Config& oricfg, const IndexMode mode) {
     static int64_t MIN_NTREES = 1;
@@ -85,6 +85,12 @@ class HNSWConfAdapter : public ConfAdapter {
     CheckSearch(Config& oricfg, const IndexType type, const IndexMode mode) override;
 };
 
+class BinHNSWConfAdapter : public HNSWConfAdapter {
+ public:
+    bool
+    CheckTrain(Config& oricfg, const IndexMode mode) override;
+};
+
 class ANNOYConfAdapter : public ConfAdapter {
  public:
     bool
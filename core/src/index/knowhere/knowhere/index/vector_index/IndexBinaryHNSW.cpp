@@ -0,0 +1,120 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "knowhere/index/vector_index/IndexBinaryHNSW.h"
+
+#include <faiss/IndexBinaryHNSW.h>
+#include <faiss/MetaIndexes.h>
+
+#include <string>
+
+#include "knowhere/common/Exception.h"
+#include "knowhere/common/Log.h"
+#include "knowhere/index/vector_index/adapter/VectorAdapter.h"
+
+namespace milvus {
+namespace knowhere {
+
+BinarySet
+BinaryHNSW::Serialize(const Config& config) {
+    if (!index_) {
+        KNOWHERE_THROW_MSG("index not initialize or trained");
+    }
+
+    std::lock_guard<std::mutex> lk(mutex_);
+    return SerializeImpl(index_type_);
+}
+
+void
+BinaryHNSW::Load(const BinarySet& index_binary) {
+    std::lock_guard<std::mutex> lk(mutex_);
+    LoadImpl(index_binary, index_type_);
+}
+
+void
+BinaryHNSW::Train(const DatasetPtr& dataset_ptr, const Config& config) {
+    try {
+        int64_t dim = config[meta::DIM].get<int64_t>();
+        faiss::MetricType metric_type = GetMetricType(config[Metric::TYPE].get<std::string>());
+        auto hnsw_index = new faiss::IndexBinaryHNSW(dim, config[IndexParams::M].get<int64_t>(), metric_type);
+        hnsw_index->hnsw.efConstruction = config[IndexParams::efConstruction].get<int64_t>();
+
+        auto index = std::make_shared<faiss::IndexBinaryIDMap>(hnsw_index);
+        index->own_fields = true;
+        index_ = index;
+    } catch (faiss::FaissException& e) {
+        KNOWHERE_THROW_MSG(e.what());
+    } catch (std::exception& e) {
+        KNOWHERE_THROW_MSG(e.what());
+    }
+}
+
+void
+BinaryHNSW::Add(const DatasetPtr& dataset_ptr, const Config& config) {
+    if (!index_) {
+        KNOWHERE_THROW_MSG("index not initialize");
+    }
+
+    std::lock_guard<std::mutex> lk(mutex_);
+    GETTENSORWITHIDS(dataset_ptr)
+
+    index_->add_with_ids(rows, (uint8_t*)p_data, p_ids);
+}
+
+DatasetPtr
+BinaryHNSW::Query(const DatasetPtr& dataset_ptr, const Config& config) {
+    if (!index_) {
+        KNOWHERE_THROW_MSG("index not initialize or trained");
+    }
+    GETTENSOR(dataset_ptr)
+
+    try {
+        int64_t k = config[meta::TOPK].get<int64_t>();
+        auto elems = rows * k;
+        size_t p_id_size = sizeof(int64_t) * elems;
+        size_t p_dist_size = sizeof(float) * elems;
+        auto p_id = (int64_t*)malloc(p_id_size);
+        auto p_dist = (float*)malloc(p_dist_size);
+
+        {
+            // efSearch lives on the shared index, hold the lock until the search has used it
+            std::lock_guard<std::mutex> lk(mutex_);
+            auto id_map = dynamic_cast<faiss::IndexBinaryIDMap*>(index_.get());
+            auto hnsw_index = dynamic_cast<faiss::IndexBinaryHNSW*>(id_map->index);
+            hnsw_index->hnsw.efSearch = config[IndexParams::ef].get<int64_t>();
+
+            index_->search(rows, (uint8_t*)p_data, k, (int32_t*)p_dist, p_id, bitset_);
+        }
+
+        auto ret_ds = std::make_shared<Dataset>();
+        if (index_->metric_type == faiss::METRIC_Hamming) {
+            auto pf_dist = (float*)malloc(p_dist_size);
+            int32_t* pi_dist = (int32_t*)p_dist;
+            for (int i = 0; i < elems; i++) {
+                *(pf_dist + i) = (float)(*(pi_dist + i));
+            }
+            ret_ds->Set(meta::IDS, p_id);
+            ret_ds->Set(meta::DISTANCE, pf_dist);
+            free(p_dist);
+        } else {
+            ret_ds->Set(meta::IDS, p_id);
+            ret_ds->Set(meta::DISTANCE, p_dist);
+        }
+        return ret_ds;
+    } catch (faiss::FaissException& e) {
+        KNOWHERE_THROW_MSG(e.what());
+    } catch (std::exception& e) {
+        KNOWHERE_THROW_MSG(e.what());
+    }
+}
+
+}  // namespace knowhere
+}  // namespace milvus
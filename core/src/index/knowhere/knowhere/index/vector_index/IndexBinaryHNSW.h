@@ -0,0 +1,74 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <utility>
+
+#include "knowhere/common/Exception.h"
+#include "knowhere/index/vector_index/FaissBaseBinaryIndex.h"
+#include "knowhere/index/vector_index/VecIndex.h"
+
+namespace milvus {
+namespace knowhere {
+
+/* HNSW graph over binary codes (faiss::IndexBinaryHNSW wrapped in an id map),
+ * supports the Hamming, Jaccard and Tanimoto metrics */
+class BinaryHNSW : public VecIndex, public FaissBaseBinaryIndex {
+ public:
+    BinaryHNSW() : FaissBaseBinaryIndex(nullptr) {
+        index_type_ = IndexEnum::INDEX_FAISS_BIN_HNSW;
+    }
+
+    explicit BinaryHNSW(std::shared_ptr<faiss::IndexBinary> index) : FaissBaseBinaryIndex(std::move(index)) {
+        index_type_ = IndexEnum::INDEX_FAISS_BIN_HNSW;
+    }
+
+    BinarySet
+    Serialize(const Config& config = Config()) override;
+
+    void
+    Load(const BinarySet& index_binary) override;
+
+    void
+    Train(const DatasetPtr& dataset_ptr, const Config& config) override;
+
+    void
+    Add(const DatasetPtr& dataset_ptr, const Config& config) override;
+
+    void
+    AddWithoutIds(const DatasetPtr&, const Config&) override {
+        KNOWHERE_THROW_MSG("Incremental index is not supported");
+    }
+
+    DatasetPtr
+    Query(const DatasetPtr& dataset_ptr, const Config& config) override;
+
+    int64_t
+    Count() override {
+        return index_->ntotal;
+    }
+
+    int64_t
+    Dim() override {
+        return index_->d;
+    }
+
+ protected:
+    std::mutex mutex_;
+};
+
+using BinaryHNSWPtr = std::shared_ptr<BinaryHNSW>;
+
+}  // namespace knowhere
+}  // namespace milvus
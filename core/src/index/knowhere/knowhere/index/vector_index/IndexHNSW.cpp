@@ -12,12 +12,14 @@
 #include "knowhere/index/vector_index/IndexHNSW.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <iterator>
 #include <utility>
 #include <vector>
 
 #include "faiss/BuilderSuspend.h"
+#include "faiss/SearchInterrupt.h"
 #include "hnswlib/hnswalg.h"
 #include "hnswlib/space_ip.h"
 #include "hnswlib/space_l2.h"
@@ -149,8 +151,13 @@ IndexHNSW::Query(const DatasetPtr& dataset_ptr, const Config& config) {
     auto compare = [](const P& v1, const P& v2) { return v1.first < v2.first; };
 
     faiss::ConcurrentBitsetPtr blacklist = GetBlacklist();
+    auto search_checker = faiss::SearchInterrupt::current();
+    std::atomic_bool interrupted(false);
 #pragma omp parallel for
     for (unsigned int i = 0; i < rows; ++i) {
+        if (interrupted) {
+            continue;
+        }
         std::vector<P> ret;
         const float* single_query = (float*)p_data + i * Dim();
 
@@ -181,6 +188,16 @@ IndexHNSW::Query(const DatasetPtr& dataset_ptr, const Config& config) {
 
         memcpy(p_dist + i * k, dist.data(), dist_size);
         memcpy(p_id + i * k, ids.data(), id_size);
+
+        if (faiss::SearchInterrupt::is_interrupted(search_checker)) {
+            interrupted = true;
+        }
+    }
+
+    if (interrupted) {
+        free(p_id);
+        free(p_dist);
+        KNOWHERE_THROW_MSG("search interrupted");
     }
 
     auto ret_ds = std::make_shared<Dataset>();
@@ -205,5 +222,26 @@ IndexHNSW::Dim() {
     return (*(size_t*)index_->dist_func_param_);
 }
 
+bool
+IndexHNSW::Compact(const faiss::ConcurrentBitsetPtr& deleted) {
+    if (!index_) {
+        KNOWHERE_THROW_MSG("index not initialize");
+    }
+
+    std::lock_guard<std::mutex> lk(mutex_);
+    int64_t count = index_->cur_element_count;
+    for (hnswlib::tableint i = 0; i < count; ++i) {
+        if (index_->getExternalLabel(i) >= (size_t)count) {
+            // labels are not offsets, can not be remapped
+            return false;
+        }
+    }
+
+    auto offset_map = GenOffsetMap(deleted, count);
+    index_->removeElements(offset_map);
+    CompactUids(offset_map);
+    return true;
+}
+
 }  // namespace knowhere
 }  // namespace milvus
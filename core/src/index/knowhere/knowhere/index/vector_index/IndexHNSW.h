@@ -54,6 +54,9 @@ class IndexHNSW : public VecIndex {
     int64_t
     Dim() override;
 
+    bool
+    Compact(const faiss::ConcurrentBitsetPtr& deleted) override;
+
  private:
     bool normalize = false;
     std::mutex mutex_;
@@ -25,6 +25,7 @@
 
 #include <fiu-local.h>
 #include <chrono>
+#include <cstring>
 #include <memory>
 #include <string>
 #include <utility>
@@ -217,6 +218,63 @@ IVF::GetVectorById(const DatasetPtr& dataset_ptr, const Config& config) {
 }
 #endif
 
+bool
+IVF::Compact(const faiss::ConcurrentBitsetPtr& deleted) {
+    auto ivf_index = dynamic_cast<faiss::IndexIVF*>(index_.get());
+    if (ivf_index == nullptr) {
+        return false;
+    }
+    // sealed lists are read only
+    auto invlists = dynamic_cast<faiss::ArrayInvertedLists*>(ivf_index->invlists);
+    if (invlists == nullptr) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lk(mutex_);
+    auto offset_map = GenOffsetMap(deleted, ivf_index->ntotal);
+    for (auto& ids : invlists->ids) {
+        for (auto id : ids) {
+            if (id < 0 || id >= ivf_index->ntotal) {
+                // ids are not offsets, can not be remapped
+                return false;
+            }
+        }
+    }
+
+    // rewrite each inverted list without deleted entries, centroids and codes of live entries are kept
+    size_t code_size = invlists->code_size;
+    int64_t removed = 0;
+#pragma omp parallel for reduction(+ : removed)
+    for (int64_t list_no = 0; list_no < (int64_t)invlists->nlist; ++list_no) {
+        auto& ids = invlists->ids[list_no];
+        auto& codes = invlists->codes[list_no];
+        size_t live = 0;
+        for (size_t i = 0; i < ids.size(); ++i) {
+            int64_t new_id = offset_map[ids[i]];
+            if (new_id < 0) {
+                continue;
+            }
+            if (live != i) {
+                memcpy(codes.data() + live * code_size, codes.data() + i * code_size, code_size);
+            }
+            ids[live++] = new_id;
+        }
+        removed += ids.size() - live;
+        ids.resize(live);
+        codes.resize(live * code_size);
+    }
+    ivf_index->ntotal -= removed;
+
+    if (!ivf_index->direct_map.no()) {
+        auto type = ivf_index->direct_map.type;
+        ivf_index->set_direct_map_type(faiss::DirectMap::NoMap);
+        ivf_index->set_direct_map_type(type);
+    }
+
+    CompactUids(offset_map);
+    return true;
+}
+
 void
 IVF::Seal() {
     if (!index_ || !index_->is_trained) {
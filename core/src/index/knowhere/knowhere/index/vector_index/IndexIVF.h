@@ -73,6 +73,9 @@ class IVF : public VecIndex, public FaissBaseIndex {
     GetVectorById(const DatasetPtr& dataset, const Config& config) override;
 #endif
 
+    bool
+    Compact(const faiss::ConcurrentBitsetPtr& deleted) override;
+
     virtual void
     Seal();
 
@@ -39,6 +39,7 @@ static std::unordered_map<int32_t, std::string> old_index_type_str_map = {
     {(int32_t)OldIndexType::ANNOY, IndexEnum::INDEX_ANNOY},
     {(int32_t)OldIndexType::FAISS_BIN_IDMAP, IndexEnum::INDEX_FAISS_BIN_IDMAP},
     {(int32_t)OldIndexType::FAISS_BIN_IVFLAT_CPU, IndexEnum::INDEX_FAISS_BIN_IVFFLAT},
+    {(int32_t)OldIndexType::FAISS_BIN_HNSW, IndexEnum::INDEX_FAISS_BIN_HNSW},
 };
 
 static std::unordered_map<std::string, int32_t> str_old_index_type_map = {
@@ -57,6 +58,7 @@ static std::unordered_map<std::string, int32_t> str_old_index_type_map = {
     {IndexEnum::INDEX_ANNOY, (int32_t)OldIndexType::ANNOY},
     {IndexEnum::INDEX_FAISS_BIN_IDMAP, (int32_t)OldIndexType::FAISS_BIN_IDMAP},
     {IndexEnum::INDEX_FAISS_BIN_IVFFLAT, (int32_t)OldIndexType::FAISS_BIN_IVFLAT_CPU},
+    {IndexEnum::INDEX_FAISS_BIN_HNSW, (int32_t)OldIndexType::FAISS_BIN_HNSW},
 };
 
 /* used in 0.8.0 */
@@ -69,6 +71,7 @@ const char* INDEX_FAISS_IVFSQ8 = "IVF_SQ8";
 const char* INDEX_FAISS_IVFSQ8H = "IVF_SQ8_HYBRID";
 const char* INDEX_FAISS_BIN_IDMAP = "BIN_IDMAP";
 const char* INDEX_FAISS_BIN_IVFFLAT = "BIN_IVF_FLAT";
+const char* INDEX_FAISS_BIN_HNSW = "BIN_HNSW";
 const char* INDEX_NSG = "NSG";
 #ifdef MILVUS_SUPPORT_SPTAG
 const char* INDEX_SPTAG_KDT_RNT = "SPTAG_KDT_RNT";
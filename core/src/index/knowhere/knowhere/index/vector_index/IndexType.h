@@ -37,6 +37,7 @@ enum class OldIndexType {
     ANNOY,
     FAISS_BIN_IDMAP = 100,
     FAISS_BIN_IVFLAT_CPU = 101,
+    FAISS_BIN_HNSW = 102,
 };
 
 using IndexType = std::string;
@@ -51,6 +52,7 @@ extern const char* INDEX_FAISS_IVFSQ8;
 extern const char* INDEX_FAISS_IVFSQ8H;
 extern const char* INDEX_FAISS_BIN_IDMAP;
 extern const char* INDEX_FAISS_BIN_IVFFLAT;
+extern const char* INDEX_FAISS_BIN_HNSW;
 extern const char* INDEX_NSG;
 #ifdef MILVUS_SUPPORT_SPTAG
 extern const char* INDEX_SPTAG_KDT_RNT;
@@ -134,6 +134,43 @@ class VecIndex : public Index {
         return BlacklistSize() + UidsSize() + IndexSize();
     }
 
+    /*
+     * Remove entries marked in deleted and renumber the remaining ones densely, keeping trained structures.
+     * Uids are compacted alike and the blacklist is dropped.
+     * Returns false if the index can not be compacted in place and has to be rebuilt.
+     */
+    virtual bool
+    Compact(const faiss::ConcurrentBitsetPtr& deleted) {
+        return false;
+    }
+
+ protected:
+    // map from old offset to new offset, -1 for deleted ones
+    std::vector<int64_t>
+    GenOffsetMap(const faiss::ConcurrentBitsetPtr& deleted, int64_t count) {
+        std::vector<int64_t> offset_map(count);
+        int64_t next = 0;
+        for (int64_t i = 0; i < count; ++i) {
+            bool is_deleted = deleted != nullptr && i < (int64_t)deleted->capacity() && deleted->test(i);
+            offset_map[i] = is_deleted ? -1 : next++;
+        }
+        return offset_map;
+    }
+
+    void
+    CompactUids(const std::vector<int64_t>& offset_map) {
+        if (uids_.size() == offset_map.size()) {
+            size_t live = 0;
+            for (size_t i = 0; i < offset_map.size(); ++i) {
+                if (offset_map[i] >= 0) {
+                    uids_[live++] = uids_[i];
+                }
+            }
+            uids_.resize(live);
+        }
+        bitset_ = nullptr;
+    }
+
  protected:
     IndexType index_type_ = "";
     IndexMode index_mode_ = IndexMode::MODE_CPU;
@@ -14,6 +14,7 @@
 #include "knowhere/common/Exception.h"
 #include "knowhere/common/Log.h"
 #include "knowhere/index/vector_index/IndexAnnoy.h"
+#include "knowhere/index/vector_index/IndexBinaryHNSW.h"
 #include "knowhere/index/vector_index/IndexBinaryIDMAP.h"
 #include "knowhere/index/vector_index/IndexBinaryIVF.h"
 #include "knowhere/index/vector_index/IndexHNSW.h"
@@ -73,6 +74,8 @@ VecIndexFactory::CreateVecIndex(const IndexType& type, const IndexMode mode) {
         return std::make_shared<knowhere::BinaryIDMAP>();
     } else if (type == IndexEnum::INDEX_FAISS_BIN_IVFFLAT) {
         return std::make_shared<knowhere::BinaryIVF>();
+    } else if (type == IndexEnum::INDEX_FAISS_BIN_HNSW) {
+        return std::make_shared<knowhere::BinaryHNSW>();
     } else if (type == IndexEnum::INDEX_NSG) {
         return std::make_shared<knowhere::NSG>(-1);
 #ifdef MILVUS_SUPPORT_SPTAG
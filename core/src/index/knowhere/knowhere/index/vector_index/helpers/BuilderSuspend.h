@@ -26,5 +26,10 @@ BuildResume() {
     faiss::BuilderSuspend::resume();
 }
 
+inline void
+BuildCheckWait() {
+    faiss::BuilderSuspend::check_wait();
+}
+
 }  // namespace knowhere
 }  // namespace milvus
@@ -18,6 +18,12 @@ namespace milvus {
 namespace knowhere {
 namespace impl {
 
+DistanceL2::DistanceL2(size_t dimension) : func_(faiss::fvec_L2sqr_for_dim(dimension)) {
+}
+
+DistanceIP::DistanceIP(size_t dimension) : func_(faiss::fvec_inner_product_for_dim(dimension)) {
+}
+
 #if 0 /* use FAISS distance calculation algorithm instead */
 
 float
@@ -232,12 +238,12 @@ DistanceIP::Compare(const float* a, const float* b, unsigned size) const {
 
 float
 DistanceL2::Compare(const float* a, const float* b, unsigned size) const {
-    return faiss::fvec_L2sqr(a, b, (size_t)size);
+    return func_(a, b, (size_t)size);
 }
 
 float
 DistanceIP::Compare(const float* a, const float* b, unsigned size) const {
-    return faiss::fvec_inner_product(a, b, (size_t)size);
+    return func_(a, b, (size_t)size);
 }
 
 #endif
@@ -11,6 +11,8 @@
 
 #pragma once
 
+#include <cstddef>
+
 namespace milvus {
 namespace knowhere {
 namespace impl {
@@ -20,14 +22,26 @@ struct Distance {
     Compare(const float* a, const float* b, unsigned size) const = 0;
 };
 
+using DistanceFunc = float (*)(const float*, const float*, size_t);
+
 struct DistanceL2 : public Distance {
+    explicit DistanceL2(size_t dimension);
+
     float
     Compare(const float* a, const float* b, unsigned size) const override;
+
+ private:
+    DistanceFunc func_;  // resolved once for the index dimension
 };
 
 struct DistanceIP : public Distance {
+    explicit DistanceIP(size_t dimension);
+
     float
     Compare(const float* a, const float* b, unsigned size) const override;
+
+ private:
+    DistanceFunc func_;
 };
 
 }  // namespace impl
@@ -34,9 +34,9 @@ unsigned int seed = 100;
 NsgIndex::NsgIndex(const size_t& dimension, const size_t& n, std::string metric)
     : dimension(dimension), ntotal(n), metric_type(metric) {
     if (metric == knowhere::Metric::L2) {
-        distance_ = new DistanceL2;
+        distance_ = new DistanceL2(dimension);
     } else if (metric == knowhere::Metric::IP) {
-        distance_ = new DistanceIP;
+        distance_ = new DistanceIP(dimension);
     }
 }
 
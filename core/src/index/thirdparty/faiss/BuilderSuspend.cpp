@@ -23,6 +23,7 @@ void BuilderSuspend::suspend() {
 
 void BuilderSuspend::resume() {
     suspend_flag_ = false;
+    cv_.notify_all();
 }
 
 void BuilderSuspend::check_wait() {
@@ -12,6 +12,8 @@
 #include <faiss/utils/distances.h>
 #include <faiss/utils/distances_avx.h>
 #include <faiss/utils/distances_avx512.h>
+#include <faiss/utils/distances_dim.h>
+#include <faiss/utils/hamming_simd.h>
 #include <faiss/utils/instruction_set.h>
 
 namespace faiss {
@@ -26,6 +28,15 @@ fvec_func_ptr fvec_L2sqr = fvec_L2sqr_avx;
 fvec_func_ptr fvec_L1 = fvec_L1_avx;
 fvec_func_ptr fvec_Linf = fvec_Linf_avx;
 
+fvec_tile_func_ptr fvec_inner_products_tile = fvec_inner_products_tile_avx;
+
+fvec_dim_func_ptr fvec_L2sqr_dim_sel = fvec_L2sqr_dim_avx;
+fvec_dim_func_ptr fvec_inner_product_dim_sel = fvec_inner_product_dim_avx;
+
+bvec_hamming_func_ptr bvec_hamming = bvec_hamming_avx;
+bvec_jaccard_func_ptr bvec_jaccard_counts = bvec_jaccard_counts_avx;
+size_t bvec_simd_min_code_size = 256;
+
 sq_get_distance_computer_func_ptr sq_get_distance_computer = sq_get_distance_computer_avx;
 sq_sel_quantizer_func_ptr sq_sel_quantizer = sq_select_quantizer_avx;
 sq_sel_inv_list_scanner_func_ptr sq_sel_inv_list_scanner = sq_select_inverted_list_scanner_avx;
@@ -41,6 +52,13 @@ bool support_avx512() {
             instruction_set_inst.AVX512BW());
 }
 
+bool support_avx512_vpopcntdq() {
+    if (!support_avx512()) return false;
+
+    InstructionSet& instruction_set_inst = InstructionSet::GetInstance();
+    return (instruction_set_inst.AVX512VPOPCNTDQ());
+}
+
 bool support_avx2() {
     if (!faiss_use_avx2) return false;
 
@@ -48,6 +66,11 @@ bool support_avx2() {
     return (instruction_set_inst.AVX2());
 }
 
+bool support_fma() {
+    InstructionSet& instruction_set_inst = InstructionSet::GetInstance();
+    return (instruction_set_inst.FMA());
+}
+
 bool support_sse() {
     if (!faiss_use_sse) return false;
 
@@ -65,6 +88,20 @@ bool hook_init(std::string& cpu_flag) {
         fvec_L2sqr = fvec_L2sqr_avx512;
         fvec_L1 = fvec_L1_avx512;
         fvec_Linf = fvec_Linf_avx512;
+        fvec_inner_products_tile = fvec_inner_products_tile_avx512;
+        fvec_L2sqr_dim_sel = fvec_L2sqr_dim_avx512;
+        fvec_inner_product_dim_sel = fvec_inner_product_dim_avx512;
+
+        /* for binary metrics */
+        if (support_avx512_vpopcntdq()) {
+            bvec_hamming = bvec_hamming_avx512;
+            bvec_jaccard_counts = bvec_jaccard_counts_avx512;
+            bvec_simd_min_code_size = 64;
+        } else {
+            bvec_hamming = bvec_hamming_avx;
+            bvec_jaccard_counts = bvec_jaccard_counts_avx;
+            bvec_simd_min_code_size = 256;
+        }
 
         /* for IVFSQ */
         sq_get_distance_computer = sq_get_distance_computer_avx512;
@@ -78,6 +115,20 @@ bool hook_init(std::string& cpu_flag) {
         fvec_L2sqr = fvec_L2sqr_avx;
         fvec_L1 = fvec_L1_avx;
         fvec_Linf = fvec_Linf_avx;
+        fvec_inner_products_tile = fvec_inner_products_tile_avx;
+        if (support_fma()) {
+            fvec_L2sqr_dim_sel = fvec_L2sqr_dim_avx;
+            fvec_inner_product_dim_sel = fvec_inner_product_dim_avx;
+        } else {
+            /* the fixed dimension kernels are built with FMA */
+            fvec_L2sqr_dim_sel = fvec_L2sqr_dim_sse;
+            fvec_inner_product_dim_sel = fvec_inner_product_dim_sse;
+        }
+
+        /* for binary metrics */
+        bvec_hamming = bvec_hamming_avx;
+        bvec_jaccard_counts = bvec_jaccard_counts_avx;
+        bvec_simd_min_code_size = 256;
 
         /* for IVFSQ */
         sq_get_distance_computer = sq_get_distance_computer_avx;
@@ -91,6 +142,14 @@ bool hook_init(std::string& cpu_flag) {
         fvec_L2sqr = fvec_L2sqr_sse;
         fvec_L1 = fvec_L1_sse;
         fvec_Linf = fvec_Linf_sse;
+        fvec_inner_products_tile = fvec_inner_products_tile_sse;
+        fvec_L2sqr_dim_sel = fvec_L2sqr_dim_sse;
+        fvec_inner_product_dim_sel = fvec_inner_product_dim_sse;
+
+        /* for binary metrics, popcnt is already what the unrolled computers use */
+        bvec_hamming = bvec_hamming_sse;
+        bvec_jaccard_counts = bvec_jaccard_counts_sse;
+        bvec_simd_min_code_size = SIZE_MAX;
 
         /* for IVFSQ */
         sq_get_distance_computer = sq_get_distance_computer_ref;
@@ -106,4 +165,14 @@ bool hook_init(std::string& cpu_flag) {
     return true;
 }
 
+fvec_func_ptr fvec_L2sqr_for_dim(size_t d) {
+    fvec_func_ptr func = fvec_L2sqr_dim_sel(d);
+    return func ? func : fvec_L2sqr;
+}
+
+fvec_func_ptr fvec_inner_product_for_dim(size_t d) {
+    fvec_func_ptr func = fvec_inner_product_dim_sel(d);
+    return func ? func : fvec_inner_product;
+}
+
 } // namespace faiss
@@ -9,10 +9,13 @@
 #include <faiss/impl/ScalarQuantizer.h>
 #include <faiss/impl/ScalarQuantizerOp.h>
 #include <faiss/MetricType.h>
+#include <faiss/utils/distances_dim.h>
+#include <faiss/utils/hamming_simd.h>
 
 namespace faiss {
 
-typedef float (*fvec_func_ptr)(const float*, const float*, size_t);
+typedef fvec_func_ptr (*fvec_dim_func_ptr)(size_t);
+typedef void (*fvec_tile_func_ptr)(float*, const float*, size_t, const float*, size_t, size_t);
 
 typedef SQDistanceComputer* (*sq_get_distance_computer_func_ptr)(MetricType, QuantizerType, size_t, const std::vector<float>&);
 typedef Quantizer* (*sq_sel_quantizer_func_ptr)(QuantizerType, size_t, const std::vector<float>&);
@@ -27,14 +30,34 @@ extern fvec_func_ptr fvec_L2sqr;
 extern fvec_func_ptr fvec_L1;
 extern fvec_func_ptr fvec_Linf;
 
+extern fvec_tile_func_ptr fvec_inner_products_tile;
+
+extern fvec_dim_func_ptr fvec_L2sqr_dim_sel;
+extern fvec_dim_func_ptr fvec_inner_product_dim_sel;
+
+/// popcount kernels for long binary codes, used once the code size reaches
+/// bvec_simd_min_code_size bytes (shorter codes stay on the unrolled
+/// HammingComputer / JaccardComputer specializations)
+extern bvec_hamming_func_ptr bvec_hamming;
+extern bvec_jaccard_func_ptr bvec_jaccard_counts;
+extern size_t bvec_simd_min_code_size;
+
 extern sq_get_distance_computer_func_ptr sq_get_distance_computer;
 extern sq_sel_quantizer_func_ptr sq_sel_quantizer;
 extern sq_sel_inv_list_scanner_func_ptr sq_sel_inv_list_scanner;
 
 extern bool support_avx512();
+extern bool support_avx512_vpopcntdq();
 extern bool support_avx2();
+extern bool support_fma();
 extern bool support_sse();
 
 extern bool hook_init(std::string& cpu_flag);
 
+/// kernels specialized for dimension d under the instruction set picked by
+/// hook_init, falling back to fvec_L2sqr / fvec_inner_product for other sizes;
+/// callers should resolve them once per index rather than per distance
+extern fvec_func_ptr fvec_L2sqr_for_dim(size_t d);
+extern fvec_func_ptr fvec_inner_product_for_dim(size_t d);
+
 } // namespace faiss
@@ -20,6 +20,7 @@
 
 #include <unordered_set>
 #include <queue>
+#include <limits>
 
 #include <sys/types.h>
 #include <sys/stat.h>
@@ -31,6 +32,8 @@
 #include <faiss/impl/FaissAssert.h>
 #include <faiss/IndexBinaryFlat.h>
 #include <faiss/utils/hamming.h>
+#include <faiss/utils/hamming_simd-inl.h>
+#include <faiss/utils/BinaryDistance.h>
 #include <faiss/impl/AuxIndexStructures.h>
 
 namespace faiss {
@@ -164,12 +167,15 @@ IndexBinaryHNSW::IndexBinaryHNSW()
   is_trained = true;
 }
 
-IndexBinaryHNSW::IndexBinaryHNSW(int d, int M)
-    : IndexBinary(d),
+IndexBinaryHNSW::IndexBinaryHNSW(int d, int M, MetricType metric)
+    : IndexBinary(d, metric),
       hnsw(M),
       own_fields(true),
-      storage(new IndexBinaryFlat(d))
+      storage(new IndexBinaryFlat(d, metric))
 {
+  FAISS_THROW_IF_NOT_MSG(metric == METRIC_Hamming || metric == METRIC_Jaccard ||
+                         metric == METRIC_Tanimoto,
+                         "IndexBinaryHNSW only supports Hamming, Jaccard and Tanimoto");
   is_trained = true;
 }
 
@@ -199,10 +205,16 @@ void IndexBinaryHNSW::search(idx_t n, const uint8_t *x, idx_t k,
                              int32_t *distances, idx_t *labels,
                              ConcurrentBitsetPtr bitset) const
 {
+  // with deletions the graph is searched for a longer candidate list and
+  // the deleted entries are dropped from it afterwards
+  idx_t k_search = bitset ? std::max(k, (idx_t)hnsw.efSearch) : k;
+
 #pragma omp parallel
   {
     VisitedTable vt(ntotal);
     std::unique_ptr<DistanceComputer> dis(get_distance_computer());
+    std::vector<idx_t> idx_buf(bitset ? k_search : 0);
+    std::vector<float> dis_buf(bitset ? k_search : 0);
 
 #pragma omp for
     for(idx_t i = 0; i < n; i++) {
@@ -211,15 +223,53 @@ void IndexBinaryHNSW::search(idx_t n, const uint8_t *x, idx_t k,
 
       dis->set_query((float *)(x + i * code_size));
 
-      maxheap_heapify(k, simi, idxi);
-      hnsw.search(*dis, k, idxi, simi, vt);
-      maxheap_reorder(k, simi, idxi);
+      if (!bitset) {
+        maxheap_heapify(k, simi, idxi);
+        hnsw.search(*dis, k, idxi, simi, vt);
+        maxheap_reorder(k, simi, idxi);
+        continue;
+      }
+
+      maxheap_heapify(k_search, dis_buf.data(), idx_buf.data());
+      hnsw.search(*dis, k_search, idx_buf.data(), dis_buf.data(), vt);
+      maxheap_reorder(k_search, dis_buf.data(), idx_buf.data());
+
+      idx_t nres = 0;
+      for (idx_t j = 0; j < k_search && nres < k; j++) {
+        if (idx_buf[j] >= 0 && !bitset->test(idx_buf[j])) {
+          idxi[nres] = idx_buf[j];
+          simi[nres] = dis_buf[j];
+          nres++;
+        }
+      }
+      for (; nres < k; nres++) {
+        idxi[nres] = -1;
+        simi[nres] = std::numeric_limits<float>::max();
+      }
     }
   }
 
+  if (metric_type == METRIC_Jaccard || metric_type == METRIC_Tanimoto) {
+    if (metric_type == METRIC_Tanimoto) {
+      float *D = (float *)distances;
 #pragma omp parallel for
-  for (int i = 0; i < n * k; ++i) {
-    distances[i] = std::round(((float *)distances)[i]);
+      for (idx_t i = 0; i < n * k; ++i) {
+        if (labels[i] >= 0) {
+          D[i] = -log2(1 - D[i]);
+        }
+      }
+    }
+    return;
+  }
+
+  // empty slots hold FLT_MAX, which does not fit in an int32
+#pragma omp parallel for
+  for (idx_t i = 0; i < n * k; ++i) {
+    if (labels[i] >= 0) {
+      distances[i] = std::round(((float *)distances)[i]);
+    } else {
+      distances[i] = std::numeric_limits<int32_t>::max();
+    }
   }
 }
 
@@ -290,6 +340,43 @@ struct FlatHammingDis : DistanceComputer {
 };
 
 
+template<class JaccardComputer>
+struct FlatJaccardDis : DistanceComputer {
+  const int code_size;
+  const uint8_t *b;
+  size_t ndis;
+  JaccardComputer jc;
+
+  float operator () (idx_t i) override {
+    ndis++;
+    return jc.compute(b + i * code_size);
+  }
+
+  float symmetric_dis(idx_t i, idx_t j) override {
+    return JaccardComputerDefault(b + j * code_size, code_size)
+      .compute(b + i * code_size);
+  }
+
+
+  explicit FlatJaccardDis(const IndexBinaryFlat& storage)
+      : code_size(storage.code_size),
+        b(storage.xb.data()),
+        ndis(0),
+        jc() {}
+
+  void set_query(const float *x) override {
+    jc.set((uint8_t *)x, code_size);
+  }
+
+  ~FlatJaccardDis() override {
+#pragma omp critical
+    {
+      hnsw_stats.ndis += ndis;
+    }
+  }
+};
+
+
 }  // namespace
 
 
@@ -298,6 +385,32 @@ DistanceComputer *IndexBinaryHNSW::get_distance_computer() const {
 
   FAISS_ASSERT(flat_storage != nullptr);
 
+  // Tanimoto is a monotonic function of Jaccard, the graph is built and
+  // searched on Jaccard and converted at the end of search()
+  if (metric_type == METRIC_Jaccard || metric_type == METRIC_Tanimoto) {
+    if (bvec_use_simd(code_size)) {
+      return new FlatJaccardDis<JaccardComputerSIMD>(*flat_storage);
+    }
+    switch(code_size) {
+      case 8:
+        return new FlatJaccardDis<JaccardComputer8>(*flat_storage);
+      case 16:
+        return new FlatJaccardDis<JaccardComputer16>(*flat_storage);
+      case 32:
+        return new FlatJaccardDis<JaccardComputer32>(*flat_storage);
+      case 64:
+        return new FlatJaccardDis<JaccardComputer64>(*flat_storage);
+      case 128:
+        return new FlatJaccardDis<JaccardComputer128>(*flat_storage);
+      case 256:
+        return new FlatJaccardDis<JaccardComputer256>(*flat_storage);
+      case 512:
+        return new FlatJaccardDis<JaccardComputer512>(*flat_storage);
+      default:
+        return new FlatJaccardDis<JaccardComputerDefault>(*flat_storage);
+    }
+  }
+
   switch(code_size) {
     case 4:
       return new FlatHammingDis<HammingComputer4>(*flat_storage);
@@ -312,7 +425,9 @@ DistanceComputer *IndexBinaryHNSW::get_distance_computer() const {
     case 64:
       return new FlatHammingDis<HammingComputer64>(*flat_storage);
     default:
-      if (code_size % 8 == 0) {
+      if (bvec_use_simd(code_size)) {
+        return new FlatHammingDis<HammingComputerSIMD>(*flat_storage);
+      } else if (code_size % 8 == 0) {
         return new FlatHammingDis<HammingComputerM8>(*flat_storage);
       } else if (code_size % 4 == 0) {
         return new FlatHammingDis<HammingComputerM4>(*flat_storage);
@@ -31,7 +31,8 @@ struct IndexBinaryHNSW : IndexBinary {
   IndexBinary *storage;
 
   explicit IndexBinaryHNSW();
-  explicit IndexBinaryHNSW(int d, int M = 32);
+  /// metric may be METRIC_Hamming, METRIC_Jaccard or METRIC_Tanimoto
+  explicit IndexBinaryHNSW(int d, int M = 32, MetricType metric = METRIC_Hamming);
   explicit IndexBinaryHNSW(IndexBinary *storage, int M = 32);
 
   ~IndexBinaryHNSW() override;
@@ -43,7 +44,12 @@ struct IndexBinaryHNSW : IndexBinary {
   /// Trains the storage if needed
   void train(idx_t n, const uint8_t* x) override;
 
-  /// entry point for search
+  /** entry point for search
+   *
+   * Entries set in bitset are skipped: the graph is explored with at least
+   * efSearch candidates and deleted ones are filtered from that list, so
+   * results may come back short of k when most neighbours are deleted.
+   * Distances are int32 for Hamming and float for Jaccard / Tanimoto. */
   void search(idx_t n, const uint8_t *x, idx_t k,
               int32_t *distances, idx_t *labels,
               ConcurrentBitsetPtr bitset = nullptr) const override;
@@ -24,6 +24,7 @@
 #include <faiss/utils/Heap.h>
 #include <faiss/impl/AuxIndexStructures.h>
 #include <faiss/impl/FaissAssert.h>
+#include <faiss/utils/hamming_simd-inl.h>
 #include <faiss/IndexFlat.h>
 #include <faiss/IndexLSH.h>
 
@@ -374,6 +375,12 @@ struct IVFBinaryScannerL2: BinaryInvertedListScanner {
     {
         using C = CMax<int32_t, idx_t>;
 
+        if (k >= heap_batch_min_k) {
+            return scan_codes_batch<C> (
+                n, ids, list_no, store_pairs, simi, idxi, k, bitset,
+                [&] (size_t j) { return (int32_t)hc.hamming (codes + j * code_size); });
+        }
+
         size_t nup = 0;
         for (size_t j = 0; j < n; j++) {
             if (!bitset || !bitset->test(ids[j])) {
@@ -472,7 +479,9 @@ BinaryInvertedListScanner *select_IVFBinaryScannerL2 (size_t code_size) {
         case 32: HC(HammingComputer32);
         case 64: HC(HammingComputer64);
         default:
-            if (code_size % 8 == 0) {
+            if (bvec_use_simd(code_size)) {
+                HC(HammingComputerSIMD);
+            } else if (code_size % 8 == 0) {
                 HC(HammingComputerM8);
             } else if (code_size % 4 == 0) {
                 HC(HammingComputerM4);
@@ -485,6 +494,9 @@ BinaryInvertedListScanner *select_IVFBinaryScannerL2 (size_t code_size) {
 
 template <bool store_pairs>
 BinaryInvertedListScanner *select_IVFBinaryScannerJaccard (size_t code_size) {
+    if (bvec_use_simd(code_size)) {
+        return new IVFBinaryScannerJaccard<JaccardComputerSIMD, store_pairs>(code_size);
+    }
     switch (code_size) {
 #define HANDLE_CS(cs)                                                  \
     case cs:                                                            \
@@ -22,6 +22,7 @@
 #include <faiss/impl/FaissAssert.h>
 #include <faiss/IndexFlat.h>
 #include <faiss/impl/AuxIndexStructures.h>
+#include <faiss/SearchInterrupt.h>
 
 namespace faiss {
 
@@ -360,6 +361,8 @@ void IndexIVF::search_preassigned (idx_t n, const float *x, idx_t k,
     using HeapForL2 = CMax<float, idx_t>;
 
     bool interrupt = false;
+    // omp workers do not see the caller's thread_local checker
+    const SearchInterrupt::Checker* search_checker = SearchInterrupt::current ();
 
     int pmode = this->parallel_mode & ~PARALLEL_MODE_NO_HEAP_INIT;
     bool do_heap_init = !(this->parallel_mode & PARALLEL_MODE_NO_HEAP_INIT);
@@ -481,7 +484,8 @@ void IndexIVF::search_preassigned (idx_t n, const float *x, idx_t k,
                 ndis += nscan;
                 reorder_result (simi, idxi);
 
-                if (InterruptCallback::is_interrupted ()) {
+                if (InterruptCallback::is_interrupted () ||
+                    SearchInterrupt::is_interrupted (search_checker)) {
                     interrupt = true;
                 }
 
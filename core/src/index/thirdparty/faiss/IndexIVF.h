@@ -374,6 +374,40 @@ struct InvertedListScanner {
 };
 
 
+/** Scan an inverted list for large k: distances are computed block by
+ * block (deleted entries get the neutral value so they never enter the
+ * heap), then merged with heap_addn_batch. dis_func (j) returns the
+ * distance to the j-th code of the list. Returns the nb of heap updates. */
+template <class C, class DisFunc>
+size_t scan_codes_batch (size_t list_size,
+                         const Index::idx_t *ids,
+                         Index::idx_t list_no,
+                         bool store_pairs,
+                         typename C::T *simi, Index::idx_t *idxi,
+                         size_t k,
+                         const ConcurrentBitsetPtr &bitset,
+                         DisFunc dis_func)
+{
+    const size_t bs = 1024;
+    typename C::T dis[bs];
+    size_t nup = 0;
+    for (size_t j0 = 0; j0 < list_size; j0 += bs) {
+        size_t nj = std::min (bs, list_size - j0);
+        for (size_t j = 0; j < nj; j++) {
+            dis[j] = (bitset && bitset->test (ids[j0 + j])) ?
+                     C::neutral () : dis_func (j0 + j);
+        }
+        if (store_pairs) {
+            nup += heap_addn_batch<C> (k, simi, idxi, dis, nullptr,
+                                       lo_build (list_no, j0), nj);
+        } else {
+            nup += heap_addn_batch<C> (k, simi, idxi, dis, ids + j0, 0, nj);
+        }
+    }
+    return nup;
+}
+
+
 struct IndexIVFStats {
     size_t nq;       // nb of queries run
     size_t nlist;    // nb of inverted lists scanned
@@ -124,9 +124,12 @@ template<MetricType metric, class C>
 struct IVFFlatScanner: InvertedListScanner {
     size_t d;
     bool store_pairs;
+    fvec_func_ptr dis_func;
 
     IVFFlatScanner(size_t d, bool store_pairs):
-        d(d), store_pairs(store_pairs) {}
+        d(d), store_pairs(store_pairs),
+        dis_func(metric == METRIC_INNER_PRODUCT ?
+                 fvec_inner_product_for_dim(d) : fvec_L2sqr_for_dim(d)) {}
 
     const float *xi;
     void set_query (const float *query) override {
@@ -140,8 +143,7 @@ struct IVFFlatScanner: InvertedListScanner {
 
     float distance_to_code (const uint8_t *code) const override {
         const float *yj = (float*)code;
-        float dis = metric == METRIC_INNER_PRODUCT ?
-            fvec_inner_product (xi, yj, d) : fvec_L2sqr (xi, yj, d);
+        float dis = dis_func (xi, yj, d);
         return dis;
     }
 
@@ -153,12 +155,16 @@ struct IVFFlatScanner: InvertedListScanner {
                        ConcurrentBitsetPtr bitset) const override
     {
         const float *list_vecs = (const float*)codes;
+        if (k >= heap_batch_min_k) {
+            return scan_codes_batch<C> (
+                list_size, ids, list_no, store_pairs, simi, idxi, k, bitset,
+                [&] (size_t j) { return dis_func (xi, list_vecs + d * j, d); });
+        }
         size_t nup = 0;
         for (size_t j = 0; j < list_size; j++) {
             if (!bitset || !bitset->test(ids[j])) {
                 const float * yj = list_vecs + d * j;
-                float dis = metric == METRIC_INNER_PRODUCT ?
-                            fvec_inner_product (xi, yj, d) : fvec_L2sqr (xi, yj, d);
+                float dis = dis_func (xi, yj, d);
                 if (C::cmp (simi[0], dis)) {
                     int64_t id = store_pairs ? (list_no << 32 | j) : ids[j];
                     heap_swap_top<C> (k, simi, idxi, dis, id);
@@ -179,8 +185,7 @@ struct IVFFlatScanner: InvertedListScanner {
         const float *list_vecs = (const float*)codes;
         for (size_t j = 0; j < list_size; j++) {
             const float * yj = list_vecs + d * j;
-            float dis = metric == METRIC_INNER_PRODUCT ?
-                fvec_inner_product (xi, yj, d) : fvec_L2sqr (xi, yj, d);
+            float dis = dis_func (xi, yj, d);
             if (C::cmp (radius, dis)) {
                 int64_t id = store_pairs ? lo_build (list_no, j) : ids[j];
                 res.add (dis, id);
@@ -0,0 +1,30 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "SearchInterrupt.h"
+
+namespace faiss {
+
+thread_local const SearchInterrupt::Checker* SearchInterrupt::current_ = nullptr;
+
+SearchInterrupt::Scope::Scope(const Checker* checker) : prev_(current_) {
+    current_ = checker;
+}
+
+SearchInterrupt::Scope::~Scope() {
+    current_ = prev_;
+}
+
+const SearchInterrupt::Checker* SearchInterrupt::current() {
+    return current_;
+}
+
+}  // namespace faiss
@@ -0,0 +1,48 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <functional>
+
+namespace faiss {
+
+/** Cooperative abort of a single search.
+ *
+ * Unlike InterruptCallback, which is process wide, the checker is bound to
+ * the thread issuing the search. Search loops fetch it with current() before
+ * entering their omp region and poll is_interrupted() between queries.
+ */
+class SearchInterrupt {
+public:
+    using Checker = std::function<bool()>;
+
+    /// install a checker for searches issued from this thread
+    class Scope {
+    public:
+        explicit Scope(const Checker* checker);
+        ~Scope();
+
+    private:
+        const Checker* prev_;
+    };
+
+    static const Checker* current();
+
+    static bool is_interrupted(const Checker* checker) {
+        return checker != nullptr && (*checker)();
+    }
+
+private:
+    static thread_local const Checker* current_;
+};
+
+}  // namespace faiss
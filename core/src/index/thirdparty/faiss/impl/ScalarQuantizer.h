@@ -116,6 +116,12 @@ struct IVFSQScannerIP: InvertedListScanner {
                        size_t k,
                        ConcurrentBitsetPtr bitset) const override
     {
+        if (k >= heap_batch_min_k) {
+            return scan_codes_batch<CMin<float, idx_t> > (
+                list_size, ids, list_no, store_pairs, simi, idxi, k, bitset,
+                [&] (size_t j) { return accu0 + dc.query_to_code (codes + j * code_size); });
+        }
+
         size_t nup = 0;
 
         for (size_t j = 0; j < list_size; j++) {
@@ -204,6 +210,12 @@ struct IVFSQScannerL2: InvertedListScanner {
                        size_t k,
                        ConcurrentBitsetPtr bitset) const override
     {
+        if (k >= heap_batch_min_k) {
+            return scan_codes_batch<CMax<float, idx_t> > (
+                list_size, ids, list_no, store_pairs, simi, idxi, k, bitset,
+                [&] (size_t j) { return dc.query_to_code (codes + j * code_size); });
+        }
+
         size_t nup = 0;
         for (size_t j = 0; j < list_size; j++) {
             if(!bitset || !bitset->test(ids[j])){
@@ -12,6 +12,7 @@
 #include <faiss/utils/Heap.h>
 #include <faiss/impl/FaissAssert.h>
 #include <faiss/utils/utils.h>
+#include <faiss/utils/hamming_simd-inl.h>
 
 namespace faiss {
 
@@ -134,6 +135,11 @@ void binary_distence_knn_hc (
     switch (metric_type) {
     case METRIC_Jaccard:
     case METRIC_Tanimoto:
+        if (bvec_use_simd(ncodes)) {
+            binary_distence_knn_hc<faiss::JaccardComputerSIMD>
+                    (ncodes, ha, a, b, nb, order, true, bitset);
+            break;
+        }
         switch (ncodes) {
 #define binary_distence_knn_hc_jaccard(ncodes) \
         case ncodes: \
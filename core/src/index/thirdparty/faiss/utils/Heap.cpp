@@ -11,9 +11,133 @@
 
 #include <faiss/utils/Heap.h>
 
+#ifdef __SSE__
+#include <immintrin.h>
+#endif
+
 
 namespace faiss {
 
+size_t heap_batch_min_k = 256;
+
+/*******************************************************************
+ * Vectorized candidate filtering
+ *******************************************************************/
+
+namespace {
+
+// append the positions of the set bits of mask, offset by i
+inline size_t append_mask (uint32_t mask, size_t i, uint32_t * out_idx, size_t m)
+{
+    while (mask) {
+        out_idx[m++] = i + __builtin_ctz (mask);
+        mask &= mask - 1;
+    }
+    return m;
+}
+
+#ifdef __SSE__
+// CMP (a, b) returns a 4-bit mask of the lanes that pass
+template <class C, class CMP>
+size_t heap_filter_sse (typename C::T thresh, const typename C::T * x,
+                        size_t n, uint32_t * out_idx, CMP cmp4)
+{
+    size_t m = 0, i = 0;
+    for (; i + 16 <= n; i += 16) {
+        uint32_t mask = cmp4 (x + i) | (cmp4 (x + i + 4) << 4) |
+                        (cmp4 (x + i + 8) << 8) | (cmp4 (x + i + 12) << 12);
+        m = append_mask (mask, i, out_idx, m);
+    }
+    for (; i + 4 <= n; i += 4) {
+        m = append_mask (cmp4 (x + i), i, out_idx, m);
+    }
+    for (; i < n; i++) {
+        if (C::cmp (thresh, x[i])) out_idx[m++] = i;
+    }
+    return m;
+}
+#endif
+
+} // namespace
+
+template <>
+size_t heap_filter<CMax<float, int64_t> > (
+        float thresh, const float * x, size_t n, uint32_t * out_idx)
+{
+#ifdef __SSE__
+    __m128 mt = _mm_set1_ps (thresh);
+    return heap_filter_sse<CMax<float, int64_t> > (thresh, x, n, out_idx,
+        [mt] (const float * p) -> uint32_t {
+            return _mm_movemask_ps (_mm_cmplt_ps (_mm_loadu_ps (p), mt));
+        });
+#else
+    size_t m = 0;
+    for (size_t i = 0; i < n; i++) {
+        if (x[i] < thresh) out_idx[m++] = i;
+    }
+    return m;
+#endif
+}
+
+template <>
+size_t heap_filter<CMin<float, int64_t> > (
+        float thresh, const float * x, size_t n, uint32_t * out_idx)
+{
+#ifdef __SSE__
+    __m128 mt = _mm_set1_ps (thresh);
+    return heap_filter_sse<CMin<float, int64_t> > (thresh, x, n, out_idx,
+        [mt] (const float * p) -> uint32_t {
+            return _mm_movemask_ps (_mm_cmpgt_ps (_mm_loadu_ps (p), mt));
+        });
+#else
+    size_t m = 0;
+    for (size_t i = 0; i < n; i++) {
+        if (x[i] > thresh) out_idx[m++] = i;
+    }
+    return m;
+#endif
+}
+
+template <>
+size_t heap_filter<CMax<int, int64_t> > (
+        int thresh, const int * x, size_t n, uint32_t * out_idx)
+{
+#ifdef __SSE__
+    __m128i mt = _mm_set1_epi32 (thresh);
+    return heap_filter_sse<CMax<int, int64_t> > (thresh, x, n, out_idx,
+        [mt] (const int * p) -> uint32_t {
+            __m128i mx = _mm_loadu_si128 ((const __m128i *) p);
+            return _mm_movemask_ps (_mm_castsi128_ps (_mm_cmplt_epi32 (mx, mt)));
+        });
+#else
+    size_t m = 0;
+    for (size_t i = 0; i < n; i++) {
+        if (x[i] < thresh) out_idx[m++] = i;
+    }
+    return m;
+#endif
+}
+
+template <>
+size_t heap_filter<CMin<int, int64_t> > (
+        int thresh, const int * x, size_t n, uint32_t * out_idx)
+{
+#ifdef __SSE__
+    __m128i mt = _mm_set1_epi32 (thresh);
+    return heap_filter_sse<CMin<int, int64_t> > (thresh, x, n, out_idx,
+        [mt] (const int * p) -> uint32_t {
+            __m128i mx = _mm_loadu_si128 ((const __m128i *) p);
+            return _mm_movemask_ps (_mm_castsi128_ps (_mm_cmpgt_epi32 (mx, mt)));
+        });
+#else
+    size_t m = 0;
+    for (size_t i = 0; i < n; i++) {
+        if (x[i] > thresh) out_idx[m++] = i;
+    }
+    return m;
+#endif
+}
+
 
 template <typename C>
 void HeapArray<C>::heapify ()
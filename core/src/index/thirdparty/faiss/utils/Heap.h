@@ -29,7 +29,10 @@
 #include <cstdio>
 #include <stdint.h>
 
+#include <algorithm>
 #include <limits>
+#include <utility>
+#include <vector>
 
 
 namespace faiss {
@@ -334,6 +337,180 @@ void maxheap_addn (size_t k, T * bh_val, int64_t * bh_ids,
 
 
 
+/*******************************************************************
+ * Batched insertion for large heaps
+ *
+ * With large k (thousands) one sift per accepted candidate dominates the
+ * scan. Instead, candidates are compared against the running threshold
+ * (the heap top) with SIMD, and the survivors are merged into the heap by
+ * selection when they are numerous enough to amortize it.
+ *******************************************************************/
+
+/// below this k, heap_addn_batch falls back to one heap_swap_top per candidate
+extern size_t heap_batch_min_k;
+
+/** Store in out_idx the positions i < n such that C::cmp (thresh, x[i]),
+ * ie. the candidates that would enter a heap whose top is thresh.
+ * Returns their count. Vectorized for float and int values. */
+template <class C> inline
+size_t heap_filter (typename C::T thresh, const typename C::T * x,
+                    size_t n, uint32_t * out_idx)
+{
+    size_t m = 0;
+    for (size_t i = 0; i < n; i++) {
+        if (C::cmp (thresh, x[i])) {
+            out_idx[m++] = i;
+        }
+    }
+    return m;
+}
+
+template <> size_t heap_filter<CMax<float, int64_t> > (
+        float thresh, const float * x, size_t n, uint32_t * out_idx);
+template <> size_t heap_filter<CMin<float, int64_t> > (
+        float thresh, const float * x, size_t n, uint32_t * out_idx);
+template <> size_t heap_filter<CMax<int, int64_t> > (
+        int thresh, const int * x, size_t n, uint32_t * out_idx);
+template <> size_t heap_filter<CMin<int, int64_t> > (
+        int thresh, const int * x, size_t n, uint32_t * out_idx);
+
+/* Sift element i down (0-based) in a heap of size k */
+template <class C> inline
+void heap_sift_down (size_t k,
+                     typename C::T * bh_val, typename C::TI * bh_ids,
+                     size_t i)
+{
+    typename C::T val = bh_val[i];
+    typename C::TI id = bh_ids[i];
+    while (1) {
+        size_t i1 = 2 * i + 1, i2 = i1 + 1;
+        if (i1 >= k)
+            break;
+        size_t ic = (i2 >= k || C::cmp (bh_val[i1], bh_val[i2])) ? i1 : i2;
+        if (C::cmp (val, bh_val[ic]))
+            break;
+        bh_val[i] = bh_val[ic];
+        bh_ids[i] = bh_ids[ic];
+        i = ic;
+    }
+    bh_val[i] = val;
+    bh_ids[i] = id;
+}
+
+/** Insert n candidates into a heap of size k. Candidates that do not beat
+ * the top are dropped. A few survivors are sifted in one by one; when they
+ * are many w.r.t. k, the heap and the survivors are merged by selection
+ * (nth_element over k + n entries, then a linear-time heap rebuild), which
+ * costs O(k + n) instead of O(n log k). If ids is nullptr, the id of x[i]
+ * is id0 + i. Returns the number of candidates that entered the heap. */
+template <class C> inline
+size_t heap_batch_insert (size_t k,
+                          typename C::T * bh_val, typename C::TI * bh_ids,
+                          const typename C::T * x,
+                          const typename C::TI * ids,
+                          typename C::TI id0,
+                          size_t n)
+{
+    typedef typename C::T T;
+    typedef typename C::TI TI;
+
+    size_t log2k = 1;
+    while ((size_t(1) << log2k) < k) log2k++;
+
+    if (n * log2k < k + n) {
+        size_t nup = 0;
+        for (size_t i = 0; i < n; i++) {
+            if (C::cmp (bh_val[0], x[i])) {
+                heap_swap_top<C> (k, bh_val, bh_ids, x[i], ids ? ids[i] : id0 + i);
+                nup++;
+            }
+        }
+        return nup;
+    }
+
+    static thread_local std::vector<std::pair<T, TI> > buf;
+    buf.clear ();
+    for (size_t i = 0; i < k; i++) {
+        buf.emplace_back (bh_val[i], bh_ids[i]);
+    }
+    T thresh = bh_val[0];
+    for (size_t i = 0; i < n; i++) {
+        if (C::cmp (thresh, x[i])) {
+            buf.emplace_back (x[i], ids ? ids[i] : id0 + i);
+        }
+    }
+    size_t nup = buf.size () - k;
+    if (nup == 0) return 0;
+
+    // best first: the opposite order of the heap
+    std::nth_element (buf.begin (), buf.begin () + (k - 1), buf.end (),
+                      [] (const std::pair<T, TI> & a, const std::pair<T, TI> & b) {
+                          return C::Crev::cmp (a.first, b.first);
+                      });
+    for (size_t i = 0; i < k; i++) {
+        bh_val[i] = buf[i].first;
+        bh_ids[i] = buf[i].second;
+    }
+    for (size_t i = k / 2; i-- > 0; ) {
+        heap_sift_down<C> (k, bh_val, bh_ids, i);
+    }
+    return nup;
+}
+
+/** Same as heap_addn, for large heaps: the values are filtered against the
+ * running threshold block by block and the survivors are batch-inserted.
+ * If ids is nullptr, the id of x[i] is id0 + i. */
+template <class C> inline
+size_t heap_addn_batch (size_t k,
+                        typename C::T * bh_val, typename C::TI * bh_ids,
+                        const typename C::T * x,
+                        const typename C::TI * ids,
+                        typename C::TI id0,
+                        size_t n)
+{
+    if (k < heap_batch_min_k) {
+        size_t nup = 0;
+        for (size_t i = 0; i < n; i++) {
+            if (C::cmp (bh_val[0], x[i])) {
+                heap_swap_top<C> (k, bh_val, bh_ids, x[i], ids ? ids[i] : id0 + i);
+                nup++;
+            }
+        }
+        return nup;
+    }
+
+    // survivors are accumulated until there are about k of them, so that
+    // each selection pass is amortized over as many candidates as it keeps
+    static thread_local std::vector<typename C::T> cand_val;
+    static thread_local std::vector<typename C::TI> cand_ids;
+    cand_val.clear ();
+    cand_ids.clear ();
+
+    const size_t bs = 256;
+    uint32_t idx[bs];
+    size_t nup = 0;
+    for (size_t i0 = 0; i0 < n; i0 += bs) {
+        size_t ni = std::min (bs, n - i0);
+        size_t m = heap_filter<C> (bh_val[0], x + i0, ni, idx);
+        for (size_t t = 0; t < m; t++) {
+            size_t i = i0 + idx[t];
+            cand_val.push_back (x[i]);
+            cand_ids.push_back (ids ? ids[i] : id0 + i);
+        }
+        if (cand_val.size () >= k) {
+            nup += heap_batch_insert<C> (k, bh_val, bh_ids, cand_val.data (),
+                                         cand_ids.data (), 0, cand_val.size ());
+            cand_val.clear ();
+            cand_ids.clear ();
+        }
+    }
+    nup += heap_batch_insert<C> (k, bh_val, bh_ids, cand_val.data (),
+                                 cand_ids.data (), 0, cand_val.size ());
+    return nup;
+}
+
+
+
 /*******************************************************************
  * Heap finalization (reorder elements)
  *******************************************************************/
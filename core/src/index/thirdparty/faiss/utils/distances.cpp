@@ -13,6 +13,8 @@
 #include <cassert>
 #include <cstring>
 #include <cmath>
+#include <algorithm>
+#include <vector>
 
 #include <omp.h>
 #include <faiss/BuilderSuspend.h>
@@ -151,6 +153,7 @@ static void knn_inner_product_sse (const float * x,
                         ConcurrentBitsetPtr bitset = nullptr)
 {
     size_t k = res->k;
+    fvec_func_ptr ip_func = fvec_inner_product_for_dim(d);
 
     size_t thread_max_num = omp_get_max_threads();
     
@@ -172,7 +175,7 @@ static void knn_inner_product_sse (const float * x,
             const float *y_j = y + j * d;
             for (size_t i = 0; i < nx; i++) {
                 const float *x_i = x + i * d;
-                float ip = fvec_inner_product (x_i, y_j, d);
+                float ip = ip_func (x_i, y_j, d);
 
                 float * val_ = value + thread_no * thread_heap_size + i * k;
                 int64_t * ids_ = labels + thread_no * thread_heap_size + i * k;
@@ -256,6 +259,7 @@ static void knn_L2sqr_sse (
                 ConcurrentBitsetPtr bitset = nullptr)
 {
     size_t k = res->k;
+    fvec_func_ptr l2_func = fvec_L2sqr_for_dim(d);
 
     size_t thread_max_num = omp_get_max_threads();
 
@@ -277,7 +281,7 @@ static void knn_L2sqr_sse (
             const float *y_j = y + j * d;
             for (size_t i = 0; i < nx; i++) {
                 const float *x_i = x + i * d;
-                float disij = fvec_L2sqr (x_i, y_j, d);
+                float disij = l2_func (x_i, y_j, d);
 
                 float * val_ = value + thread_no * thread_heap_size + i * k;
                 int64_t * ids_ = labels + thread_no * thread_heap_size + i * k;
@@ -395,7 +399,17 @@ static void knn_inner_product_blas (
             for(size_t i = i0; i < i1; i++){
                 float * __restrict simi = res->get_val(i);
                 int64_t * __restrict idxi = res->get_ids (i);
-                const float *ip_line = ip_block + (i - i0) * (j1 - j0);
+                float *ip_line = ip_block + (i - i0) * (j1 - j0);
+
+                if (k >= heap_batch_min_k) {
+                    if (bitset) {
+                        for (size_t j = j0; j < j1; j++) {
+                            if (bitset->test(j)) ip_line[j - j0] = CMin<float, int64_t>::neutral();
+                        }
+                    }
+                    heap_addn_batch<CMin<float, int64_t> > (k, simi, idxi, ip_line, nullptr, j0, j1 - j0);
+                    continue;
+                }
 
                 for(size_t j = j0; j < j1; j++){
                     if(!bitset || !bitset->test(j)){
@@ -465,7 +479,21 @@ static void knn_L2sqr_blas (const float * x,
             for (size_t i = i0; i < i1; i++) {
                 float * __restrict simi = res->get_val(i);
                 int64_t * __restrict idxi = res->get_ids (i);
-                const float *ip_line = ip_block + (i - i0) * (j1 - j0);
+                float *ip_line = ip_block + (i - i0) * (j1 - j0);
+
+                if (k >= heap_batch_min_k) {
+                    for (size_t j = j0; j < j1; j++) {
+                        float dis = CMax<float, int64_t>::neutral();
+                        if (!bitset || !bitset->test(j)) {
+                            dis = x_norms[i] + y_norms[j] - 2 * ip_line[j - j0];
+                            if (dis < 0) dis = 0;
+                            dis = corr (dis, i, j);
+                        }
+                        ip_line[j - j0] = dis;
+                    }
+                    heap_addn_batch<CMax<float, int64_t> > (k, simi, idxi, ip_line, nullptr, j0, j1 - j0);
+                    continue;
+                }
 
                 for (size_t j = j0; j < j1; j++) {
                     if(!bitset || !bitset->test(j)){
@@ -492,6 +520,108 @@ static void knn_L2sqr_blas (const float * x,
 
 }
 
+/** Fused distance + top-k: tiles of queries are scored against base blocks
+ * that stay resident in L2, and the result heaps are updated in the same
+ * pass, so the nx * ny distance matrix is never materialized. Each thread
+ * owns whole query tiles, hence no heap merging is needed. */
+template<class C, class DistanceFinalizer>
+static void knn_fused (const float * x,
+        const float * y,
+        size_t d, size_t nx, size_t ny,
+        HeapArray<C> * res,
+        const DistanceFinalizer &finalize,
+        ConcurrentBitsetPtr bitset = nullptr)
+{
+    res->heapify ();
+
+    if (nx == 0 || ny == 0) return;
+
+    size_t k = res->k;
+
+    /* block sizes: split the queries so that every thread gets a tile, and
+     * size base blocks to fit in L2 next to the tile */
+    size_t thread_max_num = omp_get_max_threads();
+    size_t bs_x = (nx + thread_max_num - 1) / thread_max_num;
+    bs_x = std::max ((size_t)4, std::min ((size_t)distance_compute_fused_query_tile, bs_x));
+    size_t bs_y = distance_compute_fused_block_bytes / (d * sizeof(float));
+    bs_y = std::max ((size_t)16, bs_y);
+
+#pragma omp parallel
+    {
+        std::vector<float> ip_block (bs_x * bs_y);
+
+#pragma omp for schedule(dynamic)
+        for (size_t i0 = 0; i0 < nx; i0 += bs_x) {
+            size_t i1 = std::min (i0 + bs_x, nx);
+
+            for (size_t j0 = 0; j0 < ny; j0 += bs_y) {
+                size_t j1 = std::min (j0 + bs_y, ny);
+                fvec_inner_products_tile (ip_block.data(), x + i0 * d, i1 - i0,
+                                          y + j0 * d, j1 - j0, d);
+
+                for (size_t i = i0; i < i1; i++) {
+                    float * __restrict simi = res->get_val(i);
+                    int64_t * __restrict idxi = res->get_ids (i);
+                    float *ip_line = ip_block.data() + (i - i0) * (j1 - j0);
+
+                    if (k >= heap_batch_min_k) {
+                        for (size_t j = j0; j < j1; j++) {
+                            ip_line[j - j0] = (bitset && bitset->test(j)) ?
+                                C::neutral() : finalize (ip_line[j - j0], i, j);
+                        }
+                        heap_addn_batch<C> (k, simi, idxi, ip_line, nullptr, j0, j1 - j0);
+                        continue;
+                    }
+
+                    for (size_t j = j0; j < j1; j++) {
+                        if(!bitset || !bitset->test(j)){
+                            float dis = finalize (*ip_line, i, j);
+                            if (C::cmp (simi[0], dis)) {
+                                heap_swap_top<C> (k, simi, idxi, dis, j);
+                            }
+                        }
+                        ip_line++;
+                    }
+                }
+            }
+        }
+    }
+    InterruptCallback::check ();
+    res->reorder ();
+}
+
+struct IPDistanceFinalizer {
+    float operator()(float ip, size_t /*qno*/, size_t /*bno*/) const {
+        return ip;
+    }
+};
+
+struct L2DistanceFinalizer {
+    const float *x_norms;
+    const float *y_norms;
+    float operator()(float ip, size_t qno, size_t bno) const {
+        float dis = x_norms[qno] + y_norms[bno] - 2 * ip;
+        // negative values can occur for identical vectors
+        // due to roundoff errors
+        return dis < 0 ? 0 : dis;
+    }
+};
+
+static void knn_L2sqr_fused (const float * x,
+        const float * y,
+        size_t d, size_t nx, size_t ny,
+        float_maxheap_array_t * res,
+        ConcurrentBitsetPtr bitset = nullptr)
+{
+    std::vector<float> x_norms (nx);
+    std::vector<float> y_norms (ny);
+    fvec_norms_L2sqr (x_norms.data(), x, d, nx);
+    fvec_norms_L2sqr (y_norms.data(), y, d, ny);
+
+    L2DistanceFinalizer finalize = {x_norms.data(), y_norms.data()};
+    knn_fused (x, y, d, nx, ny, res, finalize, bitset);
+}
+
 template<class DistanceCorrection>
 static void knn_jaccard_blas (const float * x,
                               const float * y,
@@ -578,6 +708,9 @@ static void knn_jaccard_blas (const float * x,
  *******************************************************/
 
 int distance_compute_blas_threshold = 20;
+int distance_compute_fused_threshold = 2048;
+int distance_compute_fused_query_tile = 32;
+size_t distance_compute_fused_block_bytes = 256 * 1024;
 
 void knn_inner_product (const float * x,
         const float * y,
@@ -587,6 +720,8 @@ void knn_inner_product (const float * x,
 {
     if (nx < distance_compute_blas_threshold) {
         knn_inner_product_sse (x, y, d, nx, ny, res, bitset);
+    } else if (nx < distance_compute_fused_threshold) {
+        knn_fused (x, y, d, nx, ny, res, IPDistanceFinalizer(), bitset);
     } else {
         knn_inner_product_blas (x, y, d, nx, ny, res, bitset);
     }
@@ -608,6 +743,8 @@ void knn_L2sqr (const float * x,
 {
     if (nx < distance_compute_blas_threshold) {
         knn_L2sqr_sse (x, y, d, nx, ny, res, bitset);
+    } else if (nx < distance_compute_fused_threshold) {
+        knn_L2sqr_fused (x, y, d, nx, ny, res, bitset);
     } else {
         NopDistanceCorrection nop;
         knn_L2sqr_blas (x, y, d, nx, ny, res, nop, bitset);
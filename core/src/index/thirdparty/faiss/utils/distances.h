@@ -44,6 +44,13 @@ float fvec_Linf_sse (
         const float * x,
         const float * y,
         size_t d);
+
+/* inner products of nx vectors x with ny vectors y, ip is nx * ny row-major */
+void fvec_inner_products_tile_sse (
+        float * ip,
+        const float * x, size_t nx,
+        const float * y, size_t ny,
+        size_t d);
 #endif
 
 float fvec_jaccard (
@@ -158,6 +165,15 @@ void pairwise_indexed_inner_product (
 // threshold on nx above which we switch to BLAS to compute distances
 extern int distance_compute_blas_threshold;
 
+// nx in [distance_compute_blas_threshold, distance_compute_fused_threshold)
+// uses the fused distance + top-k kernel instead of BLAS; set it to 0 to
+// always use BLAS
+extern int distance_compute_fused_threshold;
+
+// queries per tile and bytes of base vectors per block of the fused kernel
+extern int distance_compute_fused_query_tile;
+extern size_t distance_compute_fused_block_bytes;
+
 /** Return the k nearest neighors of each of the nx vectors x among the ny
  *  vector y, w.r.t to max inner product
  *
@@ -29,4 +29,8 @@ fvec_L1_avx(const float* x, const float* y, size_t d);
 float
 fvec_Linf_avx(const float* x, const float* y, size_t d);
 
+/// inner products of nx vectors x with ny vectors y, ip is nx * ny row-major
+void
+fvec_inner_products_tile_avx(float* ip, const float* x, size_t nx, const float* y, size_t ny, size_t d);
+
 } // namespace faiss
@@ -0,0 +1,91 @@
+// -*- c++ -*-
+
+#include <faiss/utils/distances_dim.h>
+
+#include <immintrin.h>
+
+namespace faiss {
+
+#ifdef __SSE__
+
+template <size_t D>
+static float fvec_L2sqr_sse_d (const float* x, const float* y, size_t) {
+    static_assert(D % 16 == 0, "dimension must be a multiple of 16");
+    __m128 msum0 = _mm_setzero_ps();
+    __m128 msum1 = _mm_setzero_ps();
+    __m128 msum2 = _mm_setzero_ps();
+    __m128 msum3 = _mm_setzero_ps();
+
+    for (size_t i = 0; i < D; i += 16) {
+        const __m128 a_m_b0 = _mm_loadu_ps (x + i) - _mm_loadu_ps (y + i);
+        const __m128 a_m_b1 = _mm_loadu_ps (x + i + 4) - _mm_loadu_ps (y + i + 4);
+        const __m128 a_m_b2 = _mm_loadu_ps (x + i + 8) - _mm_loadu_ps (y + i + 8);
+        const __m128 a_m_b3 = _mm_loadu_ps (x + i + 12) - _mm_loadu_ps (y + i + 12);
+        msum0 += a_m_b0 * a_m_b0;
+        msum1 += a_m_b1 * a_m_b1;
+        msum2 += a_m_b2 * a_m_b2;
+        msum3 += a_m_b3 * a_m_b3;
+    }
+
+    msum0 = (msum0 + msum1) + (msum2 + msum3);
+    msum0 = _mm_hadd_ps (msum0, msum0);
+    msum0 = _mm_hadd_ps (msum0, msum0);
+    return  _mm_cvtss_f32 (msum0);
+}
+
+template <size_t D>
+static float fvec_inner_product_sse_d (const float* x, const float* y, size_t) {
+    static_assert(D % 16 == 0, "dimension must be a multiple of 16");
+    __m128 msum0 = _mm_setzero_ps();
+    __m128 msum1 = _mm_setzero_ps();
+    __m128 msum2 = _mm_setzero_ps();
+    __m128 msum3 = _mm_setzero_ps();
+
+    for (size_t i = 0; i < D; i += 16) {
+        msum0 += _mm_loadu_ps (x + i) * _mm_loadu_ps (y + i);
+        msum1 += _mm_loadu_ps (x + i + 4) * _mm_loadu_ps (y + i + 4);
+        msum2 += _mm_loadu_ps (x + i + 8) * _mm_loadu_ps (y + i + 8);
+        msum3 += _mm_loadu_ps (x + i + 12) * _mm_loadu_ps (y + i + 12);
+    }
+
+    msum0 = (msum0 + msum1) + (msum2 + msum3);
+    msum0 = _mm_hadd_ps (msum0, msum0);
+    msum0 = _mm_hadd_ps (msum0, msum0);
+    return  _mm_cvtss_f32 (msum0);
+}
+
+fvec_func_ptr fvec_L2sqr_dim_sse (size_t d) {
+    switch (d) {
+        case 128: return fvec_L2sqr_sse_d<128>;
+        case 256: return fvec_L2sqr_sse_d<256>;
+        case 512: return fvec_L2sqr_sse_d<512>;
+        case 768: return fvec_L2sqr_sse_d<768>;
+        case 1024: return fvec_L2sqr_sse_d<1024>;
+        default: return nullptr;
+    }
+}
+
+fvec_func_ptr fvec_inner_product_dim_sse (size_t d) {
+    switch (d) {
+        case 128: return fvec_inner_product_sse_d<128>;
+        case 256: return fvec_inner_product_sse_d<256>;
+        case 512: return fvec_inner_product_sse_d<512>;
+        case 768: return fvec_inner_product_sse_d<768>;
+        case 1024: return fvec_inner_product_sse_d<1024>;
+        default: return nullptr;
+    }
+}
+
+#else
+
+fvec_func_ptr fvec_L2sqr_dim_sse (size_t d) {
+    return nullptr;
+}
+
+fvec_func_ptr fvec_inner_product_dim_sse (size_t d) {
+    return nullptr;
+}
+
+#endif
+
+} // namespace faiss
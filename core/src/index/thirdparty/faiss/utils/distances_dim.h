@@ -0,0 +1,36 @@
+// -*- c++ -*-
+
+/* L2 and IP kernels specialized for a compile-time dimension.
+ * Embedding sizes 128, 256, 512, 768 and 1024 are covered; the loops have no
+ * tail handling and keep several independent accumulators in flight.
+ * The actual functions are implemented in distances_dim.cpp (SSE4.2),
+ * distances_dim_avx.cpp (AVX2) and distances_dim_avx512.cpp (AVX-512). */
+
+#pragma once
+
+#include <stddef.h>
+
+namespace faiss {
+
+typedef float (*fvec_func_ptr)(const float*, const float*, size_t);
+
+/// @return the kernel specialized for dimension d, or nullptr if there is none
+fvec_func_ptr
+fvec_L2sqr_dim_sse(size_t d);
+
+fvec_func_ptr
+fvec_inner_product_dim_sse(size_t d);
+
+fvec_func_ptr
+fvec_L2sqr_dim_avx(size_t d);
+
+fvec_func_ptr
+fvec_inner_product_dim_avx(size_t d);
+
+fvec_func_ptr
+fvec_L2sqr_dim_avx512(size_t d);
+
+fvec_func_ptr
+fvec_inner_product_dim_avx512(size_t d);
+
+} // namespace faiss
@@ -0,0 +1,102 @@
+// -*- c++ -*-
+
+#include <faiss/utils/distances_dim.h>
+
+#include <immintrin.h>
+
+namespace faiss {
+
+#ifdef __AVX__
+
+// acc + a * b, fused when the target supports FMA
+static inline __m256 madd_8 (__m256 a, __m256 b, __m256 acc) {
+#ifdef __FMA__
+    return _mm256_fmadd_ps (a, b, acc);
+#else
+    return _mm256_add_ps (acc, _mm256_mul_ps (a, b));
+#endif
+}
+
+static inline float reduce_add_8 (__m256 msum) {
+    __m128 msum2 = _mm256_extractf128_ps(msum, 1);
+    msum2 +=       _mm256_extractf128_ps(msum, 0);
+    msum2 = _mm_hadd_ps (msum2, msum2);
+    msum2 = _mm_hadd_ps (msum2, msum2);
+    return  _mm_cvtss_f32 (msum2);
+}
+
+template <size_t D>
+static float fvec_L2sqr_avx_d (const float* x, const float* y, size_t) {
+    static_assert(D % 32 == 0, "dimension must be a multiple of 32");
+    __m256 msum0 = _mm256_setzero_ps();
+    __m256 msum1 = _mm256_setzero_ps();
+    __m256 msum2 = _mm256_setzero_ps();
+    __m256 msum3 = _mm256_setzero_ps();
+
+    for (size_t i = 0; i < D; i += 32) {
+        const __m256 a_m_b0 = _mm256_loadu_ps (x + i) - _mm256_loadu_ps (y + i);
+        const __m256 a_m_b1 = _mm256_loadu_ps (x + i + 8) - _mm256_loadu_ps (y + i + 8);
+        const __m256 a_m_b2 = _mm256_loadu_ps (x + i + 16) - _mm256_loadu_ps (y + i + 16);
+        const __m256 a_m_b3 = _mm256_loadu_ps (x + i + 24) - _mm256_loadu_ps (y + i + 24);
+        msum0 = madd_8 (a_m_b0, a_m_b0, msum0);
+        msum1 = madd_8 (a_m_b1, a_m_b1, msum1);
+        msum2 = madd_8 (a_m_b2, a_m_b2, msum2);
+        msum3 = madd_8 (a_m_b3, a_m_b3, msum3);
+    }
+
+    return reduce_add_8 ((msum0 + msum1) + (msum2 + msum3));
+}
+
+template <size_t D>
+static float fvec_inner_product_avx_d (const float* x, const float* y, size_t) {
+    static_assert(D % 32 == 0, "dimension must be a multiple of 32");
+    __m256 msum0 = _mm256_setzero_ps();
+    __m256 msum1 = _mm256_setzero_ps();
+    __m256 msum2 = _mm256_setzero_ps();
+    __m256 msum3 = _mm256_setzero_ps();
+
+    for (size_t i = 0; i < D; i += 32) {
+        msum0 = madd_8 (_mm256_loadu_ps (x + i), _mm256_loadu_ps (y + i), msum0);
+        msum1 = madd_8 (_mm256_loadu_ps (x + i + 8), _mm256_loadu_ps (y + i + 8), msum1);
+        msum2 = madd_8 (_mm256_loadu_ps (x + i + 16), _mm256_loadu_ps (y + i + 16), msum2);
+        msum3 = madd_8 (_mm256_loadu_ps (x + i + 24), _mm256_loadu_ps (y + i + 24), msum3);
+    }
+
+    return reduce_add_8 ((msum0 + msum1) + (msum2 + msum3));
+}
+
+fvec_func_ptr fvec_L2sqr_dim_avx (size_t d) {
+    switch (d) {
+        case 128: return fvec_L2sqr_avx_d<128>;
+        case 256: return fvec_L2sqr_avx_d<256>;
+        case 512: return fvec_L2sqr_avx_d<512>;
+        case 768: return fvec_L2sqr_avx_d<768>;
+        case 1024: return fvec_L2sqr_avx_d<1024>;
+        default: return nullptr;
+    }
+}
+
+fvec_func_ptr fvec_inner_product_dim_avx (size_t d) {
+    switch (d) {
+        case 128: return fvec_inner_product_avx_d<128>;
+        case 256: return fvec_inner_product_avx_d<256>;
+        case 512: return fvec_inner_product_avx_d<512>;
+        case 768: return fvec_inner_product_avx_d<768>;
+        case 1024: return fvec_inner_product_avx_d<1024>;
+        default: return nullptr;
+    }
+}
+
+#else
+
+fvec_func_ptr fvec_L2sqr_dim_avx (size_t d) {
+    return nullptr;
+}
+
+fvec_func_ptr fvec_inner_product_dim_avx (size_t d) {
+    return nullptr;
+}
+
+#endif
+
+} // namespace faiss
@@ -0,0 +1,95 @@
+// -*- c++ -*-
+
+#include <faiss/utils/distances_dim.h>
+
+#include <immintrin.h>
+
+namespace faiss {
+
+#if (defined(__AVX512F__) && defined(__AVX512DQ__))
+
+static inline float reduce_add_16 (__m512 msum0) {
+    __m256 msum1 = _mm512_extractf32x8_ps(msum0, 1);
+    msum1 +=       _mm512_extractf32x8_ps(msum0, 0);
+    __m128 msum2 = _mm256_extractf128_ps(msum1, 1);
+    msum2 +=       _mm256_extractf128_ps(msum1, 0);
+    msum2 = _mm_hadd_ps (msum2, msum2);
+    msum2 = _mm_hadd_ps (msum2, msum2);
+    return  _mm_cvtss_f32 (msum2);
+}
+
+template <size_t D>
+static float fvec_L2sqr_avx512_d (const float* x, const float* y, size_t) {
+    static_assert(D % 64 == 0, "dimension must be a multiple of 64");
+    __m512 msum0 = _mm512_setzero_ps();
+    __m512 msum1 = _mm512_setzero_ps();
+    __m512 msum2 = _mm512_setzero_ps();
+    __m512 msum3 = _mm512_setzero_ps();
+
+    for (size_t i = 0; i < D; i += 64) {
+        const __m512 a_m_b0 = _mm512_loadu_ps (x + i) - _mm512_loadu_ps (y + i);
+        const __m512 a_m_b1 = _mm512_loadu_ps (x + i + 16) - _mm512_loadu_ps (y + i + 16);
+        const __m512 a_m_b2 = _mm512_loadu_ps (x + i + 32) - _mm512_loadu_ps (y + i + 32);
+        const __m512 a_m_b3 = _mm512_loadu_ps (x + i + 48) - _mm512_loadu_ps (y + i + 48);
+        msum0 = _mm512_fmadd_ps (a_m_b0, a_m_b0, msum0);
+        msum1 = _mm512_fmadd_ps (a_m_b1, a_m_b1, msum1);
+        msum2 = _mm512_fmadd_ps (a_m_b2, a_m_b2, msum2);
+        msum3 = _mm512_fmadd_ps (a_m_b3, a_m_b3, msum3);
+    }
+
+    return reduce_add_16 ((msum0 + msum1) + (msum2 + msum3));
+}
+
+template <size_t D>
+static float fvec_inner_product_avx512_d (const float* x, const float* y, size_t) {
+    static_assert(D % 64 == 0, "dimension must be a multiple of 64");
+    __m512 msum0 = _mm512_setzero_ps();
+    __m512 msum1 = _mm512_setzero_ps();
+    __m512 msum2 = _mm512_setzero_ps();
+    __m512 msum3 = _mm512_setzero_ps();
+
+    for (size_t i = 0; i < D; i += 64) {
+        msum0 = _mm512_fmadd_ps (_mm512_loadu_ps (x + i), _mm512_loadu_ps (y + i), msum0);
+        msum1 = _mm512_fmadd_ps (_mm512_loadu_ps (x + i + 16), _mm512_loadu_ps (y + i + 16), msum1);
+        msum2 = _mm512_fmadd_ps (_mm512_loadu_ps (x + i + 32), _mm512_loadu_ps (y + i + 32), msum2);
+        msum3 = _mm512_fmadd_ps (_mm512_loadu_ps (x + i + 48), _mm512_loadu_ps (y + i + 48), msum3);
+    }
+
+    return reduce_add_16 ((msum0 + msum1) + (msum2 + msum3));
+}
+
+fvec_func_ptr fvec_L2sqr_dim_avx512 (size_t d) {
+    switch (d) {
+        case 128: return fvec_L2sqr_avx512_d<128>;
+        case 256: return fvec_L2sqr_avx512_d<256>;
+        case 512: return fvec_L2sqr_avx512_d<512>;
+        case 768: return fvec_L2sqr_avx512_d<768>;
+        case 1024: return fvec_L2sqr_avx512_d<1024>;
+        default: return nullptr;
+    }
+}
+
+fvec_func_ptr fvec_inner_product_dim_avx512 (size_t d) {
+    switch (d) {
+        case 128: return fvec_inner_product_avx512_d<128>;
+        case 256: return fvec_inner_product_avx512_d<256>;
+        case 512: return fvec_inner_product_avx512_d<512>;
+        case 768: return fvec_inner_product_avx512_d<768>;
+        case 1024: return fvec_inner_product_avx512_d<1024>;
+        default: return nullptr;
+    }
+}
+
+#else
+
+fvec_func_ptr fvec_L2sqr_dim_avx512 (size_t d) {
+    return nullptr;
+}
+
+fvec_func_ptr fvec_inner_product_dim_avx512 (size_t d) {
+    return nullptr;
+}
+
+#endif
+
+} // namespace faiss
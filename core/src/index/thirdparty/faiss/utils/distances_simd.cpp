@@ -376,6 +376,19 @@ float fvec_inner_product_sse (const float * x,
     return  _mm_cvtss_f32 (msum1);
 }
 
+
+void fvec_inner_products_tile_sse (float * ip,
+                                   const float * x, size_t nx,
+                                   const float * y, size_t ny,
+                                   size_t d)
+{
+    for (size_t i = 0; i < nx; i++) {
+        for (size_t j = 0; j < ny; j++) {
+            ip[i * ny + j] = fvec_inner_product_sse (x + i * d, y + j * d, d);
+        }
+    }
+}
+
 #endif /* defined(__SSE__) */
 
 //#elif defined(__aarch64__)
@@ -186,6 +186,57 @@ float fvec_Linf_avx (const float* x, const float* y, size_t d) {
     return  _mm_cvtss_f32 (msum2);
 }
 
+
+void fvec_inner_products_tile_avx (float* ip, const float* x, size_t nx,
+                                   const float* y, size_t ny, size_t d) {
+    size_t i = 0;
+    // 4 queries x 1 base vector per step, each base vector load is shared
+    for (; i + 4 <= nx; i += 4) {
+        const float* x0 = x + i * d;
+        const float* x1 = x0 + d;
+        const float* x2 = x1 + d;
+        const float* x3 = x2 + d;
+        for (size_t j = 0; j < ny; j++) {
+            const float* yj = y + j * d;
+            __m256 msum0 = _mm256_setzero_ps();
+            __m256 msum1 = _mm256_setzero_ps();
+            __m256 msum2 = _mm256_setzero_ps();
+            __m256 msum3 = _mm256_setzero_ps();
+            size_t l = 0;
+            for (; l + 8 <= d; l += 8) {
+                __m256 my = _mm256_loadu_ps (yj + l);
+                msum0 += _mm256_loadu_ps (x0 + l) * my;
+                msum1 += _mm256_loadu_ps (x1 + l) * my;
+                msum2 += _mm256_loadu_ps (x2 + l) * my;
+                msum3 += _mm256_loadu_ps (x3 + l) * my;
+            }
+            if (l < d) {
+                __m256 my = masked_read_8 (d - l, yj + l);
+                msum0 += masked_read_8 (d - l, x0 + l) * my;
+                msum1 += masked_read_8 (d - l, x1 + l) * my;
+                msum2 += masked_read_8 (d - l, x2 + l) * my;
+                msum3 += masked_read_8 (d - l, x3 + l) * my;
+            }
+            // transpose-reduce the 4 accumulators into one __m128
+            __m256 t01 = _mm256_hadd_ps (msum0, msum1);
+            __m256 t23 = _mm256_hadd_ps (msum2, msum3);
+            __m256 t = _mm256_hadd_ps (t01, t23);
+            __m128 r = _mm256_extractf128_ps (t, 1) + _mm256_extractf128_ps (t, 0);
+            __attribute__((__aligned__(16))) float buf[4];
+            _mm_store_ps (buf, r);
+            ip[(i + 0) * ny + j] = buf[0];
+            ip[(i + 1) * ny + j] = buf[1];
+            ip[(i + 2) * ny + j] = buf[2];
+            ip[(i + 3) * ny + j] = buf[3];
+        }
+    }
+    for (; i < nx; i++) {
+        for (size_t j = 0; j < ny; j++) {
+            ip[i * ny + j] = fvec_inner_product_avx (x + i * d, y + j * d, d);
+        }
+    }
+}
+
 #else
 
 float fvec_inner_product_avx(const float* x, const float* y, size_t d) {
@@ -208,6 +259,11 @@ float fvec_Linf_avx (const float* x, const float* y, size_t d) {
     return 0.0;
 }
 
+void fvec_inner_products_tile_avx (float* ip, const float* x, size_t nx,
+                                   const float* y, size_t ny, size_t d) {
+    FAISS_ASSERT(false);
+}
+
 #endif
 
 } // namespace faiss
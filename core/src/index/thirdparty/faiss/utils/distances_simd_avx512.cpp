@@ -219,6 +219,52 @@ fvec_Linf_avx512(const float* x, const float* y, size_t d) {
     return  _mm_cvtss_f32 (msum2);
 }
 
+
+void
+fvec_inner_products_tile_avx512(float* ip, const float* x, size_t nx,
+                                const float* y, size_t ny, size_t d) {
+    size_t i = 0;
+    // 4 queries x 1 base vector per step: one base load feeds 4 FMAs
+    for (; i + 4 <= nx; i += 4) {
+        const float* x0 = x + i * d;
+        const float* x1 = x0 + d;
+        const float* x2 = x1 + d;
+        const float* x3 = x2 + d;
+        for (size_t j = 0; j < ny; j++) {
+            const float* yj = y + j * d;
+            __m512 msum0 = _mm512_setzero_ps();
+            __m512 msum1 = _mm512_setzero_ps();
+            __m512 msum2 = _mm512_setzero_ps();
+            __m512 msum3 = _mm512_setzero_ps();
+            size_t l = 0;
+            for (; l + 16 <= d; l += 16) {
+                __m512 my = _mm512_loadu_ps (yj + l);
+                msum0 = _mm512_fmadd_ps (_mm512_loadu_ps (x0 + l), my, msum0);
+                msum1 = _mm512_fmadd_ps (_mm512_loadu_ps (x1 + l), my, msum1);
+                msum2 = _mm512_fmadd_ps (_mm512_loadu_ps (x2 + l), my, msum2);
+                msum3 = _mm512_fmadd_ps (_mm512_loadu_ps (x3 + l), my, msum3);
+            }
+            if (l < d) {
+                __mmask16 mask = (__mmask16)((1U << (d - l)) - 1);
+                __m512 my = _mm512_maskz_loadu_ps (mask, yj + l);
+                msum0 = _mm512_fmadd_ps (_mm512_maskz_loadu_ps (mask, x0 + l), my, msum0);
+                msum1 = _mm512_fmadd_ps (_mm512_maskz_loadu_ps (mask, x1 + l), my, msum1);
+                msum2 = _mm512_fmadd_ps (_mm512_maskz_loadu_ps (mask, x2 + l), my, msum2);
+                msum3 = _mm512_fmadd_ps (_mm512_maskz_loadu_ps (mask, x3 + l), my, msum3);
+            }
+            ip[(i + 0) * ny + j] = _mm512_reduce_add_ps (msum0);
+            ip[(i + 1) * ny + j] = _mm512_reduce_add_ps (msum1);
+            ip[(i + 2) * ny + j] = _mm512_reduce_add_ps (msum2);
+            ip[(i + 3) * ny + j] = _mm512_reduce_add_ps (msum3);
+        }
+    }
+    for (; i < nx; i++) {
+        for (size_t j = 0; j < ny; j++) {
+            ip[i * ny + j] = fvec_inner_product_avx512 (x + i * d, y + j * d, d);
+        }
+    }
+}
+
 #else
 
 float
@@ -245,6 +291,12 @@ fvec_Linf_avx512(const float* x, const float* y, size_t d) {
     return 0.0;
 }
 
+void
+fvec_inner_products_tile_avx512(float* ip, const float* x, size_t nx,
+                                const float* y, size_t ny, size_t d) {
+    FAISS_ASSERT(false);
+}
+
 #endif
 
 } // namespace faiss
@@ -36,6 +36,7 @@
 #include <faiss/impl/FaissAssert.h>
 #include <faiss/utils/utils.h>
 #include <faiss/impl/AuxIndexStructures.h>
+#include <faiss/utils/hamming_simd-inl.h>
 
 static const size_t BLOCKSIZE_QUERY = 8192;
 static const size_t size_1M = 1 * 1024 * 1024;
@@ -687,7 +688,10 @@ void hammings_knn_hc (
             (32, ha, a, b, nb, order, true, bitset);
         break;
     default:
-        if(ncodes % 8 == 0) {
+        if (bvec_use_simd(ncodes)) {
+            hammings_knn_hc<faiss::HammingComputerSIMD>
+                (ncodes, ha, a, b, nb, order, true, bitset);
+        } else if(ncodes % 8 == 0) {
             hammings_knn_hc<faiss::HammingComputerM8>
                 (ncodes, ha, a, b, nb, order, true, bitset);
         } else {
@@ -733,7 +737,11 @@ void hammings_knn_mc(
         );
         break;
     default:
-        if(ncodes % 8 == 0) {
+        if (bvec_use_simd(ncodes)) {
+            hammings_knn_mc<faiss::HammingComputerSIMD>(
+              ncodes, a, b, na, nb, k, distances, labels, bitset
+            );
+        } else if(ncodes % 8 == 0) {
             hammings_knn_mc<faiss::HammingComputerM8>(
               ncodes, a, b, na, nb, k, distances, labels, bitset
             );
@@ -796,7 +804,9 @@ void hamming_range_search (
     case 16: HC(HammingComputer16); break;
     case 32: HC(HammingComputer32); break;
     default:
-        if (code_size % 8 == 0) {
+        if (bvec_use_simd(code_size)) {
+            HC(HammingComputerSIMD);
+        } else if (code_size % 8 == 0) {
             HC(HammingComputerM8);
         } else {
             HC(HammingComputerDefault);
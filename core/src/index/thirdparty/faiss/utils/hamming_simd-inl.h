@@ -0,0 +1,69 @@
+// -*- c++ -*-
+
+#pragma once
+
+#include <faiss/FaissHook.h>
+#include <faiss/utils/hamming_simd.h>
+
+namespace faiss {
+
+/* Computers running on the kernels selected by hook_init. They share the
+ * interface of the HammingComputer / JaccardComputer families so the knn
+ * templates can be instantiated on them for long codes. */
+
+struct HammingComputerSIMD {
+    const uint8_t *a;
+    int n;
+    bvec_hamming_func_ptr func;
+
+    HammingComputerSIMD () {}
+
+    HammingComputerSIMD (const uint8_t *a8, int code_size) {
+        set (a8, code_size);
+    }
+
+    void set (const uint8_t *a8, int code_size) {
+        a = a8;
+        n = code_size;
+        func = bvec_hamming;
+    }
+
+    inline int hamming (const uint8_t *b8) const {
+        return func (a, b8, n);
+    }
+
+};
+
+struct JaccardComputerSIMD {
+    const uint8_t *a;
+    int n;
+    bvec_jaccard_func_ptr func;
+
+    JaccardComputerSIMD () {}
+
+    JaccardComputerSIMD (const uint8_t *a8, int code_size) {
+        set (a8, code_size);
+    }
+
+    void set (const uint8_t *a8, int code_size) {
+        a = a8;
+        n = code_size;
+        func = bvec_jaccard_counts;
+    }
+
+    inline float compute (const uint8_t *b8) const {
+        int accu_num, accu_den;
+        func (a, b8, n, &accu_num, &accu_den);
+        if (accu_num == 0)
+            return 1.0;
+        return 1.0 - (float)(accu_num) / (float)(accu_den);
+    }
+
+};
+
+/// whether codes of this size should go through the SIMD computers
+inline bool bvec_use_simd (size_t code_size) {
+    return code_size >= bvec_simd_min_code_size;
+}
+
+} // namespace faiss
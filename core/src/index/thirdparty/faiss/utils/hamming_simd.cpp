@@ -0,0 +1,66 @@
+// -*- c++ -*-
+
+#include <faiss/utils/hamming_simd.h>
+
+#include <cstring>
+
+namespace faiss {
+
+static inline int popcnt64 (uint64_t x) {
+    return __builtin_popcountl (x);
+}
+
+int
+bvec_hamming_sse (const uint8_t* a, const uint8_t* b, size_t n) {
+    uint64_t c0 = 0, c1 = 0, c2 = 0, c3 = 0;
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        uint64_t x[4], y[4];
+        memcpy (x, a + i, 32);
+        memcpy (y, b + i, 32);
+        c0 += popcnt64 (x[0] ^ y[0]);
+        c1 += popcnt64 (x[1] ^ y[1]);
+        c2 += popcnt64 (x[2] ^ y[2]);
+        c3 += popcnt64 (x[3] ^ y[3]);
+    }
+    for (; i + 8 <= n; i += 8) {
+        uint64_t x, y;
+        memcpy (&x, a + i, 8);
+        memcpy (&y, b + i, 8);
+        c0 += popcnt64 (x ^ y);
+    }
+    for (; i < n; i++) {
+        c0 += popcnt64 (a[i] ^ b[i]);
+    }
+    return c0 + c1 + c2 + c3;
+}
+
+void
+bvec_jaccard_counts_sse (const uint8_t* a, const uint8_t* b, size_t n, int* num, int* den) {
+    uint64_t n0 = 0, n1 = 0, d0 = 0, d1 = 0;
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        uint64_t x[2], y[2];
+        memcpy (x, a + i, 16);
+        memcpy (y, b + i, 16);
+        n0 += popcnt64 (x[0] & y[0]);
+        n1 += popcnt64 (x[1] & y[1]);
+        d0 += popcnt64 (x[0] | y[0]);
+        d1 += popcnt64 (x[1] | y[1]);
+    }
+    for (; i + 8 <= n; i += 8) {
+        uint64_t x, y;
+        memcpy (&x, a + i, 8);
+        memcpy (&y, b + i, 8);
+        n0 += popcnt64 (x & y);
+        d0 += popcnt64 (x | y);
+    }
+    for (; i < n; i++) {
+        n0 += popcnt64 (a[i] & b[i]);
+        d0 += popcnt64 (a[i] | b[i]);
+    }
+    *num = n0 + n1;
+    *den = d0 + d1;
+}
+
+} // namespace faiss
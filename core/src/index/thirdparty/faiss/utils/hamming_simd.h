@@ -0,0 +1,41 @@
+// -*- c++ -*-
+
+/* Popcount kernels over long binary codes for the Hamming, Jaccard and
+ * Tanimoto metrics. The SSE4.2 versions use the scalar popcnt instruction,
+ * the AVX2 versions use the Harley-Seal carry-save adder scheme and the
+ * AVX-512 versions use VPOPCNTDQ.
+ * The actual functions are implemented in hamming_simd.cpp,
+ * hamming_simd_avx.cpp and hamming_simd_avx512.cpp. */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace faiss {
+
+typedef int (*bvec_hamming_func_ptr)(const uint8_t*, const uint8_t*, size_t);
+typedef void (*bvec_jaccard_func_ptr)(const uint8_t*, const uint8_t*, size_t, int*, int*);
+
+/// number of differing bits between a and b, both of size n bytes
+int
+bvec_hamming_sse(const uint8_t* a, const uint8_t* b, size_t n);
+
+/// popcount(a & b) in *num and popcount(a | b) in *den
+void
+bvec_jaccard_counts_sse(const uint8_t* a, const uint8_t* b, size_t n, int* num, int* den);
+
+int
+bvec_hamming_avx(const uint8_t* a, const uint8_t* b, size_t n);
+
+void
+bvec_jaccard_counts_avx(const uint8_t* a, const uint8_t* b, size_t n, int* num, int* den);
+
+/// require AVX512_VPOPCNTDQ on top of AVX512F/BW
+int
+bvec_hamming_avx512(const uint8_t* a, const uint8_t* b, size_t n);
+
+void
+bvec_jaccard_counts_avx512(const uint8_t* a, const uint8_t* b, size_t n, int* num, int* den);
+
+} // namespace faiss
@@ -0,0 +1,145 @@
+// -*- c++ -*-
+
+#include <faiss/utils/hamming_simd.h>
+#include <faiss/impl/FaissAssert.h>
+
+#include <cstring>
+#include <immintrin.h>
+
+namespace faiss {
+
+#ifdef __AVX2__
+
+namespace {
+
+struct OpXor {
+    static inline __m256i op (__m256i x, __m256i y) { return _mm256_xor_si256 (x, y); }
+    static inline uint64_t op (uint64_t x, uint64_t y) { return x ^ y; }
+};
+
+struct OpAnd {
+    static inline __m256i op (__m256i x, __m256i y) { return _mm256_and_si256 (x, y); }
+    static inline uint64_t op (uint64_t x, uint64_t y) { return x & y; }
+};
+
+struct OpOr {
+    static inline __m256i op (__m256i x, __m256i y) { return _mm256_or_si256 (x, y); }
+    static inline uint64_t op (uint64_t x, uint64_t y) { return x | y; }
+};
+
+/// per-64-bit-lane popcount through a nibble lookup table (Mula)
+inline __m256i popcount256 (__m256i v) {
+    const __m256i lookup = _mm256_setr_epi8 (
+        0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+        0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i low_mask = _mm256_set1_epi8 (0x0f);
+    __m256i lo = _mm256_and_si256 (v, low_mask);
+    __m256i hi = _mm256_and_si256 (_mm256_srli_epi16 (v, 4), low_mask);
+    __m256i cnt = _mm256_add_epi8 (_mm256_shuffle_epi8 (lookup, lo),
+                                   _mm256_shuffle_epi8 (lookup, hi));
+    return _mm256_sad_epu8 (cnt, _mm256_setzero_si256 ());
+}
+
+/// carry-save adder: (h, l) = a + b + c
+inline void csa (__m256i& h, __m256i& l, __m256i a, __m256i b, __m256i c) {
+    __m256i u = _mm256_xor_si256 (a, b);
+    h = _mm256_or_si256 (_mm256_and_si256 (a, b), _mm256_and_si256 (u, c));
+    l = _mm256_xor_si256 (u, c);
+}
+
+inline uint64_t reduce_add_4 (__m256i v) {
+    __m128i s = _mm_add_epi64 (_mm256_castsi256_si128 (v),
+                               _mm256_extracti128_si256 (v, 1));
+    return (uint64_t)_mm_cvtsi128_si64 (s) + (uint64_t)_mm_extract_epi64 (s, 1);
+}
+
+template <class Op>
+inline __m256i load_op (const uint8_t* a, const uint8_t* b, size_t i) {
+    return Op::op (_mm256_loadu_si256 ((const __m256i*)(a + i * 32)),
+                   _mm256_loadu_si256 ((const __m256i*)(b + i * 32)));
+}
+
+/// Harley-Seal over 16 x 256-bit words per iteration: only one nibble
+/// popcount per 512 bytes, the rest is plain logic ops
+template <class Op>
+uint64_t popcount_hs (const uint8_t* a, const uint8_t* b, size_t n) {
+    size_t nvec = n / 32;
+    __m256i total = _mm256_setzero_si256 ();
+    __m256i ones = _mm256_setzero_si256 ();
+    __m256i twos = _mm256_setzero_si256 ();
+    __m256i fours = _mm256_setzero_si256 ();
+    __m256i eights = _mm256_setzero_si256 ();
+    __m256i sixteens, twos_a, twos_b, fours_a, fours_b, eights_a, eights_b;
+
+    size_t i = 0;
+    for (; i + 16 <= nvec; i += 16) {
+        csa (twos_a, ones, ones, load_op<Op> (a, b, i), load_op<Op> (a, b, i + 1));
+        csa (twos_b, ones, ones, load_op<Op> (a, b, i + 2), load_op<Op> (a, b, i + 3));
+        csa (fours_a, twos, twos, twos_a, twos_b);
+        csa (twos_a, ones, ones, load_op<Op> (a, b, i + 4), load_op<Op> (a, b, i + 5));
+        csa (twos_b, ones, ones, load_op<Op> (a, b, i + 6), load_op<Op> (a, b, i + 7));
+        csa (fours_b, twos, twos, twos_a, twos_b);
+        csa (eights_a, fours, fours, fours_a, fours_b);
+        csa (twos_a, ones, ones, load_op<Op> (a, b, i + 8), load_op<Op> (a, b, i + 9));
+        csa (twos_b, ones, ones, load_op<Op> (a, b, i + 10), load_op<Op> (a, b, i + 11));
+        csa (fours_a, twos, twos, twos_a, twos_b);
+        csa (twos_a, ones, ones, load_op<Op> (a, b, i + 12), load_op<Op> (a, b, i + 13));
+        csa (twos_b, ones, ones, load_op<Op> (a, b, i + 14), load_op<Op> (a, b, i + 15));
+        csa (fours_b, twos, twos, twos_a, twos_b);
+        csa (eights_b, fours, fours, fours_a, fours_b);
+        csa (sixteens, eights, eights, eights_a, eights_b);
+        total = _mm256_add_epi64 (total, popcount256 (sixteens));
+    }
+
+    total = _mm256_slli_epi64 (total, 4);
+    total = _mm256_add_epi64 (total, _mm256_slli_epi64 (popcount256 (eights), 3));
+    total = _mm256_add_epi64 (total, _mm256_slli_epi64 (popcount256 (fours), 2));
+    total = _mm256_add_epi64 (total, _mm256_slli_epi64 (popcount256 (twos), 1));
+    total = _mm256_add_epi64 (total, popcount256 (ones));
+
+    for (; i < nvec; i++) {
+        total = _mm256_add_epi64 (total, popcount256 (load_op<Op> (a, b, i)));
+    }
+
+    uint64_t accu = reduce_add_4 (total);
+    for (size_t j = nvec * 32; j + 8 <= n; j += 8) {
+        uint64_t x, y;
+        memcpy (&x, a + j, 8);
+        memcpy (&y, b + j, 8);
+        accu += __builtin_popcountl (Op::op (x, y));
+    }
+    for (size_t j = n & ~(size_t)7; j < n; j++) {
+        accu += __builtin_popcountl (Op::op ((uint64_t)a[j], (uint64_t)b[j]));
+    }
+    return accu;
+}
+
+} // namespace
+
+int
+bvec_hamming_avx (const uint8_t* a, const uint8_t* b, size_t n) {
+    return popcount_hs<OpXor> (a, b, n);
+}
+
+void
+bvec_jaccard_counts_avx (const uint8_t* a, const uint8_t* b, size_t n, int* num, int* den) {
+    *num = popcount_hs<OpAnd> (a, b, n);
+    *den = popcount_hs<OpOr> (a, b, n);
+}
+
+#else
+
+int
+bvec_hamming_avx (const uint8_t* a, const uint8_t* b, size_t n) {
+    FAISS_ASSERT(false);
+    return 0;
+}
+
+void
+bvec_jaccard_counts_avx (const uint8_t* a, const uint8_t* b, size_t n, int* num, int* den) {
+    FAISS_ASSERT(false);
+}
+
+#endif
+
+} // namespace faiss
@@ -0,0 +1,82 @@
+// -*- c++ -*-
+
+#include <faiss/utils/hamming_simd.h>
+#include <faiss/impl/FaissAssert.h>
+
+#include <immintrin.h>
+
+namespace faiss {
+
+#if (defined(__AVX512F__) && defined(__AVX512BW__))
+
+/* VPOPCNTDQ is not implied by the AVX-512 flags this file is built with
+ * (Skylake-SP lacks it), so it is enabled per function; hook_init only
+ * selects these kernels after checking the cpuid bit. */
+#define FAISS_TARGET_VPOPCNTDQ __attribute__((target("avx512f,avx512bw,avx512vpopcntdq")))
+
+namespace {
+
+FAISS_TARGET_VPOPCNTDQ
+inline __mmask64 tail_mask (size_t rest) {
+    return rest >= 64 ? ~(__mmask64)0 : (((__mmask64)1 << rest) - 1);
+}
+
+} // namespace
+
+FAISS_TARGET_VPOPCNTDQ
+int
+bvec_hamming_avx512 (const uint8_t* a, const uint8_t* b, size_t n) {
+    __m512i acc0 = _mm512_setzero_si512 ();
+    __m512i acc1 = _mm512_setzero_si512 ();
+    size_t i = 0;
+    for (; i + 128 <= n; i += 128) {
+        __m512i x0 = _mm512_loadu_si512 ((const void*)(a + i));
+        __m512i y0 = _mm512_loadu_si512 ((const void*)(b + i));
+        __m512i x1 = _mm512_loadu_si512 ((const void*)(a + i + 64));
+        __m512i y1 = _mm512_loadu_si512 ((const void*)(b + i + 64));
+        acc0 = _mm512_add_epi64 (acc0, _mm512_popcnt_epi64 (_mm512_xor_si512 (x0, y0)));
+        acc1 = _mm512_add_epi64 (acc1, _mm512_popcnt_epi64 (_mm512_xor_si512 (x1, y1)));
+    }
+    for (; i < n; i += 64) {
+        __mmask64 m = tail_mask (n - i);
+        __m512i x = _mm512_maskz_loadu_epi8 (m, a + i);
+        __m512i y = _mm512_maskz_loadu_epi8 (m, b + i);
+        acc0 = _mm512_add_epi64 (acc0, _mm512_popcnt_epi64 (_mm512_xor_si512 (x, y)));
+    }
+    return _mm512_reduce_add_epi64 (_mm512_add_epi64 (acc0, acc1));
+}
+
+FAISS_TARGET_VPOPCNTDQ
+void
+bvec_jaccard_counts_avx512 (const uint8_t* a, const uint8_t* b, size_t n, int* num, int* den) {
+    __m512i acc_num = _mm512_setzero_si512 ();
+    __m512i acc_den = _mm512_setzero_si512 ();
+    for (size_t i = 0; i < n; i += 64) {
+        __mmask64 m = tail_mask (n - i);
+        __m512i x = _mm512_maskz_loadu_epi8 (m, a + i);
+        __m512i y = _mm512_maskz_loadu_epi8 (m, b + i);
+        acc_num = _mm512_add_epi64 (acc_num, _mm512_popcnt_epi64 (_mm512_and_si512 (x, y)));
+        acc_den = _mm512_add_epi64 (acc_den, _mm512_popcnt_epi64 (_mm512_or_si512 (x, y)));
+    }
+    *num = _mm512_reduce_add_epi64 (acc_num);
+    *den = _mm512_reduce_add_epi64 (acc_den);
+}
+
+#undef FAISS_TARGET_VPOPCNTDQ
+
+#else
+
+int
+bvec_hamming_avx512 (const uint8_t* a, const uint8_t* b, size_t n) {
+    FAISS_ASSERT(false);
+    return 0;
+}
+
+void
+bvec_jaccard_counts_avx512 (const uint8_t* a, const uint8_t* b, size_t n, int* num, int* den) {
+    FAISS_ASSERT(false);
+}
+
+#endif
+
+} // namespace faiss
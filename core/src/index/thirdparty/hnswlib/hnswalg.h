@@ -585,6 +585,123 @@ class HierarchicalNSW : public AlgorithmInterface<dist_t> {
 
     }
 
+    /**
+     * Physically remove elements and repair the graph locally.
+     * label_map maps each label to its new label, a negative value removes the element.
+     * A link list that pointed to removed elements is rebuilt from its live links and the live links
+     * of the removed ones, pruned by the neighbor heuristic; the rest of the graph is untouched.
+     */
+    void removeElements(const std::vector<int64_t> &label_map) {
+        std::vector<bool> removed(cur_element_count, false);
+        size_t removed_count = 0;
+        for (tableint i = 0; i < cur_element_count; i++) {
+            labeltype label = getExternalLabel(i);
+            if (label >= label_map.size() || label_map[label] < 0) {
+                removed[i] = true;
+                removed_count++;
+            }
+        }
+        if (removed_count == 0)
+            return;
+
+        // repair links of live elements around removed ones, removed elements keep their lists until renumbering
+        for (tableint i = 0; i < cur_element_count; i++) {
+            if (removed[i])
+                continue;
+            for (int level = 0; level <= element_levels_[i]; level++) {
+                linklistsizeint *ll_cur = level == 0 ? get_linklist0(i) : get_linklist(i, level);
+                size_t size = getListCount(ll_cur);
+                tableint *data = (tableint *) (ll_cur + 1);
+
+                bool touched = false;
+                for (size_t j = 0; j < size; j++) {
+                    if (removed[data[j]]) {
+                        touched = true;
+                        break;
+                    }
+                }
+                if (!touched)
+                    continue;
+
+                std::unordered_set<tableint> seen;
+                std::priority_queue<std::pair<dist_t, tableint>, std::vector<std::pair<dist_t, tableint>>, CompareByFirst> candidates;
+                auto add_candidate = [&](tableint cand) {
+                    if (cand == i || removed[cand] || !seen.insert(cand).second)
+                        return;
+                    candidates.emplace(fstdistfunc_(getDataByInternalId(cand), getDataByInternalId(i), dist_func_param_), cand);
+                };
+                for (size_t j = 0; j < size; j++) {
+                    if (!removed[data[j]]) {
+                        add_candidate(data[j]);
+                        continue;
+                    }
+                    linklistsizeint *ll_removed = level == 0 ? get_linklist0(data[j]) : get_linklist(data[j], level);
+                    size_t removed_size = getListCount(ll_removed);
+                    tableint *removed_data = (tableint *) (ll_removed + 1);
+                    for (size_t k = 0; k < removed_size; k++)
+                        add_candidate(removed_data[k]);
+                }
+
+                size_t Mcurmax = level ? maxM_ : maxM0_;
+                getNeighborsByHeuristic2(candidates, Mcurmax);
+                size_t indx = 0;
+                while (candidates.size() > 0) {
+                    data[indx++] = candidates.top().second;
+                    candidates.pop();
+                }
+                setListCount(ll_cur, indx);
+            }
+        }
+
+        // renumber live elements densely
+        std::vector<tableint> new_ids(cur_element_count);
+        tableint next = 0;
+        for (tableint i = 0; i < cur_element_count; i++) {
+            new_ids[i] = removed[i] ? 0 : next++;
+        }
+
+        bool enterpoint_alive = enterpoint_node_ < cur_element_count && !removed[enterpoint_node_];
+        int new_maxlevel = -1;
+        tableint new_enterpoint = 0;
+        label_lookup_.clear();
+        for (tableint i = 0; i < cur_element_count; i++) {
+            if (removed[i]) {
+                if (linkLists_[i] != nullptr)
+                    free(linkLists_[i]);
+                linkLists_[i] = nullptr;
+                continue;
+            }
+            tableint new_id = new_ids[i];
+            if (new_id != i)
+                memcpy(data_level0_memory_ + new_id * size_data_per_element_,
+                       data_level0_memory_ + i * size_data_per_element_, size_data_per_element_);
+            linkLists_[new_id] = linkLists_[i];
+            element_levels_[new_id] = element_levels_[i];
+
+            for (int level = 0; level <= element_levels_[new_id]; level++) {
+                linklistsizeint *ll_cur = level == 0 ? get_linklist0(new_id) : get_linklist(new_id, level);
+                size_t size = getListCount(ll_cur);
+                tableint *data = (tableint *) (ll_cur + 1);
+                for (size_t j = 0; j < size; j++)
+                    data[j] = new_ids[data[j]];
+            }
+
+            labeltype new_label = label_map[getExternalLabel(new_id)];
+            setExternalLabel(new_id, new_label);
+            label_lookup_[new_label] = new_id;
+
+            // keep the entry point if it survives, otherwise take the highest live element
+            if (enterpoint_alive ? i == enterpoint_node_ : element_levels_[new_id] > new_maxlevel) {
+                new_enterpoint = new_id;
+                new_maxlevel = element_levels_[new_id];
+            }
+        }
+
+        cur_element_count -= removed_count;
+        maxlevel_ = new_maxlevel;
+        enterpoint_node_ = cur_element_count > 0 ? new_enterpoint : -1;
+    }
+
     void saveIndex(milvus::knowhere::MemoryIOWriter& output) {
         // write l2/ip calculator
         writeBinaryPOD(output, metric_type_);
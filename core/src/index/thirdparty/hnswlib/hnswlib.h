@@ -64,6 +64,13 @@ namespace hnswlib {
     template<typename MTYPE>
     using DISTFUNC = MTYPE(*)(const void *, const void *, const void *);
 
+    /* distance function param of the float spaces: dim must stay the first member,
+     * index code reads the dimension back through a size_t pointer */
+    struct DistFuncParam {
+        size_t dim;
+        float (*func)(const float *, const float *, size_t);
+    };
+
 
     template<typename MTYPE>
     class SpaceInterface {
@@ -14,7 +14,8 @@ InnerProduct(const void *pVect1, const void *pVect2, const void *qty_ptr) {
     }
     return (1.0f - res);
 #else
-    return (1.0f - faiss::fvec_inner_product((const float*)pVect1, (const float*)pVect2, *((size_t*)qty_ptr)));
+    const DistFuncParam *param = (const DistFuncParam *) qty_ptr;
+    return (1.0f - param->func((const float*)pVect1, (const float*)pVect2, param->dim));
 #endif
 }
 
@@ -220,7 +221,7 @@ InnerProductSIMD16Ext(const void *pVect1v, const void *pVect2v, const void *qty_
 class InnerProductSpace : public SpaceInterface<float> {
     DISTFUNC<float> fstdistfunc_;
     size_t data_size_;
-    size_t dim_;
+    DistFuncParam param_;
  public:
     InnerProductSpace(size_t dim) {
         fstdistfunc_ = InnerProduct;
@@ -232,7 +233,8 @@ class InnerProductSpace : public SpaceInterface<float> {
             fstdistfunc_ = InnerProductSIMD16Ext;
 #endif
 #endif
-        dim_ = dim;
+        param_.dim = dim;
+        param_.func = faiss::fvec_inner_product_for_dim(dim);
         data_size_ = dim * sizeof(float);
     }
 
@@ -245,7 +247,7 @@ class InnerProductSpace : public SpaceInterface<float> {
     }
 
     void *get_dist_func_param() {
-        return &dim_;
+        return &param_;
     }
 
     ~InnerProductSpace() {}
@@ -0,0 +1,116 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include <faiss/FaissHook.h>
+#include <faiss/utils/distances.h>
+#include <faiss/utils/distances_avx.h>
+#include <faiss/utils/distances_avx512.h>
+#include <faiss/utils/distances_dim.h>
+#include <faiss/utils/instruction_set.h>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr int64_t NB = 20000;
+constexpr int64_t NQ = 4;
+constexpr int64_t LOOP = 5;
+
+struct Kernel {
+    std::string name;
+    faiss::fvec_func_ptr func;
+    int64_t flops_per_dim;  // L2: sub + mul + add, IP: mul + add
+};
+
+void
+GenerateData(const int64_t dim, const int64_t n, float* x) {
+    for (int64_t i = 0; i < n; ++i) {
+        for (int64_t j = 0; j < dim; ++j) {
+            x[i * dim + j] = drand48();
+        }
+    }
+}
+
+double
+RunKernel(const Kernel& kernel, const std::vector<float>& xb, const std::vector<float>& xq, int64_t dim,
+          std::vector<float>& distance) {
+    int64_t diff = 0;
+    for (int64_t loop = 0; loop < LOOP; loop++) {
+        auto t0 = std::chrono::system_clock::now();
+        for (int64_t i = 0; i < NB; i++) {
+            for (int64_t j = 0; j < NQ; j++) {
+                distance[i * NQ + j] = kernel.func(xb.data() + i * dim, xq.data() + j * dim, dim);
+            }
+        }
+        auto t1 = std::chrono::system_clock::now();
+        diff += std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0).count();
+    }
+    double flops = (double)kernel.flops_per_dim * dim * NB * NQ * LOOP;
+    return flops / (diff * 1e3);
+}
+
+void
+CheckResult(const std::vector<float>& expect, const std::vector<float>& result) {
+    for (size_t i = 0; i < expect.size(); i++) {
+        ASSERT_NEAR(expect[i], result[i], std::abs(expect[i]) * 1e-4);
+    }
+}
+
+}  // namespace
+
+TEST(METRICTEST, DIM_KERNEL_BENCHMARK) {
+    faiss::InstructionSet& instruction_set_inst = faiss::InstructionSet::GetInstance();
+    bool avx2 = instruction_set_inst.AVX2();
+    bool avx512 = instruction_set_inst.AVX512F() && instruction_set_inst.AVX512DQ() && instruction_set_inst.AVX512BW();
+
+    for (int64_t dim : {128, 256, 512, 768, 1024}) {
+        std::vector<Kernel> l2_kernels = {{"SSE::L2", faiss::fvec_L2sqr_sse, 3},
+                                          {"SSE::L2::DIM", faiss::fvec_L2sqr_dim_sse(dim), 3}};
+        std::vector<Kernel> ip_kernels = {{"SSE::IP", faiss::fvec_inner_product_sse, 2},
+                                          {"SSE::IP::DIM", faiss::fvec_inner_product_dim_sse(dim), 2}};
+        if (avx2) {
+            l2_kernels.push_back({"AVX2::L2", faiss::fvec_L2sqr_avx, 3});
+            l2_kernels.push_back({"AVX2::L2::DIM", faiss::fvec_L2sqr_dim_avx(dim), 3});
+            ip_kernels.push_back({"AVX2::IP", faiss::fvec_inner_product_avx, 2});
+            ip_kernels.push_back({"AVX2::IP::DIM", faiss::fvec_inner_product_dim_avx(dim), 2});
+        }
+        if (avx512) {
+            l2_kernels.push_back({"AVX512::L2", faiss::fvec_L2sqr_avx512, 3});
+            l2_kernels.push_back({"AVX512::L2::DIM", faiss::fvec_L2sqr_dim_avx512(dim), 3});
+            ip_kernels.push_back({"AVX512::IP", faiss::fvec_inner_product_avx512, 2});
+            ip_kernels.push_back({"AVX512::IP::DIM", faiss::fvec_inner_product_dim_avx512(dim), 2});
+        }
+
+        std::vector<float> xb(NB * dim);
+        std::vector<float> xq(NQ * dim);
+        GenerateData(dim, NB, xb.data());
+        GenerateData(dim, NQ, xq.data());
+
+        for (auto kernels : {l2_kernels, ip_kernels}) {
+            std::cout << "========== dim " << dim << std::endl;
+            std::vector<float> expect(NB * NQ);
+            std::vector<float> distance(NB * NQ);
+            for (size_t i = 0; i < kernels.size(); i++) {
+                ASSERT_NE(kernels[i].func, nullptr) << kernels[i].name;
+                double gflops = RunKernel(kernels[i], xb, xq, dim, (i == 0) ? expect : distance);
+                std::cout << kernels[i].name << " " << gflops << " GFLOP/s" << std::endl;
+                if (i > 0) {
+                    CheckResult(expect, distance);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,70 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include <faiss/utils/Heap.h>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+namespace {
+
+using C = faiss::CMax<float, int64_t>;
+
+constexpr int64_t BLOCK = 4096;  // candidates per call, like one inverted list
+
+int64_t
+RunSelection(bool batch, size_t k, const std::vector<float>& x, std::vector<float>& val, std::vector<int64_t>& ids) {
+    val.resize(k);
+    ids.resize(k);
+    faiss::heap_heapify<C>(k, val.data(), ids.data());
+
+    auto t0 = std::chrono::system_clock::now();
+    for (size_t i0 = 0; i0 < x.size(); i0 += BLOCK) {
+        size_t n = std::min((size_t)BLOCK, x.size() - i0);
+        if (batch) {
+            faiss::heap_addn_batch<C>(k, val.data(), ids.data(), x.data() + i0, nullptr, i0, n);
+        } else {
+            faiss::heap_addn<C>(k, val.data(), ids.data(), x.data() + i0, nullptr, n);
+        }
+    }
+    faiss::heap_reorder<C>(k, val.data(), ids.data());
+    auto t1 = std::chrono::system_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0).count();
+}
+
+}  // namespace
+
+TEST(METRICTEST, TOPK_SELECTION_BENCHMARK) {
+    size_t heap_batch_min_k = faiss::heap_batch_min_k;
+    faiss::heap_batch_min_k = 0;
+
+    for (int64_t n : {100000, 1000000, 10000000}) {
+        std::vector<float> x(n);
+        for (auto& v : x) {
+            v = drand48();
+        }
+        for (size_t k : {10, 100, 1000, 4096, 16384}) {
+            std::vector<float> heap_val, batch_val;
+            std::vector<int64_t> heap_ids, batch_ids;
+            auto heap_time = RunSelection(false, k, x, heap_val, heap_ids);
+            auto batch_time = RunSelection(true, k, x, batch_val, batch_ids);
+            std::cout << "n " << n << " k " << k << ": heap " << heap_time << "us, batch " << batch_time << "us"
+                      << std::endl;
+            for (size_t i = 0; i < k; i++) {
+                ASSERT_EQ(heap_val[i], batch_val[i]);
+            }
+        }
+    }
+
+    faiss::heap_batch_min_k = heap_batch_min_k;
+}
@@ -0,0 +1,188 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include <gtest/gtest.h>
+#include <iostream>
+#include <limits>
+#include <thread>
+
+#include <faiss/FaissHook.h>
+#include <faiss/utils/hamming_simd.h>
+
+#include "knowhere/common/Exception.h"
+#include "knowhere/index/vector_index/IndexBinaryHNSW.h"
+#include "knowhere/index/vector_index/adapter/VectorAdapter.h"
+#include "unittest/Helper.h"
+#include "unittest/utils.h"
+
+using ::testing::Combine;
+using ::testing::TestWithParam;
+using ::testing::Values;
+
+class BinaryHNSWTest : public DataGen, public TestWithParam<std::string> {
+ protected:
+    void
+    SetUp() override {
+        std::string MetricType = GetParam();
+        Init_with_default(true);
+        index_ = std::make_shared<milvus::knowhere::BinaryHNSW>();
+
+        milvus::knowhere::Config temp_conf{
+            {milvus::knowhere::meta::DIM, dim},
+            {milvus::knowhere::meta::TOPK, k},
+            {milvus::knowhere::IndexParams::M, 16},
+            {milvus::knowhere::IndexParams::efConstruction, 200},
+            {milvus::knowhere::IndexParams::ef, 200},
+            {milvus::knowhere::Metric::TYPE, MetricType},
+        };
+        conf = temp_conf;
+    }
+
+    void
+    TearDown() override {
+    }
+
+ protected:
+    milvus::knowhere::Config conf;
+    milvus::knowhere::BinaryHNSWPtr index_ = nullptr;
+};
+
+INSTANTIATE_TEST_CASE_P(METRICParameters, BinaryHNSWTest,
+                        Values(std::string("JACCARD"), std::string("TANIMOTO"), std::string("HAMMING")));
+
+TEST_P(BinaryHNSWTest, binaryhnsw_basic) {
+    assert(!xb_bin.empty());
+
+    // null faiss index
+    {
+        ASSERT_ANY_THROW(index_->Serialize());
+        ASSERT_ANY_THROW(index_->Query(query_dataset, conf));
+        ASSERT_ANY_THROW(index_->Add(nullptr, conf));
+        ASSERT_ANY_THROW(index_->AddWithoutIds(nullptr, conf));
+    }
+
+    index_->BuildAll(base_dataset, conf);
+    EXPECT_EQ(index_->Count(), nb);
+    EXPECT_EQ(index_->Dim(), dim);
+
+    auto result = index_->Query(query_dataset, conf);
+    AssertAnns(result, nq, conf[milvus::knowhere::meta::TOPK]);
+
+    faiss::ConcurrentBitsetPtr concurrent_bitset_ptr = std::make_shared<faiss::ConcurrentBitset>(nb);
+    for (int64_t i = 0; i < nq; ++i) {
+        concurrent_bitset_ptr->set(i);
+    }
+    index_->SetBlacklist(concurrent_bitset_ptr);
+
+    auto result2 = index_->Query(query_dataset, conf);
+    AssertAnns(result2, nq, k, CheckMode::CHECK_NOT_EQUAL);
+
+    // slots the blacklist leaves empty keep a valid largest distance
+    for (int64_t i = 0; i < nb; ++i) {
+        concurrent_bitset_ptr->set(i);
+    }
+    auto result3 = index_->Query(query_dataset, conf);
+    auto ids = result3->Get<int64_t*>(milvus::knowhere::meta::IDS);
+    auto dist = result3->Get<float*>(milvus::knowhere::meta::DISTANCE);
+    for (int64_t i = 0; i < nq * k; ++i) {
+        ASSERT_EQ(ids[i], -1);
+        if (GetParam() == "HAMMING") {
+            ASSERT_EQ(dist[i], static_cast<float>(std::numeric_limits<int32_t>::max()));
+        }
+    }
+}
+
+TEST_P(BinaryHNSWTest, binaryhnsw_concurrent_query) {
+    index_->BuildAll(base_dataset, conf);
+
+    // queries with different ef share the index
+    std::vector<std::thread> threads;
+    for (int64_t ef : {16, 64, 200, 400}) {
+        threads.emplace_back([&, ef]() {
+            auto query_conf = conf;
+            query_conf[milvus::knowhere::IndexParams::ef] = ef;
+            for (int i = 0; i < 10; ++i) {
+                auto result = index_->Query(query_dataset, query_conf);
+                AssertAnns(result, nq, k);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+TEST_P(BinaryHNSWTest, binaryhnsw_serialize) {
+    auto serialize = [](const std::string& filename, milvus::knowhere::BinaryPtr& bin, uint8_t* ret) {
+        FileIOWriter writer(filename);
+        writer(static_cast<void*>(bin->data.get()), bin->size);
+
+        FileIOReader reader(filename);
+        reader(ret, bin->size);
+    };
+
+    index_->BuildAll(base_dataset, conf);
+    auto binaryset = index_->Serialize();
+    auto bin = binaryset.GetByName("BinaryIVF");
+
+    std::string filename = "/tmp/binaryhnsw_test_serialize.bin";
+    auto load_data = new uint8_t[bin->size];
+    serialize(filename, bin, load_data);
+
+    binaryset.clear();
+    std::shared_ptr<uint8_t[]> data(load_data);
+    binaryset.Append("BinaryIVF", data, bin->size);
+
+    index_->Load(binaryset);
+    EXPECT_EQ(index_->Count(), nb);
+    EXPECT_EQ(index_->Dim(), dim);
+    auto result = index_->Query(query_dataset, conf);
+    AssertAnns(result, nq, conf[milvus::knowhere::meta::TOPK]);
+}
+
+TEST(BinaryKernelTest, popcount_kernels) {
+    // odd sizes exercise the Harley-Seal remainder and the masked AVX-512 tail
+    std::vector<size_t> sizes = {1, 7, 8, 31, 64, 100, 256, 511, 512, 513, 1024, 4103};
+    std::vector<uint8_t> a(4200), b(4200);
+    for (size_t i = 0; i < a.size(); i++) {
+        a[i] = lrand48();
+        b[i] = lrand48();
+    }
+
+    for (auto n : sizes) {
+        int ref_ham = 0, ref_num = 0, ref_den = 0;
+        for (size_t i = 0; i < n; i++) {
+            ref_ham += __builtin_popcount(a[i] ^ b[i]);
+            ref_num += __builtin_popcount(a[i] & b[i]);
+            ref_den += __builtin_popcount(a[i] | b[i]);
+        }
+
+        int num, den;
+        EXPECT_EQ(faiss::bvec_hamming_sse(a.data(), b.data(), n), ref_ham);
+        faiss::bvec_jaccard_counts_sse(a.data(), b.data(), n, &num, &den);
+        EXPECT_EQ(num, ref_num);
+        EXPECT_EQ(den, ref_den);
+
+        if (faiss::support_avx2()) {
+            EXPECT_EQ(faiss::bvec_hamming_avx(a.data(), b.data(), n), ref_ham);
+            faiss::bvec_jaccard_counts_avx(a.data(), b.data(), n, &num, &den);
+            EXPECT_EQ(num, ref_num);
+            EXPECT_EQ(den, ref_den);
+        }
+
+        if (faiss::support_avx512_vpopcntdq()) {
+            EXPECT_EQ(faiss::bvec_hamming_avx512(a.data(), b.data(), n), ref_ham);
+            faiss::bvec_jaccard_counts_avx512(a.data(), b.data(), n, &num, &den);
+            EXPECT_EQ(num, ref_num);
+            EXPECT_EQ(den, ref_den);
+        }
+    }
+}
@@ -107,6 +107,42 @@ TEST_P(HNSWTest, HNSW_delete) {
     */
 }
 
+TEST_P(HNSWTest, HNSW_compact) {
+    index_->Train(base_dataset, conf);
+    index_->Add(base_dataset, conf);
+
+    std::vector<milvus::knowhere::IDType> uids(nb);
+    for (int64_t i = 0; i < nb; ++i) {
+        uids[i] = i * 10;
+    }
+    index_->SetUids(uids);
+
+    // delete every other row behind the queries, queries keep their offsets
+    faiss::ConcurrentBitsetPtr deleted = std::make_shared<faiss::ConcurrentBitset>(nb);
+    int64_t deleted_count = 0;
+    for (int64_t i = nq; i < nb; i += 2) {
+        deleted->set(i);
+        ++deleted_count;
+    }
+    index_->SetBlacklist(deleted);
+
+    ASSERT_TRUE(index_->Compact(deleted));
+    EXPECT_EQ(index_->Count(), nb - deleted_count);
+    EXPECT_EQ(index_->GetBlacklist(), nullptr);
+
+    auto& compacted_uids = index_->GetUids();
+    ASSERT_EQ(compacted_uids.size(), nb - deleted_count);
+    EXPECT_EQ(compacted_uids[nq - 1], (nq - 1) * 10);
+    EXPECT_EQ(compacted_uids[nq], (nq + 1) * 10);
+
+    auto result = index_->Query(query_dataset, conf);
+    AssertAnns(result, nq, k);
+    auto ids = result->Get<int64_t*>(milvus::knowhere::meta::IDS);
+    for (int64_t i = 0; i < nq * k; ++i) {
+        ASSERT_LT(ids[i], index_->Count());
+    }
+}
+
 TEST_P(HNSWTest, HNSW_serialize) {
     auto serialize = [](const std::string& filename, milvus::knowhere::BinaryPtr& bin, uint8_t* ret) {
         {
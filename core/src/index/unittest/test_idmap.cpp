@@ -11,6 +11,7 @@
 
 #include <gtest/gtest.h>
 
+#include <faiss/utils/distances.h>
 #include <fiu-control.h>
 #include <fiu-local.h>
 #include <iostream>
@@ -128,6 +129,43 @@ TEST_P(IDMAPTest, idmap_basic) {
 #endif
 }
 
+TEST_P(IDMAPTest, idmap_fused_search) {
+    Generate(128, 20000, 200);
+
+    for (auto& metric : {milvus::knowhere::Metric::L2, milvus::knowhere::Metric::IP}) {
+        milvus::knowhere::Config conf{{milvus::knowhere::meta::DIM, dim},
+                                      {milvus::knowhere::meta::TOPK, k},
+                                      {milvus::knowhere::Metric::TYPE, metric}};
+        auto index = std::make_shared<milvus::knowhere::IDMAP>();
+        index->Train(base_dataset, conf);
+        index->Add(base_dataset, conf);
+
+        faiss::ConcurrentBitsetPtr concurrent_bitset_ptr = std::make_shared<faiss::ConcurrentBitset>(nb);
+        for (int64_t i = 0; i < nb; i += 3) {
+            concurrent_bitset_ptr->set(i);
+        }
+        index->SetBlacklist(concurrent_bitset_ptr);
+
+        // nq is between the blas and fused thresholds, so this goes through the fused kernel
+        auto fused_result = index->Query(query_dataset, conf);
+
+        int fused_threshold = faiss::distance_compute_fused_threshold;
+        faiss::distance_compute_fused_threshold = 0;
+        auto blas_result = index->Query(query_dataset, conf);
+        faiss::distance_compute_fused_threshold = fused_threshold;
+
+        auto fused_ids = fused_result->Get<int64_t*>(milvus::knowhere::meta::IDS);
+        auto fused_dis = fused_result->Get<float*>(milvus::knowhere::meta::DISTANCE);
+        auto blas_ids = blas_result->Get<int64_t*>(milvus::knowhere::meta::IDS);
+        auto blas_dis = blas_result->Get<float*>(milvus::knowhere::meta::DISTANCE);
+        for (int64_t i = 0; i < nq * k; ++i) {
+            ASSERT_NEAR(fused_dis[i], blas_dis[i], std::abs(blas_dis[i]) * 1e-4 + 1e-4);
+            ASSERT_NE(fused_ids[i] % 3, 0);
+            ASSERT_NE(blas_ids[i] % 3, 0);
+        }
+    }
+}
+
 TEST_P(IDMAPTest, idmap_serialize) {
     auto serialize = [](const std::string& filename, milvus::knowhere::BinaryPtr& bin, uint8_t* ret) {
         FileIOWriter writer(filename);
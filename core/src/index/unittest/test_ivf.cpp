@@ -150,6 +150,46 @@ TEST_P(IVFTest, ivf_basic_cpu) {
 #endif
 }
 
+TEST_P(IVFTest, ivf_compact_cpu) {
+    if (index_mode_ != milvus::knowhere::IndexMode::MODE_CPU) {
+        return;
+    }
+
+    index_->Train(base_dataset, conf_);
+    index_->AddWithoutIds(base_dataset, conf_);
+
+    std::vector<milvus::knowhere::IDType> uids(nb);
+    for (int64_t i = 0; i < nb; ++i) {
+        uids[i] = i * 10;
+    }
+    index_->SetUids(uids);
+
+    // delete every other row behind the queries, queries keep their offsets
+    faiss::ConcurrentBitsetPtr deleted = std::make_shared<faiss::ConcurrentBitset>(nb);
+    int64_t deleted_count = 0;
+    for (int64_t i = nq; i < nb; i += 2) {
+        deleted->set(i);
+        ++deleted_count;
+    }
+    index_->SetBlacklist(deleted);
+
+    ASSERT_TRUE(index_->Compact(deleted));
+    EXPECT_EQ(index_->Count(), nb - deleted_count);
+    EXPECT_EQ(index_->GetBlacklist(), nullptr);
+
+    auto& compacted_uids = index_->GetUids();
+    ASSERT_EQ(compacted_uids.size(), nb - deleted_count);
+    EXPECT_EQ(compacted_uids[nq - 1], (nq - 1) * 10);
+    EXPECT_EQ(compacted_uids[nq], (nq + 1) * 10);
+
+    auto result = index_->Query(query_dataset, conf_);
+    AssertAnns(result, nq, k);
+    auto ids = result->Get<int64_t*>(milvus::knowhere::meta::IDS);
+    for (int64_t i = 0; i < nq * k; ++i) {
+        ASSERT_LT(ids[i], index_->Count());
+    }
+}
+
 TEST_P(IVFTest, ivf_basic_gpu) {
     assert(!xb.empty());
 
@@ -143,6 +143,54 @@ class MetricsBase {
     QueryVectorResponsePerSecondGaugeSet(double value) {
     }
 
+    virtual void
+    SearchBatchSizeHistogramObserve(double value) {
+    }
+
+    virtual void
+    SearchBatchWaitHistogramObserve(double value) {
+    }
+
+    virtual void
+    SearchTaskDroppedTotalIncrement(double value = 1) {
+    }
+
+    virtual void
+    SearchTaskAbortedTotalIncrement(double value = 1) {
+    }
+
+    virtual void
+    LoaderInFlightGaugeSet(double value) {
+    }
+
+    virtual void
+    LoaderDepthGaugeSet(double value) {
+    }
+
+    virtual void
+    LoaderStallHistogramObserve(double value) {
+    }
+
+    virtual void
+    FlushBytesWrittenIncrement(double value) {
+    }
+
+    virtual void
+    MergeBytesWrittenIncrement(double value) {
+    }
+
+    virtual void
+    MergeCandidateSegmentsGaugeSet(double value) {
+    }
+
+    virtual void
+    CollectionQueryDurationObserve(const std::string& collection_id, const std::string& stage, double value) {
+    }
+
+    virtual void
+    CollectionQueryDurationRemove(const std::string& collection_id) {
+    }
+
     virtual void
     CPUUsagePercentSet() {
     }
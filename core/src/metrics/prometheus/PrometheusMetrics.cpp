@@ -144,6 +144,34 @@ PrometheusMetrics::QueryIndexTypePerSecondSet(std::string type, double value) {
     }
 }
 
+void
+PrometheusMetrics::CollectionQueryDurationObserve(const std::string& collection_id, const std::string& stage,
+                                                  double value) {
+    if (!startup_) {
+        return;
+    }
+
+    static const prometheus::Histogram::BucketBoundaries buckets{0.001, 0.005, 0.01, 0.05, 0.1, 0.5, 1.0, 5.0, 10.0};
+    std::lock_guard<std::mutex> lock(collection_query_mutex_);
+    auto& histogram =
+        collection_query_duration_seconds_.Add({{"collection", collection_id}, {"stage", stage}}, buckets);
+    collection_query_histograms_[collection_id].insert(&histogram);
+    histogram.Observe(value);
+}
+
+void
+PrometheusMetrics::CollectionQueryDurationRemove(const std::string& collection_id) {
+    std::lock_guard<std::mutex> lock(collection_query_mutex_);
+    auto iter = collection_query_histograms_.find(collection_id);
+    if (iter == collection_query_histograms_.end()) {
+        return;
+    }
+    for (auto histogram : iter->second) {
+        collection_query_duration_seconds_.Remove(histogram);
+    }
+    collection_query_histograms_.erase(iter);
+}
+
 void
 PrometheusMetrics::ConnectionGaugeIncrement() {
     if (!startup_) {
@@ -16,7 +16,10 @@
 #include <prometheus/registry.h>
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "metrics/MetricBase.h"
@@ -132,6 +135,78 @@ class PrometheusMetrics : public MetricsBase {
         }
     }
 
+    void
+    SearchBatchSizeHistogramObserve(double value) override {
+        if (startup_) {
+            search_batch_size_histogram_.Observe(value);
+        }
+    }
+
+    void
+    SearchBatchWaitHistogramObserve(double value) override {
+        if (startup_) {
+            search_batch_wait_histogram_.Observe(value);
+        }
+    }
+
+    void
+    SearchTaskDroppedTotalIncrement(double value = 1) override {
+        if (startup_) {
+            search_task_dropped_total_.Increment(value);
+        }
+    }
+
+    void
+    SearchTaskAbortedTotalIncrement(double value = 1) override {
+        if (startup_) {
+            search_task_aborted_total_.Increment(value);
+        }
+    }
+
+    void
+    LoaderInFlightGaugeSet(double value) override {
+        if (startup_) {
+            loader_in_flight_gauge_.Set(value);
+        }
+    }
+
+    void
+    LoaderDepthGaugeSet(double value) override {
+        if (startup_) {
+            loader_depth_gauge_.Set(value);
+        }
+    }
+    void
+    FlushBytesWrittenIncrement(double value) override {
+        if (startup_) {
+            flush_bytes_written_counter_.Increment(value);
+            UpdateWriteAmplification();
+        }
+    }
+
+    void
+    MergeBytesWrittenIncrement(double value) override {
+        if (startup_) {
+            merge_bytes_written_counter_.Increment(value);
+            UpdateWriteAmplification();
+        }
+    }
+
+    void
+    MergeCandidateSegmentsGaugeSet(double value) override {
+        if (startup_) {
+            merge_candidate_segments_gauge_.Set(value);
+        }
+    }
+
+
+    void
+    LoaderStallHistogramObserve(double value) override {
+        if (startup_) {
+            loader_stall_histogram_.Observe(value);
+        }
+    }
+
     void
     FaissDiskLoadIOSpeedGaugeSet(double value) override {
         if (startup_) {
@@ -270,6 +345,10 @@ class PrometheusMetrics : public MetricsBase {
     void
     QueryIndexTypePerSecondSet(std::string type, double value) override;
     void
+    CollectionQueryDurationObserve(const std::string& collection_id, const std::string& stage, double value) override;
+    void
+    CollectionQueryDurationRemove(const std::string& collection_id) override;
+    void
     ConnectionGaugeIncrement() override;
     void
     ConnectionGaugeDecrement() override;
@@ -311,6 +390,14 @@ class PrometheusMetrics : public MetricsBase {
 
     // .....
  private:
+    void
+    UpdateWriteAmplification() {
+        double flushed = flush_bytes_written_counter_.Value();
+        if (flushed > 0) {
+            write_amplification_gauge_.Set((flushed + merge_bytes_written_counter_.Value()) / flushed);
+        }
+    }
+
     ////all from db_connection.cpp
     //    prometheus::Family<prometheus::Counter> &connect_request_ = prometheus::BuildCounter()
     //        .Name("connection_total")
@@ -382,6 +469,62 @@ class PrometheusMetrics : public MetricsBase {
     prometheus::Counter& search_success_total_ = search_request_.Add({{"outcome", "success"}});
     prometheus::Counter& search_fail_total_ = search_request_.Add({{"outcome", "fail"}});
 
+    // record how many search requests run as one job and how long the batch window held them
+    prometheus::Family<prometheus::Histogram>& search_batch_size_ =
+        prometheus::BuildHistogram()
+            .Name("search_batch_size")
+            .Help("histogram of search requests combined into one search")
+            .Register(*registry_);
+    prometheus::Histogram& search_batch_size_histogram_ =
+        search_batch_size_.Add({}, BucketBoundaries{1, 2, 4, 8, 16, 32, 64});
+
+    prometheus::Family<prometheus::Histogram>& search_batch_wait_ =
+        prometheus::BuildHistogram()
+            .Name("search_batch_wait_microseconds")
+            .Help("histogram of time a search was held to gather a batch")
+            .Register(*registry_);
+    prometheus::Histogram& search_batch_wait_histogram_ =
+        search_batch_wait_.Add({}, BucketBoundaries{0, 100, 250, 500, 1000, 2000, 5000});
+
+    // record search tasks of cancelled or expired requests
+    prometheus::Family<prometheus::Counter>& search_task_cancelled_ = prometheus::BuildCounter()
+                                                                          .Name("search_task_cancelled_total")
+                                                                          .Help("the number of cancelled search tasks")
+                                                                          .Register(*registry_);
+    prometheus::Counter& search_task_dropped_total_ = search_task_cancelled_.Add({{"stage", "queued"}});
+    prometheus::Counter& search_task_aborted_total_ = search_task_cancelled_.Add({{"stage", "running"}});
+
+    // bytes written to segments by flush and merge, write amplification is (flush + merge) / flush
+    prometheus::Family<prometheus::Counter>& segment_bytes_written_ = prometheus::BuildCounter()
+                                                                         .Name("segment_bytes_written_total")
+                                                                         .Help("bytes written to segments")
+                                                                         .Register(*registry_);
+    prometheus::Counter& flush_bytes_written_counter_ = segment_bytes_written_.Add({{"type", "flush"}});
+    prometheus::Counter& merge_bytes_written_counter_ = segment_bytes_written_.Add({{"type", "merge"}});
+
+    prometheus::Family<prometheus::Gauge>& segment_merge_ = prometheus::BuildGauge()
+                                                                .Name("segment_merge")
+                                                                .Help("write amplification and segments awaiting merge")
+                                                                .Register(*registry_);
+    prometheus::Gauge& write_amplification_gauge_ = segment_merge_.Add({{"type", "write_amplification"}});
+    prometheus::Gauge& merge_candidate_segments_gauge_ = segment_merge_.Add({{"type", "candidate_segments"}});
+
+    // task loader of cpu resource
+    prometheus::Family<prometheus::Gauge>& loader_ = prometheus::BuildGauge()
+                                                         .Name("task_loader")
+                                                         .Help("tasks being loaded and the allowed load depth")
+                                                         .Register(*registry_);
+    prometheus::Gauge& loader_in_flight_gauge_ = loader_.Add({{"type", "in_flight"}});
+    prometheus::Gauge& loader_depth_gauge_ = loader_.Add({{"type", "depth"}});
+
+    prometheus::Family<prometheus::Histogram>& loader_stall_ =
+        prometheus::BuildHistogram()
+            .Name("task_loader_stall_microseconds")
+            .Help("histogram of time executor waited for a task to be loaded")
+            .Register(*registry_);
+    prometheus::Histogram& loader_stall_histogram_ =
+        loader_stall_.Add({}, BucketBoundaries{100, 1000, 10000, 100000, 1000000});
+
     prometheus::Family<prometheus::Histogram>& search_request_duration_seconds_ =
         prometheus::BuildHistogram()
             .Name("search_request_duration_microsecond")
@@ -390,6 +533,16 @@ class PrometheusMetrics : public MetricsBase {
     prometheus::Histogram& search_duration_histogram_ =
         search_request_duration_seconds_.Add({}, BucketBoundaries{0.1, 1.0, 10.0});
 
+    // query latency of each collection by stage, series are added as collections are queried
+    prometheus::Family<prometheus::Histogram>& collection_query_duration_seconds_ =
+        prometheus::BuildHistogram()
+            .Name("collection_query_duration_seconds")
+            .Help("histogram of query time of each collection by stage")
+            .Register(*registry_);
+    // series of each collection, removed when the collection is dropped
+    std::mutex collection_query_mutex_;
+    std::unordered_map<std::string, std::unordered_set<prometheus::Histogram*>> collection_query_histograms_;
+
     // record raw_files size histogram
     prometheus::Family<prometheus::Histogram>& raw_files_size_ = prometheus::BuildHistogram()
                                                                      .Name("search_raw_files_bytes")
@@ -10,6 +10,7 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include "scheduler/CPUBuilder.h"
+#include "index/knowhere/knowhere/index/vector_index/helpers/BuilderSuspend.h"
 #include "utils/Log.h"
 
 namespace milvus {
@@ -57,6 +58,8 @@ CPUBuilder::worker_function() {
             // thread exit
             break;
         }
+        // searches preempt index building between tasks
+        knowhere::BuildCheckWait();
         task->Load(LoadType::DISK2CPU, 0);
         task->Execute();
     }
@@ -37,6 +37,10 @@ using EngineType = engine::EngineType;
 using MetricType = engine::MetricType;
 
 constexpr uint64_t TASK_TABLE_MAX_COUNT = 1ULL << 16ULL;
+// how many waiting tasks PickToLoad/PickToExecute rank before handing out the best ones
+constexpr uint64_t TASK_TABLE_PICK_WINDOW = 4096;
+// default number of tasks allowed to be loading or loaded ahead of the executor
+constexpr uint64_t TASK_TABLE_LOAD_DEPTH = 3;
 
 }  // namespace scheduler
 }  // namespace milvus
@@ -16,8 +16,12 @@
 #include "utils/Log.h"
 #include "utils/TimeRecorder.h"
 
+#include <algorithm>
 #include <ctime>
+#include <limits>
 #include <sstream>
+#include <tuple>
+#include <unordered_map>
 #include <vector>
 
 namespace milvus {
@@ -135,6 +139,19 @@ TaskTableItem::Moved() {
     return false;
 }
 
+bool
+TaskTableItem::Cancel() {
+    std::unique_lock<std::mutex> lock(mutex);
+    if (state == TaskTableItemState::START) {
+        state = TaskTableItemState::EXECUTED;
+        lock.unlock();
+        timestamp.executed = get_current_timestamp();
+        timestamp.finish = get_current_timestamp();
+        return true;
+    }
+    return false;
+}
+
 json
 TaskTableItem::Dump() const {
     json ret{
@@ -146,15 +163,94 @@ TaskTableItem::Dump() const {
     return ret;
 }
 
+namespace {
+
+// Order in which waiting tasks are handed out, smaller first
+struct PickOrder {
+    int32_t rank;        // searches before index building
+    int64_t priority;    // negated job priority
+    uint64_t deadline;   // earlier deadline first, none goes last
+    uint64_t job_tasks;  // tasks of the same job waiting here, shortest job first
+    uint64_t id;         // arrival order
+    uint64_t index;
+
+    bool
+    operator<(const PickOrder& other) const {
+        return std::tie(rank, priority, deadline, job_tasks, id) <
+               std::tie(other.rank, other.priority, other.deadline, other.job_tasks, other.id);
+    }
+};
+
+}  // namespace
+
+std::vector<uint64_t>
+TaskTable::OrderByPriority(const std::vector<uint64_t>& indexes, uint64_t limit) {
+    if (indexes.size() <= 1) {
+        return indexes;
+    }
+
+    std::vector<PickOrder> orders(indexes.size());
+    std::vector<JobId> job_ids(indexes.size());
+    std::unordered_map<JobId, uint64_t> job_tasks;
+    for (size_t i = 0; i < indexes.size(); ++i) {
+        auto& item = table_[indexes[i]];
+        auto& order = orders[i];
+        order.rank = (item->task != nullptr && item->task->Type() == TaskType::BuildIndexTask) ? 1 : 0;
+        order.priority = 0;
+        order.deadline = std::numeric_limits<uint64_t>::max();
+        order.job_tasks = 0;
+        order.id = item->id;
+        order.index = indexes[i];
+
+        auto job = (item->task != nullptr) ? item->task->job_.lock() : nullptr;
+        job_ids[i] = std::numeric_limits<JobId>::max();
+        if (job != nullptr) {
+            order.priority = -job->priority();
+            if (job->deadline() != 0) {
+                order.deadline = job->deadline();
+            }
+            job_ids[i] = job->id();
+            ++job_tasks[job->id()];
+        }
+    }
+    for (size_t i = 0; i < orders.size(); ++i) {
+        if (job_ids[i] != std::numeric_limits<JobId>::max()) {
+            orders[i].job_tasks = job_tasks[job_ids[i]];
+        }
+    }
+
+    auto count = std::min<uint64_t>(limit, orders.size());
+    std::partial_sort(orders.begin(), orders.begin() + count, orders.end());
+
+    std::vector<uint64_t> picked;
+    picked.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        picked.push_back(orders[i].index);
+    }
+    return picked;
+}
+
+/*
+ * Tasks are handed out by job priority, then deadline, then shortest job first, so that
+ * a search spanning thousands of segments does not starve small searches queued behind it.
+ * Searches go before index building, except that one build is always let into the load pipeline
+ * while any are waiting, so that a steady stream of searches cannot starve them.
+ * Tasks of cancelled jobs are dropped here instead of being loaded.
+ */
 std::vector<uint64_t>
 TaskTable::PickToLoad(uint64_t limit) {
 #if 1
     // TimeRecorder rc("");
     std::vector<uint64_t> indexes;
+    std::vector<uint64_t> build_indexes;
     bool cross = false;
+    bool building = false;
+    JobId checked_job = std::numeric_limits<JobId>::max();
+    bool job_cancelled = false;
 
     uint64_t available_begin = table_.front() + 1;
-    for (uint64_t i = 0, loaded_count = 0, pick_count = 0; i < table_.size() && pick_count < limit; ++i) {
+    for (uint64_t i = 0, loaded_count = 0, pick_count = 0;
+         i < table_.size() && pick_count < TASK_TABLE_PICK_WINDOW; ++i) {
         auto index = available_begin + i;
         if (not table_[index])
             break;
@@ -162,14 +258,30 @@ TaskTable::PickToLoad(uint64_t limit) {
             break;
         if (not cross && table_[index]->IsFinish()) {
             table_.set_front(index);
-        } else if (table_[index]->state == TaskTableItemState::LOADED) {
+        } else if (table_[index]->state == TaskTableItemState::LOADING ||
+                   table_[index]->state == TaskTableItemState::LOADED) {
             cross = true;
             ++loaded_count;
-            if (loaded_count > 2)
+            if (table_[index]->task != nullptr && table_[index]->task->Type() == TaskType::BuildIndexTask) {
+                building = true;
+            }
+            if (loaded_count >= load_depth_)
                 return std::vector<uint64_t>();
         } else if (table_[index]->state == TaskTableItemState::START) {
             auto task = table_[index]->task;
 
+            // tasks of one job sit next to each other, so remember the last answer
+            auto job = task->job_.lock();
+            if (job != nullptr) {
+                if (job->id() != checked_job) {
+                    checked_job = job->id();
+                    job_cancelled = job->IsCancelled();
+                }
+                if (job_cancelled && Cancel(index)) {
+                    continue;
+                }
+            }
+
             // if task is a build index task, limit it
             if (task->Type() == TaskType::BuildIndexTask && task->path().Current() == "cpu") {
                 if (BuildMgrInst::GetInstance()->NumOfAvailable() < 1) {
@@ -178,12 +290,29 @@ TaskTable::PickToLoad(uint64_t limit) {
                 }
             }
             cross = true;
-            indexes.push_back(index);
+            if (task->Type() == TaskType::BuildIndexTask) {
+                build_indexes.push_back(index);
+            } else {
+                indexes.push_back(index);
+            }
             ++pick_count;
         }
     }
     // rc.ElapseFromBegin("PickToLoad ");
-    return indexes;
+
+    // search preempts index building at task granularity, but one build keeps a load slot
+    if (indexes.empty()) {
+        return OrderByPriority(build_indexes, limit);
+    }
+    if (build_indexes.empty() || building || limit == 0) {
+        return OrderByPriority(indexes, limit);
+    }
+    auto picked = OrderByPriority(build_indexes, 1);
+    if (limit > 1) {
+        auto searches = OrderByPriority(indexes, limit - 1);
+        picked.insert(picked.end(), searches.begin(), searches.end());
+    }
+    return picked;
 #else
     size_t count = 0;
     for (uint64_t j = last_finish_ + 1; j < table_.size(); ++j) {
@@ -237,7 +366,7 @@ TaskTable::PickToExecute(uint64_t limit) {
     std::vector<uint64_t> indexes;
     bool cross = false;
     uint64_t available_begin = table_.front() + 1;
-    for (uint64_t i = 0, pick_count = 0; i < table_.size() && pick_count < limit; ++i) {
+    for (uint64_t i = 0, pick_count = 0; i < table_.size() && pick_count < TASK_TABLE_PICK_WINDOW; ++i) {
         uint64_t index = available_begin + i;
         if (not table_[index]) {
             break;
@@ -255,7 +384,22 @@ TaskTable::PickToExecute(uint64_t limit) {
         }
     }
     // rc.ElapseFromBegin("PickToExecute ");
-    return indexes;
+    return OrderByPriority(indexes, limit);
+}
+
+bool
+TaskTable::Cancel(uint64_t index) {
+    auto& item = table_[index];
+    if (!item->Cancel()) {
+        return false;
+    }
+
+    if (item->from) {
+        item->from->Moved();
+        item->from = nullptr;
+    }
+    item->task->Cancel();
+    return true;
 }
 
 void
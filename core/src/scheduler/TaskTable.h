@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <deque>
 #include <functional>
 #include <memory>
@@ -91,6 +92,9 @@ struct TaskTableItem : public interface::dumpable {
     bool
     Moved();
 
+    bool
+    Cancel();
+
     json
     Dump() const override;
 };
@@ -125,6 +129,19 @@ class TaskTable : public interface::dumpable {
     std::vector<uint64_t>
     PickToExecute(uint64_t limit);
 
+    /*
+     * Max number of tasks loading or loaded but not yet executed;
+     */
+    inline void
+    SetLoadDepth(uint64_t depth) {
+        load_depth_ = depth;
+    }
+
+    inline uint64_t
+    LoadDepth() const {
+        return load_depth_;
+    }
+
  public:
     inline const TaskTableItemPtr& operator[](uint64_t index) {
         return table_[index];
@@ -210,6 +227,18 @@ class TaskTable : public interface::dumpable {
         return table_[index]->Moved();
     }
 
+    /*
+     * Drop a task not started yet;
+     * Set state executed;
+     * Called by loader;
+     */
+    bool
+    Cancel(uint64_t index);
+
+ private:
+    std::vector<uint64_t>
+    OrderByPriority(const std::vector<uint64_t>& indexes, uint64_t limit);
+
  private:
     std::uint64_t id_ = 0;
     CircleQueue<TaskTableItemPtr> table_;
@@ -219,6 +248,8 @@ class TaskTable : public interface::dumpable {
     // pick from (last_finish_ + 1)
     // init with -1, pick from (last_finish_ + 1) = 0
     uint64_t last_finish_ = -1;
+
+    std::atomic<uint64_t> load_depth_{TASK_TABLE_LOAD_DEPTH};
 };
 
 }  // namespace scheduler
@@ -24,11 +24,21 @@ Job::Job(JobType type) : type_(type) {
     id_ = unique_job_id++;
 }
 
+void
+Job::SetSchedulingHints(const std::shared_ptr<server::Context>& context) {
+    if (context != nullptr) {
+        priority_ = context->GetPriority();
+        deadline_ = context->GetDeadline();
+    }
+}
+
 json
 Job::Dump() const {
     json ret{
         {"id", id_},
         {"type", type_},
+        {"priority", priority_},
+        {"deadline", deadline_},
     };
     return ret;
 }
@@ -49,15 +49,38 @@ class Job : public interface::dumpable {
         return type_;
     }
 
+    // Scheduling hints consulted by TaskTable when picking tasks
+    inline int64_t
+    priority() const {
+        return priority_;
+    }
+
+    // Milliseconds since epoch, 0 means none
+    inline uint64_t
+    deadline() const {
+        return deadline_;
+    }
+
+    // Tasks of a cancelled job are dropped before loading and aborted while searching
+    virtual bool
+    IsCancelled() {
+        return false;
+    }
+
     json
     Dump() const override;
 
  protected:
     explicit Job(JobType type);
 
+    void
+    SetSchedulingHints(const std::shared_ptr<server::Context>& context);
+
  private:
     JobId id_ = 0;
     JobType type_;
+    int64_t priority_ = 0;
+    uint64_t deadline_ = 0;
 };
 
 using JobPtr = std::shared_ptr<Job>;
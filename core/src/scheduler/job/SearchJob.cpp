@@ -19,6 +19,7 @@ namespace scheduler {
 SearchJob::SearchJob(const std::shared_ptr<server::Context>& context, uint64_t topk, const milvus::json& extra_params,
                      const engine::VectorsData& vectors)
     : Job(JobType::SEARCH), context_(context), topk_(topk), extra_params_(extra_params), vectors_(vectors) {
+    SetSchedulingHints(context_);
 }
 
 SearchJob::SearchJob(const std::shared_ptr<server::Context>& context, milvus::query::GeneralQueryPtr general_query,
@@ -31,6 +32,7 @@ SearchJob::SearchJob(const std::shared_ptr<server::Context>& context, milvus::qu
       query_ptr_(query_ptr),
       attr_type_(attr_type),
       vectors_(vectors) {
+    SetSchedulingHints(context_);
 }
 
 bool
@@ -82,12 +84,29 @@ SearchJob::GetStatus() {
     return status_;
 }
 
+bool
+SearchJob::IsCancelled() {
+    if (cancelled_) {
+        return true;
+    }
+    if (context_ != nullptr && context_->IsCancelled()) {
+        cancelled_ = true;
+    }
+    return cancelled_;
+}
+
+void
+SearchJob::Cancel() {
+    cancelled_ = true;
+}
+
 json
 SearchJob::Dump() const {
     json ret{
         {"topk", topk_},
         {"nq", vectors_.vector_count_},
         {"extra_params", extra_params_.dump()},
+        {"cancelled", cancelled_.load()},
     };
     auto base = Job::Dump();
     ret.insert(base.begin(), base.end());
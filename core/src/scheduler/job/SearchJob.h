@@ -10,6 +10,8 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <deque>
 #include <list>
@@ -74,6 +76,12 @@ class SearchJob : public Job {
     Status&
     GetStatus();
 
+    bool
+    IsCancelled() override;
+
+    void
+    Cancel();
+
     json
     Dump() const override;
 
@@ -136,6 +144,11 @@ class SearchJob : public Job {
         return time_stat_;
     }
 
+    const std::chrono::steady_clock::time_point&
+    create_time() const {
+        return create_time_;
+    }
+
  private:
     const std::shared_ptr<server::Context> context_;
 
@@ -157,8 +170,10 @@ class SearchJob : public Job {
 
     std::mutex mutex_;
     std::condition_variable cv_;
+    std::atomic_bool cancelled_{false};
 
     SearchTimeStat time_stat_;
+    std::chrono::steady_clock::time_point create_time_ = std::chrono::steady_clock::now();
 };
 
 using SearchJobPtr = std::shared_ptr<SearchJob>;
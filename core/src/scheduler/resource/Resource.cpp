@@ -10,9 +10,13 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include "scheduler/resource/Resource.h"
+#include "config/Config.h"
+#include "metrics/Metrics.h"
 #include "scheduler/SchedInst.h"
 #include "scheduler/Utils.h"
 
+#include <algorithm>
+#include <chrono>
 #include <iostream>
 #include <limits>
 #include <utility>
@@ -53,9 +57,34 @@ Resource::Resource(std::string name, ResourceType type, uint64_t device_id, bool
     });
 }
 
+namespace {
+
+uint64_t
+elapsed_us(const std::chrono::steady_clock::time_point& start) {
+    auto now = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(now - start).count();
+}
+
+void
+update_average(uint64_t& avg, uint64_t cost) {
+    avg = (avg == 0) ? cost : (avg * 7 + cost) / 8;
+}
+
+}  // namespace
+
 void
 Resource::Start() {
     running_ = true;
+
+    int64_t max_load_depth = TASK_TABLE_LOAD_DEPTH;
+    server::Config::GetInstance().GetEngineConfigMaxLoadDepth(max_load_depth);
+    max_load_depth_ = max_load_depth;
+    task_table_.SetLoadDepth(std::min(max_load_depth_, TASK_TABLE_LOAD_DEPTH));
+
+    // cpu reads and decodes several files at once, other resources keep loading one by one
+    size_t load_threads = (type_ == ResourceType::CPU) ? max_load_depth_ : 1;
+    load_pool_ = std::make_unique<ThreadPool>(load_threads, max_load_depth_);
+
     loader_thread_ = std::thread(&Resource::loader_function, this);
     if (enable_executor_) {
         executor_thread_ = std::thread(&Resource::executor_function, this);
@@ -67,6 +96,8 @@ Resource::Stop() {
     running_ = false;
     WakeupLoader();
     loader_thread_.join();
+    // wait for loads in flight
+    load_pool_ = nullptr;
     if (enable_executor_) {
         WakeupExecutor();
         executor_thread_.join();
@@ -102,6 +133,8 @@ Resource::Dump() const {
         {"total_tasks", total_task_},
         {"running", running_},
         {"enable_executor", enable_executor_},
+        {"load_depth", task_table_.LoadDepth()},
+        {"loading", loading_count_.load()},
     };
     return ret;
 }
@@ -168,16 +201,67 @@ Resource::loader_function() {
                 BuildMgrInst::GetInstance()->Take();
                 LOG_SERVER_DEBUG_ << name() << " load BuildIndexTask";
             }
-            LoadFile(task_item->task);
-            task_item->Loaded();
-            if (task_item->from) {
-                task_item->from->Moved();
-                task_item->from = nullptr;
-            }
-            if (subscriber_) {
-                auto event = std::make_shared<LoadCompletedEvent>(shared_from_this(), task_item);
-                subscriber_(std::static_pointer_cast<Event>(event));
+            ++loading_count_;
+            if (type_ == ResourceType::CPU) {
+                server::Metrics::GetInstance().LoaderInFlightGaugeSet(loading_count_);
             }
+            load_pool_->enqueue(&Resource::load_task, this, task_item);
+        }
+    }
+}
+
+void
+Resource::load_task(const TaskTableItemPtr& task_item) {
+    // the enqueued future is discarded, so a throwing load must not skip the bookkeeping below
+    uint64_t load_cost = 0;
+    try {
+        auto start = std::chrono::steady_clock::now();
+        LoadFile(task_item->task);
+        load_cost = elapsed_us(start);
+    } catch (std::exception& ex) {
+        LOG_SERVER_ERROR_ << name() << " failed to load task: " << ex.what();
+    } catch (...) {
+        LOG_SERVER_ERROR_ << name() << " failed to load task";
+    }
+
+    task_item->Loaded();
+    if (task_item->from) {
+        task_item->from->Moved();
+        task_item->from = nullptr;
+    }
+    --loading_count_;
+    if (type_ == ResourceType::CPU) {
+        server::Metrics::GetInstance().LoaderInFlightGaugeSet(loading_count_);
+    }
+    adjust_load_depth(load_cost, 0);
+
+    if (subscriber_) {
+        auto event = std::make_shared<LoadCompletedEvent>(shared_from_this(), task_item);
+        subscriber_(std::static_pointer_cast<Event>(event));
+    }
+}
+
+void
+Resource::adjust_load_depth(uint64_t load_cost, uint64_t exec_cost) {
+    std::lock_guard<std::mutex> lock(cost_mutex_);
+    if (load_cost > 0) {
+        update_average(load_cost_avg_, load_cost);
+    }
+    if (exec_cost > 0) {
+        update_average(exec_cost_avg_, exec_cost);
+    }
+    if (load_cost_avg_ == 0 || exec_cost_avg_ == 0) {
+        return;
+    }
+
+    // one task ready to execute, plus as many loading as one load takes executions
+    uint64_t depth = (load_cost_avg_ + exec_cost_avg_ - 1) / exec_cost_avg_ + 1;
+    depth = std::min(depth, max_load_depth_);
+    depth = std::max(depth, std::min<uint64_t>(2, max_load_depth_));
+    if (depth != task_table_.LoadDepth()) {
+        task_table_.SetLoadDepth(depth);
+        if (type_ == ResourceType::CPU) {
+            server::Metrics::GetInstance().LoaderDepthGaugeSet(depth);
         }
     }
 }
@@ -189,6 +273,8 @@ Resource::executor_function() {
         auto event = std::make_shared<StartUpEvent>(shared_from_this());
         subscriber_(std::static_pointer_cast<Event>(event));
     }
+    bool stalled = false;
+    std::chrono::steady_clock::time_point stall_start;
     while (running_) {
         std::unique_lock<std::mutex> lock(exec_mutex_);
         exec_cv_.wait(lock, [&] { return exec_flag_; });
@@ -197,13 +283,27 @@ Resource::executor_function() {
         while (true) {
             auto task_item = pick_task_execute();
             if (task_item == nullptr) {
+                // executor idles while tasks are still loading
+                if (!stalled && loading_count_ > 0) {
+                    stalled = true;
+                    stall_start = std::chrono::steady_clock::now();
+                }
                 break;
             }
+            if (stalled) {
+                stalled = false;
+                if (type_ == ResourceType::CPU) {
+                    server::Metrics::GetInstance().LoaderStallHistogramObserve(elapsed_us(stall_start));
+                }
+            }
+
+            auto exec_start = std::chrono::steady_clock::now();
             auto start = get_current_timestamp();
             Process(task_item->task);
             auto finish = get_current_timestamp();
             ++total_task_;
             total_cost_ += finish - start;
+            adjust_load_depth(0, std::max<uint64_t>(elapsed_us(exec_start), 1));
 
             task_item->Executed();
 
@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <condition_variable>
 #include <functional>
 #include <memory>
@@ -28,6 +29,7 @@
 #include "../task/Task.h"
 #include "Connection.h"
 #include "Node.h"
+#include "utils/ThreadPool.h"
 
 namespace milvus {
 namespace scheduler {
@@ -161,6 +163,18 @@ class Resource : public Node, public std::enable_shared_from_this<Resource> {
     void
     loader_function();
 
+    /*
+     * Run on load pool, several tasks may be loaded at the same time;
+     */
+    void
+    load_task(const TaskTableItemPtr& task_item);
+
+    /*
+     * Keep enough tasks loading to cover the execution of one task;
+     */
+    void
+    adjust_load_depth(uint64_t load_cost, uint64_t exec_cost);
+
     /*
      * Only called by worker thread;
      */
@@ -186,6 +200,15 @@ class Resource : public Node, public std::enable_shared_from_this<Resource> {
     std::thread loader_thread_;
     std::thread executor_thread_;
 
+    std::unique_ptr<ThreadPool> load_pool_;
+    std::atomic<uint64_t> loading_count_{0};
+    uint64_t max_load_depth_ = TASK_TABLE_LOAD_DEPTH;
+
+    // moving average of load and execute cost, unit: microsecond
+    std::mutex cost_mutex_;
+    uint64_t load_cost_avg_ = 0;
+    uint64_t exec_cost_avg_ = 0;
+
     bool load_flag_ = false;
     bool exec_flag_ = false;
     std::mutex load_mutex_;
@@ -206,6 +206,7 @@ XBuildIndexTask::Execute() {
         table_file.file_type_ = engine::meta::SegmentSchema::INDEX;
         table_file.file_size_ = server::CommonUtil::GetFileSize(table_file.location_);
         table_file.row_count_ = file_->row_count_;  // index->Count();
+        table_file.deleted_row_count_ = file_->deleted_row_count_;
 
         auto origin_file = *file_;
         origin_file.file_type_ = engine::meta::SegmentSchema::BACKUP;
@@ -14,14 +14,18 @@
 #include <fiu-local.h>
 
 #include <algorithm>
+#include <chrono>
 #include <memory>
 #include <string>
 #include <thread>
 #include <unordered_map>
 #include <utility>
 
+#include "cache/CpuCacheMgr.h"
 #include "db/Utils.h"
 #include "db/engine/EngineFactory.h"
+#include "index/knowhere/knowhere/index/vector_index/helpers/SearchInterrupt.h"
+#include "knowhere/index/vector_index/helpers/IndexParameter.h"
 #include "metrics/Metrics.h"
 #include "scheduler/SchedInst.h"
 #include "scheduler/job/SearchJob.h"
@@ -148,6 +152,28 @@ void
 XSearchTask::Load(LoadType type, uint8_t device_id) {
     milvus::server::ContextFollower tracer(context_, "XSearchTask::Load " + std::to_string(file_->id_));
 
+    // skip the disk read, Execute() reports the file done
+    if (auto job = job_.lock()) {
+        if (job->IsCancelled()) {
+            if (index_engine_ != nullptr) {
+                server::Metrics::GetInstance().SearchTaskDroppedTotalIncrement();
+                index_engine_ = nullptr;
+                index_id_ = file_->id_;
+            }
+            return;
+        }
+    }
+
+    bool profiling = context_ != nullptr && context_->GetQueryProfile() != nullptr;
+    if (profiling && type == LoadType::DISK2CPU) {
+        if (auto job = job_.lock()) {
+            auto search_job = std::static_pointer_cast<scheduler::SearchJob>(job);
+            auto waited = std::chrono::steady_clock::now() - search_job->create_time();
+            profile_.queue_time_ = std::chrono::duration<double, std::milli>(waited).count();
+        }
+        profile_.cache_hit_ = cache::CpuCacheMgr::GetInstance()->ItemExists(file_->location_);
+    }
+
     TimeRecorder rc(LogOut("[%s][%ld]", "search", 0));
     Status stat = Status::OK();
     std::string error_msg;
@@ -204,7 +230,10 @@ XSearchTask::Load(LoadType type, uint8_t device_id) {
     std::string info = "Search task load file id:" + std::to_string(file_->id_) + " " + type_str +
                        " file type:" + std::to_string(file_->file_type_) + " size:" + std::to_string(file_size) +
                        " bytes from location: " + file_->location_ + " totally cost";
-    rc.ElapseFromBegin(info);
+    double span = rc.ElapseFromBegin(info);
+    if (profiling) {
+        profile_.load_time_ += span / 1000;
+    }
 
     CollectFileMetrics(file_->file_type_, file_size);
 
@@ -233,6 +262,13 @@ XSearchTask::Execute() {
             return;
         }
 
+        if (search_job->IsCancelled()) {
+            server::Metrics::GetInstance().SearchTaskDroppedTotalIncrement();
+            search_job->SearchDone(index_id_);
+            index_engine_ = nullptr;
+            return;
+        }
+
         /* step 1: allocate memory */
         query::GeneralQueryPtr general_query = search_job->general_query();
 
@@ -265,6 +301,9 @@ XSearchTask::Execute() {
                 nq = vector_query->query_vector.float_data.size() / file_->dimension_;
                 search_job->vector_count() = nq;
             } else {
+                // index searches poll the job between queries and stop early once it is cancelled
+                knowhere::SearchChecker checker = [&search_job]() { return search_job->IsCancelled(); };
+                knowhere::SearchInterruptScope interrupt_scope(&checker);
                 s = index_engine_->Search(output_ids, output_distance, search_job, hybrid);
             }
 
@@ -276,6 +315,7 @@ XSearchTask::Execute() {
             }
 
             span = rc.RecordSection("search done");
+            profile_.search_time_ = span / 1000;
 
             /* step 3: pick up topk result */
             auto spec_k = file_->row_count_ < topk ? file_->row_count_ : topk;
@@ -290,12 +330,29 @@ XSearchTask::Execute() {
 
             span = rc.RecordSection("reduce topk done");
             search_job->time_stat().reduce_time += span / 1000;
+            profile_.reduce_time_ = span / 1000;
         } catch (std::exception& ex) {
+            if (search_job->IsCancelled()) {
+                LOG_ENGINE_DEBUG_ << LogOut("[%s][%ld] SearchTask %ld aborted", "search", 0, index_id_);
+                server::Metrics::GetInstance().SearchTaskAbortedTotalIncrement();
+                search_job->SearchDone(index_id_);
+                index_engine_ = nullptr;
+                return;
+            }
             LOG_ENGINE_ERROR_ << LogOut("[%s][%ld] SearchTask encounter exception: %s", "search", 0, ex.what());
             // search_job->IndexSearchDone(index_id_);  //mark as done avoid dead lock, even search failed
         }
 
-        /* step 4: notify to send result to client */
+        /* step 4: record profile and notify to send result to client */
+        if (context_ != nullptr && context_->GetQueryProfile() != nullptr) {
+            auto& extra_params = search_job->extra_params();
+            auto nprobe = extra_params.find(knowhere::IndexParams::nprobe);
+            profile_.segment_id_ = index_id_;
+            profile_.index_type_ = engine::utils::GetIndexName(static_cast<int32_t>(index_engine_->IndexEngineType()));
+            profile_.nprobe_ = (nprobe != extra_params.end() && nprobe->is_number()) ? nprobe->get<int64_t>() : -1;
+            profile_.rows_ = file_->row_count_;
+            context_->GetQueryProfile()->AddSegment(profile_);
+        }
         search_job->SearchDone(index_id_);
     }
 
@@ -305,6 +362,16 @@ XSearchTask::Execute() {
     index_engine_ = nullptr;
 }
 
+void
+XSearchTask::Cancel() {
+    server::Metrics::GetInstance().SearchTaskDroppedTotalIncrement();
+    if (auto job = job_.lock()) {
+        auto search_job = std::static_pointer_cast<scheduler::SearchJob>(job);
+        search_job->SearchDone(file_ != nullptr ? file_->id_ : index_id_);
+    }
+    index_engine_ = nullptr;
+}
+
 void
 XSearchTask::MergeTopkToResultSet(const scheduler::ResultIds& src_ids, const scheduler::ResultDistances& src_distances,
                                   size_t src_k, size_t nq, size_t topk, bool ascending, scheduler::ResultIds& tar_ids,
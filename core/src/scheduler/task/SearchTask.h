@@ -18,6 +18,7 @@
 #include "Task.h"
 #include "scheduler/Definition.h"
 #include "scheduler/job/SearchJob.h"
+#include "server/context/QueryProfile.h"
 
 namespace milvus {
 namespace scheduler {
@@ -33,6 +34,9 @@ class XSearchTask : public Task {
     void
     Execute() override;
 
+    void
+    Cancel() override;
+
  public:
     static void
     MergeTopkToResultSet(const scheduler::ResultIds& src_ids, const scheduler::ResultDistances& src_distances,
@@ -62,6 +66,9 @@ class XSearchTask : public Task {
     // distance -- value 0 means two vectors equal, ascending reduce, L2/HAMMING/JACCARD/TONIMOTO ...
     // similarity -- infinity value means two vectors equal, descending reduce, IP
     bool ascending_reduce = true;
+
+    // filled only when the request asked for a query profile
+    server::SegmentProfile profile_;
 };
 
 }  // namespace scheduler
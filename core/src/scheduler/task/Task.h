@@ -78,6 +78,11 @@ class Task {
     virtual void
     Execute() = 0;
 
+    // Called instead of Load/Execute when the job is cancelled before the task starts
+    virtual void
+    Cancel() {
+    }
+
  public:
     Path task_path_;
     scheduler::JobWPtr job_;
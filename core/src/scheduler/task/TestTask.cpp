@@ -11,6 +11,7 @@
 
 #include "scheduler/task/TestTask.h"
 
+#include <fiu-local.h>
 #include <utility>
 
 #include "cache/GpuCacheMgr.h"
@@ -25,6 +26,7 @@ TestTask::TestTask(const std::shared_ptr<server::Context>& context, SegmentSchem
 void
 TestTask::Load(LoadType type, uint8_t device_id) {
     load_count_++;
+    fiu_do_on("TestTask.Load.throw_exception", throw std::exception());
 }
 
 void
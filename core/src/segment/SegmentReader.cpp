@@ -20,9 +20,8 @@
 #include <memory>
 
 #include "Vectors.h"
-#include "codecs/default/DefaultCodec.h"
-#include "storage/disk/DiskIOReader.h"
-#include "storage/disk/DiskIOWriter.h"
+#include "codecs/CodecFactory.h"
+#include "storage/disk/DiskIOFactory.h"
 #include "storage/disk/DiskOperation.h"
 #include "utils/Log.h"
 
@@ -30,11 +29,12 @@ namespace milvus {
 namespace segment {
 
 SegmentReader::SegmentReader(const std::string& directory) {
-    storage::IOReaderPtr reader_ptr = std::make_shared<storage::DiskIOReader>();
-    storage::IOWriterPtr writer_ptr = std::make_shared<storage::DiskIOWriter>();
+    storage::IOReaderPtr reader_ptr = storage::CreateDiskIOReader();
+    storage::IOWriterPtr writer_ptr = storage::CreateDiskIOWriter();
     storage::OperationPtr operation_ptr = std::make_shared<storage::DiskOperation>(directory);
     fs_ptr_ = std::make_shared<storage::FSHandler>(reader_ptr, writer_ptr, operation_ptr);
     segment_ptr_ = std::make_shared<Segment>();
+    codec_ = codec::CreateCodec(directory);
 }
 
 Status
@@ -46,13 +46,12 @@ SegmentReader::LoadCache(bool& in_cache) {
 Status
 SegmentReader::Load() {
     // TODO(zhiru)
-    codec::DefaultCodec default_codec;
     try {
         fs_ptr_->operation_ptr_->CreateDirectory();
-        default_codec.GetVectorsFormat()->read(fs_ptr_, segment_ptr_->vectors_ptr_);
-        default_codec.GetAttrsFormat()->read(fs_ptr_, segment_ptr_->attrs_ptr_);
-        // default_codec.GetVectorIndexFormat()->read(fs_ptr_, segment_ptr_->vector_index_ptr_);
-        default_codec.GetDeletedDocsFormat()->read(fs_ptr_, segment_ptr_->deleted_docs_ptr_);
+        codec_->GetVectorsFormat()->read(fs_ptr_, segment_ptr_->vectors_ptr_);
+        codec_->GetAttrsFormat()->read(fs_ptr_, segment_ptr_->attrs_ptr_);
+        // codec_->GetVectorIndexFormat()->read(fs_ptr_, segment_ptr_->vector_index_ptr_);
+        codec_->GetDeletedDocsFormat()->read(fs_ptr_, segment_ptr_->deleted_docs_ptr_);
     } catch (std::exception& e) {
         return Status(DB_ERROR, e.what());
     }
@@ -61,10 +60,22 @@ SegmentReader::Load() {
 
 Status
 SegmentReader::LoadVectors(off_t offset, size_t num_bytes, std::vector<uint8_t>& raw_vectors) {
-    codec::DefaultCodec default_codec;
     try {
         fs_ptr_->operation_ptr_->CreateDirectory();
-        default_codec.GetVectorsFormat()->read_vectors(fs_ptr_, offset, num_bytes, raw_vectors);
+        codec_->GetVectorsFormat()->read_vectors(fs_ptr_, offset, num_bytes, raw_vectors);
+    } catch (std::exception& e) {
+        std::string err_msg = "Failed to load raw vectors: " + std::string(e.what());
+        LOG_ENGINE_ERROR_ << err_msg;
+        return Status(DB_ERROR, err_msg);
+    }
+    return Status::OK();
+}
+
+Status
+SegmentReader::LoadVectors(const std::vector<off_t>& offsets, size_t num_bytes, std::vector<uint8_t>& raw_vectors) {
+    try {
+        fs_ptr_->operation_ptr_->CreateDirectory();
+        codec_->GetVectorsFormat()->read_vectors(fs_ptr_, offsets, num_bytes, raw_vectors);
     } catch (std::exception& e) {
         std::string err_msg = "Failed to load raw vectors: " + std::string(e.what());
         LOG_ENGINE_ERROR_ << err_msg;
@@ -76,10 +87,9 @@ SegmentReader::LoadVectors(off_t offset, size_t num_bytes, std::vector<uint8_t>&
 Status
 SegmentReader::LoadAttrs(const std::string& field_name, off_t offset, size_t num_bytes,
                          std::vector<uint8_t>& raw_attrs) {
-    codec::DefaultCodec default_codec;
     try {
         fs_ptr_->operation_ptr_->CreateDirectory();
-        default_codec.GetAttrsFormat()->read_attrs(fs_ptr_, field_name, offset, num_bytes, raw_attrs);
+        codec_->GetAttrsFormat()->read_attrs(fs_ptr_, field_name, offset, num_bytes, raw_attrs);
     } catch (std::exception& e) {
         std::string err_msg = "Failed to load raw attributes: " + std::string(e.what());
         LOG_ENGINE_ERROR_ << err_msg;
@@ -90,10 +100,9 @@ SegmentReader::LoadAttrs(const std::string& field_name, off_t offset, size_t num
 
 Status
 SegmentReader::LoadUids(std::vector<doc_id_t>& uids) {
-    codec::DefaultCodec default_codec;
     try {
         fs_ptr_->operation_ptr_->CreateDirectory();
-        default_codec.GetVectorsFormat()->read_uids(fs_ptr_, uids);
+        codec_->GetVectorsFormat()->read_uids(fs_ptr_, uids);
     } catch (std::exception& e) {
         std::string err_msg = "Failed to load uids: " + std::string(e.what());
         LOG_ENGINE_ERROR_ << err_msg;
@@ -110,10 +119,9 @@ SegmentReader::GetSegment(SegmentPtr& segment_ptr) {
 
 Status
 SegmentReader::LoadVectorIndex(const std::string& location, segment::VectorIndexPtr& vector_index_ptr) {
-    codec::DefaultCodec default_codec;
     try {
         fs_ptr_->operation_ptr_->CreateDirectory();
-        default_codec.GetVectorIndexFormat()->read(fs_ptr_, location, vector_index_ptr);
+        codec_->GetVectorIndexFormat()->read(fs_ptr_, location, vector_index_ptr);
     } catch (std::exception& e) {
         std::string err_msg = "Failed to load vector index: " + std::string(e.what());
         LOG_ENGINE_ERROR_ << err_msg;
@@ -124,10 +132,9 @@ SegmentReader::LoadVectorIndex(const std::string& location, segment::VectorIndex
 
 Status
 SegmentReader::LoadBloomFilter(segment::IdBloomFilterPtr& id_bloom_filter_ptr) {
-    codec::DefaultCodec default_codec;
     try {
         fs_ptr_->operation_ptr_->CreateDirectory();
-        default_codec.GetIdBloomFilterFormat()->read(fs_ptr_, id_bloom_filter_ptr);
+        codec_->GetIdBloomFilterFormat()->read(fs_ptr_, id_bloom_filter_ptr);
     } catch (std::exception& e) {
         std::string err_msg = "Failed to load bloom filter: " + std::string(e.what());
         LOG_ENGINE_ERROR_ << err_msg;
@@ -138,10 +145,9 @@ SegmentReader::LoadBloomFilter(segment::IdBloomFilterPtr& id_bloom_filter_ptr) {
 
 Status
 SegmentReader::LoadDeletedDocs(segment::DeletedDocsPtr& deleted_docs_ptr) {
-    codec::DefaultCodec default_codec;
     try {
         fs_ptr_->operation_ptr_->CreateDirectory();
-        default_codec.GetDeletedDocsFormat()->read(fs_ptr_, deleted_docs_ptr);
+        codec_->GetDeletedDocsFormat()->read(fs_ptr_, deleted_docs_ptr);
     } catch (std::exception& e) {
         std::string err_msg = "Failed to load deleted docs: " + std::string(e.what());
         LOG_ENGINE_ERROR_ << err_msg;
@@ -152,10 +158,9 @@ SegmentReader::LoadDeletedDocs(segment::DeletedDocsPtr& deleted_docs_ptr) {
 
 Status
 SegmentReader::ReadDeletedDocsSize(size_t& size) {
-    codec::DefaultCodec default_codec;
     try {
         fs_ptr_->operation_ptr_->CreateDirectory();
-        default_codec.GetDeletedDocsFormat()->readSize(fs_ptr_, size);
+        codec_->GetDeletedDocsFormat()->readSize(fs_ptr_, size);
     } catch (std::exception& e) {
         std::string err_msg = "Failed to read deleted docs size: " + std::string(e.what());
         LOG_ENGINE_ERROR_ << err_msg;
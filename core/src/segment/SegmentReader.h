@@ -21,6 +21,7 @@
 #include <string>
 #include <vector>
 
+#include "codecs/Codec.h"
 #include "segment/Types.h"
 #include "storage/FSHandler.h"
 #include "utils/Status.h"
@@ -42,6 +43,10 @@ class SegmentReader {
     Status
     LoadVectors(off_t offset, size_t num_bytes, std::vector<uint8_t>& raw_vectors);
 
+    // load num_bytes at each offset in one pass over the vector file
+    Status
+    LoadVectors(const std::vector<off_t>& offsets, size_t num_bytes, std::vector<uint8_t>& raw_vectors);
+
     Status
     LoadAttrs(const std::string& field_name, off_t offset, size_t num_bytes, std::vector<uint8_t>& raw_attrs);
 
@@ -66,6 +71,7 @@ class SegmentReader {
  private:
     storage::FSHandlerPtr fs_ptr_;
     SegmentPtr segment_ptr_;
+    codec::CodecPtr codec_;
 };
 
 using SegmentReaderPtr = std::shared_ptr<SegmentReader>;
@@ -18,28 +18,234 @@
 #include "segment/SegmentWriter.h"
 
 #include <algorithm>
+#include <cstring>
+#include <functional>
 #include <memory>
 #include <utility>
 
+#include <boost/filesystem.hpp>
+
 #include "SegmentReader.h"
 #include "Vectors.h"
-#include "codecs/default/DefaultCodec.h"
+#include "codecs/CodecFactory.h"
+#include "codecs/container/SegmentContainer.h"
 #include "db/Utils.h"
+#include "storage/disk/DiskIOFactory.h"
 #include "storage/disk/DiskIOReader.h"
-#include "storage/disk/DiskIOWriter.h"
 #include "storage/disk/DiskOperation.h"
+#include "utils/Exception.h"
 #include "utils/Log.h"
+#include "utils/RateLimiter.h"
 #include "utils/TimeRecorder.h"
 
 namespace milvus {
 namespace segment {
 
+namespace {
+
+constexpr size_t MERGE_CHUNK_SIZE = 16 * 1024 * 1024;
+
+const char* RAW_VECTOR_EXTENSION = ".rv";
+const char* USER_ID_EXTENSION = ".uid";
+const char* RAW_ATTR_EXTENSION = ".ra";
+
+// shared by all merges so that the limit holds for the whole server
+RateLimiter&
+MergeRateLimiter() {
+    static RateLimiter limiter;
+    return limiter;
+}
+
+struct MergeSource {
+    std::string rv_path;
+    std::string uid_path;
+    // where the rows start in those files
+    int64_t rv_offset = 0;
+    int64_t uid_offset = 0;
+    size_t row_count = 0;
+    size_t row_size = 0;
+    size_t live_count = 0;
+    std::vector<bool> deleted;
+};
+
+Status
+PlanContainerSource(const std::string& dir, MergeSource& source, size_t& rv_bytes, size_t& uid_bytes,
+                    bool& has_attrs) {
+    source.rv_path = source.uid_path = codec::ContainerPath(dir);
+    auto reader_ptr = storage::CreateDiskIOReader();
+    codec::ContainerReader container(*reader_ptr, source.rv_path);
+    if (!container.Has(codec::CONTAINER_VECTORS) || !container.Has(codec::CONTAINER_UIDS)) {
+        return Status(DB_ERROR, "Missing vectors or uids in segment " + dir);
+    }
+    auto& rv_entry = container.Entry(codec::CONTAINER_VECTORS);
+    auto& uid_entry = container.Entry(codec::CONTAINER_UIDS);
+    source.rv_offset = rv_entry.offset_;
+    source.uid_offset = uid_entry.offset_;
+    rv_bytes = rv_entry.size_;
+    uid_bytes = uid_entry.size_;
+
+    const std::string prefix = codec::CONTAINER_ATTR_PREFIX;
+    for (auto& pair : container.Index()) {
+        if (pair.first.compare(0, prefix.size(), prefix) == 0) {
+            has_attrs = true;
+        }
+    }
+    return Status::OK();
+}
+
+Status
+PlanFileSource(const std::string& dir, MergeSource& source, size_t& rv_bytes, size_t& uid_bytes, bool& has_attrs) {
+    boost::filesystem::directory_iterator it_end;
+    for (boost::filesystem::directory_iterator it(dir); it != it_end; ++it) {
+        auto extension = it->path().extension().string();
+        if (extension == RAW_VECTOR_EXTENSION) {
+            source.rv_path = it->path().string();
+        } else if (extension == USER_ID_EXTENSION) {
+            source.uid_path = it->path().string();
+        } else if (extension == RAW_ATTR_EXTENSION) {
+            has_attrs = true;
+        }
+    }
+    if (source.rv_path.empty() || source.uid_path.empty()) {
+        return Status(DB_ERROR, "Missing vectors or uids in segment " + dir);
+    }
+
+    // headers hold the byte count of the data following
+    storage::DiskIOReader reader;
+    if (!reader.open(source.rv_path)) {
+        return Status(SERVER_CANNOT_OPEN_FILE, "Failed to open file: " + source.rv_path);
+    }
+    reader.read(&rv_bytes, sizeof(size_t));
+    reader.close();
+    if (!reader.open(source.uid_path)) {
+        return Status(SERVER_CANNOT_OPEN_FILE, "Failed to open file: " + source.uid_path);
+    }
+    reader.read(&uid_bytes, sizeof(size_t));
+    reader.close();
+    source.rv_offset = source.uid_offset = sizeof(size_t);
+    return Status::OK();
+}
+
+Status
+PlanMergeSource(const std::string& dir, MergeSource& source, bool& has_attrs) {
+    size_t rv_bytes = 0, uid_bytes = 0;
+    auto status = (codec::DetectCodecType(dir) == codec::CodecType::CONTAINER)
+                      ? PlanContainerSource(dir, source, rv_bytes, uid_bytes, has_attrs)
+                      : PlanFileSource(dir, source, rv_bytes, uid_bytes, has_attrs);
+    if (!status.ok()) {
+        return status;
+    }
+
+    source.row_count = uid_bytes / sizeof(doc_id_t);
+    if (source.row_count > 0) {
+        if (rv_bytes % source.row_count != 0) {
+            return Status(DB_ERROR, "Vectors and uids do not match in segment " + dir);
+        }
+        source.row_size = rv_bytes / source.row_count;
+    }
+
+    SegmentReader segment_reader(dir);
+    DeletedDocsPtr deleted_docs_ptr;
+    status = segment_reader.LoadDeletedDocs(deleted_docs_ptr);
+    if (!status.ok()) {
+        return status;
+    }
+
+    source.deleted.resize(source.row_count, false);
+    source.live_count = source.row_count;
+    if (deleted_docs_ptr != nullptr) {
+        for (auto offset : deleted_docs_ptr->GetDeletedDocs()) {
+            if (offset >= 0 && (size_t)offset < source.row_count && !source.deleted[offset]) {
+                source.deleted[offset] = true;
+                --source.live_count;
+            }
+        }
+    }
+    return Status::OK();
+}
+
+using RowSink = std::function<void(const void*, int64_t)>;
+
+// pass live rows of one file type from all sources to sink, one chunk of rows in memory at a time
+void
+StreamLiveRows(const std::vector<MergeSource>& sources, bool uid_file, const RowSink& sink,
+               const std::function<void(const uint8_t*)>& on_row) {
+    auto& limiter = MergeRateLimiter();
+    std::vector<uint8_t> buffer;
+    for (auto& source : sources) {
+        if (source.live_count == 0) {
+            continue;
+        }
+
+        const std::string& path = uid_file ? source.uid_path : source.rv_path;
+        size_t row_size = uid_file ? sizeof(doc_id_t) : source.row_size;
+        auto reader_ptr = storage::CreateDiskIOReader();
+        auto& reader = *reader_ptr;
+        if (!reader.open(path)) {
+            std::string err_msg = "Failed to open file: " + path + ", error: " + std::strerror(errno);
+            throw Exception(SERVER_CANNOT_OPEN_FILE, err_msg);
+        }
+        reader.seekg(uid_file ? source.uid_offset : source.rv_offset);
+
+        size_t chunk_rows = std::max<size_t>(MERGE_CHUNK_SIZE / row_size, 1);
+        for (size_t begin = 0; begin < source.row_count; begin += chunk_rows) {
+            size_t rows = std::min(chunk_rows, source.row_count - begin);
+            buffer.resize(rows * row_size);
+            limiter.Acquire(buffer.size());
+            reader.read(buffer.data(), buffer.size());
+
+            // move live rows to the front of the chunk
+            size_t live = 0;
+            for (size_t i = 0; i < rows; ++i) {
+                if (source.deleted[begin + i]) {
+                    continue;
+                }
+                uint8_t* row = buffer.data() + live * row_size;
+                if (live != i) {
+                    memcpy(row, buffer.data() + i * row_size, row_size);
+                }
+                if (on_row) {
+                    on_row(row);
+                }
+                ++live;
+            }
+
+            limiter.Acquire(live * row_size);
+            sink(buffer.data(), live * row_size);
+        }
+        reader.close();
+    }
+}
+
+// live rows into a file of the default codec, behind a header of their byte count
+void
+StreamLiveRowsToFile(const std::vector<MergeSource>& sources, bool uid_file, storage::IOWriter& writer,
+                     const std::string& file_path, const std::function<void(const uint8_t*)>& on_row) {
+    size_t total_bytes = 0;
+    for (auto& source : sources) {
+        total_bytes += source.live_count * (uid_file ? sizeof(doc_id_t) : source.row_size);
+    }
+
+    if (!writer.open(file_path)) {
+        std::string err_msg = "Failed to open file: " + file_path + ", error: " + std::strerror(errno);
+        throw Exception(SERVER_CANNOT_CREATE_FILE, err_msg);
+    }
+    writer.write(&total_bytes, sizeof(size_t));
+    StreamLiveRows(
+        sources, uid_file, [&](const void* data, int64_t size) { writer.write(const_cast<void*>(data), size); },
+        on_row);
+    writer.close();
+}
+
+}  // namespace
+
 SegmentWriter::SegmentWriter(const std::string& directory) {
-    storage::IOReaderPtr reader_ptr = std::make_shared<storage::DiskIOReader>();
-    storage::IOWriterPtr writer_ptr = std::make_shared<storage::DiskIOWriter>();
+    storage::IOReaderPtr reader_ptr = storage::CreateDiskIOReader();
+    storage::IOWriterPtr writer_ptr = storage::CreateDiskIOWriter();
     storage::OperationPtr operation_ptr = std::make_shared<storage::DiskOperation>(directory);
     fs_ptr_ = std::make_shared<storage::FSHandler>(reader_ptr, writer_ptr, operation_ptr);
     segment_ptr_ = std::make_shared<Segment>();
+    codec_ = codec::CreateCodec(directory);
 }
 
 Status
@@ -62,6 +268,15 @@ SegmentWriter::AddVectors(const std::string& name, const uint8_t* data, uint64_t
     return Status::OK();
 }
 
+Status
+SegmentWriter::AddVectors(const std::string& name, std::vector<uint8_t>&& data, const std::vector<doc_id_t>& uids) {
+    segment_ptr_->vectors_ptr_->AddData(std::move(data));
+    segment_ptr_->vectors_ptr_->AddUids(uids);
+    segment_ptr_->vectors_ptr_->SetName(name);
+
+    return Status::OK();
+}
+
 Status
 SegmentWriter::AddAttrs(const std::string& name, const std::unordered_map<std::string, uint64_t>& attr_nbytes,
                         const std::unordered_map<std::string, std::vector<uint8_t>>& attr_data,
@@ -128,10 +343,9 @@ SegmentWriter::Serialize() {
 
 Status
 SegmentWriter::WriteVectors() {
-    codec::DefaultCodec default_codec;
     try {
         fs_ptr_->operation_ptr_->CreateDirectory();
-        default_codec.GetVectorsFormat()->write(fs_ptr_, segment_ptr_->vectors_ptr_);
+        codec_->GetVectorsFormat()->write(fs_ptr_, segment_ptr_->vectors_ptr_);
     } catch (std::exception& e) {
         std::string err_msg = "Failed to write vectors: " + std::string(e.what());
         LOG_ENGINE_ERROR_ << err_msg;
@@ -144,10 +358,9 @@ SegmentWriter::WriteVectors() {
 
 Status
 SegmentWriter::WriteAttrs() {
-    codec::DefaultCodec default_codec;
     try {
         fs_ptr_->operation_ptr_->CreateDirectory();
-        default_codec.GetAttrsFormat()->write(fs_ptr_, segment_ptr_->attrs_ptr_);
+        codec_->GetAttrsFormat()->write(fs_ptr_, segment_ptr_->attrs_ptr_);
     } catch (std::exception& e) {
         std::string err_msg = "Failed to write vectors: " + std::string(e.what());
         LOG_ENGINE_ERROR_ << err_msg;
@@ -164,10 +377,9 @@ SegmentWriter::WriteVectorIndex(const std::string& location) {
         return Status(SERVER_WRITE_ERROR, "Invalid parameter of WriteVectorIndex");
     }
 
-    codec::DefaultCodec default_codec;
     try {
         fs_ptr_->operation_ptr_->CreateDirectory();
-        default_codec.GetVectorIndexFormat()->write(fs_ptr_, location, segment_ptr_->vector_index_ptr_);
+        codec_->GetVectorIndexFormat()->write(fs_ptr_, location, segment_ptr_->vector_index_ptr_);
     } catch (std::exception& e) {
         std::string err_msg = "Failed to write vector index: " + std::string(e.what());
         LOG_ENGINE_ERROR_ << err_msg;
@@ -180,13 +392,12 @@ SegmentWriter::WriteVectorIndex(const std::string& location) {
 
 Status
 SegmentWriter::WriteBloomFilter() {
-    codec::DefaultCodec default_codec;
     try {
         fs_ptr_->operation_ptr_->CreateDirectory();
 
         TimeRecorder recorder("SegmentWriter::WriteBloomFilter");
 
-        default_codec.GetIdBloomFilterFormat()->create(fs_ptr_, segment_ptr_->id_bloom_filter_ptr_);
+        codec_->GetIdBloomFilterFormat()->create(fs_ptr_, segment_ptr_->id_bloom_filter_ptr_);
 
         recorder.RecordSection("Initializing bloom filter");
 
@@ -197,7 +408,7 @@ SegmentWriter::WriteBloomFilter() {
 
         recorder.RecordSection("Adding " + std::to_string(uids.size()) + " ids to bloom filter");
 
-        default_codec.GetIdBloomFilterFormat()->write(fs_ptr_, segment_ptr_->id_bloom_filter_ptr_);
+        codec_->GetIdBloomFilterFormat()->write(fs_ptr_, segment_ptr_->id_bloom_filter_ptr_);
 
         recorder.RecordSection("Writing bloom filter");
     } catch (std::exception& e) {
@@ -212,11 +423,10 @@ SegmentWriter::WriteBloomFilter() {
 
 Status
 SegmentWriter::WriteDeletedDocs() {
-    codec::DefaultCodec default_codec;
     try {
         fs_ptr_->operation_ptr_->CreateDirectory();
         DeletedDocsPtr deleted_docs_ptr = std::make_shared<DeletedDocs>();
-        default_codec.GetDeletedDocsFormat()->write(fs_ptr_, deleted_docs_ptr);
+        codec_->GetDeletedDocsFormat()->write(fs_ptr_, deleted_docs_ptr);
     } catch (std::exception& e) {
         std::string err_msg = "Failed to write deleted docs: " + std::string(e.what());
         LOG_ENGINE_ERROR_ << err_msg;
@@ -229,10 +439,9 @@ SegmentWriter::WriteDeletedDocs() {
 
 Status
 SegmentWriter::WriteDeletedDocs(const DeletedDocsPtr& deleted_docs) {
-    codec::DefaultCodec default_codec;
     try {
         fs_ptr_->operation_ptr_->CreateDirectory();
-        default_codec.GetDeletedDocsFormat()->write(fs_ptr_, deleted_docs);
+        codec_->GetDeletedDocsFormat()->write(fs_ptr_, deleted_docs);
     } catch (std::exception& e) {
         std::string err_msg = "Failed to write deleted docs: " + std::string(e.what());
         LOG_ENGINE_ERROR_ << err_msg;
@@ -245,10 +454,9 @@ SegmentWriter::WriteDeletedDocs(const DeletedDocsPtr& deleted_docs) {
 
 Status
 SegmentWriter::WriteBloomFilter(const IdBloomFilterPtr& id_bloom_filter_ptr) {
-    codec::DefaultCodec default_codec;
     try {
         fs_ptr_->operation_ptr_->CreateDirectory();
-        default_codec.GetIdBloomFilterFormat()->write(fs_ptr_, id_bloom_filter_ptr);
+        codec_->GetIdBloomFilterFormat()->write(fs_ptr_, id_bloom_filter_ptr);
     } catch (std::exception& e) {
         std::string err_msg = "Failed to write bloom filter: " + std::string(e.what());
         LOG_ENGINE_ERROR_ << err_msg;
@@ -333,6 +541,113 @@ SegmentWriter::Merge(const std::string& dir_to_merge, const std::string& name) {
     return Status::OK();
 }
 
+Status
+SegmentWriter::Merge(const std::vector<std::string>& segment_dirs_to_merge, const std::string& name,
+                     int64_t max_size, int64_t io_rate_limit, size_t& merged_count) {
+    merged_count = 0;
+    std::string dir_path = fs_ptr_->operation_ptr_->GetDirectory();
+    TimeRecorder recorder("SegmentWriter::Merge");
+
+    // step 1: choose segments by their live size, only headers and deleted docs are read here
+    std::vector<MergeSource> sources;
+    bool has_attrs = false;
+    int64_t merged_size = 0;
+    try {
+        for (auto& dir : segment_dirs_to_merge) {
+            if (dir == dir_path) {
+                return Status(DB_ERROR, "Cannot Merge Self");
+            }
+            MergeSource source;
+            auto status = PlanMergeSource(dir, source, has_attrs);
+            if (!status.ok()) {
+                LOG_ENGINE_ERROR_ << "Failed to merge " << dir << ": " << status.message();
+                return status;
+            }
+            if (!sources.empty() && source.row_size > 0 && sources.front().row_size > 0 &&
+                source.row_size != sources.front().row_size) {
+                return Status(DB_ERROR, "Cannot merge segments of different dimension");
+            }
+            merged_size += source.live_count * (source.row_size + sizeof(doc_id_t));
+            sources.emplace_back(std::move(source));
+            if (merged_size >= max_size) {
+                break;
+            }
+        }
+    } catch (std::exception& e) {
+        return Status(DB_ERROR, "Failed to read segments to merge: " + std::string(e.what()));
+    }
+    merged_count = sources.size();
+
+    // attributes are merged in memory, they are small and rarely used
+    if (has_attrs) {
+        for (size_t i = 0; i < merged_count; ++i) {
+            auto status = Merge(segment_dirs_to_merge[i], name);
+            if (!status.ok()) {
+                return status;
+            }
+        }
+        return Serialize();
+    }
+
+    recorder.RecordSection("Planning " + std::to_string(merged_count) + " segments");
+
+    // step 2: stream vectors, then uids and bloom filter, into the new segment
+    size_t live_count = 0;
+    for (auto& source : sources) {
+        live_count += source.live_count;
+    }
+
+    MergeRateLimiter().SetRate(io_rate_limit);
+    try {
+        fs_ptr_->operation_ptr_->CreateDirectory();
+        auto& bloom_filter = segment_ptr_->id_bloom_filter_ptr_;
+        auto add_to_bloom_filter = [&](const uint8_t* row) {
+            bloom_filter->Add(*reinterpret_cast<const doc_id_t*>(row));
+        };
+
+        if (codec::DetectCodecType(dir_path) == codec::CodecType::CONTAINER) {
+            codec::ContainerWriter container(codec::ContainerPath(dir_path));
+            auto sink = [&](const void* data, int64_t size) { container.Write(data, size); };
+            container.Open();
+            container.BeginComponent(codec::CONTAINER_VECTORS);
+            StreamLiveRows(sources, false, sink, nullptr);
+            container.EndComponent();
+            recorder.RecordSection("Writing vectors done");
+
+            codec_->GetIdBloomFilterFormat()->create(fs_ptr_, bloom_filter);
+            container.BeginComponent(codec::CONTAINER_UIDS);
+            StreamLiveRows(sources, true, sink, add_to_bloom_filter);
+            container.EndComponent();
+            container.Put(codec::CONTAINER_VECTORS_NAME, name.data(), name.size());
+            container.Commit();
+        } else {
+            auto& writer = *fs_ptr_->writer_ptr_;
+            StreamLiveRowsToFile(sources, false, writer, dir_path + "/" + name + RAW_VECTOR_EXTENSION, nullptr);
+            recorder.RecordSection("Writing vectors done");
+
+            codec_->GetIdBloomFilterFormat()->create(fs_ptr_, bloom_filter);
+            StreamLiveRowsToFile(sources, true, writer, dir_path + "/" + name + USER_ID_EXTENSION,
+                                 add_to_bloom_filter);
+        }
+        codec_->GetIdBloomFilterFormat()->write(fs_ptr_, bloom_filter);
+        recorder.RecordSection("Writing uids and bloom filter done");
+    } catch (std::exception& e) {
+        std::string err_msg = "Failed to write merged segment: " + std::string(e.what());
+        LOG_ENGINE_ERROR_ << err_msg;
+        return Status(SERVER_WRITE_ERROR, err_msg);
+    }
+
+    auto status = WriteDeletedDocs();
+    if (!status.ok()) {
+        return status;
+    }
+
+    streamed_size_ += merged_size;
+    streamed_count_ += live_count;
+    LOG_ENGINE_DEBUG_ << "Merged " << merged_count << " segments with " << live_count << " rows to " << dir_path;
+    return Status::OK();
+}
+
 size_t
 SegmentWriter::Size() {
     // TODO(zhiru): switch to actual directory size
@@ -343,12 +658,12 @@ SegmentWriter::Size() {
         ret += segment_ptr_->id_bloom_filter_ptr_->Size();
     }
      */
-    return (vectors_size * sizeof(uint8_t) + uids_size * sizeof(doc_id_t));
+    return (vectors_size * sizeof(uint8_t) + uids_size * sizeof(doc_id_t)) + streamed_size_;
 }
 
 size_t
 SegmentWriter::VectorCount() {
-    return segment_ptr_->vectors_ptr_->GetCount();
+    return segment_ptr_->vectors_ptr_->GetCount() + streamed_count_;
 }
 
 }  // namespace segment
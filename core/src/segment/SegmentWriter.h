@@ -22,6 +22,7 @@
 #include <unordered_map>
 #include <vector>
 
+#include "codecs/Codec.h"
 #include "segment/Types.h"
 #include "storage/FSHandler.h"
 #include "utils/Status.h"
@@ -39,6 +40,9 @@ class SegmentWriter {
     Status
     AddVectors(const std::string& name, const uint8_t* data, uint64_t size, const std::vector<doc_id_t>& uids);
 
+    Status
+    AddVectors(const std::string& name, std::vector<uint8_t>&& data, const std::vector<doc_id_t>& uids);
+
     Status
     AddAttrs(const std::string& name, const std::unordered_map<std::string, uint64_t>& attr_nbytes,
              const std::unordered_map<std::string, std::vector<uint8_t>>& attr_data, const std::vector<doc_id_t>& uids);
@@ -64,6 +68,15 @@ class SegmentWriter {
     Status
     Merge(const std::string& segment_dir_to_merge, const std::string& name);
 
+    /*
+     * Merge segments into this one chunk by chunk and persist the result, deleted docs are skipped;
+     * stops after the segment that makes the merged size reach max_size;
+     * merged_count returns how many leading segments were merged;
+     */
+    Status
+    Merge(const std::vector<std::string>& segment_dirs_to_merge, const std::string& name, int64_t max_size,
+          int64_t io_rate_limit, size_t& merged_count);
+
     size_t
     Size();
 
@@ -89,6 +102,11 @@ class SegmentWriter {
  private:
     storage::FSHandlerPtr fs_ptr_;
     SegmentPtr segment_ptr_;
+    codec::CodecPtr codec_;
+
+    // size and rows written by streaming merge, not held in segment_ptr_
+    size_t streamed_size_ = 0;
+    size_t streamed_count_ = 0;
 };
 
 using SegmentWriterPtr = std::shared_ptr<SegmentWriter>;
@@ -36,9 +36,16 @@ Vectors::AddData(const std::vector<uint8_t>& data) {
 
 void
 Vectors::AddData(const uint8_t* data, uint64_t size) {
-    int64_t old_size = data_.size();
-    data_.resize(data_.size() + size);
-    memcpy(data_.data() + old_size, data, size);
+    data_.insert(data_.end(), data, data + size);
+}
+
+void
+Vectors::AddData(std::vector<uint8_t>&& data) {
+    if (data_.empty()) {
+        data_.swap(data);
+        return;
+    }
+    data_.insert(data_.end(), data.begin(), data.end());
 }
 
 void
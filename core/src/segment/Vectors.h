@@ -36,6 +36,10 @@ class Vectors {
     void
     AddData(const uint8_t* data, uint64_t size);
 
+    // Adopts the buffer when nothing has been added yet, appends otherwise
+    void
+    AddData(std::vector<uint8_t>&& data);
+
     void
     AddUids(const std::vector<doc_id_t>& uids);
 
@@ -18,8 +18,10 @@
 
 #include <faiss/utils/distances.h>
 
+#include "codecs/CodecFactory.h"
 #include "config/Config.h"
 #include "db/DBFactory.h"
+#include "storage/disk/DiskIOFactory.h"
 #include "utils/CommonUtil.h"
 #include "utils/Log.h"
 #include "utils/StringHelpFunctions.h"
@@ -60,6 +62,41 @@ DBWrapper::StartService() {
         return s;
     }
 
+    s = config.GetStorageConfigMergeIORateLimit(opt.merge_io_rate_limit_);
+    if (!s.ok()) {
+        std::cerr << s.ToString() << std::endl;
+        return s;
+    }
+
+    s = config.GetStorageConfigMergeStrategy(opt.merge_strategy_);
+    if (!s.ok()) {
+        std::cerr << s.ToString() << std::endl;
+        return s;
+    }
+
+    std::string io_engine;
+    storage::DiskIOOptions io_options;
+    s = config.GetStorageConfigIOEngine(io_engine);
+    if (!s.ok()) {
+        std::cerr << s.ToString() << std::endl;
+        return s;
+    }
+    io_options.engine_ = (io_engine == "uring") ? storage::DiskIOEngine::URING : storage::DiskIOEngine::FSTREAM;
+    s = config.GetStorageConfigDirectIO(io_options.direct_io_);
+    if (!s.ok()) {
+        std::cerr << s.ToString() << std::endl;
+        return s;
+    }
+    storage::SetDiskIOOptions(io_options);
+
+    std::string codec;
+    s = config.GetStorageConfigCodec(codec);
+    if (!s.ok()) {
+        std::cerr << s.ToString() << std::endl;
+        return s;
+    }
+    codec::SetCodecType((codec == "container") ? codec::CodecType::CONTAINER : codec::CodecType::DEFAULT);
+
     // metric config
     s = config.GetMetricConfigEnableMonitor(opt.metric_enable_);
     if (!s.ok()) {
@@ -67,6 +104,12 @@ DBWrapper::StartService() {
         return s;
     }
 
+    s = config.GetLogsTraceSampleInterval(opt.trace_sample_interval_);
+    if (!s.ok()) {
+        std::cerr << s.ToString() << std::endl;
+        return s;
+    }
+
     // cache config
     s = config.GetCacheConfigCacheInsertData(opt.insert_cache_immediately_);
     if (!s.ok()) {
@@ -82,6 +125,12 @@ DBWrapper::StartService() {
     }
     opt.insert_buffer_size_ = insert_buffer_size;
 
+    s = config.GetCacheConfigPreloadParallelism(opt.preload_parallelism_);
+    if (!s.ok()) {
+        std::cerr << s.ToString() << std::endl;
+        return s;
+    }
+
     bool cluster_enable = false;
     std::string cluster_role;
     STATUS_CHECK(config.GetClusterConfigEnable(cluster_enable));
@@ -11,6 +11,8 @@
 
 #include "server/context/Context.h"
 
+#include <chrono>
+
 namespace milvus {
 namespace server {
 
@@ -30,6 +32,10 @@ std::shared_ptr<Context>
 Context::Child(const std::string& operation_name) const {
     auto new_context = std::make_shared<Context>(request_id_);
     new_context->SetTraceContext(trace_context_->Child(operation_name));
+    new_context->SetPriority(priority_);
+    new_context->SetDeadline(deadline_);
+    new_context->SetQueryProfile(query_profile_);
+    new_context->context_ = context_;
     return new_context;
 }
 
@@ -37,6 +43,10 @@ std::shared_ptr<Context>
 Context::Follower(const std::string& operation_name) const {
     auto new_context = std::make_shared<Context>(request_id_);
     new_context->SetTraceContext(trace_context_->Follower(operation_name));
+    new_context->SetPriority(priority_);
+    new_context->SetDeadline(deadline_);
+    new_context->SetQueryProfile(query_profile_);
+    new_context->context_ = context_;
     return new_context;
 }
 
@@ -54,6 +64,19 @@ Context::IsConnectionBroken() const {
     return context_->IsConnectionBroken();
 }
 
+bool
+Context::IsCancelled() const {
+    if (deadline_ != 0) {
+        auto now = std::chrono::system_clock::now().time_since_epoch();
+        uint64_t now_ms = std::chrono::duration_cast<std::chrono::milliseconds>(now).count();
+        if (now_ms >= deadline_) {
+            return true;
+        }
+    }
+
+    return IsConnectionBroken();
+}
+
 BaseRequest::RequestType
 Context::GetRequestType() const {
     return request_type_;
@@ -64,6 +87,46 @@ Context::SetRequestType(BaseRequest::RequestType type) {
     request_type_ = type;
 }
 
+int64_t
+Context::GetPriority() const {
+    return priority_;
+}
+
+void
+Context::SetPriority(int64_t priority) {
+    priority_ = priority;
+}
+
+uint64_t
+Context::GetDeadline() const {
+    return deadline_;
+}
+
+void
+Context::SetDeadline(uint64_t deadline) {
+    deadline_ = deadline;
+}
+
+void
+Context::SetTimeout(int64_t timeout_ms) {
+    if (timeout_ms <= 0) {
+        deadline_ = 0;
+        return;
+    }
+    auto now = std::chrono::system_clock::now().time_since_epoch();
+    deadline_ = std::chrono::duration_cast<std::chrono::milliseconds>(now).count() + timeout_ms;
+}
+
+const QueryProfilePtr&
+Context::GetQueryProfile() const {
+    return query_profile_;
+}
+
+void
+Context::SetQueryProfile(const QueryProfilePtr& profile) {
+    query_profile_ = profile;
+}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////
 ContextChild::ContextChild(const ContextPtr& context, const std::string& operation_name) {
     if (context) {
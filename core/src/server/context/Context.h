@@ -18,6 +18,7 @@
 #include <grpcpp/server_context.h>
 
 #include "server/context/ConnectionContext.h"
+#include "server/context/QueryProfile.h"
 #include "server/delivery/request/BaseRequest.h"
 #include "tracing/TraceContext.h"
 
@@ -51,17 +52,49 @@ class Context {
     bool
     IsConnectionBroken() const;
 
+    // The client went away or the deadline has passed, work for this request can be dropped
+    bool
+    IsCancelled() const;
+
     BaseRequest::RequestType
     GetRequestType() const;
 
     void
     SetRequestType(BaseRequest::RequestType type);
 
+    // Scheduling hints for the jobs spawned by this request, larger priority is served first
+    int64_t
+    GetPriority() const;
+
+    void
+    SetPriority(int64_t priority);
+
+    // Deadline in milliseconds since epoch, 0 means none
+    uint64_t
+    GetDeadline() const;
+
+    void
+    SetDeadline(uint64_t deadline);
+
+    // Set deadline to now + timeout_ms, timeout_ms <= 0 clears it
+    void
+    SetTimeout(int64_t timeout_ms);
+
+    // Non-null when the client asked for an execution profile of this request
+    const QueryProfilePtr&
+    GetQueryProfile() const;
+
+    void
+    SetQueryProfile(const QueryProfilePtr& profile);
+
  private:
     std::string request_id_;
     BaseRequest::RequestType request_type_;
+    int64_t priority_ = 0;
+    uint64_t deadline_ = 0;
     std::shared_ptr<tracing::TraceContext> trace_context_;
     ConnectionContextPtr context_;
+    QueryProfilePtr query_profile_;
 };
 
 using ContextPtr = std::shared_ptr<milvus::server::Context>;
@@ -0,0 +1,65 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+
+#include "server/context/QueryProfile.h"
+
+namespace milvus {
+namespace server {
+
+void
+QueryProfile::AddStage(const std::string& stage, double time_ms) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stages_[stage] += time_ms;
+}
+
+void
+QueryProfile::AddSegment(const SegmentProfile& segment) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    segments_.push_back(segment);
+}
+
+std::vector<SegmentProfile>
+QueryProfile::Segments() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return segments_;
+}
+
+json
+QueryProfile::ToJson() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    json stages = json::object();
+    for (auto& pair : stages_) {
+        stages[pair.first + "_ms"] = pair.second;
+    }
+
+    json segments = json::array();
+    for (auto& segment : segments_) {
+        json item;
+        item["segment_id"] = segment.segment_id_;
+        item["index_type"] = segment.index_type_;
+        item["rows"] = segment.rows_;
+        item["cache_hit"] = segment.cache_hit_;
+        item["queue_ms"] = segment.queue_time_;
+        item["load_ms"] = segment.load_time_;
+        item["search_ms"] = segment.search_time_;
+        item["reduce_ms"] = segment.reduce_time_;
+        if (segment.nprobe_ >= 0) {
+            item["nprobe"] = segment.nprobe_;
+        }
+        segments.push_back(item);
+    }
+
+    return json{{"stages", stages}, {"segments", segments}};
+}
+
+}  // namespace server
+}  // namespace milvus
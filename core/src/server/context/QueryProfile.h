@@ -0,0 +1,64 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "utils/Json.h"
+
+namespace milvus {
+namespace server {
+
+// What one segment of a profiled search cost, times are in milliseconds
+struct SegmentProfile {
+    int64_t segment_id_ = 0;
+    std::string index_type_;
+    int64_t nprobe_ = -1;
+    int64_t rows_ = 0;
+    bool cache_hit_ = false;
+    double queue_time_ = 0.0;
+    double load_time_ = 0.0;
+    double search_time_ = 0.0;
+    double reduce_time_ = 0.0;
+};
+
+// Execution profile of a search requested by the client, shared by every context derived from the request
+class QueryProfile {
+ public:
+    // stages with the same name are summed
+    void
+    AddStage(const std::string& stage, double time_ms);
+
+    void
+    AddSegment(const SegmentProfile& segment);
+
+    std::vector<SegmentProfile>
+    Segments() const;
+
+    json
+    ToJson() const;
+
+ private:
+    mutable std::mutex mutex_;
+    std::map<std::string, double> stages_;
+    std::vector<SegmentProfile> segments_;
+};
+
+using QueryProfilePtr = std::shared_ptr<QueryProfile>;
+
+}  // namespace server
+}  // namespace milvus
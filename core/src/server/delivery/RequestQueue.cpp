@@ -10,13 +10,19 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include "server/delivery/RequestQueue.h"
+#include "config/Config.h"
+#include "metrics/Metrics.h"
+#include "server/delivery/request/SearchCombineRequest.h"
+#include "server/delivery/request/SearchRequest.h"
 #include "server/delivery/strategy/RequestStrategy.h"
 #include "server/delivery/strategy/SearchReqStrategy.h"
 #include "utils/Log.h"
 
 #include <fiu-local.h>
 #include <unistd.h>
-#include <queue>
+#include <chrono>
+#include <deque>
+#include <memory>
 #include <utility>
 
 namespace milvus {
@@ -24,14 +30,14 @@ namespace server {
 
 namespace {
 Status
-ScheduleRequest(const BaseRequestPtr& request, std::queue<BaseRequestPtr>& queue) {
+ScheduleRequest(const BaseRequestPtr& request, std::deque<BaseRequestPtr>& queue) {
 #if 1
     if (request == nullptr) {
         return Status(SERVER_NULL_POINTER, "request schedule cannot handle null object");
     }
 
     if (queue.empty()) {
-        queue.push(request);
+        queue.push_back(request);
         return Status::OK();
     }
 
@@ -40,12 +46,12 @@ ScheduleRequest(const BaseRequestPtr& request, std::queue<BaseRequestPtr>& queue
 
     auto iter = s_schedulers.find(request->GetRequestType());
     if (iter == s_schedulers.end() || iter->second == nullptr) {
-        queue.push(request);
+        queue.push_back(request);
     } else {
         iter->second->ReScheduleQueue(request, queue);
     }
 #else
-    queue.push(request);
+    queue.push_back(request);
 #endif
 
     return Status::OK();
@@ -61,17 +67,74 @@ RequestQueue::~RequestQueue() {
 
 BaseRequestPtr
 RequestQueue::TakeRequest() {
-    return Take();
+    std::unique_lock<std::mutex> lock(mtx);
+    empty_.wait(lock, [this] { return !queue_.empty(); });
+
+    // requests that queued up behind a running one have already waited, only hold
+    // a search that arrived at an idle queue
+    auto hold_begin = std::chrono::steady_clock::now();
+    if (batch_window_us_ > 0 && hold_head_) {
+        auto deadline = head_arrival_ + std::chrono::microseconds(batch_window_us_);
+        while (queue_.size() == 1 && CanGrowBatch(queue_.front()) && std::chrono::steady_clock::now() < deadline) {
+            empty_.wait_until(lock, deadline);
+        }
+    }
+    hold_head_ = false;
+
+    BaseRequestPtr request = queue_.front();
+    queue_.pop_front();
+    full_.notify_all();
+    lock.unlock();
+
+    if (request != nullptr) {
+        size_t batch_size = 0;
+        if (request->GetRequestType() == BaseRequest::kSearch) {
+            batch_size = 1;
+        } else if (request->GetRequestType() == BaseRequest::kSearchCombine) {
+            batch_size = std::static_pointer_cast<SearchCombineRequest>(request)->RequestCount();
+        }
+        if (batch_size > 0) {
+            auto wait_us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() -
+                                                                                 hold_begin);
+            server::MetricsBase& metrics = server::Metrics::GetInstance();
+            metrics.SearchBatchSizeHistogramObserve(batch_size);
+            metrics.SearchBatchWaitHistogramObserve(wait_us.count());
+        }
+    }
+    return request;
 }
 
 Status
 RequestQueue::PutRequest(const BaseRequestPtr& request_ptr) {
     std::unique_lock<std::mutex> lock(mtx);
     full_.wait(lock, [this] { return (queue_.size() < capacity_); });
+    if (queue_.empty()) {
+        // a new batch starts, pick up the current window settings
+        Config::GetInstance().GetEngineConfigSearchBatchWindow(batch_window_us_);
+        batch_max_nq_ = SearchCombineRequest::MaxCombineNq();
+        hold_head_ = true;
+        head_arrival_ = std::chrono::steady_clock::now();
+    }
     auto status = ScheduleRequest(request_ptr, queue_);
     empty_.notify_all();
     return status;
 }
 
+bool
+RequestQueue::CanGrowBatch(const BaseRequestPtr& request) const {
+    if (request == nullptr) {
+        return false;
+    }
+    if (request->GetRequestType() == BaseRequest::kSearch) {
+        auto search_request = std::static_pointer_cast<SearchRequest>(request);
+        return search_request->VectorsData().vector_count_ < batch_max_nq_;
+    }
+    if (request->GetRequestType() == BaseRequest::kSearchCombine) {
+        auto combine_request = std::static_pointer_cast<SearchCombineRequest>(request);
+        return combine_request->CombinedNq() < batch_max_nq_;
+    }
+    return false;
+}
+
 }  // namespace server
 }  // namespace milvus
@@ -15,6 +15,7 @@
 #include "utils/BlockingQueue.h"
 #include "utils/Status.h"
 
+#include <chrono>
 #include <map>
 #include <memory>
 #include <string>
@@ -36,6 +37,18 @@ class RequestQueue : public BlockingRequestQueue {
 
     Status
     PutRequest(const BaseRequestPtr& request_ptr);
+
+ private:
+    bool
+    CanGrowBatch(const BaseRequestPtr& request) const;
+
+ private:
+    // an idle queue holds a lone search up to batch_window_us_ so that searches arriving
+    // right behind it are combined into one job, see engine_config.search_batch_window_us
+    int64_t batch_window_us_ = 0;
+    uint64_t batch_max_nq_ = 0;
+    bool hold_head_ = false;
+    std::chrono::steady_clock::time_point head_arrival_;
 };
 
 using RequestQueuePtr = std::shared_ptr<RequestQueue>;
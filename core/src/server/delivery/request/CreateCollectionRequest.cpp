@@ -87,6 +87,8 @@ CreateCollectionRequest::OnExecute() {
                 collection_info.engine_type_ = static_cast<int32_t>(engine::EngineType::FAISS_BIN_IDMAP);
             } else if (collection_info.engine_type_ == static_cast<int32_t>(engine::EngineType::FAISS_IVFFLAT)) {
                 collection_info.engine_type_ = static_cast<int32_t>(engine::EngineType::FAISS_BIN_IVFFLAT);
+            } else if (collection_info.engine_type_ == static_cast<int32_t>(engine::EngineType::HNSW)) {
+                collection_info.engine_type_ = static_cast<int32_t>(engine::EngineType::FAISS_BIN_HNSW);
             }
         }
 
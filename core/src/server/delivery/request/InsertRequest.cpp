@@ -20,6 +20,7 @@
 #include <fiu-local.h>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #ifdef ENABLE_CPU_PROFILING
@@ -146,7 +147,7 @@ InsertRequest::OnExecute() {
         auto vec_count = static_cast<uint64_t>(vector_count);
 
         rc.RecordSection("prepare vectors data");
-        status = DBWrapper::DB()->InsertVectors(collection_name_, partition_tag_, vectors_data_);
+        status = DBWrapper::DB()->InsertVectors(collection_name_, partition_tag_, std::move(vectors_data_));
         fiu_do_on("InsertRequest.OnExecute.insert_fail", status = Status(milvus::SERVER_UNEXPECTED_ERROR, ""));
         if (!status.ok()) {
             LOG_SERVER_ERROR_ << LogOut("[%s][%ld] Insert fail: %s", "insert", 0, status.message().c_str());
@@ -10,6 +10,7 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include "server/delivery/request/SearchCombineRequest.h"
+#include "config/Config.h"
 #include "db/Utils.h"
 #include "server/DBWrapper.h"
 #include "server/context/Context.h"
@@ -27,7 +28,10 @@ namespace server {
 namespace {
 
 constexpr int64_t MAX_TOPK_GAP = 200;
-constexpr uint64_t MAX_NQ = 200;
+
+// search params that trade speed for recall, requests whose values fall in the same
+// power-of-two bucket are combined and searched with the largest value
+const std::set<std::string> RECALL_PARAMS = {"nprobe", "ef", "search_k"};
 
 void
 GetUniqueList(const std::vector<std::string>& list, std::set<std::string>& unique_list) {
@@ -53,6 +57,64 @@ IsSameList(const std::set<std::string>& left, const std::set<std::string>& right
     return true;
 }
 
+bool
+IsProfiled(const SearchRequestPtr& request) {
+    return request->Context() != nullptr && request->Context()->GetQueryProfile() != nullptr;
+}
+
+int64_t
+ParamBucket(int64_t value) {
+    int64_t bucket = 1;
+    while (bucket < value) {
+        bucket <<= 1;
+    }
+    return bucket;
+}
+
+bool
+IsCompatibleParams(const milvus::json& left, const milvus::json& right) {
+    if (!left.is_object() || !right.is_object()) {
+        return left == right;
+    }
+    if (left.size() != right.size()) {
+        return false;
+    }
+
+    for (auto& item : left.items()) {
+        auto iter = right.find(item.key());
+        if (iter == right.end()) {
+            return false;
+        }
+        if (RECALL_PARAMS.find(item.key()) != RECALL_PARAMS.end() && item.value().is_number_integer() &&
+            iter->is_number_integer()) {
+            int64_t left_value = item.value().get<int64_t>();
+            int64_t right_value = iter->get<int64_t>();
+            if (left_value > 0 && right_value > 0 && ParamBucket(left_value) == ParamBucket(right_value)) {
+                continue;
+            }
+        }
+        if (item.value() != *iter) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void
+MergeParams(milvus::json& target, const milvus::json& source) {
+    if (!target.is_object() || !source.is_object()) {
+        return;
+    }
+    for (auto& key : RECALL_PARAMS) {
+        auto iter = source.find(key);
+        if (iter != source.end() && target.contains(key) && iter->is_number_integer() &&
+            target[key].is_number_integer() && iter->get<int64_t>() > target[key].get<int64_t>()) {
+            target[key] = *iter;
+        }
+    }
+}
+
 void
 FreeRequest(SearchRequestPtr& request, const Status& status) {
     request->set_status(status);
@@ -94,6 +156,14 @@ class TracingContextList {
 }  // namespace
 
 SearchCombineRequest::SearchCombineRequest() : BaseRequest(nullptr, BaseRequest::kSearchCombine) {
+    max_nq_ = MaxCombineNq();
+}
+
+uint64_t
+SearchCombineRequest::MaxCombineNq() {
+    int64_t max_nq = 0;
+    Config::GetInstance().GetEngineConfigSearchBatchMaxNq(max_nq);
+    return max_nq > 0 ? max_nq : std::stoll(CONFIG_ENGINE_SEARCH_BATCH_MAX_NQ_DEFAULT);
 }
 
 Status
@@ -130,19 +200,22 @@ SearchCombineRequest::Combine(const SearchRequestPtr& request) {
 
         GetUniqueList(request->PartitionList(), partition_list_);
         GetUniqueList(request->FileIDList(), file_id_list_);
+    } else {
+        MergeParams(extra_params_, request->ExtraParams());
     }
 
+    combined_nq_ += request->VectorsData().vector_count_;
     request_list_.push_back(request);
     return Status::OK();
 }
 
 bool
 SearchCombineRequest::CanCombine(const SearchRequestPtr& request) {
-    if (collection_name_ != request->CollectionName()) {
+    if (collection_name_ != request->CollectionName() || IsProfiled(request)) {
         return false;
     }
 
-    if (extra_params_ != request->ExtraParams()) {
+    if (!IsCompatibleParams(extra_params_, request->ExtraParams())) {
         return false;
     }
 
@@ -151,12 +224,9 @@ SearchCombineRequest::CanCombine(const SearchRequestPtr& request) {
         return false;
     }
 
-    // sum of nq must less-equal than MAX_NQ
-    if (vectors_data_.vector_count_ > MAX_NQ || request->VectorsData().vector_count_ > MAX_NQ) {
-        return false;
-    }
-    uint64_t total_nq = vectors_data_.vector_count_ + request->VectorsData().vector_count_;
-    if (total_nq > MAX_NQ) {
+    // sum of nq must less-equal than max nq
+    uint64_t total_nq = combined_nq_ + request->VectorsData().vector_count_;
+    if (total_nq > max_nq_) {
         return false;
     }
 
@@ -183,21 +253,23 @@ SearchCombineRequest::CanCombine(const SearchRequestPtr& left, const SearchReque
         return false;
     }
 
-    if (left->ExtraParams() != right->ExtraParams()) {
+    // a profiled search has to run alone to report its own execution
+    if (IsProfiled(left) || IsProfiled(right)) {
         return false;
     }
 
-    // topk must within certain range
-    if (abs(left->TopK() - right->TopK() > MAX_TOPK_GAP)) {
+    if (!IsCompatibleParams(left->ExtraParams(), right->ExtraParams())) {
         return false;
     }
 
-    // sum of nq must less-equal than MAX_NQ
-    if (left->VectorsData().vector_count_ > MAX_NQ || right->VectorsData().vector_count_ > MAX_NQ) {
+    // topk must within certain range
+    if (std::abs(left->TopK() - right->TopK()) > MAX_TOPK_GAP / 2) {
         return false;
     }
+
+    // sum of nq must less-equal than max nq
     uint64_t total_nq = left->VectorsData().vector_count_ + right->VectorsData().vector_count_;
-    if (total_nq > MAX_NQ) {
+    if (total_nq > MaxCombineNq()) {
         return false;
     }
 
@@ -315,6 +387,12 @@ SearchCombineRequest::OnExecute() {
 
         LOG_SERVER_DEBUG_ << (combined_request - run_request) << " requests were skipped";
         LOG_SERVER_DEBUG_ << "reset topk to " << search_topk_;
+
+        // hnsw needs ef >= topk, the combined topk may exceed the ef of the first request
+        if (extra_params_.is_object() && extra_params_.contains("ef") && extra_params_["ef"].is_number_integer() &&
+            extra_params_["ef"].get<int64_t>() < search_topk_) {
+            extra_params_["ef"] = search_topk_;
+        }
         rc.RecordSection("check validation");
 
         // step 3: construct vectors_data
@@ -400,7 +478,7 @@ SearchCombineRequest::OnExecute() {
             return status;
         }
 
-        // step 5: construct result array
+        // step 5: construct result array, each row of the combined result holds search_topk_ items
         offset = 0;
         for (auto& request : request_list_) {
             uint64_t count = request->VectorsData().vector_count_;
@@ -410,9 +488,12 @@ SearchCombineRequest::OnExecute() {
             result.row_num_ = count;
             result.id_list_.resize(element_cnt);
             result.distance_list_.resize(element_cnt);
-            memcpy(result.id_list_.data(), result_ids.data() + offset, element_cnt * sizeof(int64_t));
-            memcpy(result.distance_list_.data(), result_distances.data() + offset, element_cnt * sizeof(float));
-            offset += (count * search_topk_);
+            for (uint64_t i = 0; i < count; ++i) {
+                memcpy(result.id_list_.data() + i * topk, result_ids.data() + offset, topk * sizeof(int64_t));
+                memcpy(result.distance_list_.data() + i * topk, result_distances.data() + offset,
+                       topk * sizeof(float));
+                offset += search_topk_;
+            }
 
             // let request return
             FreeRequest(request, Status::OK());
@@ -35,6 +35,20 @@ class SearchCombineRequest : public BaseRequest {
     static bool
     CanCombine(const SearchRequestPtr& left, const SearchRequestPtr& right);
 
+    // Largest nq a combined search may reach, engine_config.search_batch_max_nq
+    static uint64_t
+    MaxCombineNq();
+
+    uint64_t
+    CombinedNq() const {
+        return combined_nq_;
+    }
+
+    size_t
+    RequestCount() const {
+        return request_list_.size();
+    }
+
  protected:
     Status
     OnExecute() override;
@@ -52,6 +66,8 @@ class SearchCombineRequest : public BaseRequest {
     milvus::json extra_params_;
     std::set<std::string> partition_list_;
     std::set<std::string> file_id_list_;
+    uint64_t combined_nq_ = 0;
+    uint64_t max_nq_ = 0;
 
     std::vector<SearchRequestPtr> request_list_;
 };
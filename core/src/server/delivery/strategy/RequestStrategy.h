@@ -15,8 +15,8 @@
 #include "utils/BlockingQueue.h"
 #include "utils/Status.h"
 
+#include <deque>
 #include <memory>
-#include <queue>
 #include <string>
 #include <utility>
 #include <vector>
@@ -30,7 +30,7 @@ class RequestStrategy {
 
  public:
     virtual Status
-    ReScheduleQueue(const BaseRequestPtr& request, std::queue<BaseRequestPtr>& queue) = 0;
+    ReScheduleQueue(const BaseRequestPtr& request, std::deque<BaseRequestPtr>& queue) = 0;
 };
 
 using RequestStrategyPtr = std::shared_ptr<RequestStrategy>;
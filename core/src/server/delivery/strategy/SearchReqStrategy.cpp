@@ -17,7 +17,7 @@
 #include "utils/Log.h"
 #include "utils/TimeRecorder.h"
 
-#include <queue>
+#include <deque>
 #include <string>
 
 namespace milvus {
@@ -27,7 +27,7 @@ SearchReqStrategy::SearchReqStrategy() {
 }
 
 Status
-SearchReqStrategy::ReScheduleQueue(const BaseRequestPtr& request, std::queue<BaseRequestPtr>& queue) {
+SearchReqStrategy::ReScheduleQueue(const BaseRequestPtr& request, std::deque<BaseRequestPtr>& queue) {
     if (request->GetRequestType() != BaseRequest::kSearch) {
         std::string msg = "search strategy can only handle search request";
         LOG_SERVER_ERROR_ << msg;
@@ -37,36 +37,38 @@ SearchReqStrategy::ReScheduleQueue(const BaseRequestPtr& request, std::queue<Bas
     //    TimeRecorderAuto rc("SearchReqStrategy::ReScheduleQueue");
     SearchRequestPtr new_search_req = std::static_pointer_cast<SearchRequest>(request);
 
-    BaseRequestPtr last_req = queue.back();
-    if (last_req->GetRequestType() == BaseRequest::kSearch) {
-        SearchRequestPtr last_search_req = std::static_pointer_cast<SearchRequest>(last_req);
-        if (SearchCombineRequest::CanCombine(last_search_req, new_search_req)) {
-            // combine request
-            SearchCombineRequestPtr combine_request = std::make_shared<SearchCombineRequest>();
-            combine_request->Combine(last_search_req);
-            combine_request->Combine(new_search_req);
-            queue.back() = combine_request;  // replace the last request to combine request
-            LOG_SERVER_DEBUG_ << "Combine 2 search request";
+    // look for a queued search on the same collection to join, newest first; other request
+    // types are barriers since a search must not overtake e.g. a reload of segments
+    for (auto iter = queue.rbegin(); iter != queue.rend(); ++iter) {
+        BaseRequestPtr& queued_req = *iter;
+        if (queued_req->GetRequestType() == BaseRequest::kSearch) {
+            SearchRequestPtr queued_search_req = std::static_pointer_cast<SearchRequest>(queued_req);
+            if (SearchCombineRequest::CanCombine(queued_search_req, new_search_req)) {
+                // combine request
+                SearchCombineRequestPtr combine_request = std::make_shared<SearchCombineRequest>();
+                if (!combine_request->Combine(queued_search_req).ok()) {
+                    break;  // let the queued request report its own error
+                }
+                combine_request->Combine(new_search_req);
+                queued_req = combine_request;  // replace the queued request to combine request
+                LOG_SERVER_DEBUG_ << "Combine 2 search request";
+                return Status::OK();
+            }
+        } else if (queued_req->GetRequestType() == BaseRequest::kSearchCombine) {
+            SearchCombineRequestPtr combine_req = std::static_pointer_cast<SearchCombineRequest>(queued_req);
+            if (combine_req->CanCombine(new_search_req)) {
+                // combine request
+                combine_req->Combine(new_search_req);
+                LOG_SERVER_DEBUG_ << "Combine more search request";
+                return Status::OK();
+            }
         } else {
-            // directly put to queue
-            queue.push(request);
+            break;
         }
-    } else if (last_req->GetRequestType() == BaseRequest::kSearchCombine) {
-        SearchCombineRequestPtr combine_req = std::static_pointer_cast<SearchCombineRequest>(last_req);
-        if (combine_req->CanCombine(new_search_req)) {
-            // combine request
-            combine_req->Combine(new_search_req);
-            LOG_SERVER_DEBUG_ << "Combine more search request";
-        } else {
-            // directly put to queue
-            queue.push(request);
-        }
-    } else {
-        std::string msg = "unsupported request type for search strategy";
-        LOG_SERVER_ERROR_ << msg;
-        return Status(SERVER_UNSUPPORTED_ERROR, msg);
     }
 
+    // directly put to queue
+    queue.push_back(request);
     return Status::OK();
 }
 
@@ -13,6 +13,7 @@
 
 #include <fiu-local.h>
 #include <algorithm>
+#include <chrono>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -33,6 +34,9 @@ namespace server {
 namespace grpc {
 
 const char* EXTRA_PARAM_KEY = "params";
+const char* EXTRA_PARAM_ROW_COUNT = "row_count";
+const char* EXTRA_PARAM_PROFILE = "profile";
+const char* QUERY_PROFILE_METADATA_KEY = "milvus-query-profile";
 
 ::milvus::grpc::ErrorCode
 ErrorMap(ErrorCode code) {
@@ -99,34 +103,29 @@ void
 CopyRowRecords(const google::protobuf::RepeatedPtrField<::milvus::grpc::RowRecord>& grpc_records,
                const google::protobuf::RepeatedField<google::protobuf::int64>& grpc_id_array,
                engine::VectorsData& vectors) {
-    // step 1: copy vector data
+    // step 1: copy vector data, reserve first so every record is appended without zero-filling
     int64_t float_data_size = 0, binary_data_size = 0;
     for (auto& record : grpc_records) {
         float_data_size += record.float_data_size();
         binary_data_size += record.binary_data().size();
     }
 
-    std::vector<float> float_array(float_data_size, 0.0f);
-    std::vector<uint8_t> binary_array(binary_data_size, 0);
-    int64_t float_offset = 0, binary_offset = 0;
+    std::vector<float> float_array;
+    std::vector<uint8_t> binary_array;
     if (float_data_size > 0) {
+        float_array.reserve(float_data_size);
         for (auto& record : grpc_records) {
-            memcpy(&float_array[float_offset], record.float_data().data(), record.float_data_size() * sizeof(float));
-            float_offset += record.float_data_size();
+            float_array.insert(float_array.end(), record.float_data().begin(), record.float_data().end());
         }
     } else if (binary_data_size > 0) {
+        binary_array.reserve(binary_data_size);
         for (auto& record : grpc_records) {
-            memcpy(&binary_array[binary_offset], record.binary_data().data(), record.binary_data().size());
-            binary_offset += record.binary_data().size();
+            binary_array.insert(binary_array.end(), record.binary_data().begin(), record.binary_data().end());
         }
     }
 
     // step 2: copy id array
-    std::vector<int64_t> id_array;
-    if (grpc_id_array.size() > 0) {
-        id_array.resize(grpc_id_array.size());
-        memcpy(id_array.data(), grpc_id_array.data(), grpc_id_array.size() * sizeof(int64_t));
-    }
+    std::vector<int64_t> id_array(grpc_id_array.begin(), grpc_id_array.end());
 
     // step 3: contruct vectors
     vectors.vector_count_ = grpc_records.size();
@@ -135,6 +134,22 @@ CopyRowRecords(const google::protobuf::RepeatedPtrField<::milvus::grpc::RowRecor
     vectors.id_array_.swap(id_array);
 }
 
+// Flat insert payload: a single RowRecord carries row_count vectors back to back, row-major float32 in
+// float_data (packed on the wire) or uint8 in binary_data. One bulk copy replaces the per-record loop,
+// the resulting buffers are then moved all the way down to the segment.
+void
+CopyFlatRowRecord(const ::milvus::grpc::RowRecord& grpc_record,
+                  const google::protobuf::RepeatedField<google::protobuf::int64>& grpc_id_array, int64_t row_count,
+                  engine::VectorsData& vectors) {
+    vectors.vector_count_ = row_count;
+    if (grpc_record.float_data_size() > 0) {
+        vectors.float_data_.assign(grpc_record.float_data().begin(), grpc_record.float_data().end());
+    } else {
+        vectors.binary_data_.assign(grpc_record.binary_data().begin(), grpc_record.binary_data().end());
+    }
+    vectors.id_array_.assign(grpc_id_array.begin(), grpc_id_array.end());
+}
+
 void
 DeSerialization(const ::milvus::grpc::GeneralQuery& general_query, query::BooleanQueryPtr& boolean_clause,
                 query::QueryPtr& query_ptr) {
@@ -230,6 +245,31 @@ ConstructResults(const TopKQueryResult& result, ::milvus::grpc::TopKQueryResult*
            result.distance_list_.size() * sizeof(float));
 }
 
+// A search asks for its execution profile with the extra param {key: "profile", value: "true"}
+QueryProfilePtr
+EnableQueryProfile(const google::protobuf::RepeatedPtrField<::milvus::grpc::KeyValuePair>& extra_params,
+                   const std::shared_ptr<Context>& context) {
+    if (context == nullptr) {
+        return nullptr;
+    }
+    for (auto& extra : extra_params) {
+        if (extra.key() == EXTRA_PARAM_PROFILE && extra.value() == "true") {
+            auto profile = std::make_shared<QueryProfile>();
+            context->SetQueryProfile(profile);
+            return profile;
+        }
+    }
+    return nullptr;
+}
+
+// The profile travels in trailing metadata so the result messages keep their layout
+void
+SendQueryProfile(::grpc::ServerContext* context, const QueryProfilePtr& profile) {
+    if (profile != nullptr) {
+        context->AddTrailingMetadata(QUERY_PROFILE_METADATA_KEY, profile->ToJson().dump());
+    }
+}
+
 void
 ConstructHEntityResults(const std::vector<engine::AttrsData>& attrs, const std::vector<engine::VectorsData>& vectors,
                         std::vector<std::string>& field_names, ::milvus::grpc::HEntity* response) {
@@ -490,6 +530,24 @@ GrpcRequestHandler::OnPostRecvInitialMetaData(
     auto trace_context = std::make_shared<tracing::TraceContext>(span);
     auto context = std::make_shared<Context>(request_id);
     context->SetTraceContext(trace_context);
+
+    // client may rank its requests by providing priority in metadata, larger is served first
+    auto priority_kv = client_metadata.find("priority");
+    if (priority_kv != client_metadata.end()) {
+        std::string priority(priority_kv->second.data(), priority_kv->second.length());
+        try {
+            context->SetPriority(std::stoll(priority));
+        } catch (std::exception& ex) {
+            LOG_SERVER_WARNING_ << "invalid priority in metadata: " << priority;
+        }
+    }
+
+    // client deadline bounds the work scheduled for this request
+    auto deadline = server_context->deadline();
+    if (deadline != std::chrono::system_clock::time_point::max()) {
+        auto since_epoch = std::chrono::duration_cast<std::chrono::milliseconds>(deadline.time_since_epoch());
+        context->SetDeadline(since_epoch.count() > 0 ? since_epoch.count() : 1);
+    }
     SetContext(server_rpc_info->server_context(), context);
 }
 
@@ -620,8 +678,32 @@ GrpcRequestHandler::Insert(::grpc::ServerContext* context, const ::milvus::grpc:
     LOG_SERVER_INFO_ << LogOut("Request [%s] %s begin.", GetContext(context)->RequestID().c_str(), __func__);
 
     // step 1: copy vector data
+    int64_t row_count = 0;
+    for (int i = 0; i < request->extra_params_size(); i++) {
+        const ::milvus::grpc::KeyValuePair& extra = request->extra_params(i);
+        if (extra.key() == EXTRA_PARAM_KEY) {
+            try {
+                milvus::json json_params = json::parse(extra.value());
+                auto it = json_params.find(EXTRA_PARAM_ROW_COUNT);
+                if (it != json_params.end() && it->is_number_integer()) {
+                    row_count = it->get<int64_t>();
+                }
+            } catch (json::exception& ex) {
+                LOG_SERVER_ERROR_ << LogOut("Request [%s] %s invalid extra params: %s",
+                                            GetContext(context)->RequestID().c_str(), __func__, ex.what());
+                Status status(SERVER_INVALID_ARGUMENT, std::string("Invalid extra params: ") + ex.what());
+                SET_RESPONSE(response->mutable_status(), status, context);
+                return ::grpc::Status::OK;
+            }
+        }
+    }
+
     engine::VectorsData vectors;
-    CopyRowRecords(request->row_record_array(), request->row_id_array(), vectors);
+    if (row_count > 0 && request->row_record_array_size() == 1) {
+        CopyFlatRowRecord(request->row_record_array(0), request->row_id_array(), row_count, vectors);
+    } else {
+        CopyRowRecords(request->row_record_array(), request->row_id_array(), vectors);
+    }
 
     // step 2: insert vectors
     Status status =
@@ -723,11 +805,13 @@ GrpcRequestHandler::Search(::grpc::ServerContext* context, const ::milvus::grpc:
     TopKQueryResult result;
     fiu_do_on("GrpcRequestHandler.Search.not_empty_file_ids", file_ids.emplace_back("test_file_id"));
 
+    auto profile = EnableQueryProfile(request->extra_params(), GetContext(context));
     Status status = request_handler_.Search(GetContext(context), request->collection_name(), vectors, request->topk(),
                                             json_params, partitions, file_ids, result);
 
     // step 5: construct and return result
     ConstructResults(result, response);
+    SendQueryProfile(context, profile);
 
     LOG_SERVER_INFO_ << LogOut("Request [%s] %s end.", GetContext(context)->RequestID().c_str(), __func__);
     SET_RESPONSE(response->mutable_status(), status, context);
@@ -1272,8 +1356,10 @@ GrpcRequestHandler::HybridSearchPB(::grpc::ServerContext* context, const ::milvu
 
     engine::QueryResult result;
     std::vector<std::string> field_names;
+    auto profile = EnableQueryProfile(request->extra_params(), GetContext(context));
     status = request_handler_.HybridSearch(GetContext(context), request->collection_name(), partition_list,
                                            general_query, query_ptr, json_params, field_names, result);
+    SendQueryProfile(context, profile);
 
     // step 6: construct and return result
     response->set_row_num(result.row_num_);
@@ -1600,8 +1686,10 @@ GrpcRequestHandler::HybridSearch(::grpc::ServerContext* context, const ::milvus:
 
     engine::QueryResult result;
     std::vector<std::string> field_names;
+    auto profile = EnableQueryProfile(request->extra_params(), GetContext(context));
     status = request_handler_.HybridSearch(GetContext(context), request->collection_name(), partition_list,
                                            general_query, query_ptr, json_params, field_names, result);
+    SendQueryProfile(context, profile);
 
     // step 6: construct and return result
     response->set_row_num(result.row_num_);
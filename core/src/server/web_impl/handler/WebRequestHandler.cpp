@@ -429,6 +429,7 @@ WebRequestHandler::Search(const std::string& collection_name, const nlohmann::js
     }
 
     TopKQueryResult result;
+    QueryProfilePtr profile;
     Status status;
     if (json.contains("ids")) {
         auto vec_ids = json["ids"];
@@ -471,6 +472,11 @@ WebRequestHandler::Search(const std::string& collection_name, const nlohmann::js
             return status;
         }
 
+        if (json.contains("profile") && json["profile"].is_boolean() && json["profile"].get<bool>()) {
+            profile = std::make_shared<QueryProfile>();
+            context_ptr_->SetQueryProfile(profile);
+        }
+
         status = request_handler_.Search(context_ptr_, collection_name, vectors_data, topk, json["params"],
                                          partition_tags, file_id_vec, result);
     }
@@ -480,6 +486,9 @@ WebRequestHandler::Search(const std::string& collection_name, const nlohmann::js
 
     nlohmann::json result_json;
     result_json["num"] = result.row_num_;
+    if (profile != nullptr) {
+        result_json["profile"] = profile->ToJson();
+    }
     if (result.row_num_ == 0) {
         result_json["result"] = std::vector<int64_t>();
         result_str = result_json.dump();
@@ -13,10 +13,17 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace milvus {
 namespace storage {
 
+struct IORegion {
+    int64_t offset_ = 0;
+    int64_t size_ = 0;
+    void* ptr_ = nullptr;
+};
+
 class IOReader {
  public:
     virtual bool
@@ -28,6 +35,16 @@ class IOReader {
     virtual void
     seekg(int64_t pos) = 0;
 
+    // read several regions of the file, backends may serve them in one submission;
+    // the position afterwards is unspecified
+    virtual void
+    readv(const std::vector<IORegion>& regions) {
+        for (auto& region : regions) {
+            seekg(region.offset_);
+            read(region.ptr_, region.size_);
+        }
+    }
+
     virtual int64_t
     length() = 0;
 
@@ -0,0 +1,340 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+
+#include "storage/disk/DirectIOReader.h"
+
+#include <fcntl.h>
+#include <fiu-local.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <future>
+#include <thread>
+
+#include "storage/disk/IOUring.h"
+#include "utils/Exception.h"
+#include "utils/Log.h"
+#include "utils/ThreadPool.h"
+
+namespace milvus {
+namespace storage {
+
+namespace {
+
+ThreadPool&
+PreadPool() {
+    static ThreadPool pool(8);
+    return pool;
+}
+
+int64_t
+AlignDown(int64_t value) {
+    return value / DIRECT_IO_ALIGNMENT * DIRECT_IO_ALIGNMENT;
+}
+
+int64_t
+AlignUp(int64_t value) {
+    return AlignDown(value + DIRECT_IO_ALIGNMENT - 1);
+}
+
+bool
+IsAligned(const void* ptr) {
+    return reinterpret_cast<uintptr_t>(ptr) % DIRECT_IO_ALIGNMENT == 0;
+}
+
+// one ring per thread, created on first use; nullptr once io_uring turned out unusable
+IOUring*
+ThreadRing() {
+#if defined(MILVUS_WITH_IO_URING)
+    thread_local std::unique_ptr<IOUring> ring;
+    thread_local bool tried = false;
+    if (!tried) {
+        tried = true;
+        ring = std::make_unique<IOUring>();
+        if (!ring->Init(DISK_IO_QUEUE_DEPTH)) {
+            LOG_STORAGE_DEBUG_ << "io_uring unavailable, disk reads fall back to pread";
+            ring = nullptr;
+        }
+    }
+    return ring.get();
+#else
+    return nullptr;
+#endif
+}
+
+}  // namespace
+
+struct DirectIOReader::Chunk {
+    int64_t offset_ = 0;  // file offset of buffer_[0]
+    int64_t size_ = 0;
+    char* buffer_ = nullptr;
+    int64_t done_ = 0;
+    iovec iov_;
+
+    // set when reading through an aligned bounce buffer
+    std::shared_ptr<char> bounce_;
+    char* dst_ = nullptr;
+    int64_t dst_skip_ = 0;
+    int64_t dst_size_ = 0;
+};
+
+DirectIOReader::~DirectIOReader() {
+    close();
+}
+
+bool
+DirectIOReader::open(const std::string& name) {
+    close();
+    name_ = name;
+    pos_ = 0;
+    length_ = 0;
+
+    direct_opened_ = false;
+    if (direct_io_) {
+        fd_ = ::open(name_.c_str(), O_RDONLY | O_DIRECT);
+        // some file systems such as tmpfs reject O_DIRECT
+        direct_opened_ = fd_ >= 0;
+    }
+    if (fd_ < 0) {
+        fd_ = ::open(name_.c_str(), O_RDONLY);
+    }
+    if (fd_ < 0) {
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd_, &st) != 0) {
+        close();
+        return false;
+    }
+    length_ = st.st_size;
+    return true;
+}
+
+void
+DirectIOReader::read(void* ptr, int64_t size) {
+    readv({IORegion{pos_, size, ptr}});
+    pos_ += size;
+}
+
+void
+DirectIOReader::readv(const std::vector<IORegion>& regions) {
+    if (fd_ < 0) {
+        return;
+    }
+
+    std::vector<Chunk> chunks;
+    for (auto& region : regions) {
+        int64_t end = std::min(region.offset_ + region.size_, length_);
+        for (int64_t offset = region.offset_; offset < end; offset += DISK_IO_CHUNK_SIZE) {
+            Chunk chunk;
+            int64_t size = std::min(DISK_IO_CHUNK_SIZE, end - offset);
+            char* dst = static_cast<char*>(region.ptr_) + (offset - region.offset_);
+            if (!direct_opened_ || (offset % DIRECT_IO_ALIGNMENT == 0 && size % DIRECT_IO_ALIGNMENT == 0 &&
+                                    IsAligned(dst))) {
+                chunk.offset_ = offset;
+                chunk.size_ = size;
+                chunk.buffer_ = dst;
+            } else {
+                chunk.offset_ = AlignDown(offset);
+                chunk.size_ = AlignUp(offset + size) - chunk.offset_;
+                void* buffer = nullptr;
+                if (posix_memalign(&buffer, DIRECT_IO_ALIGNMENT, chunk.size_) != 0) {
+                    LOG_STORAGE_ERROR_ << "Failed to allocate aligned buffer of " << chunk.size_ << " bytes";
+                    return;
+                }
+                chunk.bounce_ = std::shared_ptr<char>(static_cast<char*>(buffer), free);
+                chunk.buffer_ = chunk.bounce_.get();
+                chunk.dst_ = dst;
+                chunk.dst_skip_ = offset - chunk.offset_;
+                chunk.dst_size_ = size;
+            }
+            chunks.emplace_back(std::move(chunk));
+        }
+    }
+    if (chunks.empty()) {
+        return;
+    }
+
+    bool use_uring = chunks.size() > 1;
+    fiu_do_on("DirectIOReader.readv.uring_disable", use_uring = false);
+    if (!use_uring || !ReadByUring(chunks)) {
+        ReadByPool(chunks);
+    }
+
+    for (auto& chunk : chunks) {
+        if (chunk.dst_ != nullptr) {
+            int64_t available = std::max<int64_t>(0, std::min(chunk.done_ - chunk.dst_skip_, chunk.dst_size_));
+            memcpy(chunk.dst_, chunk.buffer_ + chunk.dst_skip_, available);
+        }
+    }
+}
+
+void
+DirectIOReader::seekg(int64_t pos) {
+    pos_ = pos;
+}
+
+int64_t
+DirectIOReader::length() {
+    return length_;
+}
+
+void
+DirectIOReader::close() {
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+}
+
+bool
+DirectIOReader::ReadByUring(std::vector<Chunk>& chunks) {
+    IOUring* ring = ThreadRing();
+    if (ring == nullptr) {
+        return false;
+    }
+
+    std::vector<size_t> pending;
+    for (size_t i = chunks.size(); i > 0; --i) {
+        pending.push_back(i - 1);
+    }
+
+    size_t inflight = 0;
+    std::string error;
+    while (!pending.empty() || inflight > 0) {
+        if (!error.empty()) {
+            // stop issuing reads, only wait for the ones in flight
+            pending.clear();
+            if (inflight == 0) {
+                break;
+            }
+        }
+        while (!pending.empty()) {
+            auto& chunk = chunks[pending.back()];
+            chunk.iov_.iov_base = chunk.buffer_ + chunk.done_;
+            chunk.iov_.iov_len = chunk.size_ - chunk.done_;
+            if (!ring->PrepareReadv(fd_, &chunk.iov_, chunk.offset_ + chunk.done_, pending.back())) {
+                break;
+            }
+            pending.pop_back();
+            ++inflight;
+        }
+
+        int ret = ring->Submit(1);
+        if (ret < 0 && ret != -EAGAIN && ret != -EBUSY && ret != -EINTR) {
+            LOG_STORAGE_ERROR_ << "io_uring_enter failed: " << strerror(-ret);
+            // the kernel still writes into the buffers of submitted entries, never fail over before they complete
+            inflight -= ring->DiscardUnsubmitted();
+            WaitInflight(ring, inflight);
+            if (!error.empty()) {
+                break;
+            }
+            return false;
+        }
+
+        uint64_t id;
+        int32_t res;
+        while (ring->PopCompletion(id, res)) {
+            --inflight;
+            fiu_do_on("DirectIOReader.ReadByUring.read_fail", res = -EIO);
+            auto& chunk = chunks[id];
+            if (res == -EAGAIN || res == -EINTR) {
+                pending.push_back(id);
+            } else if (res < 0) {
+                error = "Failed to read " + name_ + " at " + std::to_string(chunk.offset_ + chunk.done_) + ": " +
+                        strerror(-res);
+                LOG_STORAGE_ERROR_ << error;
+            } else if (res > 0) {
+                chunk.done_ += res;
+                if (chunk.done_ < chunk.size_ && chunk.offset_ + chunk.done_ < length_) {
+                    pending.push_back(id);
+                }
+            }
+        }
+    }
+
+    if (!error.empty()) {
+        throw Exception(SERVER_READ_ERROR, error);
+    }
+    return true;
+}
+
+void
+DirectIOReader::WaitInflight(IOUring* ring, size_t& inflight) {
+    // completions are posted to the ring without entering the kernel, poll them if waiting keeps failing
+    while (inflight > 0) {
+        uint64_t id;
+        int32_t res;
+        bool reaped = false;
+        while (ring->PopCompletion(id, res)) {
+            --inflight;
+            reaped = true;
+        }
+        if (!reaped && inflight > 0 && ring->Submit(1) < 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+}
+
+void
+DirectIOReader::ReadByPool(std::vector<Chunk>& chunks) {
+    bool ok = true;
+    if (chunks.size() == 1) {
+        ok = PreadChunk(chunks[0]);
+    } else {
+        std::vector<std::future<bool>> results;
+        results.reserve(chunks.size());
+        for (auto& chunk : chunks) {
+            results.emplace_back(PreadPool().enqueue([this, &chunk]() { return PreadChunk(chunk); }));
+        }
+        // every task refers to a chunk, wait for all of them before failing
+        for (auto& result : results) {
+            ok = result.get() && ok;
+        }
+    }
+
+    if (!ok) {
+        std::string err_msg = "Failed to read " + name_;
+        LOG_STORAGE_ERROR_ << err_msg;
+        throw Exception(SERVER_READ_ERROR, err_msg);
+    }
+}
+
+bool
+DirectIOReader::PreadChunk(Chunk& chunk) {
+    chunk.done_ = 0;
+    while (chunk.done_ < chunk.size_) {
+        ssize_t ret = pread(fd_, chunk.buffer_ + chunk.done_, chunk.size_ - chunk.done_, chunk.offset_ + chunk.done_);
+        fiu_do_on("DirectIOReader.PreadChunk.fail", ret = -1; errno = EIO);
+        if (ret < 0 && errno == EINTR) {
+            continue;
+        }
+        if (ret < 0) {
+            LOG_STORAGE_ERROR_ << "Failed to read " << name_ << " at " << chunk.offset_ << ": " << strerror(errno);
+            return false;
+        }
+        if (ret == 0) {
+            break;
+        }
+        chunk.done_ += ret;
+    }
+    return true;
+}
+
+}  // namespace storage
+}  // namespace milvus
@@ -0,0 +1,97 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "storage/IOReader.h"
+
+namespace milvus {
+namespace storage {
+
+constexpr int64_t DIRECT_IO_ALIGNMENT = 4096;
+constexpr int64_t DISK_IO_CHUNK_SIZE = 1024 * 1024;
+constexpr uint32_t DISK_IO_QUEUE_DEPTH = 32;
+
+class IOUring;
+
+// Reader issuing large reads as chunks kept in flight on a per-thread io_uring, or on a pread
+// thread pool where io_uring is unavailable. With direct_io the file is opened with O_DIRECT
+// and read through aligned buffers, bypassing the page cache. Failed reads throw.
+class DirectIOReader : public IOReader {
+ public:
+    explicit DirectIOReader(bool direct_io = false) : direct_io_(direct_io) {
+    }
+    ~DirectIOReader();
+
+    // No copy and move
+    DirectIOReader(const DirectIOReader&) = delete;
+    DirectIOReader(DirectIOReader&&) = delete;
+
+    DirectIOReader&
+    operator=(const DirectIOReader&) = delete;
+    DirectIOReader&
+    operator=(DirectIOReader&&) = delete;
+
+    bool
+    open(const std::string& name) override;
+
+    void
+    read(void* ptr, int64_t size) override;
+
+    void
+    readv(const std::vector<IORegion>& regions) override;
+
+    void
+    seekg(int64_t pos) override;
+
+    int64_t
+    length() override;
+
+    void
+    close() override;
+
+ private:
+    struct Chunk;
+
+    // throws when a read fails, returns false when the ring is unusable and nothing is in flight any more
+    bool
+    ReadByUring(std::vector<Chunk>& chunks);
+
+    void
+    WaitInflight(IOUring* ring, size_t& inflight);
+
+    // throws when a read fails
+    void
+    ReadByPool(std::vector<Chunk>& chunks);
+
+    bool
+    PreadChunk(Chunk& chunk);
+
+ public:
+    std::string name_;
+
+ private:
+    bool direct_io_ = false;
+    bool direct_opened_ = false;
+    int fd_ = -1;
+    int64_t length_ = 0;
+    int64_t pos_ = 0;
+};
+
+using DirectIOReaderPtr = std::shared_ptr<DirectIOReader>;
+
+}  // namespace storage
+}  // namespace milvus
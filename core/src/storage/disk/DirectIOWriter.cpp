@@ -0,0 +1,134 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+
+#include "storage/disk/DirectIOWriter.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+
+#include "storage/disk/DirectIOReader.h"
+#include "utils/Log.h"
+
+namespace milvus {
+namespace storage {
+
+namespace {
+
+constexpr int64_t DIRECT_IO_WRITE_BUFFER = 4 * DISK_IO_CHUNK_SIZE;
+
+}  // namespace
+
+DirectIOWriter::~DirectIOWriter() {
+    close();
+}
+
+bool
+DirectIOWriter::open(const std::string& name) {
+    close();
+    name_ = name;
+    len_ = 0;
+    flushed_ = 0;
+    buffer_size_ = 0;
+
+    direct_opened_ = false;
+    if (direct_io_) {
+        fd_ = ::open(name_.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_DIRECT, 0644);
+        direct_opened_ = fd_ >= 0;
+    }
+    if (fd_ < 0) {
+        fd_ = ::open(name_.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    }
+    if (fd_ < 0) {
+        return false;
+    }
+
+    if (buffer_ == nullptr) {
+        void* buffer = nullptr;
+        if (posix_memalign(&buffer, DIRECT_IO_ALIGNMENT, DIRECT_IO_WRITE_BUFFER) != 0) {
+            close();
+            return false;
+        }
+        buffer_ = std::shared_ptr<char>(static_cast<char*>(buffer), free);
+    }
+    return true;
+}
+
+void
+DirectIOWriter::write(void* ptr, int64_t size) {
+    if (fd_ < 0) {
+        return;
+    }
+
+    auto src = static_cast<char*>(ptr);
+    len_ += size;
+    while (size > 0) {
+        int64_t count = std::min(size, DIRECT_IO_WRITE_BUFFER - buffer_size_);
+        memcpy(buffer_.get() + buffer_size_, src, count);
+        buffer_size_ += count;
+        src += count;
+        size -= count;
+        if (buffer_size_ == DIRECT_IO_WRITE_BUFFER) {
+            Flush();
+        }
+    }
+}
+
+int64_t
+DirectIOWriter::length() {
+    return len_;
+}
+
+void
+DirectIOWriter::close() {
+    if (fd_ < 0) {
+        return;
+    }
+
+    // O_DIRECT only takes whole blocks, the unaligned tail goes through the page cache
+    if (direct_opened_ && buffer_size_ % DIRECT_IO_ALIGNMENT != 0) {
+        int flags = fcntl(fd_, F_GETFL);
+        if (flags < 0 || fcntl(fd_, F_SETFL, flags & ~O_DIRECT) != 0) {
+            LOG_STORAGE_ERROR_ << "Failed to clear O_DIRECT on " << name_ << ": " << strerror(errno);
+        }
+    }
+    Flush();
+
+    ::close(fd_);
+    fd_ = -1;
+}
+
+void
+DirectIOWriter::Flush() {
+    int64_t written = 0;
+    while (written < buffer_size_) {
+        ssize_t ret = pwrite(fd_, buffer_.get() + written, buffer_size_ - written, flushed_ + written);
+        if (ret < 0 && errno == EINTR) {
+            continue;
+        }
+        if (ret <= 0) {
+            LOG_STORAGE_ERROR_ << "Failed to write " << name_ << " at " << flushed_ + written << ": "
+                               << strerror(errno);
+            break;
+        }
+        written += ret;
+    }
+    flushed_ += written;
+    buffer_size_ = 0;
+}
+
+}  // namespace storage
+}  // namespace milvus
@@ -0,0 +1,72 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "storage/IOWriter.h"
+
+namespace milvus {
+namespace storage {
+
+// Writer collecting data in an aligned buffer and flushing it with large pwrite calls. With
+// direct_io the file is written with O_DIRECT, so segment writes do not evict the page cache.
+class DirectIOWriter : public IOWriter {
+ public:
+    explicit DirectIOWriter(bool direct_io = false) : direct_io_(direct_io) {
+    }
+    ~DirectIOWriter();
+
+    // No copy and move
+    DirectIOWriter(const DirectIOWriter&) = delete;
+    DirectIOWriter(DirectIOWriter&&) = delete;
+
+    DirectIOWriter&
+    operator=(const DirectIOWriter&) = delete;
+    DirectIOWriter&
+    operator=(DirectIOWriter&&) = delete;
+
+    bool
+    open(const std::string& name) override;
+
+    void
+    write(void* ptr, int64_t size) override;
+
+    int64_t
+    length() override;
+
+    void
+    close() override;
+
+ private:
+    void
+    Flush();
+
+ public:
+    std::string name_;
+    int64_t len_ = 0;
+
+ private:
+    bool direct_io_ = false;
+    bool direct_opened_ = false;
+    int fd_ = -1;
+    std::shared_ptr<char> buffer_;
+    int64_t buffer_size_ = 0;
+    int64_t flushed_ = 0;
+};
+
+using DirectIOWriterPtr = std::shared_ptr<DirectIOWriter>;
+
+}  // namespace storage
+}  // namespace milvus
@@ -0,0 +1,64 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+
+#include "storage/disk/DiskIOFactory.h"
+
+#include <memory>
+#include <mutex>
+
+#include "storage/disk/DirectIOReader.h"
+#include "storage/disk/DirectIOWriter.h"
+#include "storage/disk/DiskIOReader.h"
+#include "storage/disk/DiskIOWriter.h"
+
+namespace milvus {
+namespace storage {
+
+namespace {
+
+std::mutex options_mutex;
+DiskIOOptions disk_io_options;
+
+}  // namespace
+
+void
+SetDiskIOOptions(const DiskIOOptions& options) {
+    std::lock_guard<std::mutex> lock(options_mutex);
+    disk_io_options = options;
+}
+
+DiskIOOptions
+GetDiskIOOptions() {
+    std::lock_guard<std::mutex> lock(options_mutex);
+    return disk_io_options;
+}
+
+IOReaderPtr
+CreateDiskIOReader() {
+    auto options = GetDiskIOOptions();
+    if (options.engine_ == DiskIOEngine::URING) {
+        return std::make_shared<DirectIOReader>(options.direct_io_);
+    }
+    return std::make_shared<DiskIOReader>();
+}
+
+IOWriterPtr
+CreateDiskIOWriter() {
+    auto options = GetDiskIOOptions();
+    if (options.engine_ == DiskIOEngine::URING) {
+        return std::make_shared<DirectIOWriter>(options.direct_io_);
+    }
+    return std::make_shared<DiskIOWriter>();
+}
+
+}  // namespace storage
+}  // namespace milvus
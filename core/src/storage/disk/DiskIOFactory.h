@@ -0,0 +1,45 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+
+#pragma once
+
+#include "storage/IOReader.h"
+#include "storage/IOWriter.h"
+
+namespace milvus {
+namespace storage {
+
+enum class DiskIOEngine {
+    FSTREAM,
+    URING,
+};
+
+struct DiskIOOptions {
+    DiskIOEngine engine_ = DiskIOEngine::FSTREAM;
+    bool direct_io_ = false;
+};
+
+// process wide, set once from the storage config at startup
+void
+SetDiskIOOptions(const DiskIOOptions& options);
+
+DiskIOOptions
+GetDiskIOOptions();
+
+IOReaderPtr
+CreateDiskIOReader();
+
+IOWriterPtr
+CreateDiskIOWriter();
+
+}  // namespace storage
+}  // namespace milvus
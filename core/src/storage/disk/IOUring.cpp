@@ -0,0 +1,222 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+
+#include "storage/disk/IOUring.h"
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+namespace milvus {
+namespace storage {
+
+namespace {
+
+template <typename T>
+T*
+RingField(void* base, uint32_t offset) {
+    return reinterpret_cast<T*>(static_cast<char*>(base) + offset);
+}
+
+}  // namespace
+
+IOUring::~IOUring() {
+    Release();
+}
+
+#if defined(MILVUS_WITH_IO_URING)
+
+bool
+IOUring::Init(uint32_t entries) {
+#if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter)
+    Release();
+
+    io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    int fd = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+    if (fd < 0) {
+        return false;
+    }
+    ring_fd_ = fd;
+    sq_entries_ = params.sq_entries;
+
+    sq_size_ = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+    cq_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (single_mmap) {
+        sq_size_ = cq_size_ = std::max(sq_size_, cq_size_);
+    }
+
+    sq_ptr_ = mmap(nullptr, sq_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+    if (sq_ptr_ == MAP_FAILED) {
+        sq_ptr_ = nullptr;
+        Release();
+        return false;
+    }
+    if (single_mmap) {
+        cq_ptr_ = sq_ptr_;
+    } else {
+        cq_ptr_ = mmap(nullptr, cq_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+        if (cq_ptr_ == MAP_FAILED) {
+            cq_ptr_ = nullptr;
+            Release();
+            return false;
+        }
+    }
+
+    sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+    void* sqes = mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+    if (sqes == MAP_FAILED) {
+        Release();
+        return false;
+    }
+    sqes_ = sqes;
+
+    sq_head_ = RingField<uint32_t>(sq_ptr_, params.sq_off.head);
+    sq_ktail_ = RingField<uint32_t>(sq_ptr_, params.sq_off.tail);
+    sq_mask_ = RingField<uint32_t>(sq_ptr_, params.sq_off.ring_mask);
+    sq_array_ = RingField<uint32_t>(sq_ptr_, params.sq_off.array);
+    cq_head_ = RingField<uint32_t>(cq_ptr_, params.cq_off.head);
+    cq_tail_ = RingField<uint32_t>(cq_ptr_, params.cq_off.tail);
+    cq_mask_ = RingField<uint32_t>(cq_ptr_, params.cq_off.ring_mask);
+    cqes_ = RingField<io_uring_cqe>(cq_ptr_, params.cq_off.cqes);
+    sq_tail_ = *sq_ktail_;
+    to_submit_ = 0;
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool
+IOUring::PrepareReadv(int fd, const iovec* iov, int64_t offset, uint64_t user_data) {
+    uint32_t head = __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+    if (sq_tail_ - head >= sq_entries_) {
+        return false;
+    }
+
+    uint32_t index = sq_tail_ & *sq_mask_;
+    io_uring_sqe* sqe = static_cast<io_uring_sqe*>(sqes_) + index;
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = IORING_OP_READV;
+    sqe->fd = fd;
+    sqe->addr = reinterpret_cast<uint64_t>(iov);
+    sqe->len = 1;
+    sqe->off = static_cast<uint64_t>(offset);
+    sqe->user_data = user_data;
+    sq_array_[index] = index;
+
+    ++sq_tail_;
+    ++to_submit_;
+    __atomic_store_n(sq_ktail_, sq_tail_, __ATOMIC_RELEASE);
+    return true;
+}
+
+int
+IOUring::Submit(uint32_t wait_nr) {
+#if defined(__NR_io_uring_enter)
+    uint32_t flags = wait_nr > 0 ? IORING_ENTER_GETEVENTS : 0;
+    while (true) {
+        int ret = static_cast<int>(syscall(__NR_io_uring_enter, ring_fd_, to_submit_, wait_nr, flags, nullptr, 0));
+        if (ret >= 0) {
+            to_submit_ -= std::min<uint32_t>(to_submit_, ret);
+            return ret;
+        }
+        if (errno != EINTR) {
+            return -errno;
+        }
+    }
+#else
+    return -ENOSYS;
+#endif
+}
+
+bool
+IOUring::PopCompletion(uint64_t& user_data, int32_t& result) {
+    uint32_t head = *cq_head_;
+    if (head == __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE)) {
+        return false;
+    }
+    io_uring_cqe* cqe = static_cast<io_uring_cqe*>(cqes_) + (head & *cq_mask_);
+    user_data = cqe->user_data;
+    result = cqe->res;
+    __atomic_store_n(cq_head_, head + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+uint32_t
+IOUring::DiscardUnsubmitted() {
+    // without SQPOLL the kernel only reads the submission queue inside io_uring_enter
+    uint32_t head = __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+    uint32_t discarded = sq_tail_ - head;
+    sq_tail_ = head;
+    to_submit_ = 0;
+    __atomic_store_n(sq_ktail_, sq_tail_, __ATOMIC_RELEASE);
+    return discarded;
+}
+
+#else
+
+bool
+IOUring::Init(uint32_t entries) {
+    return false;
+}
+
+bool
+IOUring::PrepareReadv(int fd, const iovec* iov, int64_t offset, uint64_t user_data) {
+    return false;
+}
+
+int
+IOUring::Submit(uint32_t wait_nr) {
+    return -ENOSYS;
+}
+
+bool
+IOUring::PopCompletion(uint64_t& user_data, int32_t& result) {
+    return false;
+}
+
+uint32_t
+IOUring::DiscardUnsubmitted() {
+    return 0;
+}
+
+#endif
+
+void
+IOUring::Release() {
+    if (sqes_ != nullptr) {
+        munmap(sqes_, sqes_size_);
+        sqes_ = nullptr;
+    }
+    if (cq_ptr_ != nullptr && cq_ptr_ != sq_ptr_) {
+        munmap(cq_ptr_, cq_size_);
+    }
+    cq_ptr_ = nullptr;
+    if (sq_ptr_ != nullptr) {
+        munmap(sq_ptr_, sq_size_);
+        sq_ptr_ = nullptr;
+    }
+    if (ring_fd_ >= 0) {
+        ::close(ring_fd_);
+        ring_fd_ = -1;
+    }
+    sq_entries_ = 0;
+}
+
+}  // namespace storage
+}  // namespace milvus
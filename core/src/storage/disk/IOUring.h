@@ -0,0 +1,99 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+
+#pragma once
+
+#include <sys/uio.h>
+
+// linux/io_uring.h only ships with kernel headers 5.1 and later, older build hosts get a ring that never initializes
+#if defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#define MILVUS_WITH_IO_URING
+#endif
+#endif
+
+#include <cstdint>
+
+namespace milvus {
+namespace storage {
+
+// Minimal io_uring submission/completion ring driven through the raw syscalls, enough to
+// keep several reads in flight for one thread. Not thread safe.
+class IOUring {
+ public:
+    IOUring() = default;
+    ~IOUring();
+
+    IOUring(const IOUring&) = delete;
+    IOUring&
+    operator=(const IOUring&) = delete;
+
+    // false if the kernel or the build headers do not provide io_uring or it is not permitted
+    bool
+    Init(uint32_t entries);
+
+    bool
+    Initialized() const {
+        return ring_fd_ >= 0;
+    }
+
+    uint32_t
+    Depth() const {
+        return sq_entries_;
+    }
+
+    // queue a read into iov, which must stay valid until its completion is popped;
+    // returns false when the submission queue is full
+    bool
+    PrepareReadv(int fd, const iovec* iov, int64_t offset, uint64_t user_data);
+
+    // submit all queued entries and wait for at least wait_nr completions, returns -errno on failure
+    int
+    Submit(uint32_t wait_nr);
+
+    bool
+    PopCompletion(uint64_t& user_data, int32_t& result);
+
+    // takes back entries queued but not yet consumed by the kernel, returns how many
+    uint32_t
+    DiscardUnsubmitted();
+
+ private:
+    void
+    Release();
+
+ private:
+    int ring_fd_ = -1;
+    uint32_t sq_entries_ = 0;
+    uint32_t sq_tail_ = 0;
+    uint32_t to_submit_ = 0;
+
+    void* sq_ptr_ = nullptr;
+    size_t sq_size_ = 0;
+    void* cq_ptr_ = nullptr;
+    size_t cq_size_ = 0;
+    void* sqes_ = nullptr;  // io_uring_sqe array
+    size_t sqes_size_ = 0;
+
+    uint32_t* sq_head_ = nullptr;
+    uint32_t* sq_ktail_ = nullptr;
+    uint32_t* sq_mask_ = nullptr;
+    uint32_t* sq_array_ = nullptr;
+    uint32_t* cq_head_ = nullptr;
+    uint32_t* cq_tail_ = nullptr;
+    uint32_t* cq_mask_ = nullptr;
+    void* cqes_ = nullptr;  // io_uring_cqe array
+};
+
+}  // namespace storage
+}  // namespace milvus
@@ -0,0 +1,205 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+
+#include "storage/s3/S3BlockCache.h"
+
+#include <boost/filesystem.hpp>
+#include <atomic>
+#include <cctype>
+#include <fstream>
+#include <sstream>
+
+#include "utils/Log.h"
+
+namespace milvus {
+namespace storage {
+
+namespace {
+
+std::atomic<uint64_t> tmp_file_count{0};
+
+std::string
+BlockId(const std::string& object_key, const std::string& etag, int64_t block) {
+    return object_key + "#" + etag + "#" + std::to_string(block);
+}
+
+}  // namespace
+
+void
+S3BlockCache::Init(const std::string& path, int64_t capacity) {
+    Clear();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    path_ = path;
+    capacity_ = capacity;
+    if (capacity_ <= 0) {
+        return;
+    }
+
+    // blocks left by a previous run are not indexed, start from an empty directory
+    boost::system::error_code err;
+    boost::filesystem::remove_all(path_, err);
+    boost::filesystem::create_directories(path_, err);
+    if (err) {
+        LOG_STORAGE_ERROR_ << "Failed to create s3 block cache directory " << path_ << ": " << err.message();
+        capacity_ = 0;
+        return;
+    }
+    LOG_STORAGE_INFO_ << "S3 block cache at " << path_ << ", capacity " << (capacity_ >> 20) << "MB";
+}
+
+bool
+S3BlockCache::Enabled() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return capacity_ > 0;
+}
+
+bool
+S3BlockCache::GetBlock(const std::string& object_key, const std::string& etag, int64_t block, std::string& data) {
+    std::string file_path;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto iter = blocks_.find(BlockId(object_key, etag, block));
+        if (iter == blocks_.end()) {
+            return false;
+        }
+        lru_.splice(lru_.begin(), lru_, iter->second);
+        file_path = BlockPath(iter->second->first);
+    }
+
+    // the block may be evicted meanwhile, a failed read is treated as a miss
+    std::ifstream fs(file_path, std::ios::in | std::ios::binary);
+    if (!fs.good()) {
+        return false;
+    }
+    std::stringstream ss;
+    ss << fs.rdbuf();
+    data = ss.str();
+    return true;
+}
+
+void
+S3BlockCache::PutBlock(const std::string& object_key, const std::string& etag, int64_t block,
+                       const std::string& data) {
+    auto size = static_cast<int64_t>(data.size());
+    BlockKey key{object_key, etag, block};
+    auto block_id = BlockId(object_key, etag, block);
+    std::string file_path;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (size > capacity_ || blocks_.find(block_id) != blocks_.end()) {
+            return;
+        }
+        file_path = BlockPath(key);
+    }
+
+    // write aside and rename, so readers never see a partial block
+    std::string tmp_path = file_path + ".tmp" + std::to_string(tmp_file_count++);
+    {
+        std::ofstream fs(tmp_path, std::ios::out | std::ios::binary | std::ios::trunc);
+        fs.write(data.data(), size);
+        if (!fs.good()) {
+            LOG_STORAGE_WARNING_ << "Failed to write s3 block cache file " << tmp_path;
+            boost::system::error_code err;
+            boost::filesystem::remove(tmp_path, err);
+            return;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    boost::system::error_code err;
+    if (capacity_ <= 0 || blocks_.find(block_id) != blocks_.end()) {
+        boost::filesystem::remove(tmp_path, err);
+        return;
+    }
+    boost::filesystem::rename(tmp_path, file_path, err);
+    if (err) {
+        boost::filesystem::remove(tmp_path, err);
+        return;
+    }
+
+    lru_.emplace_front(std::move(key), size);
+    blocks_[block_id] = lru_.begin();
+    usage_ += size;
+    while (usage_ > capacity_ && !lru_.empty()) {
+        EraseInternal(std::prev(lru_.end()));
+    }
+}
+
+void
+S3BlockCache::Erase(const std::string& object_key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto iter = lru_.begin(); iter != lru_.end();) {
+        auto cur = iter++;
+        if (cur->first.object_key_ == object_key) {
+            EraseInternal(cur);
+        }
+    }
+}
+
+void
+S3BlockCache::Clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    while (!lru_.empty()) {
+        EraseInternal(lru_.begin());
+    }
+}
+
+int64_t
+S3BlockCache::usage() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return usage_;
+}
+
+int64_t
+S3BlockCache::capacity() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return capacity_;
+}
+
+std::string
+S3BlockCache::BlockPath(const BlockKey& key) const {
+    // object keys are paths, flatten them into a single file name
+    std::string name;
+    name.reserve(key.object_key_.size() + key.etag_.size() + 16);
+    for (char c : key.object_key_) {
+        if (c == '/') {
+            name += "%2F";
+        } else if (c == '%') {
+            name += "%25";
+        } else {
+            name += c;
+        }
+    }
+
+    // etags are quoted hex digests, optionally with a part count, keep only the safe characters
+    name += ".";
+    for (char c : key.etag_) {
+        if (std::isalnum(static_cast<unsigned char>(c)) || c == '-') {
+            name += c;
+        }
+    }
+    return path_ + "/" + name + "." + std::to_string(key.block_);
+}
+
+void
+S3BlockCache::EraseInternal(BlockList::iterator iter) {
+    const BlockKey& key = iter->first;
+    boost::system::error_code err;
+    boost::filesystem::remove(BlockPath(key), err);
+    usage_ -= iter->second;
+    blocks_.erase(BlockId(key.object_key_, key.etag_, key.block_));
+    lru_.erase(iter);
+}
+
+}  // namespace storage
+}  // namespace milvus
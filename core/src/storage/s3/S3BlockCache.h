@@ -0,0 +1,89 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+
+#pragma once
+
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace milvus {
+namespace storage {
+
+// S3 objects are fetched and cached in blocks of this size
+constexpr int64_t S3_BLOCK_SIZE = 4 * 1024 * 1024;
+
+// Bounded local disk cache of S3 object blocks, evicted in LRU order. Blocks are keyed by the
+// object ETag, so a rewritten object never serves blocks of its previous content.
+class S3BlockCache {
+ public:
+    static S3BlockCache&
+    GetInstance() {
+        static S3BlockCache cache;
+        return cache;
+    }
+
+    // capacity in bytes, 0 disables the cache
+    void
+    Init(const std::string& path, int64_t capacity);
+
+    bool
+    Enabled();
+
+    bool
+    GetBlock(const std::string& object_key, const std::string& etag, int64_t block, std::string& data);
+
+    void
+    PutBlock(const std::string& object_key, const std::string& etag, int64_t block, const std::string& data);
+
+    // drop every cached block of every version of an object, called when it is overwritten or deleted
+    void
+    Erase(const std::string& object_key);
+
+    void
+    Clear();
+
+    int64_t
+    usage();
+
+    int64_t
+    capacity();
+
+ private:
+    struct BlockKey {
+        std::string object_key_;
+        std::string etag_;
+        int64_t block_ = 0;
+    };
+    using BlockList = std::list<std::pair<BlockKey, int64_t>>;
+
+    std::string
+    BlockPath(const BlockKey& key) const;
+
+    void
+    EraseInternal(BlockList::iterator iter);
+
+ private:
+    std::mutex mutex_;
+    std::string path_;
+    int64_t capacity_ = 0;
+    int64_t usage_ = 0;
+
+    // most recently used first, each entry holds the block key and its size
+    BlockList lru_;
+    std::unordered_map<std::string, BlockList::iterator> blocks_;
+};
+
+}  // namespace storage
+}  // namespace milvus
@@ -9,7 +9,10 @@
 // is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
+#include <algorithm>
+#include <cstdio>
 #include <memory>
+#include <mutex>
 #include <utility>
 
 #include <aws/core/Aws.h>
@@ -18,11 +21,16 @@
 #include <aws/core/utils/Outcome.h>
 #include <aws/core/utils/StringUtils.h>
 #include <aws/s3/S3Client.h>
+#include <aws/s3/model/AbortMultipartUploadRequest.h>
+#include <aws/s3/model/CompleteMultipartUploadRequest.h>
 #include <aws/s3/model/CreateBucketRequest.h>
+#include <aws/s3/model/CreateMultipartUploadRequest.h>
 #include <aws/s3/model/DeleteBucketRequest.h>
 #include <aws/s3/model/DeleteObjectRequest.h>
 #include <aws/s3/model/GetObjectRequest.h>
+#include <aws/s3/model/HeadObjectRequest.h>
 #include <aws/s3/model/PutObjectRequest.h>
+#include <aws/s3/model/UploadPartRequest.h>
 
 namespace milvus {
 namespace storage {
@@ -54,7 +62,9 @@ class S3ClientMock : public Aws::S3::S3Client {
     PutObject(const Aws::S3::Model::PutObjectRequest& request) const override {
         Aws::String key = request.GetKey();
         std::shared_ptr<Aws::IOStream> body = request.GetBody();
+        std::lock_guard<std::mutex> lock(mutex_);
         aws_map_[key] = body;
+        NewETag(key);
 
         Aws::S3::Model::PutObjectResult result;
         return Aws::S3::Model::PutObjectOutcome(std::move(result));
@@ -66,8 +76,19 @@ class S3ClientMock : public Aws::S3::S3Client {
         Aws::Utils::Stream::ResponseStream resp_stream(factory);
 
         try {
-            std::shared_ptr<Aws::IOStream> body = aws_map_.at(request.GetKey());
-            Aws::String body_str((Aws::IStreamBufIterator(*body)), Aws::IStreamBufIterator());
+            if (request.IfMatchHasBeenSet() && request.GetIfMatch() != ReadETag(request.GetKey())) {
+                return Aws::S3::Model::GetObjectOutcome();
+            }
+            Aws::String body_str = ReadBody(request.GetKey());
+            if (request.RangeHasBeenSet()) {
+                long long first = 0, last = 0;
+                if (sscanf(request.GetRange().c_str(), "bytes=%lld-%lld", &first, &last) != 2 || first > last ||
+                    first >= static_cast<long long>(body_str.length())) {
+                    return Aws::S3::Model::GetObjectOutcome();
+                }
+                last = std::min<long long>(last, body_str.length() - 1);
+                body_str = body_str.substr(first, last - first + 1);
+            }
 
             resp_stream.GetUnderlyingStream().write(body_str.c_str(), body_str.length());
             resp_stream.GetUnderlyingStream().flush();
@@ -81,6 +102,79 @@ class S3ClientMock : public Aws::S3::S3Client {
         }
     }
 
+    Aws::S3::Model::HeadObjectOutcome
+    HeadObject(const Aws::S3::Model::HeadObjectRequest& request) const override {
+        try {
+            Aws::S3::Model::HeadObjectResult result;
+            result.SetContentLength(ReadBody(request.GetKey()).length());
+            result.SetETag(ReadETag(request.GetKey()));
+            return Aws::S3::Model::HeadObjectOutcome(std::move(result));
+        } catch (...) {
+            return Aws::S3::Model::HeadObjectOutcome();
+        }
+    }
+
+    Aws::S3::Model::CreateMultipartUploadOutcome
+    CreateMultipartUpload(const Aws::S3::Model::CreateMultipartUploadRequest& request) const override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Aws::String upload_id = request.GetKey() + "#" + Aws::Utils::StringUtils::to_string(++upload_count_);
+        uploads_[upload_id].clear();
+
+        Aws::S3::Model::CreateMultipartUploadResult result;
+        result.SetUploadId(upload_id);
+        return Aws::S3::Model::CreateMultipartUploadOutcome(std::move(result));
+    }
+
+    Aws::S3::Model::UploadPartOutcome
+    UploadPart(const Aws::S3::Model::UploadPartRequest& request) const override {
+        std::shared_ptr<Aws::IOStream> body = request.GetBody();
+        Aws::String part((Aws::IStreamBufIterator(*body)), Aws::IStreamBufIterator());
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto iter = uploads_.find(request.GetUploadId());
+        if (iter == uploads_.end()) {
+            return Aws::S3::Model::UploadPartOutcome();
+        }
+        iter->second[request.GetPartNumber()] = std::move(part);
+
+        Aws::S3::Model::UploadPartResult result;
+        result.SetETag(Aws::Utils::StringUtils::to_string(request.GetPartNumber()));
+        return Aws::S3::Model::UploadPartOutcome(std::move(result));
+    }
+
+    Aws::S3::Model::CompleteMultipartUploadOutcome
+    CompleteMultipartUpload(const Aws::S3::Model::CompleteMultipartUploadRequest& request) const override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto iter = uploads_.find(request.GetUploadId());
+        if (iter == uploads_.end()) {
+            return Aws::S3::Model::CompleteMultipartUploadOutcome();
+        }
+
+        auto body = Aws::MakeShared<Aws::StringStream>("");
+        for (auto& completed : request.GetMultipartUpload().GetParts()) {
+            auto part = iter->second.find(completed.GetPartNumber());
+            if (part == iter->second.end()) {
+                return Aws::S3::Model::CompleteMultipartUploadOutcome();
+            }
+            body->write(part->second.data(), part->second.length());
+        }
+        aws_map_[request.GetKey()] = body;
+        NewETag(request.GetKey());
+        uploads_.erase(iter);
+
+        Aws::S3::Model::CompleteMultipartUploadResult result;
+        return Aws::S3::Model::CompleteMultipartUploadOutcome(std::move(result));
+    }
+
+    Aws::S3::Model::AbortMultipartUploadOutcome
+    AbortMultipartUpload(const Aws::S3::Model::AbortMultipartUploadRequest& request) const override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        uploads_.erase(request.GetUploadId());
+
+        Aws::S3::Model::AbortMultipartUploadResult result;
+        return Aws::S3::Model::AbortMultipartUploadOutcome(std::move(result));
+    }
+
     Aws::S3::Model::ListObjectsOutcome
     ListObjects(const Aws::S3::Model::ListObjectsRequest& request) const override {
         /* TODO: add object key list into ListObjectsOutcome */
@@ -92,13 +186,42 @@ class S3ClientMock : public Aws::S3::S3Client {
     Aws::S3::Model::DeleteObjectOutcome
     DeleteObject(const Aws::S3::Model::DeleteObjectRequest& request) const override {
         Aws::String key = request.GetKey();
+        std::lock_guard<std::mutex> lock(mutex_);
         aws_map_.erase(key);
+        etags_.erase(key);
         Aws::S3::Model::DeleteObjectResult result;
         Aws::S3::Model::DeleteObjectOutcome(std::move(result));
         return result;
     }
 
+    Aws::String
+    ReadBody(const Aws::String& key) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::shared_ptr<Aws::IOStream> body = aws_map_.at(key);
+        body->clear();
+        body->seekg(0);
+        return Aws::String((Aws::IStreamBufIterator(*body)), Aws::IStreamBufIterator());
+    }
+
+    Aws::String
+    ReadETag(const Aws::String& key) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return etags_.at(key);
+    }
+
+    // every write gets a distinct etag, like a real content digest would, caller holds mutex_
+    void
+    NewETag(const Aws::String& key) const {
+        etags_[key] = "\"" + Aws::Utils::StringUtils::to_string(++version_count_) + "\"";
+    }
+
     mutable Aws::Map<Aws::String, std::shared_ptr<Aws::IOStream>> aws_map_;
+    mutable Aws::Map<Aws::String, Aws::String> etags_;
+    mutable int64_t version_count_ = 0;
+    // parts of uploads not yet completed, by upload id and part number
+    mutable Aws::Map<Aws::String, Aws::Map<int, Aws::String>> uploads_;
+    mutable int64_t upload_count_ = 0;
+    mutable std::mutex mutex_;
 };
 
 }  // namespace storage
@@ -10,12 +10,19 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include <aws/core/auth/AWSCredentialsProvider.h>
+#include <aws/s3/model/AbortMultipartUploadRequest.h>
+#include <aws/s3/model/CompleteMultipartUploadRequest.h>
+#include <aws/s3/model/CompletedMultipartUpload.h>
+#include <aws/s3/model/CompletedPart.h>
+#include <aws/s3/model/CreateMultipartUploadRequest.h>
 #include <aws/s3/model/CreateBucketRequest.h>
 #include <aws/s3/model/DeleteBucketRequest.h>
 #include <aws/s3/model/DeleteObjectRequest.h>
 #include <aws/s3/model/GetObjectRequest.h>
+#include <aws/s3/model/HeadObjectRequest.h>
 #include <aws/s3/model/ListObjectsRequest.h>
 #include <aws/s3/model/PutObjectRequest.h>
+#include <aws/s3/model/UploadPartRequest.h>
 #include <fiu-local.h>
 #include <fstream>
 #include <iostream>
@@ -23,6 +30,7 @@
 #include <utility>
 
 #include "config/Config.h"
+#include "storage/s3/S3BlockCache.h"
 #include "storage/s3/S3ClientMock.h"
 #include "storage/s3/S3ClientWrapper.h"
 #include "utils/Error.h"
@@ -48,6 +56,12 @@ S3ClientWrapper::StartService() {
     CONFIG_CHECK(config.GetStorageConfigS3SecretKey(s3_secret_key_));
     CONFIG_CHECK(config.GetStorageConfigS3Bucket(s3_bucket_));
 
+    std::string storage_path;
+    int64_t cache_capacity = 0;
+    CONFIG_CHECK(config.GetStorageConfigPath(storage_path));
+    CONFIG_CHECK(config.GetStorageConfigS3CacheCapacity(cache_capacity));
+    S3BlockCache::GetInstance().Init(storage_path + "/s3_cache", cache_capacity);
+
     Aws::InitAPI(options_);
 
     Aws::Client::ClientConfiguration cfg;
@@ -72,6 +86,7 @@ S3ClientWrapper::StartService() {
 
 void
 S3ClientWrapper::StopService() {
+    S3BlockCache::GetInstance().Clear();
     client_ptr_ = nullptr;
     Aws::ShutdownAPI(options_);
 }
@@ -123,6 +138,8 @@ S3ClientWrapper::PutObjectFile(const std::string& object_name, const std::string
         return Status(SERVER_UNEXPECTED_ERROR, str);
     }
 
+    S3BlockCache::GetInstance().Erase(object_name);
+
     Aws::S3::Model::PutObjectRequest request;
     request.WithBucket(s3_bucket_).WithKey(object_name);
 
@@ -145,6 +162,8 @@ S3ClientWrapper::PutObjectFile(const std::string& object_name, const std::string
 
 Status
 S3ClientWrapper::PutObjectStr(const std::string& object_name, const std::string& content) {
+    S3BlockCache::GetInstance().Erase(object_name);
+
     Aws::S3::Model::PutObjectRequest request;
     request.WithBucket(s3_bucket_).WithKey(object_name);
 
@@ -211,6 +230,156 @@ S3ClientWrapper::GetObjectStr(const std::string& object_name, std::string& conte
     return Status::OK();
 }
 
+Status
+S3ClientWrapper::GetObjectRange(const std::string& object_name, int64_t offset, int64_t size, std::string& content,
+                                const std::string& etag) {
+    if (size <= 0) {
+        content.clear();
+        return Status::OK();
+    }
+
+    Aws::S3::Model::GetObjectRequest request;
+    request.WithBucket(s3_bucket_)
+        .WithKey(object_name)
+        .WithRange("bytes=" + std::to_string(offset) + "-" + std::to_string(offset + size - 1));
+    if (!etag.empty()) {
+        request.WithIfMatch(etag);
+    }
+
+    auto outcome = client_ptr_->GetObject(request);
+
+    fiu_do_on("S3ClientWrapper.GetObjectRange.outcome.fail", outcome = Aws::S3::Model::GetObjectOutcome());
+    if (!outcome.IsSuccess()) {
+        auto err = outcome.GetError();
+        LOG_STORAGE_ERROR_ << "ERROR: GetObject: " << err.GetExceptionName() << ": " << err.GetMessage();
+        return Status(SERVER_UNEXPECTED_ERROR, err.GetMessage());
+    }
+
+    auto& retrieved_file = outcome.GetResultWithOwnership().GetBody();
+    content.resize(size);
+    retrieved_file.read(&content[0], size);
+    content.resize(retrieved_file.gcount());
+
+    LOG_STORAGE_TRACE_ << "GetObjectRange '" << object_name << "' [" << offset << ", " << offset + size
+                       << ") successfully!";
+    return Status::OK();
+}
+
+Status
+S3ClientWrapper::GetObjectMeta(const std::string& object_name, int64_t& length, std::string& etag) {
+    Aws::S3::Model::HeadObjectRequest request;
+    request.WithBucket(s3_bucket_).WithKey(object_name);
+
+    auto outcome = client_ptr_->HeadObject(request);
+
+    fiu_do_on("S3ClientWrapper.GetObjectMeta.outcome.fail", outcome = Aws::S3::Model::HeadObjectOutcome());
+    if (!outcome.IsSuccess()) {
+        auto err = outcome.GetError();
+        LOG_STORAGE_ERROR_ << "ERROR: HeadObject: " << err.GetExceptionName() << ": " << err.GetMessage();
+        return Status(SERVER_UNEXPECTED_ERROR, err.GetMessage());
+    }
+
+    length = outcome.GetResult().GetContentLength();
+    etag = outcome.GetResult().GetETag();
+    return Status::OK();
+}
+
+Status
+S3ClientWrapper::CreateMultipartUpload(const std::string& object_name, std::string& upload_id) {
+    Aws::S3::Model::CreateMultipartUploadRequest request;
+    request.WithBucket(s3_bucket_).WithKey(object_name);
+
+    auto outcome = client_ptr_->CreateMultipartUpload(request);
+
+    fiu_do_on("S3ClientWrapper.CreateMultipartUpload.outcome.fail",
+              outcome = Aws::S3::Model::CreateMultipartUploadOutcome());
+    if (!outcome.IsSuccess()) {
+        auto err = outcome.GetError();
+        LOG_STORAGE_ERROR_ << "ERROR: CreateMultipartUpload: " << err.GetExceptionName() << ": " << err.GetMessage();
+        return Status(SERVER_UNEXPECTED_ERROR, err.GetMessage());
+    }
+
+    upload_id = outcome.GetResult().GetUploadId();
+    LOG_STORAGE_DEBUG_ << "CreateMultipartUpload '" << object_name << "' successfully!";
+    return Status::OK();
+}
+
+Status
+S3ClientWrapper::UploadPart(const std::string& object_name, const std::string& upload_id, int32_t part_number,
+                            const std::string& content, std::string& etag) {
+    Aws::S3::Model::UploadPartRequest request;
+    request.WithBucket(s3_bucket_)
+        .WithKey(object_name)
+        .WithUploadId(upload_id)
+        .WithPartNumber(part_number)
+        .WithContentLength(content.length());
+
+    const std::shared_ptr<Aws::IOStream> input_data = Aws::MakeShared<Aws::StringStream>("");
+    input_data->write(content.data(), content.length());
+    request.SetBody(input_data);
+
+    auto outcome = client_ptr_->UploadPart(request);
+
+    fiu_do_on("S3ClientWrapper.UploadPart.outcome.fail", outcome = Aws::S3::Model::UploadPartOutcome());
+    if (!outcome.IsSuccess()) {
+        auto err = outcome.GetError();
+        LOG_STORAGE_ERROR_ << "ERROR: UploadPart: " << err.GetExceptionName() << ": " << err.GetMessage();
+        return Status(SERVER_UNEXPECTED_ERROR, err.GetMessage());
+    }
+
+    etag = outcome.GetResult().GetETag();
+    LOG_STORAGE_TRACE_ << "UploadPart '" << object_name << "' part " << part_number << " successfully!";
+    return Status::OK();
+}
+
+Status
+S3ClientWrapper::CompleteMultipartUpload(const std::string& object_name, const std::string& upload_id,
+                                         const std::vector<std::string>& etags) {
+    S3BlockCache::GetInstance().Erase(object_name);
+
+    Aws::S3::Model::CompletedMultipartUpload upload;
+    for (size_t i = 0; i < etags.size(); ++i) {
+        upload.AddParts(Aws::S3::Model::CompletedPart().WithETag(etags[i]).WithPartNumber(i + 1));
+    }
+
+    Aws::S3::Model::CompleteMultipartUploadRequest request;
+    request.WithBucket(s3_bucket_).WithKey(object_name).WithUploadId(upload_id).WithMultipartUpload(upload);
+
+    auto outcome = client_ptr_->CompleteMultipartUpload(request);
+
+    fiu_do_on("S3ClientWrapper.CompleteMultipartUpload.outcome.fail",
+              outcome = Aws::S3::Model::CompleteMultipartUploadOutcome());
+    if (!outcome.IsSuccess()) {
+        auto err = outcome.GetError();
+        LOG_STORAGE_ERROR_ << "ERROR: CompleteMultipartUpload: " << err.GetExceptionName() << ": "
+                           << err.GetMessage();
+        return Status(SERVER_UNEXPECTED_ERROR, err.GetMessage());
+    }
+
+    LOG_STORAGE_DEBUG_ << "CompleteMultipartUpload '" << object_name << "' with " << etags.size()
+                       << " parts successfully!";
+    return Status::OK();
+}
+
+Status
+S3ClientWrapper::AbortMultipartUpload(const std::string& object_name, const std::string& upload_id) {
+    Aws::S3::Model::AbortMultipartUploadRequest request;
+    request.WithBucket(s3_bucket_).WithKey(object_name).WithUploadId(upload_id);
+
+    auto outcome = client_ptr_->AbortMultipartUpload(request);
+
+    fiu_do_on("S3ClientWrapper.AbortMultipartUpload.outcome.fail",
+              outcome = Aws::S3::Model::AbortMultipartUploadOutcome());
+    if (!outcome.IsSuccess()) {
+        auto err = outcome.GetError();
+        LOG_STORAGE_ERROR_ << "ERROR: AbortMultipartUpload: " << err.GetExceptionName() << ": " << err.GetMessage();
+        return Status(SERVER_UNEXPECTED_ERROR, err.GetMessage());
+    }
+
+    LOG_STORAGE_DEBUG_ << "AbortMultipartUpload '" << object_name << "' successfully!";
+    return Status::OK();
+}
+
 Status
 S3ClientWrapper::ListObjects(std::vector<std::string>& object_list, const std::string& marker) {
     Aws::S3::Model::ListObjectsRequest request;
@@ -245,6 +414,8 @@ S3ClientWrapper::ListObjects(std::vector<std::string>& object_list, const std::s
 
 Status
 S3ClientWrapper::DeleteObject(const std::string& object_name) {
+    S3BlockCache::GetInstance().Erase(object_name);
+
     Aws::S3::Model::DeleteObjectRequest request;
     request.WithBucket(s3_bucket_).WithKey(object_name);
 
@@ -47,6 +47,22 @@ class S3ClientWrapper {
     GetObjectFile(const std::string& object_key, const std::string& file_path);
     Status
     GetObjectStr(const std::string& object_key, std::string& content);
+    // a non-empty etag makes the read fail if the object was rewritten since it was taken
+    Status
+    GetObjectRange(const std::string& object_key, int64_t offset, int64_t size, std::string& content,
+                   const std::string& etag = "");
+    Status
+    GetObjectMeta(const std::string& object_key, int64_t& length, std::string& etag);
+    Status
+    CreateMultipartUpload(const std::string& object_key, std::string& upload_id);
+    Status
+    UploadPart(const std::string& object_key, const std::string& upload_id, int32_t part_number,
+               const std::string& content, std::string& etag);
+    Status
+    CompleteMultipartUpload(const std::string& object_key, const std::string& upload_id,
+                            const std::vector<std::string>& etags);
+    Status
+    AbortMultipartUpload(const std::string& object_key, const std::string& upload_id);
     Status
     ListObjects(std::vector<std::string>& object_list, const std::string& marker = "");
     Status
@@ -10,21 +10,82 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include "storage/s3/S3IOReader.h"
+
+#include <algorithm>
+#include <cstring>
+#include <future>
+
+#include "storage/s3/S3BlockCache.h"
 #include "storage/s3/S3ClientWrapper.h"
+#include "utils/Exception.h"
+#include "utils/Log.h"
+#include "utils/ThreadPool.h"
 
 namespace milvus {
 namespace storage {
 
+namespace {
+
+constexpr int64_t S3_FETCH_PARALLELISM = 8;
+
+ThreadPool&
+FetchPool() {
+    static ThreadPool pool(S3_FETCH_PARALLELISM);
+    return pool;
+}
+
+}  // namespace
+
 bool
 S3IOReader::open(const std::string& name) {
     name_ = name;
     pos_ = 0;
-    return (S3ClientWrapper::GetInstance().GetObjectStr(name_, buffer_).ok());
+    length_ = 0;
+    etag_.clear();
+
+    // the etag pins every later read to the version seen here
+    return S3ClientWrapper::GetInstance().GetObjectMeta(name_, length_, etag_).ok();
 }
 
 void
 S3IOReader::read(void* ptr, int64_t size) {
-    memcpy(ptr, buffer_.data() + pos_, size);
+    int64_t begin = pos_;
+    int64_t end = std::min(pos_ + size, length_);
+    if (begin >= end) {
+        return;
+    }
+
+    // cached parts cover whole blocks, otherwise only the requested bytes are fetched
+    bool whole_block = S3BlockCache::GetInstance().Enabled();
+    std::vector<Part> parts;
+    for (int64_t block = begin / S3_BLOCK_SIZE; block <= (end - 1) / S3_BLOCK_SIZE; ++block) {
+        Part part;
+        part.block_ = block;
+        if (whole_block) {
+            part.offset_ = block * S3_BLOCK_SIZE;
+            part.size_ = std::min(S3_BLOCK_SIZE, length_ - part.offset_);
+        } else {
+            part.offset_ = std::max(begin, block * S3_BLOCK_SIZE);
+            part.size_ = std::min((block + 1) * S3_BLOCK_SIZE, end) - part.offset_;
+        }
+        parts.emplace_back(std::move(part));
+    }
+    auto status = FetchParts(parts);
+    if (!status.ok()) {
+        std::string err_msg = "Failed to read " + name_ + " at " + std::to_string(begin) + ": " + status.message();
+        LOG_STORAGE_ERROR_ << err_msg;
+        throw Exception(status.code(), err_msg);
+    }
+
+    auto dst = static_cast<char*>(ptr);
+    for (auto& part : parts) {
+        int64_t from = std::max(begin, part.offset_);
+        int64_t to = std::min(end, part.offset_ + static_cast<int64_t>(part.data_.size()));
+        if (from < to) {
+            memcpy(dst + (from - begin), part.data_.data() + (from - part.offset_), to - from);
+        }
+    }
+    pos_ = end;
 }
 
 void
@@ -34,12 +95,60 @@ S3IOReader::seekg(int64_t pos) {
 
 int64_t
 S3IOReader::length() {
-    return buffer_.length();
+    return length_;
 }
 
 void
 S3IOReader::close() {
 }
 
+Status
+S3IOReader::FetchParts(std::vector<Part>& parts) {
+    auto& cache = S3BlockCache::GetInstance();
+    auto& client = S3ClientWrapper::GetInstance();
+    auto fetch = [&](Part& part) {
+        bool whole_block = (part.offset_ == part.block_ * S3_BLOCK_SIZE) &&
+                           (part.size_ == std::min(S3_BLOCK_SIZE, length_ - part.offset_));
+        if (whole_block && cache.GetBlock(name_, etag_, part.block_, part.data_) &&
+            static_cast<int64_t>(part.data_.size()) == part.size_) {
+            return;
+        }
+
+        part.status_ = client.GetObjectRange(name_, part.offset_, part.size_, part.data_, etag_);
+        if (part.status_.ok() && static_cast<int64_t>(part.data_.size()) != part.size_) {
+            std::string msg =
+                "got " + std::to_string(part.data_.size()) + " of " + std::to_string(part.size_) + " bytes";
+            part.status_ = Status(SERVER_UNEXPECTED_ERROR, msg);
+        }
+        if (!part.status_.ok()) {
+            part.data_.clear();
+            return;
+        }
+        if (whole_block) {
+            cache.PutBlock(name_, etag_, part.block_, part.data_);
+        }
+    };
+
+    if (parts.size() == 1) {
+        fetch(parts[0]);
+        return parts[0].status_;
+    }
+
+    std::vector<std::future<void>> results;
+    results.reserve(parts.size());
+    for (auto& part : parts) {
+        results.emplace_back(FetchPool().enqueue(fetch, std::ref(part)));
+    }
+    for (auto& result : results) {
+        result.wait();
+    }
+    for (auto& part : parts) {
+        if (!part.status_.ok()) {
+            return part.status_;
+        }
+    }
+    return Status::OK();
+}
+
 }  // namespace storage
 }  // namespace milvus
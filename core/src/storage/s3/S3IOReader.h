@@ -13,7 +13,10 @@
 
 #include <memory>
 #include <string>
+#include <vector>
+
 #include "storage/IOReader.h"
+#include "utils/Status.h"
 
 namespace milvus {
 namespace storage {
@@ -35,6 +38,7 @@ class S3IOReader : public IOReader {
     bool
     open(const std::string& name) override;
 
+    // throws Exception if any part of the range cannot be fetched
     void
     read(void* ptr, int64_t size) override;
 
@@ -47,10 +51,24 @@ class S3IOReader : public IOReader {
     void
     close() override;
 
+ private:
+    struct Part {
+        int64_t block_ = 0;
+        int64_t offset_ = 0;
+        int64_t size_ = 0;
+        std::string data_;
+        Status status_;
+    };
+
+    // fill every part from the block cache or with ranged GETs issued in parallel
+    Status
+    FetchParts(std::vector<Part>& parts);
+
  public:
     std::string name_;
-    std::string buffer_;
-    int64_t pos_;
+    std::string etag_;
+    int64_t length_ = 0;
+    int64_t pos_ = 0;
 };
 
 using S3IOReaderPtr = std::shared_ptr<S3IOReader>;
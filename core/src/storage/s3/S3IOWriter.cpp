@@ -10,23 +10,68 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include "storage/s3/S3IOWriter.h"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <utility>
+
 #include "storage/s3/S3ClientWrapper.h"
+#include "utils/Exception.h"
+#include "utils/Log.h"
+#include "utils/ThreadPool.h"
 
 namespace milvus {
 namespace storage {
 
+namespace {
+
+// parts besides the last one must be at least 5MB
+constexpr int64_t S3_PART_SIZE = 8 * 1024 * 1024;
+constexpr int64_t S3_MAX_INFLIGHT_PARTS = 4;
+constexpr int64_t S3_UPLOAD_PARALLELISM = 8;
+constexpr int64_t S3_PART_RETRY_TIMES = 3;
+
+ThreadPool&
+UploadPool() {
+    static ThreadPool pool(S3_UPLOAD_PARALLELISM);
+    return pool;
+}
+
+}  // namespace
+
+S3IOWriter::~S3IOWriter() {
+    // an upload left open by a writer that was never closed
+    if (!upload_id_.empty()) {
+        AbortUpload();
+    }
+}
+
 bool
 S3IOWriter::open(const std::string& name) {
+    AbortUpload();
     name_ = name;
     len_ = 0;
     buffer_ = "";
+    buffer_.reserve(S3_PART_SIZE);
+    status_ = Status::OK();
+    etags_.clear();
     return true;
 }
 
 void
 S3IOWriter::write(void* ptr, int64_t size) {
-    buffer_ += std::string(reinterpret_cast<char*>(ptr), size);
+    auto src = reinterpret_cast<char*>(ptr);
     len_ += size;
+    while (size > 0) {
+        int64_t count = std::min(size, S3_PART_SIZE - static_cast<int64_t>(buffer_.size()));
+        buffer_.append(src, count);
+        src += count;
+        size -= count;
+        if (static_cast<int64_t>(buffer_.size()) == S3_PART_SIZE) {
+            SubmitPart();
+        }
+    }
 }
 
 int64_t
@@ -36,7 +81,99 @@ S3IOWriter::length() {
 
 void
 S3IOWriter::close() {
-    S3ClientWrapper::GetInstance().PutObjectStr(name_, buffer_);
+    // small objects never start a multipart upload
+    if (upload_id_.empty() && status_.ok()) {
+        status_ = S3ClientWrapper::GetInstance().PutObjectStr(name_, buffer_);
+        buffer_ = "";
+        if (!status_.ok()) {
+            FailUpload();
+        }
+        return;
+    }
+
+    if (!buffer_.empty()) {
+        SubmitPart();
+    }
+    while (!pending_parts_.empty()) {
+        WaitPart();
+    }
+
+    if (status_.ok()) {
+        status_ = S3ClientWrapper::GetInstance().CompleteMultipartUpload(name_, upload_id_, etags_);
+    }
+    if (!status_.ok()) {
+        FailUpload();
+    }
+    upload_id_.clear();
+}
+
+void
+S3IOWriter::SubmitPart() {
+    auto& client = S3ClientWrapper::GetInstance();
+    if (status_.ok() && upload_id_.empty()) {
+        status_ = client.CreateMultipartUpload(name_, upload_id_);
+    }
+    while (status_.ok() && static_cast<int64_t>(pending_parts_.size()) >= S3_MAX_INFLIGHT_PARTS) {
+        WaitPart();
+    }
+    if (!status_.ok()) {
+        FailUpload();
+    }
+
+    auto upload = [&client](const std::string& name, const std::string& upload_id, int32_t part_number,
+                            const std::string& content) {
+        PartResult result;
+        for (int64_t i = 0; i < S3_PART_RETRY_TIMES; ++i) {
+            if (i > 0) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(100 << i));
+            }
+            result.status_ = client.UploadPart(name, upload_id, part_number, content, result.etag_);
+            if (result.status_.ok()) {
+                break;
+            }
+        }
+        return result;
+    };
+    auto part_number = static_cast<int32_t>(etags_.size() + pending_parts_.size() + 1);
+    pending_parts_.emplace_back(UploadPool().enqueue(upload, name_, upload_id_, part_number, std::move(buffer_)));
+
+    buffer_ = std::string();
+    buffer_.reserve(S3_PART_SIZE);
+}
+
+void
+S3IOWriter::WaitPart() {
+    auto result = pending_parts_.front().get();
+    pending_parts_.pop_front();
+    if (!result.status_.ok()) {
+        if (status_.ok()) {
+            status_ = result.status_;
+        }
+        return;
+    }
+    etags_.emplace_back(std::move(result.etag_));
+}
+
+void
+S3IOWriter::FailUpload() {
+    std::string msg = "Failed to upload " + name_ + ": " + status_.message();
+    LOG_STORAGE_ERROR_ << msg;
+    AbortUpload();
+    throw Exception(status_.code(), msg);
+}
+
+void
+S3IOWriter::AbortUpload() {
+    while (!pending_parts_.empty()) {
+        pending_parts_.front().wait();
+        pending_parts_.pop_front();
+    }
+    if (!upload_id_.empty()) {
+        S3ClientWrapper::GetInstance().AbortMultipartUpload(name_, upload_id_);
+        upload_id_.clear();
+    }
+    etags_.clear();
+    buffer_.clear();
 }
 
 }  // namespace storage
@@ -11,9 +11,14 @@
 
 #pragma once
 
+#include <deque>
+#include <future>
 #include <memory>
 #include <string>
+#include <vector>
+
 #include "storage/IOWriter.h"
+#include "utils/Status.h"
 
 namespace milvus {
 namespace storage {
@@ -21,7 +26,7 @@ namespace storage {
 class S3IOWriter : public IOWriter {
  public:
     S3IOWriter() = default;
-    ~S3IOWriter() = default;
+    ~S3IOWriter();
 
     // No copy and move
     S3IOWriter(const S3IOWriter&) = delete;
@@ -44,10 +49,36 @@ class S3IOWriter : public IOWriter {
     void
     close() override;
 
+ private:
+    struct PartResult {
+        Status status_;
+        std::string etag_;
+    };
+
+    // hand the buffered part to the upload pool, waiting while too many parts are in flight
+    void
+    SubmitPart();
+
+    void
+    WaitPart();
+
+    // abort the upload and throw the failed status
+    void
+    FailUpload();
+
+    void
+    AbortUpload();
+
  public:
     std::string name_;
-    int64_t len_;
+    int64_t len_ = 0;
     std::string buffer_;
+
+ private:
+    std::string upload_id_;
+    Status status_;
+    std::deque<std::future<PartResult>> pending_parts_;
+    std::vector<std::string> etags_;
 };
 
 using S3IOWriterPtr = std::shared_ptr<S3IOWriter>;
@@ -13,8 +13,8 @@
 
 #include <assert.h>
 #include <condition_variable>
+#include <deque>
 #include <iostream>
-#include <queue>
 #include <vector>
 
 namespace milvus {
@@ -59,7 +59,7 @@ class BlockingQueue {
     mutable std::mutex mtx;
     std::condition_variable full_;
     std::condition_variable empty_;
-    std::queue<T> queue_;
+    std::deque<T> queue_;
     size_t capacity_ = 32;
 };
 
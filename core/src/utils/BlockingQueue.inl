@@ -20,7 +20,7 @@ BlockingQueue<T>::Put(const T& task) {
     std::unique_lock<std::mutex> lock(mtx);
     full_.wait(lock, [this] { return (queue_.size() < capacity_); });
 
-    queue_.push(task);
+    queue_.push_back(task);
     empty_.notify_all();
 }
 
@@ -31,7 +31,7 @@ BlockingQueue<T>::Take() {
     empty_.wait(lock, [this] { return !queue_.empty(); });
 
     T front(queue_.front());
-    queue_.pop();
+    queue_.pop_front();
     full_.notify_all();
     return front;
 }
@@ -10,13 +10,206 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 #include "utils/Log.h"
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <cstdarg>
 #include <cstdio>
+#include <cstdlib>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <utility>
 
 namespace milvus {
 
+namespace {
+
+std::atomic<uint32_t> enabled_log_levels(~0u);
+
+void
+WriteLog(el::Level level, const std::string& msg) {
+    switch (level) {
+        case el::Level::Trace:
+            LOG(TRACE) << msg;
+            break;
+        case el::Level::Debug:
+            LOG(DEBUG) << msg;
+            break;
+        case el::Level::Info:
+            LOG(INFO) << msg;
+            break;
+        case el::Level::Warning:
+            LOG(WARNING) << msg;
+            break;
+        case el::Level::Error:
+            LOG(ERROR) << msg;
+            break;
+        case el::Level::Fatal:
+            LOG(FATAL) << msg;
+            break;
+        default:
+            LOG(INFO) << msg;
+            break;
+    }
+}
+
+/*
+ * Bounded multi-producer ring (sequence numbered slots), drained by one writer thread.
+ * Producers never block: a full ring falls back to writing on the caller thread.
+ */
+class AsyncLogger {
+ public:
+    static AsyncLogger&
+    GetInstance() {
+        // never destroyed, the writer is stopped by the atexit hook instead
+        static AsyncLogger* instance = new AsyncLogger();
+        return *instance;
+    }
+
+    void
+    Push(el::Level level, std::string&& msg) {
+        if (stopped_.load(std::memory_order_acquire)) {
+            WriteLog(level, msg);
+            return;
+        }
+
+        size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        Slot* slot = nullptr;
+        while (true) {
+            slot = &slots_[pos & RING_MASK];
+            size_t seq = slot->seq_.load(std::memory_order_acquire);
+            auto diff = static_cast<int64_t>(seq) - static_cast<int64_t>(pos);
+            if (diff == 0) {
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                WriteLog(level, msg);
+                return;
+            } else {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+
+        slot->level_ = level;
+        slot->msg_ = std::move(msg);
+        slot->seq_.store(pos + 1, std::memory_order_release);
+
+        if (writer_idle_.load(std::memory_order_relaxed)) {
+            cv_.notify_one();
+        }
+    }
+
+    void
+    Flush() {
+        size_t target = enqueue_pos_.load(std::memory_order_acquire);
+        while (written_.load(std::memory_order_acquire) < target) {
+            cv_.notify_one();
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+    }
+
+    void
+    Stop() {
+        if (stopped_.exchange(true)) {
+            return;
+        }
+        cv_.notify_one();
+        if (writer_.joinable()) {
+            writer_.join();
+        }
+        Drain();
+    }
+
+ private:
+    AsyncLogger() {
+        for (size_t i = 0; i < RING_SIZE; ++i) {
+            slots_[i].seq_.store(i, std::memory_order_relaxed);
+        }
+        writer_ = std::thread(&AsyncLogger::Run, this);
+        std::atexit([] { AsyncLogger::GetInstance().Stop(); });
+    }
+
+    bool
+    Drain() {
+        bool drained = false;
+        while (true) {
+            Slot& slot = slots_[dequeue_pos_ & RING_MASK];
+            if (slot.seq_.load(std::memory_order_acquire) != dequeue_pos_ + 1) {
+                return drained;
+            }
+            WriteLog(slot.level_, slot.msg_);
+            slot.msg_.clear();
+            slot.seq_.store(dequeue_pos_ + RING_SIZE, std::memory_order_release);
+            ++dequeue_pos_;
+            written_.store(dequeue_pos_, std::memory_order_release);
+            drained = true;
+        }
+    }
+
+    void
+    Run() {
+        SetThreadName("async_log");
+        while (!stopped_.load(std::memory_order_acquire)) {
+            if (Drain()) {
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(mutex_);
+            writer_idle_.store(true, std::memory_order_relaxed);
+            cv_.wait_for(lock, std::chrono::milliseconds(10));
+            writer_idle_.store(false, std::memory_order_relaxed);
+        }
+    }
+
+ private:
+    static constexpr size_t RING_SIZE = 8192;
+    static constexpr size_t RING_MASK = RING_SIZE - 1;
+
+    struct Slot {
+        std::atomic<size_t> seq_{0};
+        el::Level level_ = el::Level::Info;
+        std::string msg_;
+    };
+
+    Slot slots_[RING_SIZE];
+    alignas(64) std::atomic<size_t> enqueue_pos_{0};
+    alignas(64) size_t dequeue_pos_ = 0;
+    std::atomic<size_t> written_{0};
+
+    std::atomic<bool> stopped_{false};
+    std::atomic<bool> writer_idle_{false};
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::thread writer_;
+};
+
+}  // namespace
+
+bool
+LogLevelEnabled(el::Level level) {
+    return (enabled_log_levels.load(std::memory_order_relaxed) & static_cast<uint32_t>(level)) != 0;
+}
+
+void
+SetLogLevelEnabled(el::Level level, bool enabled) {
+    if (enabled) {
+        enabled_log_levels.fetch_or(static_cast<uint32_t>(level));
+    } else {
+        enabled_log_levels.fetch_and(~static_cast<uint32_t>(level));
+    }
+}
+
+void
+FlushAsyncLog() {
+    AsyncLogger::GetInstance().Flush();
+}
+
+AsyncLogStream::~AsyncLogStream() {
+    AsyncLogger::GetInstance().Push(level_, stream_.str());
+}
+
 std::string
 LogOut(const char* pattern, ...) {
     size_t len = strnlen(pattern, 1024) + 256;
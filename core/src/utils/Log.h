@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include <sstream>
 #include <string>
 
 #include "easyloggingpp/easylogging++.h"
@@ -20,7 +21,19 @@ namespace milvus {
 /*
  * Please use LOG_MODULE_LEVEL_C macro in member function of class
  * and LOG_MODULE_LEVEL_ macro in other functions.
+ *
+ * Nothing after the macro is evaluated when its level is disabled. TRACE, DEBUG and INFO
+ * records are handed to a background writer, WARNING and above are written in place.
  */
+#define LOG_ASYNC_(LEVEL)                             \
+    if (!milvus::LogLevelEnabled(el::Level::LEVEL)) { \
+    } else                                            \
+        milvus::AsyncLogStream(el::Level::LEVEL)
+
+#define LOG_SYNC_(LEVEL, ELPP_LEVEL)                  \
+    if (!milvus::LogLevelEnabled(el::Level::LEVEL)) { \
+    } else                                            \
+        LOG(ELPP_LEVEL)
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
 #define SERVER_MODULE_NAME "SERVER"
@@ -28,19 +41,19 @@ namespace milvus {
     LogOut("[%s][%s::%s][%s] ", SERVER_MODULE_NAME, (typeid(*this).name()), __FUNCTION__, GetThreadName().c_str())
 #define SERVER_MODULE_FUNCTION LogOut("[%s][%s][%s] ", SERVER_MODULE_NAME, __FUNCTION__, GetThreadName().c_str())
 
-#define LOG_SERVER_TRACE_C LOG(TRACE) << SERVER_MODULE_CLASS_FUNCTION
-#define LOG_SERVER_DEBUG_C LOG(DEBUG) << SERVER_MODULE_CLASS_FUNCTION
-#define LOG_SERVER_INFO_C LOG(INFO) << SERVER_MODULE_CLASS_FUNCTION
-#define LOG_SERVER_WARNING_C LOG(WARNING) << SERVER_MODULE_CLASS_FUNCTION
-#define LOG_SERVER_ERROR_C LOG(ERROR) << SERVER_MODULE_CLASS_FUNCTION
-#define LOG_SERVER_FATAL_C LOG(FATAL) << SERVER_MODULE_CLASS_FUNCTION
+#define LOG_SERVER_TRACE_C LOG_ASYNC_(Trace) << SERVER_MODULE_CLASS_FUNCTION
+#define LOG_SERVER_DEBUG_C LOG_ASYNC_(Debug) << SERVER_MODULE_CLASS_FUNCTION
+#define LOG_SERVER_INFO_C LOG_ASYNC_(Info) << SERVER_MODULE_CLASS_FUNCTION
+#define LOG_SERVER_WARNING_C LOG_SYNC_(Warning, WARNING) << SERVER_MODULE_CLASS_FUNCTION
+#define LOG_SERVER_ERROR_C LOG_SYNC_(Error, ERROR) << SERVER_MODULE_CLASS_FUNCTION
+#define LOG_SERVER_FATAL_C LOG_SYNC_(Fatal, FATAL) << SERVER_MODULE_CLASS_FUNCTION
 
-#define LOG_SERVER_TRACE_ LOG(TRACE) << SERVER_MODULE_FUNCTION
-#define LOG_SERVER_DEBUG_ LOG(DEBUG) << SERVER_MODULE_FUNCTION
-#define LOG_SERVER_INFO_ LOG(INFO) << SERVER_MODULE_FUNCTION
-#define LOG_SERVER_WARNING_ LOG(WARNING) << SERVER_MODULE_FUNCTION
-#define LOG_SERVER_ERROR_ LOG(ERROR) << SERVER_MODULE_FUNCTION
-#define LOG_SERVER_FATAL_ LOG(FATAL) << SERVER_MODULE_FUNCTION
+#define LOG_SERVER_TRACE_ LOG_ASYNC_(Trace) << SERVER_MODULE_FUNCTION
+#define LOG_SERVER_DEBUG_ LOG_ASYNC_(Debug) << SERVER_MODULE_FUNCTION
+#define LOG_SERVER_INFO_ LOG_ASYNC_(Info) << SERVER_MODULE_FUNCTION
+#define LOG_SERVER_WARNING_ LOG_SYNC_(Warning, WARNING) << SERVER_MODULE_FUNCTION
+#define LOG_SERVER_ERROR_ LOG_SYNC_(Error, ERROR) << SERVER_MODULE_FUNCTION
+#define LOG_SERVER_FATAL_ LOG_SYNC_(Fatal, FATAL) << SERVER_MODULE_FUNCTION
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
 #define ENGINE_MODULE_NAME "ENGINE"
@@ -48,19 +61,19 @@ namespace milvus {
     LogOut("[%s][%s::%s][%s] ", ENGINE_MODULE_NAME, (typeid(*this).name()), __FUNCTION__, GetThreadName().c_str())
 #define ENGINE_MODULE_FUNCTION LogOut("[%s][%s][%s] ", ENGINE_MODULE_NAME, __FUNCTION__, GetThreadName().c_str())
 
-#define LOG_ENGINE_TRACE_C LOG(TRACE) << ENGINE_MODULE_CLASS_FUNCTION
-#define LOG_ENGINE_DEBUG_C LOG(DEBUG) << ENGINE_MODULE_CLASS_FUNCTION
-#define LOG_ENGINE_INFO_C LOG(INFO) << ENGINE_MODULE_CLASS_FUNCTION
-#define LOG_ENGINE_WARNING_C LOG(WARNING) << ENGINE_MODULE_CLASS_FUNCTION
-#define LOG_ENGINE_ERROR_C LOG(ERROR) << ENGINE_MODULE_CLASS_FUNCTION
-#define LOG_ENGINE_FATAL_C LOG(FATAL) << ENGINE_MODULE_CLASS_FUNCTION
+#define LOG_ENGINE_TRACE_C LOG_ASYNC_(Trace) << ENGINE_MODULE_CLASS_FUNCTION
+#define LOG_ENGINE_DEBUG_C LOG_ASYNC_(Debug) << ENGINE_MODULE_CLASS_FUNCTION
+#define LOG_ENGINE_INFO_C LOG_ASYNC_(Info) << ENGINE_MODULE_CLASS_FUNCTION
+#define LOG_ENGINE_WARNING_C LOG_SYNC_(Warning, WARNING) << ENGINE_MODULE_CLASS_FUNCTION
+#define LOG_ENGINE_ERROR_C LOG_SYNC_(Error, ERROR) << ENGINE_MODULE_CLASS_FUNCTION
+#define LOG_ENGINE_FATAL_C LOG_SYNC_(Fatal, FATAL) << ENGINE_MODULE_CLASS_FUNCTION
 
-#define LOG_ENGINE_TRACE_ LOG(TRACE) << ENGINE_MODULE_FUNCTION
-#define LOG_ENGINE_DEBUG_ LOG(DEBUG) << ENGINE_MODULE_FUNCTION
-#define LOG_ENGINE_INFO_ LOG(INFO) << ENGINE_MODULE_FUNCTION
-#define LOG_ENGINE_WARNING_ LOG(WARNING) << ENGINE_MODULE_FUNCTION
-#define LOG_ENGINE_ERROR_ LOG(ERROR) << ENGINE_MODULE_FUNCTION
-#define LOG_ENGINE_FATAL_ LOG(FATAL) << ENGINE_MODULE_FUNCTION
+#define LOG_ENGINE_TRACE_ LOG_ASYNC_(Trace) << ENGINE_MODULE_FUNCTION
+#define LOG_ENGINE_DEBUG_ LOG_ASYNC_(Debug) << ENGINE_MODULE_FUNCTION
+#define LOG_ENGINE_INFO_ LOG_ASYNC_(Info) << ENGINE_MODULE_FUNCTION
+#define LOG_ENGINE_WARNING_ LOG_SYNC_(Warning, WARNING) << ENGINE_MODULE_FUNCTION
+#define LOG_ENGINE_ERROR_ LOG_SYNC_(Error, ERROR) << ENGINE_MODULE_FUNCTION
+#define LOG_ENGINE_FATAL_ LOG_SYNC_(Fatal, FATAL) << ENGINE_MODULE_FUNCTION
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
 #define WRAPPER_MODULE_NAME "WRAPPER"
@@ -68,19 +81,19 @@ namespace milvus {
     LogOut("[%s][%s::%s][%s] ", WRAPPER_MODULE_NAME, (typeid(*this).name()), __FUNCTION__, GetThreadName().c_str())
 #define WRAPPER_MODULE_FUNCTION LogOut("[%s][%s][%s] ", WRAPPER_MODULE_NAME, __FUNCTION__, GetThreadName().c_str())
 
-#define LOG_WRAPPER_TRACE_C LOG(TRACE) << WRAPPER_MODULE_CLASS_FUNCTION
-#define LOG_WRAPPER_DEBUG_C LOG(DEBUG) << WRAPPER_MODULE_CLASS_FUNCTION
-#define LOG_WRAPPER_INFO_C LOG(INFO) << WRAPPER_MODULE_CLASS_FUNCTION
-#define LOG_WRAPPER_WARNING_C LOG(WARNING) << WRAPPER_MODULE_CLASS_FUNCTION
-#define LOG_WRAPPER_ERROR_C LOG(ERROR) << WRAPPER_MODULE_CLASS_FUNCTION
-#define LOG_WRAPPER_FATAL_C LOG(FATAL) << WRAPPER_MODULE_CLASS_FUNCTION
+#define LOG_WRAPPER_TRACE_C LOG_ASYNC_(Trace) << WRAPPER_MODULE_CLASS_FUNCTION
+#define LOG_WRAPPER_DEBUG_C LOG_ASYNC_(Debug) << WRAPPER_MODULE_CLASS_FUNCTION
+#define LOG_WRAPPER_INFO_C LOG_ASYNC_(Info) << WRAPPER_MODULE_CLASS_FUNCTION
+#define LOG_WRAPPER_WARNING_C LOG_SYNC_(Warning, WARNING) << WRAPPER_MODULE_CLASS_FUNCTION
+#define LOG_WRAPPER_ERROR_C LOG_SYNC_(Error, ERROR) << WRAPPER_MODULE_CLASS_FUNCTION
+#define LOG_WRAPPER_FATAL_C LOG_SYNC_(Fatal, FATAL) << WRAPPER_MODULE_CLASS_FUNCTION
 
-#define LOG_WRAPPER_TRACE_ LOG(TRACE) << WRAPPER_MODULE_FUNCTION
-#define LOG_WRAPPER_DEBUG_ LOG(DEBUG) << WRAPPER_MODULE_FUNCTION
-#define LOG_WRAPPER_INFO_ LOG(INFO) << WRAPPER_MODULE_FUNCTION
-#define LOG_WRAPPER_WARNING_ LOG(WARNING) << WRAPPER_MODULE_FUNCTION
-#define LOG_WRAPPER_ERROR_ LOG(ERROR) << WRAPPER_MODULE_FUNCTION
-#define LOG_WRAPPER_FATAL_ LOG(FATAL) << WRAPPER_MODULE_FUNCTION
+#define LOG_WRAPPER_TRACE_ LOG_ASYNC_(Trace) << WRAPPER_MODULE_FUNCTION
+#define LOG_WRAPPER_DEBUG_ LOG_ASYNC_(Debug) << WRAPPER_MODULE_FUNCTION
+#define LOG_WRAPPER_INFO_ LOG_ASYNC_(Info) << WRAPPER_MODULE_FUNCTION
+#define LOG_WRAPPER_WARNING_ LOG_SYNC_(Warning, WARNING) << WRAPPER_MODULE_FUNCTION
+#define LOG_WRAPPER_ERROR_ LOG_SYNC_(Error, ERROR) << WRAPPER_MODULE_FUNCTION
+#define LOG_WRAPPER_FATAL_ LOG_SYNC_(Fatal, FATAL) << WRAPPER_MODULE_FUNCTION
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
 #define STORAGE_MODULE_NAME "STORAGE"
@@ -88,19 +101,19 @@ namespace milvus {
     LogOut("[%s][%s::%s][%s] ", STORAGE_MODULE_NAME, (typeid(*this).name()), __FUNCTION__, GetThreadName().c_str())
 #define STORAGE_MODULE_FUNCTION LogOut("[%s][%s][%s] ", STORAGE_MODULE_NAME, __FUNCTION__, GetThreadName().c_str())
 
-#define LOG_STORAGE_TRACE_C LOG(TRACE) << STORAGE_MODULE_CLASS_FUNCTION
-#define LOG_STORAGE_DEBUG_C LOG(DEBUG) << STORAGE_MODULE_CLASS_FUNCTION
-#define LOG_STORAGE_INFO_C LOG(INFO) << STORAGE_MODULE_CLASS_FUNCTION
-#define LOG_STORAGE_WARNING_C LOG(WARNING) << STORAGE_MODULE_CLASS_FUNCTION
-#define LOG_STORAGE_ERROR_C LOG(ERROR) << STORAGE_MODULE_CLASS_FUNCTION
-#define LOG_STORAGE_FATAL_C LOG(FATAL) << STORAGE_MODULE_CLASS_FUNCTION
+#define LOG_STORAGE_TRACE_C LOG_ASYNC_(Trace) << STORAGE_MODULE_CLASS_FUNCTION
+#define LOG_STORAGE_DEBUG_C LOG_ASYNC_(Debug) << STORAGE_MODULE_CLASS_FUNCTION
+#define LOG_STORAGE_INFO_C LOG_ASYNC_(Info) << STORAGE_MODULE_CLASS_FUNCTION
+#define LOG_STORAGE_WARNING_C LOG_SYNC_(Warning, WARNING) << STORAGE_MODULE_CLASS_FUNCTION
+#define LOG_STORAGE_ERROR_C LOG_SYNC_(Error, ERROR) << STORAGE_MODULE_CLASS_FUNCTION
+#define LOG_STORAGE_FATAL_C LOG_SYNC_(Fatal, FATAL) << STORAGE_MODULE_CLASS_FUNCTION
 
-#define LOG_STORAGE_TRACE_ LOG(TRACE) << STORAGE_MODULE_FUNCTION
-#define LOG_STORAGE_DEBUG_ LOG(DEBUG) << STORAGE_MODULE_FUNCTION
-#define LOG_STORAGE_INFO_ LOG(INFO) << STORAGE_MODULE_FUNCTION
-#define LOG_STORAGE_WARNING_ LOG(WARNING) << STORAGE_MODULE_FUNCTION
-#define LOG_STORAGE_ERROR_ LOG(ERROR) << STORAGE_MODULE_FUNCTION
-#define LOG_STORAGE_FATAL_ LOG(FATAL) << STORAGE_MODULE_FUNCTION
+#define LOG_STORAGE_TRACE_ LOG_ASYNC_(Trace) << STORAGE_MODULE_FUNCTION
+#define LOG_STORAGE_DEBUG_ LOG_ASYNC_(Debug) << STORAGE_MODULE_FUNCTION
+#define LOG_STORAGE_INFO_ LOG_ASYNC_(Info) << STORAGE_MODULE_FUNCTION
+#define LOG_STORAGE_WARNING_ LOG_SYNC_(Warning, WARNING) << STORAGE_MODULE_FUNCTION
+#define LOG_STORAGE_ERROR_ LOG_SYNC_(Error, ERROR) << STORAGE_MODULE_FUNCTION
+#define LOG_STORAGE_FATAL_ LOG_SYNC_(Fatal, FATAL) << STORAGE_MODULE_FUNCTION
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
 #define WAL_MODULE_NAME "WAL"
@@ -108,19 +121,19 @@ namespace milvus {
     LogOut("[%s][%s::%s][%s] ", WAL_MODULE_NAME, (typeid(*this).name()), __FUNCTION__, GetThreadName().c_str())
 #define WAL_MODULE_FUNCTION LogOut("[%s][%s][%s] ", WAL_MODULE_NAME, __FUNCTION__, GetThreadName().c_str())
 
-#define LOG_WAL_TRACE_C LOG(TRACE) << WAL_MODULE_CLASS_FUNCTION
-#define LOG_WAL_DEBUG_C LOG(DEBUG) << WAL_MODULE_CLASS_FUNCTION
-#define LOG_WAL_INFO_C LOG(INFO) << WAL_MODULE_CLASS_FUNCTION
-#define LOG_WAL_WARNING_C LOG(WARNING) << WAL_MODULE_CLASS_FUNCTION
-#define LOG_WAL_ERROR_C LOG(ERROR) << WAL_MODULE_CLASS_FUNCTION
-#define LOG_WAL_FATAL_C LOG(FATAL) << WAL_MODULE_CLASS_FUNCTION
+#define LOG_WAL_TRACE_C LOG_ASYNC_(Trace) << WAL_MODULE_CLASS_FUNCTION
+#define LOG_WAL_DEBUG_C LOG_ASYNC_(Debug) << WAL_MODULE_CLASS_FUNCTION
+#define LOG_WAL_INFO_C LOG_ASYNC_(Info) << WAL_MODULE_CLASS_FUNCTION
+#define LOG_WAL_WARNING_C LOG_SYNC_(Warning, WARNING) << WAL_MODULE_CLASS_FUNCTION
+#define LOG_WAL_ERROR_C LOG_SYNC_(Error, ERROR) << WAL_MODULE_CLASS_FUNCTION
+#define LOG_WAL_FATAL_C LOG_SYNC_(Fatal, FATAL) << WAL_MODULE_CLASS_FUNCTION
 
-#define LOG_WAL_TRACE_ LOG(TRACE) << WAL_MODULE_FUNCTION
-#define LOG_WAL_DEBUG_ LOG(DEBUG) << WAL_MODULE_FUNCTION
-#define LOG_WAL_INFO_ LOG(INFO) << WAL_MODULE_FUNCTION
-#define LOG_WAL_WARNING_ LOG(WARNING) << WAL_MODULE_FUNCTION
-#define LOG_WAL_ERROR_ LOG(ERROR) << WAL_MODULE_FUNCTION
-#define LOG_WAL_FATAL_ LOG(FATAL) << WAL_MODULE_FUNCTION
+#define LOG_WAL_TRACE_ LOG_ASYNC_(Trace) << WAL_MODULE_FUNCTION
+#define LOG_WAL_DEBUG_ LOG_ASYNC_(Debug) << WAL_MODULE_FUNCTION
+#define LOG_WAL_INFO_ LOG_ASYNC_(Info) << WAL_MODULE_FUNCTION
+#define LOG_WAL_WARNING_ LOG_SYNC_(Warning, WARNING) << WAL_MODULE_FUNCTION
+#define LOG_WAL_ERROR_ LOG_SYNC_(Error, ERROR) << WAL_MODULE_FUNCTION
+#define LOG_WAL_FATAL_ LOG_SYNC_(Fatal, FATAL) << WAL_MODULE_FUNCTION
 
 /*
  * Deprecated
@@ -179,6 +192,42 @@ namespace milvus {
 std::string
 LogOut(const char* pattern, ...);
 
+bool
+LogLevelEnabled(el::Level level);
+
+void
+SetLogLevelEnabled(el::Level level, bool enabled);
+
+// Block until every record queued so far has reached easylogging
+void
+FlushAsyncLog();
+
+// Collects one record on the caller thread and queues it for the background writer on destruction
+class AsyncLogStream {
+ public:
+    explicit AsyncLogStream(el::Level level) : level_(level) {
+    }
+
+    ~AsyncLogStream();
+
+    template <typename T>
+    AsyncLogStream&
+    operator<<(const T& value) {
+        stream_ << value;
+        return *this;
+    }
+
+    AsyncLogStream&
+    operator<<(std::ostream& (*manipulator)(std::ostream&)) {
+        manipulator(stream_);
+        return *this;
+    }
+
+ private:
+    el::Level level_;
+    std::ostringstream stream_;
+};
+
 void
 SetThreadName(const std::string& name);
 
@@ -219,6 +219,14 @@ InitLog(bool trace_enable, bool debug_enable, bool info_enable, bool warning_ena
 
     el::Loggers::reconfigureLogger("default", defaultConf);
 
+    // disabled levels are dropped by the LOG_* macros before any formatting happens
+    SetLogLevelEnabled(el::Level::Trace, trace_enable);
+    SetLogLevelEnabled(el::Level::Debug, debug_enable);
+    SetLogLevelEnabled(el::Level::Info, info_enable);
+    SetLogLevelEnabled(el::Level::Warning, warning_enable);
+    SetLogLevelEnabled(el::Level::Error, error_enable);
+    SetLogLevelEnabled(el::Level::Fatal, fatal_enable);
+
     return Status::OK();
 }
 
@@ -0,0 +1,54 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+
+#include "utils/RateLimiter.h"
+
+#include <thread>
+
+namespace milvus {
+
+RateLimiter::RateLimiter(int64_t bytes_per_second) : rate_(bytes_per_second), next_free_(stdclock::now()) {
+}
+
+void
+RateLimiter::SetRate(int64_t bytes_per_second) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    rate_ = bytes_per_second;
+}
+
+int64_t
+RateLimiter::Rate() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return rate_;
+}
+
+void
+RateLimiter::Acquire(int64_t size) {
+    stdclock::time_point wait_until;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (rate_ <= 0 || size <= 0) {
+            return;
+        }
+
+        // idle time is not saved up, so a long pause never turns into a burst
+        auto now = stdclock::now();
+        if (next_free_ < now) {
+            next_free_ = now;
+        }
+        wait_until = next_free_;
+        next_free_ += std::chrono::microseconds(size * 1000000 / rate_);
+    }
+    std::this_thread::sleep_until(wait_until);
+}
+
+}  // namespace milvus
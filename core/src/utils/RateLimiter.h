@@ -0,0 +1,47 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+
+namespace milvus {
+
+/*
+ * Paces callers to a byte rate shared by all threads using the limiter;
+ * a rate of 0 means no limit.
+ */
+class RateLimiter {
+ public:
+    explicit RateLimiter(int64_t bytes_per_second = 0);
+
+    void
+    SetRate(int64_t bytes_per_second);
+
+    int64_t
+    Rate();
+
+    // block until size bytes are allowed to pass
+    void
+    Acquire(int64_t size);
+
+ private:
+    using stdclock = std::chrono::steady_clock;
+
+    std::mutex mutex_;
+    int64_t rate_;
+    stdclock::time_point next_free_;
+};
+
+}  // namespace milvus
@@ -260,7 +260,8 @@ ValidationUtil::ValidateIndexParams(const milvus::json& index_params,
             }
             break;
         }
-        case (int32_t)engine::EngineType::HNSW: {
+        case (int32_t)engine::EngineType::HNSW:
+        case (int32_t)engine::EngineType::FAISS_BIN_HNSW: {
             auto status = CheckParameterRange(index_params, knowhere::IndexParams::M, 5, 48);
             if (!status.ok()) {
                 return status;
@@ -308,7 +309,8 @@ ValidationUtil::ValidateSearchParams(const milvus::json& search_params,
             }
             break;
         }
-        case (int32_t)engine::EngineType::HNSW: {
+        case (int32_t)engine::EngineType::HNSW:
+        case (int32_t)engine::EngineType::FAISS_BIN_HNSW: {
             auto status = CheckParameterRange(search_params, knowhere::IndexParams::ef, topk, 4096);
             if (!status.ok()) {
                 return status;
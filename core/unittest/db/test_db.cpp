@@ -428,6 +428,54 @@ TEST_F(DBTest, SEARCH_TEST) {
 #endif
 }
 
+TEST_F(DBTest, QUERY_PROFILE_TEST) {
+    milvus::engine::meta::CollectionSchema collection_info = BuildCollectionSchema();
+    auto stat = db_->CreateCollection(collection_info);
+    ASSERT_TRUE(stat.ok());
+
+    uint64_t nb = 1000;
+    milvus::engine::VectorsData xb;
+    BuildVectors(nb, 0, xb);
+    stat = db_->InsertVectors(COLLECTION_NAME, "", xb);
+    ASSERT_TRUE(stat.ok());
+    stat = db_->Flush();
+    ASSERT_TRUE(stat.ok());
+
+    // queries without a profile leave nothing behind
+    milvus::engine::VectorsData xq;
+    BuildVectors(5, 0, xq);
+    milvus::json json_params = {{"nprobe", 10}};
+    std::vector<std::string> tags;
+    milvus::engine::ResultIds result_ids;
+    milvus::engine::ResultDistances result_distances;
+    stat = db_->Query(dummy_context_, COLLECTION_NAME, tags, 10, json_params, xq, result_ids, result_distances);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_EQ(dummy_context_->GetQueryProfile(), nullptr);
+
+    auto profile = std::make_shared<milvus::server::QueryProfile>();
+    auto context = dummy_context_->Child("profiled query");
+    context->SetQueryProfile(profile);
+    stat = db_->Query(context, COLLECTION_NAME, tags, 10, json_params, xq, result_ids, result_distances);
+    ASSERT_TRUE(stat.ok());
+
+    auto segments = profile->Segments();
+    ASSERT_FALSE(segments.empty());
+    uint64_t rows = 0;
+    for (auto& segment : segments) {
+        ASSERT_EQ(segment.index_type_, "IDMAP");
+        ASSERT_EQ(segment.nprobe_, 10);
+        ASSERT_GE(segment.queue_time_, 0.0);
+        rows += segment.rows_;
+    }
+    ASSERT_EQ(rows, nb);
+
+    auto json = profile->ToJson();
+    ASSERT_TRUE(json["stages"].contains("meta_ms"));
+    ASSERT_TRUE(json["stages"].contains("execute_ms"));
+    ASSERT_TRUE(json["stages"].contains("total_ms"));
+    ASSERT_EQ(json["segments"].size(), segments.size());
+}
+
 TEST_F(DBTest, PRELOAD_TEST) {
     fiu_init(0);
 
@@ -834,10 +882,10 @@ TEST_F(DBTest, PARTITION_TEST) {
         ASSERT_TRUE(stat.ok());
         ASSERT_EQ(row_count, INSERT_BATCH * PARTITION_COUNT);
 
-        FIU_ENABLE_FIU("SqliteMetaImpl.Count.throw_exception");
+        FIU_ENABLE_FIU("SqliteMetaImpl.GetCollectionStats.not_found");
         stat = db_->GetCollectionRowCount(COLLECTION_NAME, row_count);
         ASSERT_FALSE(stat.ok());
-        fiu_disable("SqliteMetaImpl.Count.throw_exception");
+        fiu_disable("SqliteMetaImpl.GetCollectionStats.not_found");
 
         FIU_ENABLE_FIU("DBImpl.GetCollectionRowCountRecursively.fail_get_collection_rowcount_for_partition");
         stat = db_->GetCollectionRowCount(COLLECTION_NAME, row_count);
@@ -1063,6 +1111,35 @@ TEST_F(DBTestWAL, DB_INSERT_TEST) {
     ASSERT_TRUE(stat.ok());
 }
 
+TEST_F(DBTestWAL, DB_INSERT_MOVE_TEST) {
+    milvus::engine::meta::CollectionSchema collection_info = BuildCollectionSchema();
+    auto stat = db_->CreateCollection(collection_info);
+    ASSERT_TRUE(stat.ok());
+
+    uint64_t qb = 1000;
+    int insert_loop = 5;
+    for (int i = 0; i < insert_loop; ++i) {
+        milvus::engine::VectorsData qxb;
+        BuildVectors(qb, i, qxb);
+
+        stat = db_->InsertVectors(collection_info.collection_id_, "", std::move(qxb));
+        ASSERT_TRUE(stat.ok());
+        ASSERT_TRUE(qxb.float_data_.empty());
+        ASSERT_EQ(qxb.id_array_.size(), qb);
+    }
+
+    stat = db_->Flush(collection_info.collection_id_);
+    ASSERT_TRUE(stat.ok());
+
+    uint64_t row_count = 0;
+    stat = db_->GetCollectionRowCount(collection_info.collection_id_, row_count);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_EQ(row_count, qb * insert_loop);
+
+    stat = db_->DropCollection(collection_info.collection_id_);
+    ASSERT_TRUE(stat.ok());
+}
+
 TEST_F(DBTestWAL, DB_STOP_TEST) {
     milvus::engine::meta::CollectionSchema collection_info = BuildCollectionSchema();
     auto stat = db_->CreateCollection(collection_info);
@@ -16,6 +16,8 @@
 #include <iostream>
 #include <random>
 #include <thread>
+#include <utility>
+#include <vector>
 #include <fiu-control.h>
 #include <fiu-local.h>
 #include <src/db/DBFactory.h>
@@ -30,6 +32,8 @@
 #include "db/utils.h"
 #include "gtest/gtest.h"
 #include "metrics/Metrics.h"
+#include "segment/SegmentReader.h"
+#include "segment/SegmentWriter.h"
 
 namespace {
 
@@ -329,6 +333,53 @@ TEST_F(MemManagerTest2, INSERT_TEST) {
     }
 }
 
+TEST_F(MemManagerTest2, INSERT_MOVE_BENCHMARK) {
+    milvus::engine::meta::CollectionSchema collection_info = BuildCollectionSchema();
+    auto stat = db_->CreateCollection(collection_info);
+    ASSERT_TRUE(stat.ok());
+
+    int64_t nb = 20000;
+    int insert_loop = 5;
+    std::vector<milvus::engine::VectorsData> batches(insert_loop);
+    for (auto& batch : batches) {
+        BuildVectors(nb, batch);
+    }
+
+    // copying path: caller keeps its vectors
+    auto start = std::chrono::high_resolution_clock::now();
+    for (auto& batch : batches) {
+        stat = db_->InsertVectors(GetCollectionName(), "", batch);
+        ASSERT_TRUE(stat.ok());
+        ASSERT_EQ(batch.float_data_.size(), nb * COLLECTION_DIM);
+        ASSERT_EQ(batch.id_array_.size(), nb);
+        batch.id_array_.clear();
+    }
+    auto copy_cost =
+        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - start);
+
+    // moving path: payload goes down to the segment, ids stay with the caller
+    start = std::chrono::high_resolution_clock::now();
+    for (auto& batch : batches) {
+        stat = db_->InsertVectors(GetCollectionName(), "", std::move(batch));
+        ASSERT_TRUE(stat.ok());
+        ASSERT_TRUE(batch.float_data_.empty());
+        ASSERT_EQ(batch.id_array_.size(), nb);
+    }
+    auto move_cost =
+        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - start);
+
+    std::cout << "Insert " << insert_loop << " x " << nb << " vectors of dim " << COLLECTION_DIM
+              << ": copy " << copy_cost.count() << " ms, move " << move_cost.count() << " ms" << std::endl;
+
+    stat = db_->Flush();
+    ASSERT_TRUE(stat.ok());
+
+    uint64_t row_count = 0;
+    stat = db_->GetCollectionRowCount(GetCollectionName(), row_count);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_EQ(row_count, 2 * insert_loop * nb);
+}
+
 TEST_F(MemManagerTest2, INSERT_BINARY_TEST) {
     milvus::engine::meta::CollectionSchema collection_info;
     collection_info.dimension_ = COLLECTION_DIM;
@@ -511,3 +562,68 @@ TEST_F(MemManagerTest2, VECTOR_IDS_TEST) {
         ASSERT_EQ(xb.id_array_[i], i + nb);
     }
 }
+
+TEST(MemManagerMiscTest, SEGMENT_STREAM_MERGE_TEST) {
+    std::string root_path = "/tmp/milvus_test/segment_merge";
+    boost::filesystem::remove_all(root_path);
+
+    const int64_t rows = 100;
+    const size_t row_size = COLLECTION_DIM * sizeof(float);
+    std::vector<std::string> dirs;
+    for (int64_t s = 0; s < 3; ++s) {
+        std::string dir = root_path + "/" + std::to_string(s);
+        std::vector<uint8_t> data(rows * row_size);
+        std::vector<milvus::segment::doc_id_t> uids;
+        for (int64_t i = 0; i < rows; ++i) {
+            float* vector = reinterpret_cast<float*>(data.data() + i * row_size);
+            for (int64_t j = 0; j < COLLECTION_DIM; ++j) {
+                vector[j] = s * rows + i;
+            }
+            uids.push_back(s * rows + i);
+        }
+
+        milvus::segment::SegmentWriter segment_writer(dir);
+        ASSERT_TRUE(segment_writer.AddVectors(std::to_string(s), data, uids).ok());
+        ASSERT_TRUE(segment_writer.Serialize().ok());
+        dirs.push_back(dir);
+    }
+
+    // delete every other row of the first segment
+    auto deleted_docs = std::make_shared<milvus::segment::DeletedDocs>();
+    for (int32_t i = 0; i < rows; i += 2) {
+        deleted_docs->AddDeletedDoc(i);
+    }
+    ASSERT_TRUE(milvus::segment::SegmentWriter(dirs[0]).WriteDeletedDocs(deleted_docs).ok());
+
+    // the second segment reaches max size, the third one is left alone
+    std::string merged_dir = root_path + "/merged";
+    milvus::segment::SegmentWriter merge_writer(merged_dir);
+    size_t merged_count = 0;
+    auto status = merge_writer.Merge(dirs, "merged", rows * row_size, 1024 * 1024 * 1024, merged_count);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(merged_count, 2);
+    ASSERT_EQ(merge_writer.VectorCount(), rows / 2 + rows);
+    ASSERT_EQ(merge_writer.Size(), (rows / 2 + rows) * (row_size + sizeof(milvus::segment::doc_id_t)));
+
+    milvus::segment::SegmentReader segment_reader(merged_dir);
+    ASSERT_TRUE(segment_reader.Load().ok());
+    milvus::segment::SegmentPtr segment_ptr;
+    segment_reader.GetSegment(segment_ptr);
+    auto& uids = segment_ptr->vectors_ptr_->GetUids();
+    auto& data = segment_ptr->vectors_ptr_->GetData();
+    ASSERT_EQ(uids.size(), rows / 2 + rows);
+    ASSERT_EQ(data.size(), uids.size() * row_size);
+    for (size_t i = 0; i < uids.size(); ++i) {
+        auto expected = (i < rows / 2) ? (int64_t)(2 * i + 1) : (int64_t)(i + rows / 2);
+        ASSERT_EQ(uids[i], expected);
+        const float* vector = reinterpret_cast<const float*>(data.data() + i * row_size);
+        ASSERT_EQ(vector[0], (float)expected);
+        ASSERT_EQ(vector[COLLECTION_DIM - 1], (float)expected);
+    }
+
+    milvus::segment::IdBloomFilterPtr bloom_filter_ptr;
+    ASSERT_TRUE(segment_reader.LoadBloomFilter(bloom_filter_ptr).ok());
+    ASSERT_TRUE(bloom_filter_ptr->Check(uids.back()));
+
+    boost::filesystem::remove_all(root_path);
+}
@@ -20,7 +20,11 @@
 #include <gtest/gtest.h>
 #include <stdlib.h>
 #include <time.h>
+#include <algorithm>
 #include <boost/filesystem/operations.hpp>
+#include <chrono>
+#include <iostream>
+#include <thread>
 
 TEST_F(MetaTest, COLLECTION_TEST) {
     auto collection_id = "meta_test_table";
@@ -465,6 +469,114 @@ TEST_F(MetaTest, COLLECTION_FILE_ROW_COUNT_TEST) {
     ASSERT_EQ(table_file.flush_lsn_, schemas[0].flush_lsn_);
 }
 
+TEST_F(MetaTest, COLLECTION_STATS_TEST) {
+    auto collection_id = "stats_test_table";
+
+    milvus::engine::meta::CollectionSchema collection;
+    collection.collection_id_ = collection_id;
+    collection.dimension_ = 256;
+    auto status = impl_->CreateCollection(collection);
+    ASSERT_TRUE(status.ok());
+
+    std::string partition_name = "stats_test_partition";
+    status = impl_->CreatePartition(collection_id, partition_name, "tag0", 0);
+    ASSERT_TRUE(status.ok());
+
+    auto create_file = [&](const std::string& id, size_t row_count, milvus::engine::meta::SegmentSchema& file) {
+        file.collection_id_ = id;
+        status = impl_->CreateCollectionFile(file);
+        ASSERT_TRUE(status.ok());
+        file.file_type_ = milvus::engine::meta::SegmentSchema::RAW;
+        file.row_count_ = row_count;
+        file.file_size_ = row_count * 1024;
+        status = impl_->UpdateCollectionFile(file);
+        ASSERT_TRUE(status.ok());
+    };
+
+    milvus::engine::meta::SegmentSchema root_file, partition_file, new_file;
+    create_file(collection_id, 100, root_file);
+    create_file(partition_name, 50, partition_file);
+
+    milvus::engine::meta::SegmentSchema shadow_file;
+    shadow_file.collection_id_ = collection_id;
+    status = impl_->CreateCollectionFile(shadow_file);
+    ASSERT_TRUE(status.ok());
+
+    milvus::engine::meta::CollectionStats stats;
+    std::vector<milvus::engine::meta::CollectionStats> partitions_stats;
+    status = impl_->GetCollectionStats(collection_id, stats, partitions_stats);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(stats.row_count_, 150UL);
+    ASSERT_EQ(stats.data_size_, 150UL * 1024);
+    ASSERT_EQ(stats.segment_count_[milvus::engine::meta::SegmentSchema::RAW], 2UL);
+    ASSERT_EQ(stats.segment_count_[milvus::engine::meta::SegmentSchema::NEW], 1UL);
+    ASSERT_EQ(partitions_stats.size(), 2UL);
+    ASSERT_EQ(partitions_stats[0].row_count_, 100UL);
+    ASSERT_EQ(partitions_stats[1].row_count_, 50UL);
+    ASSERT_EQ(partitions_stats[1].partition_tag_, "tag0");
+
+    uint64_t count = 0;
+    status = impl_->Count(partition_name, count);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(count, 50UL);
+
+    // deleting rows shrinks the row count and the deleted count is persisted along with it
+    root_file.row_count_ = 90;
+    root_file.deleted_row_count_ = 10;
+    milvus::engine::meta::SegmentsSchema files = {root_file};
+    status = impl_->UpdateCollectionFilesRowCount(files);
+    ASSERT_TRUE(status.ok());
+    status = impl_->GetCollectionStats(collection_id, stats, partitions_stats);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(stats.row_count_, 140UL);
+    ASSERT_EQ(stats.deleted_row_count_, 10UL);
+
+    {
+        milvus::engine::meta::FilesHolder files_holder;
+        status = impl_->GetCollectionFilesBySegmentId(root_file.segment_id_, files_holder);
+        ASSERT_TRUE(status.ok());
+        auto& segment_files = files_holder.HoldFiles();
+        ASSERT_EQ(segment_files.size(), 1UL);
+        ASSERT_EQ(segment_files[0].row_count_, 90UL);
+        ASSERT_EQ(segment_files[0].deleted_row_count_, 10UL);
+    }
+
+    // merging into a new file drops the deleted rows of the source file
+    create_file(collection_id, 90, new_file);
+    root_file.file_type_ = milvus::engine::meta::SegmentSchema::TO_DELETE;
+    files = {root_file};
+    status = impl_->UpdateCollectionFiles(files);
+    ASSERT_TRUE(status.ok());
+    status = impl_->GetCollectionStats(collection_id, stats, partitions_stats);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(stats.row_count_, 140UL);
+    ASSERT_EQ(stats.deleted_row_count_, 0UL);
+    ASSERT_EQ(stats.segment_count_[milvus::engine::meta::SegmentSchema::TO_DELETE], 1UL);
+
+    milvus::engine::meta::SegmentsStats segments_stats;
+    status = impl_->GetSegmentsStats(collection_id, segments_stats);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(segments_stats.size(), 3UL);
+
+    status = impl_->DropPartition(partition_name);
+    ASSERT_TRUE(status.ok());
+    status = impl_->GetCollectionStats(collection_id, stats, partitions_stats);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(stats.row_count_, 90UL);
+    ASSERT_EQ(partitions_stats.size(), 1UL);
+    status = impl_->Count(partition_name, count);
+    ASSERT_EQ(status.code(), milvus::DB_NOT_FOUND);
+
+    // statistics are rebuilt from meta on startup, shadow files are cleaned up
+    auto options = GetOptions();
+    milvus::engine::meta::SqliteMetaImpl reloaded(options.meta_);
+    status = reloaded.GetCollectionStats(collection_id, stats, partitions_stats);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(stats.row_count_, 90UL);
+    ASSERT_EQ(stats.segment_count_.count(milvus::engine::meta::SegmentSchema::NEW), 0UL);
+    ASSERT_EQ(partitions_stats.size(), 1UL);
+}
+
 TEST_F(MetaTest, ARCHIVE_TEST_DAYS) {
     srand(time(0));
     milvus::engine::DBMetaOptions options;
@@ -794,3 +906,72 @@ TEST_F(MetaTest, LSN_TEST) {
     status = impl_->GetGlobalLastLSN(temp_lsb);
     ASSERT_EQ(temp_lsb, lsn);
 }
+
+TEST_F(MetaTest, META_BENCHMARK_TEST) {
+    auto collection_id = "meta_benchmark";
+    const uint64_t files_cnt = 200;
+    const int64_t search_rounds = 200;
+
+    milvus::engine::meta::CollectionSchema collection;
+    collection.collection_id_ = collection_id;
+    auto status = impl_->CreateCollection(collection);
+    ASSERT_TRUE(status.ok());
+
+    milvus::engine::meta::SegmentsSchema files;
+    for (uint64_t i = 0; i < files_cnt; ++i) {
+        milvus::engine::meta::SegmentSchema file;
+        file.collection_id_ = collection_id;
+        status = impl_->CreateCollectionFile(file);
+        ASSERT_TRUE(status.ok());
+        file.file_type_ = milvus::engine::meta::SegmentSchema::RAW;
+        file.row_count_ = 1;
+        files.push_back(file);
+    }
+
+    auto elapsed_ms = [](std::chrono::steady_clock::time_point start) {
+        auto duration = std::chrono::steady_clock::now() - start;
+        return std::max<int64_t>(1, std::chrono::duration_cast<std::chrono::milliseconds>(duration).count());
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    status = impl_->UpdateCollectionFiles(files);
+    ASSERT_TRUE(status.ok());
+    auto update_ms = elapsed_ms(start);
+
+    start = std::chrono::steady_clock::now();
+    for (auto i = 0; i < search_rounds; ++i) {
+        milvus::engine::meta::FilesHolder files_holder;
+        status = impl_->FilesToSearch(collection_id, files_holder);
+        ASSERT_TRUE(status.ok());
+        ASSERT_EQ(files_holder.HoldFiles().size(), files_cnt);
+    }
+    auto search_ms = elapsed_ms(start);
+
+    for (auto& file : files) {
+        file.file_type_ = milvus::engine::meta::SegmentSchema::TO_DELETE;
+    }
+    status = impl_->UpdateCollectionFiles(files);
+    ASSERT_TRUE(status.ok());
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    start = std::chrono::steady_clock::now();
+    status = impl_->CleanUpFilesWithTTL(0UL);
+    ASSERT_TRUE(status.ok());
+    auto cleanup_ms = elapsed_ms(start);
+
+    milvus::engine::meta::FilesHolder files_holder;
+    status = impl_->FilesByType(collection_id, {milvus::engine::meta::SegmentSchema::TO_DELETE}, files_holder);
+    ASSERT_TRUE(status.ok());
+    ASSERT_TRUE(files_holder.HoldFiles().empty());
+
+    // updating files that are already gone doesn't bring them back
+    status = impl_->UpdateCollectionFiles(files);
+    ASSERT_TRUE(status.ok());
+    status = impl_->FilesByType(collection_id, {milvus::engine::meta::SegmentSchema::TO_DELETE}, files_holder);
+    ASSERT_TRUE(status.ok());
+    ASSERT_TRUE(files_holder.HoldFiles().empty());
+
+    std::cout << "UpdateCollectionFiles: " << files_cnt * 1000 / update_ms << " files/s" << std::endl;
+    std::cout << "FilesToSearch: " << search_rounds * 1000 / search_ms << " calls/s" << std::endl;
+    std::cout << "CleanUpFilesWithTTL: " << files_cnt * 1000 / cleanup_ms << " files/s" << std::endl;
+}
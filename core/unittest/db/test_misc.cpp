@@ -12,6 +12,10 @@
 #include <gtest/gtest.h>
 
 #include <boost/filesystem.hpp>
+#include <fstream>
+#include <map>
+#include <set>
+#include <string>
 #include <thread>
 #include <vector>
 
@@ -20,6 +24,7 @@
 #include "db/Options.h"
 #include "db/Utils.h"
 #include "db/engine/EngineFactory.h"
+#include "db/merge/MergeCostStrategy.h"
 #include "db/meta/SqliteMetaImpl.h"
 #include "utils/Exception.h"
 #include "utils/Status.h"
@@ -159,6 +164,83 @@ TEST(DBMiscTest, SAFE_ID_GENERATOR_TEST) {
     ASSERT_EQ(ids.size(), unique_ids.size());
 }
 
+TEST(DBMiscTest, SAFE_ID_GENERATOR_RANGE_TEST) {
+    milvus::engine::SafeIDGenerator& generator = milvus::engine::SafeIDGenerator::GetInstance();
+    const size_t thread_count = 8;
+    std::vector<milvus::engine::IDNumbers> thread_ids(thread_count);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < thread_count; ++t) {
+        threads.emplace_back([&, t]() {
+            for (size_t n : {1, 7, 100, 5000, 1, 3000, 10000, 2}) {
+                milvus::engine::IDNumbers ids;
+                ASSERT_TRUE(generator.GetNextIDNumbers(n, ids).ok());
+                ASSERT_EQ(ids.size(), n);
+                // ids of one call are contiguous
+                ASSERT_EQ(ids.back() - ids.front() + 1, (int64_t)n);
+                thread_ids[t].insert(thread_ids[t].end(), ids.begin(), ids.end());
+            }
+            thread_ids[t].push_back(generator.GetNextIDNumber());
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    std::set<int64_t> unique_ids;
+    size_t total = 0;
+    for (auto& ids : thread_ids) {
+        unique_ids.insert(ids.begin(), ids.end());
+        total += ids.size();
+    }
+    ASSERT_EQ(unique_ids.size(), total);
+}
+
+TEST(DBMiscTest, SAFE_ID_GENERATOR_MARK_TEST) {
+    std::string dir = "/tmp/milvus_test/id_mark";
+    boost::filesystem::create_directories(dir);
+    std::string mark_path = dir + "/id_mark";
+    boost::filesystem::remove(mark_path);
+
+    milvus::engine::SafeIDGenerator& generator = milvus::engine::SafeIDGenerator::GetInstance();
+    ASSERT_TRUE(generator.Init(mark_path).ok());
+    ASSERT_TRUE(boost::filesystem::exists(mark_path));
+
+    milvus::engine::IDNumbers ids;
+    ASSERT_TRUE(generator.GetNextIDNumbers(100, ids).ok());
+    int64_t last_id = ids.back();
+
+    // a restart continues after the stored mark
+    ASSERT_TRUE(generator.Init(mark_path).ok());
+    ASSERT_TRUE(generator.GetNextIDNumbers(100, ids).ok());
+    ASSERT_GT(ids.front(), last_id);
+    ASSERT_GT(generator.GetNextIDNumber(), ids.back());
+
+    // no id is handed out above the stored mark when the mark can't be moved
+    ASSERT_TRUE(generator.Init(mark_path).ok());
+    fiu_enable("SafeIDGenerator.StoreMark.fail", 1, NULL, 0);
+    size_t past_mark = (1 << 24) + 1;  // more ids than one reservation covers
+    ASSERT_FALSE(generator.GetNextIDNumbers(past_mark, ids).ok());
+    ASSERT_THROW(generator.GetNextIDNumber(), milvus::Exception);
+    fiu_disable("SafeIDGenerator.StoreMark.fail");
+    last_id = generator.GetNextIDNumber();
+    ASSERT_TRUE(generator.Init(mark_path).ok());
+    ASSERT_GT(generator.GetNextIDNumber(), last_id);
+
+    fiu_enable("SafeIDGenerator.StoreMark.fail", 1, NULL, 0);
+    ASSERT_FALSE(generator.Init(dir + "/other_mark").ok());
+    fiu_disable("SafeIDGenerator.StoreMark.fail");
+    ASSERT_TRUE(generator.GetNextIDNumbers(100, ids).ok());
+
+    {
+        std::ofstream file(mark_path, std::ios::binary | std::ios::trunc);
+        file << "broken";
+    }
+    ASSERT_FALSE(generator.Init(mark_path).ok());
+
+    ASSERT_TRUE(generator.Init("").ok());
+    boost::filesystem::remove_all(dir);
+}
+
 TEST(DBMiscTest, CHECKER_TEST) {
     {
         milvus::engine::IndexFailedChecker checker;
@@ -205,3 +287,110 @@ TEST(DBMiscTest, IDGENERATOR_TEST) {
 
     ASSERT_EQ(ids.size(), unique_ids.size());
 }
+
+namespace {
+
+class MockMergeCostStrategy : public milvus::engine::MergeCostStrategy {
+ public:
+    explicit MockMergeCostStrategy(int64_t io_rate_limit) : MergeCostStrategy(io_rate_limit) {
+    }
+
+    std::map<std::string, double> deleted_ratios_;
+
+ protected:
+    double
+    DeletedRatio(const milvus::engine::meta::SegmentSchema& file) override {
+        return deleted_ratios_[file.file_id_];
+    }
+};
+
+}  // namespace
+
+TEST(DBMiscTest, MERGE_COST_STRATEGY_TEST) {
+    size_t next_id = 0;
+    auto make_file = [&next_id](const std::string& id, size_t size, int32_t type) {
+        milvus::engine::meta::SegmentSchema file;
+        file.id_ = ++next_id;
+        file.collection_id_ = "merge_cost";
+        file.file_id_ = id;
+        file.file_size_ = size;
+        file.file_type_ = type;
+        file.index_file_size_ = 1000;
+        return file;
+    };
+    milvus::engine::meta::SegmentsSchema files = {
+        make_file("a", 10, milvus::engine::meta::SegmentSchema::RAW),
+        make_file("b", 20, milvus::engine::meta::SegmentSchema::RAW),
+        make_file("c", 600, milvus::engine::meta::SegmentSchema::RAW),
+        make_file("d", 600, milvus::engine::meta::SegmentSchema::RAW),
+        make_file("e", 100, milvus::engine::meta::SegmentSchema::TO_INDEX),
+    };
+
+    // budget of 60 bytes per window
+    MockMergeCostStrategy strategy(1);
+    strategy.deleted_ratios_["d"] = 0.5;
+
+    {
+        milvus::engine::meta::FilesHolder files_holder;
+        files_holder.MarkFiles(files);
+        milvus::engine::MergeFilesGroups groups;
+        ASSERT_TRUE(strategy.RegroupFiles(files_holder, groups).ok());
+
+        // large clean segment and non-raw segment are left alone, small ones merge with the tombstone heavy one
+        ASSERT_EQ(groups.size(), 1);
+        ASSERT_EQ(groups[0].size(), 3);
+        ASSERT_EQ(groups[0][0].file_id_, "a");
+        ASSERT_EQ(groups[0][2].file_id_, "d");
+        ASSERT_EQ(files_holder.HoldFiles().size(), 3);
+    }
+
+    {
+        // budget of the window is spent
+        milvus::engine::meta::FilesHolder files_holder;
+        files_holder.MarkFiles(files);
+        milvus::engine::MergeFilesGroups groups;
+        ASSERT_TRUE(strategy.RegroupFiles(files_holder, groups).ok());
+        ASSERT_TRUE(groups.empty());
+        ASSERT_TRUE(files_holder.HoldFiles().empty());
+    }
+
+    milvus::engine::MergeCostStrategy::CandidateGroup group(1);
+    group[0].live_size = 100;
+    ASSERT_EQ(milvus::engine::MergeCostStrategy::Score(group, 1000), 0.0);
+    group[0].deleted_ratio = 0.5;
+    ASSERT_GT(milvus::engine::MergeCostStrategy::Score(group, 1000), 1.0);
+}
+
+TEST(DBMiscTest, FILES_HOLDER_TEST) {
+    milvus::engine::meta::SegmentsSchema files;
+    for (size_t i = 1; i <= 3; ++i) {
+        milvus::engine::meta::SegmentSchema file;
+        file.id_ = i;
+        file.collection_id_ = "files_holder";
+        file.file_id_ = std::to_string(i);
+        files.push_back(file);
+    }
+
+    milvus::engine::meta::FilesHolder files_holder;
+    files_holder.MarkFiles(files);
+    ASSERT_TRUE(files_holder.MarkFile(milvus::engine::meta::SegmentSchema(files[0])).ok());
+    ASSERT_EQ(files_holder.HoldFiles().size(), 3);
+
+    // shared files are moved out but stay protected until released
+    auto shared = files_holder.ShareFiles();
+    ASSERT_EQ(shared.size(), 3);
+    ASSERT_EQ(shared[2]->file_id_, "3");
+    ASSERT_TRUE(files_holder.HoldFiles().empty());
+    for (auto& file : files) {
+        ASSERT_FALSE(milvus::engine::meta::FilesHolder::CanBeDeleted(file));
+    }
+
+    files_holder.UnmarkFile(files[0]);
+    ASSERT_TRUE(milvus::engine::meta::FilesHolder::CanBeDeleted(files[0]));
+    ASSERT_FALSE(milvus::engine::meta::FilesHolder::CanBeDeleted(files[1]));
+
+    files_holder.ReleaseFiles();
+    for (auto& file : files) {
+        ASSERT_TRUE(milvus::engine::meta::FilesHolder::CanBeDeleted(file));
+    }
+}
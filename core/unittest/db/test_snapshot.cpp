@@ -12,10 +12,15 @@
 #include <fiu-control.h>
 #include <fiu-local.h>
 #include <gtest/gtest.h>
+#include <boost/filesystem.hpp>
 
+#include <atomic>
+#include <chrono>
+#include <fstream>
 #include <random>
 #include <string>
 #include <set>
+#include <thread>
 
 #include "db/utils.h"
 #include "db/snapshot/ReferenceProxy.h"
@@ -880,3 +885,320 @@ TEST_F(SnapshotTest, CompoundTest1) {
     expect_segment_file_cnt += built_segs.size();
     ASSERT_EQ(expect_segment_file_cnt, final_segment_file_cnt);
 }
+
+void
+ReloadSnapshots() {
+    milvus::engine::snapshot::CollectionCommitsHolder::GetInstance().Reset();
+    milvus::engine::snapshot::CollectionsHolder::GetInstance().Reset();
+    milvus::engine::snapshot::SchemaCommitsHolder::GetInstance().Reset();
+    milvus::engine::snapshot::FieldCommitsHolder::GetInstance().Reset();
+    milvus::engine::snapshot::FieldsHolder::GetInstance().Reset();
+    milvus::engine::snapshot::FieldElementsHolder::GetInstance().Reset();
+    milvus::engine::snapshot::PartitionsHolder::GetInstance().Reset();
+    milvus::engine::snapshot::PartitionCommitsHolder::GetInstance().Reset();
+    milvus::engine::snapshot::SegmentsHolder::GetInstance().Reset();
+    milvus::engine::snapshot::SegmentCommitsHolder::GetInstance().Reset();
+    milvus::engine::snapshot::SegmentFilesHolder::GetInstance().Reset();
+    Snapshots::GetInstance().Reset();
+    Snapshots::GetInstance().Init();
+}
+
+TEST_F(SnapshotTest, DurableStoreTest) {
+    auto& store = milvus::engine::snapshot::Store::GetInstance();
+    std::string store_path = "/tmp/milvus_test/snapshot_store";
+    boost::filesystem::remove_all(store_path);
+
+    ASSERT_TRUE(store.Open(store_path).ok());
+    ReloadSnapshots();
+    IDS_TYPE ids;
+    Snapshots::GetInstance().GetCollectionIds(ids);
+    ASSERT_TRUE(ids.empty());
+
+    LSN_TYPE lsn = 0;
+    auto ss = CreateCollection("durable_c1", ++lsn);
+    ASSERT_TRUE(ss);
+    PartitionContext p_ctx;
+    p_ctx.name = "p1";
+    ss = CreatePartition("durable_c1", p_ctx, ++lsn);
+    ASSERT_TRUE(ss);
+    auto ss_id = ss->GetID();
+    auto collection_id = ss->GetCollectionId();
+    auto num_partitions = ss->NumberOfPartitions();
+    ss = ScopedSnapshotT();
+
+    auto check_c1 = [&]() {
+        ScopedSnapshotT lss;
+        auto status = Snapshots::GetInstance().GetSnapshot(lss, "durable_c1");
+        ASSERT_TRUE(status.ok()) << status.ToString();
+        ASSERT_EQ(lss->GetID(), ss_id);
+        ASSERT_EQ(lss->GetCollectionId(), collection_id);
+        ASSERT_EQ(lss->NumberOfPartitions(), num_partitions);
+        ASSERT_EQ(lss->GetMaxLsn(), 2);
+        ID_TYPE partition_id;
+        ASSERT_TRUE(lss->GetPartitionId("p1", partition_id).ok());
+    };
+
+    // replay from the commit log only
+    store.Close();
+    ASSERT_TRUE(store.Open(store_path).ok());
+    ReloadSnapshots();
+    check_c1();
+
+    // replay from a checkpoint plus the commits after it
+    ASSERT_TRUE(store.Checkpoint().ok());
+    ss = CreateCollection("durable_c2", ++lsn);
+    ASSERT_TRUE(ss);
+    auto c2_id = ss->GetCollectionId();
+    ASSERT_GT(c2_id, collection_id);
+    ss = ScopedSnapshotT();
+
+    store.Close();
+    ASSERT_TRUE(store.Open(store_path).ok());
+    ReloadSnapshots();
+    check_c1();
+    ScopedSnapshotT c2_ss;
+    ASSERT_TRUE(Snapshots::GetInstance().GetSnapshot(c2_ss, "durable_c2").ok());
+    ASSERT_EQ(c2_ss->GetCollectionId(), c2_id);
+    c2_ss = ScopedSnapshotT();
+
+    // a torn frame at the tail is dropped and the log stays usable
+    store.Close();
+    {
+        std::ofstream log(store_path + "/snapshot.log", std::ios::binary | std::ios::app);
+        log << "torn frame";
+    }
+    ASSERT_TRUE(store.Open(store_path).ok());
+    ReloadSnapshots();
+    check_c1();
+    ss = CreateCollection("durable_c3", ++lsn);
+    ASSERT_TRUE(ss);
+    ASSERT_GT(ss->GetCollectionId(), c2_id);
+    ss = ScopedSnapshotT();
+
+    store.Close();
+    ASSERT_TRUE(store.Open(store_path).ok());
+    ReloadSnapshots();
+    ids.clear();
+    Snapshots::GetInstance().GetCollectionIds(ids);
+    ASSERT_EQ(ids.size(), 3);
+
+    store.Close();
+    boost::filesystem::remove_all(store_path);
+}
+
+TEST_F(SnapshotTest, DurableStoreBusyCheckpointTest) {
+    auto& store = milvus::engine::snapshot::Store::GetInstance();
+    std::string store_path = "/tmp/milvus_test/snapshot_store_busy";
+    boost::filesystem::remove_all(store_path);
+    ASSERT_TRUE(store.Open(store_path).ok());
+
+    // every committer keeps its transaction open until another one has started, so the store never runs out of
+    // open transactions unless a pending checkpoint holds the next one back
+    const int committer_num = 3;
+    std::atomic<bool> stop(false);
+    std::atomic<int> started(0);
+    std::vector<int> rounds(committer_num, 0);
+    auto committer = [&](int i) {
+        while (!stop.load()) {
+            store.StartTransanction();
+            int self = ++started;
+            CollectionPtr collection;
+            auto name = "busy_" + std::to_string(i) + "_" + std::to_string(rounds[i]++);
+            store.CreateResource<Collection>(Collection(name), collection);
+            auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(20);
+            while (started.load() == self && std::chrono::steady_clock::now() < deadline) {
+                std::this_thread::yield();
+            }
+            ASSERT_TRUE(store.FinishTransaction().ok());
+        }
+    };
+    std::vector<std::thread> threads;
+    for (int i = 0; i < committer_num; ++i) {
+        threads.emplace_back(committer, i);
+    }
+
+    // the log is checkpointed while the commits keep coming
+    auto checkpoint_path = store_path + "/snapshot.ckpt";
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+    while (!boost::filesystem::exists(checkpoint_path) && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    bool checkpointed = boost::filesystem::exists(checkpoint_path);
+    stop = true;
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    ASSERT_TRUE(checkpointed);
+
+    store.Close();
+    ASSERT_TRUE(store.Open(store_path).ok());
+    for (int i = 0; i < committer_num; ++i) {
+        for (int j = 0; j < rounds[i]; ++j) {
+            CollectionPtr collection;
+            auto name = "busy_" + std::to_string(i) + "_" + std::to_string(j);
+            ASSERT_TRUE(store.GetCollection(name, collection).ok()) << name;
+        }
+    }
+
+    store.Close();
+    boost::filesystem::remove_all(store_path);
+}
+
+TEST_F(SnapshotTest, DurableStoreDoCommitTest) {
+    auto& store = milvus::engine::snapshot::Store::GetInstance();
+    std::string store_path = "/tmp/milvus_test/snapshot_store_commit";
+    boost::filesystem::remove_all(store_path);
+    ASSERT_TRUE(store.Open(store_path).ok());
+
+    ASSERT_FALSE(store.DoCommit().ok());
+    ASSERT_TRUE(store.DoCommit(Collection("commit_c1"), Collection("commit_c2")).ok());
+
+    // a commit that cannot be logged is reported
+    fiu_init(0);
+    fiu_enable("CommitLog.Append.fail", 1, NULL, 0);
+    ASSERT_FALSE(store.DoCommit(Collection("commit_c3")).ok());
+    fiu_disable("CommitLog.Append.fail");
+
+    store.Close();
+    ASSERT_TRUE(store.Open(store_path).ok());
+    CollectionPtr collection;
+    ASSERT_TRUE(store.GetCollection("commit_c1", collection).ok());
+    ASSERT_TRUE(store.GetCollection("commit_c2", collection).ok());
+    ASSERT_FALSE(store.GetCollection("commit_c3", collection).ok());
+
+    store.Close();
+    boost::filesystem::remove_all(store_path);
+}
+
+SegmentPtr
+CreateSegment(const std::string& collection_name, const LSN_TYPE& lsn) {
+    ScopedSnapshotT ss;
+    auto status = Snapshots::GetInstance().GetSnapshot(ss, collection_name);
+    if (!status.ok()) {
+        return nullptr;
+    }
+    ID_TYPE partition_id;
+    ss->GetPartitionId("_default", partition_id);
+
+    OperationContext context;
+    context.lsn = lsn;
+    context.prev_partition = ss->GetResource<Partition>(partition_id);
+    auto op = std::make_shared<NewSegmentOperation>(context, ss);
+    SegmentPtr new_seg;
+    status = op->CommitNewSegment(new_seg);
+    if (!status.ok()) {
+        return nullptr;
+    }
+
+    SegmentFileContext sf_context;
+    sf_context.field_name = "vector";
+    sf_context.field_element_name = "ivfsq8";
+    SegmentFilePtr seg_file;
+    status = op->CommitNewSegmentFile(sf_context, seg_file);
+    if (!status.ok()) {
+        return nullptr;
+    }
+    status = op->Push();
+    return status.ok() ? new_seg : nullptr;
+}
+
+TEST_F(SnapshotTest, MergeConflictTest) {
+    std::string collection_name("merge_conflict");
+    LSN_TYPE lsn = 0;
+    ASSERT_TRUE(CreateCollection(collection_name, ++lsn));
+    std::vector<SegmentPtr> segs;
+    for (auto i = 0; i < 4; ++i) {
+        auto seg = CreateSegment(collection_name, ++lsn);
+        ASSERT_TRUE(seg);
+        segs.push_back(seg);
+    }
+
+    ScopedSnapshotT ss;
+    ASSERT_TRUE(Snapshots::GetInstance().GetSnapshot(ss, collection_name).ok());
+    auto prepare_merge = [&](const std::vector<SegmentPtr>& stale_segments) {
+        OperationContext context;
+        context.stale_segments = stale_segments;
+        context.prev_partition = ss->GetResource<Partition>(stale_segments[0]->GetPartitionId());
+        context.lsn = ++lsn;
+        auto op = std::make_shared<MergeOperation>(context, ss);
+        SegmentPtr new_seg;
+        EXPECT_TRUE(op->CommitNewSegment(new_seg).ok());
+        SegmentFileContext sf_context;
+        sf_context.field_name = "vector";
+        sf_context.field_element_name = "ivfsq8";
+        sf_context.segment_id = new_seg->GetID();
+        SegmentFilePtr seg_file;
+        EXPECT_TRUE(op->CommitNewSegmentFile(sf_context, seg_file).ok());
+        return op;
+    };
+
+    // all merges are planned on the same snapshot and queued together, the one sharing a segment with an
+    // earlier merge is rejected while the disjoint ones both commit
+    auto merge_1 = prepare_merge({segs[0], segs[1]});
+    auto merge_2 = prepare_merge({segs[1], segs[2]});
+    auto merge_3 = prepare_merge({segs[2], segs[3]});
+    ASSERT_TRUE(merge_1->Push(false).ok());
+    ASSERT_TRUE(merge_2->Push(false).ok());
+    ASSERT_TRUE(merge_3->Push(false).ok());
+
+    ASSERT_TRUE(merge_1->WaitToCommit().ok());
+    auto status = merge_2->WaitToCommit();
+    ASSERT_EQ(status.code(), milvus::SS_STALE_ERROR);
+    ASSERT_TRUE(merge_3->WaitToCommit().ok());
+
+    ScopedSnapshotT latest_ss;
+    ASSERT_TRUE(Snapshots::GetInstance().GetSnapshot(latest_ss, collection_name).ok());
+    ASSERT_EQ(latest_ss->GetResources<Segment>().size(), 2);
+    for (auto& seg : segs) {
+        ASSERT_FALSE(latest_ss->GetResource<Segment>(seg->GetID()));
+    }
+}
+
+TEST_F(SnapshotTest, MultiCollectionCommitBenchmark) {
+    auto& store = milvus::engine::snapshot::Store::GetInstance();
+    std::string store_path = "/tmp/milvus_test/snapshot_benchmark";
+    boost::filesystem::remove_all(store_path);
+    ASSERT_TRUE(store.Open(store_path).ok());
+    ReloadSnapshots();
+
+    const int collection_count = 8;
+    const int commits_per_collection = 40;
+    for (auto i = 0; i < collection_count; ++i) {
+        ASSERT_TRUE(CreateCollection("bench_c" + std::to_string(i), 1));
+    }
+
+    // every collection ingests from its own thread, as concurrent flushes would
+    std::atomic<int> failed(0);
+    auto ingest = [&](int i) {
+        auto collection_name = "bench_c" + std::to_string(i);
+        for (LSN_TYPE lsn = 2; lsn < 2 + commits_per_collection; ++lsn) {
+            if (!CreateSegment(collection_name, lsn)) {
+                ++failed;
+            }
+        }
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (auto i = 0; i < collection_count; ++i) {
+        threads.emplace_back(ingest, i);
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    ASSERT_EQ(failed, 0);
+
+    auto commits = collection_count * commits_per_collection;
+    std::cout << "Snapshot commits: " << commits << " from " << collection_count << " collections in " << seconds
+              << " s, " << commits / seconds << " commits/s" << std::endl;
+
+    for (auto i = 0; i < collection_count; ++i) {
+        ScopedSnapshotT ss;
+        ASSERT_TRUE(Snapshots::GetInstance().GetSnapshot(ss, "bench_c" + std::to_string(i)).ok());
+        ASSERT_EQ(ss->GetResources<Segment>().size(), commits_per_collection);
+    }
+
+    store.Close();
+    boost::filesystem::remove_all(store_path);
+}
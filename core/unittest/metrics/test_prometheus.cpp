@@ -21,7 +21,7 @@ TEST(PrometheusTest, PROMETHEUS_TEST) {
     fiu_init(0);
     milvus::server::Config::GetInstance().SetMetricConfigEnableMonitor("on");
 
-    milvus::server::PrometheusMetrics instance = milvus::server::PrometheusMetrics::GetInstance();
+    milvus::server::PrometheusMetrics& instance = milvus::server::PrometheusMetrics::GetInstance();
     instance.Init();
     instance.SetStartup(true);
     milvus::server::SystemInfo::GetInstance().Init();
@@ -72,6 +72,10 @@ TEST(PrometheusTest, PROMETHEUS_TEST) {
     instance.AddVectorsPerSecondGaugeSet(1, 1, 1);
     instance.QueryIndexTypePerSecondSet("IVF", 1.0);
     instance.QueryIndexTypePerSecondSet("IDMap", 1.0);
+    instance.CollectionQueryDurationObserve("prometheus_c1", "execute", 1.0);
+    instance.CollectionQueryDurationObserve("prometheus_c1", "total", 1.0);
+    instance.CollectionQueryDurationRemove("prometheus_c1");
+    instance.CollectionQueryDurationRemove("prometheus_c2");
     instance.ConnectionGaugeIncrement();
     instance.ConnectionGaugeDecrement();
     instance.KeepingAliveCounterIncrement();
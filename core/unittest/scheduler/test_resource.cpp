@@ -9,6 +9,8 @@
 // is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
+#include <fiu-control.h>
+#include <fiu-local.h>
 #include <gtest/gtest.h>
 
 #include "scheduler/ResourceFactory.h"
@@ -213,6 +215,35 @@ TEST_F(ResourceAdvanceTest, CPU_RESOURCE_TEST) {
     out << *std::static_pointer_cast<TestResource>(test_resource_);
 }
 
+TEST_F(ResourceAdvanceTest, CPU_RESOURCE_LOAD_FAIL_TEST) {
+    fiu_init(0);
+    const uint64_t NUM = max_once_load;
+    std::vector<std::shared_ptr<TestTask>> tasks;
+    SegmentSchemaPtr dummy = nullptr;
+    for (uint64_t i = 0; i < NUM; ++i) {
+        auto label = std::make_shared<SpecResLabel>(cpu_resource_);
+        auto task = std::make_shared<TestTask>(std::make_shared<server::Context>("dummy_request_id"), dummy, label);
+        std::vector<std::string> path{cpu_resource_->name()};
+        task->path() = Path(path, 0);
+        tasks.push_back(task);
+        cpu_resource_->task_table().Put(task);
+    }
+
+    // a throwing load still completes, so the tasks are not stuck in loading
+    fiu_enable("TestTask.Load.throw_exception", 1, NULL, 0);
+    cpu_resource_->WakeupLoader();
+    WaitLoader(NUM);
+    fiu_disable("TestTask.Load.throw_exception");
+
+    cpu_resource_->WakeupExecutor();
+    WaitExecutor(NUM);
+
+    for (uint64_t i = 0; i < NUM; ++i) {
+        ASSERT_EQ(tasks[i]->load_count_, 1);
+        ASSERT_EQ(tasks[i]->exec_count_, 1);
+    }
+}
+
 TEST_F(ResourceAdvanceTest, GPU_RESOURCE_TEST) {
     const uint64_t NUM = max_once_load;
     std::vector<std::shared_ptr<TestTask>> tasks;
@@ -11,7 +11,16 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
 #include "scheduler/TaskTable.h"
+#include "scheduler/job/SearchJob.h"
+#include "scheduler/task/BuildIndexTask.h"
 #include "scheduler/task/TestTask.h"
 
 /************ TaskTableBaseTest ************/
@@ -234,6 +243,30 @@ TEST_F(TaskTableBaseTest, PICK_TO_LOAD_LIMIT) {
     ASSERT_EQ(indexes[2] % empty_table_.capacity(), 4);
 }
 
+TEST_F(TaskTableBaseTest, PICK_TO_LOAD_DEPTH) {
+    const size_t NUM_TASKS = 10;
+    for (size_t i = 0; i < NUM_TASKS; ++i) {
+        empty_table_.Put(task1_);
+    }
+    empty_table_[0]->state = milvus::scheduler::TaskTableItemState::LOADING;
+    empty_table_[1]->state = milvus::scheduler::TaskTableItemState::LOADED;
+
+    empty_table_.SetLoadDepth(3);
+    auto indexes = empty_table_.PickToLoad(1);
+    ASSERT_EQ(indexes.size(), 1);
+    ASSERT_EQ(indexes[0] % empty_table_.capacity(), 2);
+
+    // loading and loaded tasks both count toward the depth
+    empty_table_[2]->state = milvus::scheduler::TaskTableItemState::LOADING;
+    indexes = empty_table_.PickToLoad(1);
+    ASSERT_TRUE(indexes.empty());
+
+    empty_table_.SetLoadDepth(4);
+    indexes = empty_table_.PickToLoad(1);
+    ASSERT_EQ(indexes.size(), 1);
+    ASSERT_EQ(indexes[0] % empty_table_.capacity(), 3);
+}
+
 TEST_F(TaskTableBaseTest, PICK_TO_LOAD_CACHE) {
     const size_t NUM_TASKS = 10;
     for (size_t i = 0; i < NUM_TASKS; ++i) {
@@ -307,6 +340,199 @@ TEST_F(TaskTableBaseTest, PICK_TO_EXECUTE_CACHE) {
     ASSERT_EQ(indexes[0] % empty_table_.capacity(), 2);
 }
 
+/************ TaskTablePriorityTest ************/
+
+class TaskTablePriorityTest : public ::testing::Test {
+ protected:
+    milvus::scheduler::JobPtr
+    PutJob(uint64_t num_tasks, int64_t priority = 0, int64_t timeout_ms = 0) {
+        auto context = std::make_shared<milvus::server::Context>("dummy_request_id");
+        context->SetPriority(priority);
+        context->SetTimeout(timeout_ms);
+        milvus::engine::VectorsData vectors;
+        auto job = std::make_shared<milvus::scheduler::SearchJob>(context, 1, milvus::json(), vectors);
+
+        milvus::scheduler::SegmentSchemaPtr dummy = nullptr;
+        for (uint64_t i = 0; i < num_tasks; ++i) {
+            auto task = std::make_shared<milvus::scheduler::TestTask>(context, dummy, nullptr);
+            task->job_ = job;
+            table_.Put(task);
+        }
+        return job;
+    }
+
+    milvus::scheduler::JobPtr
+    JobOf(uint64_t index) {
+        return table_[index]->task->job_.lock();
+    }
+
+    milvus::scheduler::TaskTable table_;
+};
+
+TEST_F(TaskTablePriorityTest, PICK_BY_PRIORITY) {
+    auto low = PutJob(5, 0);
+    auto high = PutJob(5, 10);
+
+    auto indexes = table_.PickToLoad(3);
+    ASSERT_EQ(indexes.size(), 3);
+    for (auto index : indexes) {
+        ASSERT_EQ(JobOf(index), high);
+    }
+    // arrival order inside a job
+    ASSERT_LT(indexes[0], indexes[1]);
+    ASSERT_LT(indexes[1], indexes[2]);
+}
+
+TEST_F(TaskTablePriorityTest, PICK_BY_DEADLINE) {
+    auto no_deadline = PutJob(3);
+    auto late = PutJob(3, 0, 100000);
+    auto early = PutJob(3, 0, 1000);
+
+    auto indexes = table_.PickToLoad(9);
+    ASSERT_EQ(indexes.size(), 9);
+    ASSERT_EQ(JobOf(indexes[0]), early);
+    ASSERT_EQ(JobOf(indexes[3]), late);
+    ASSERT_EQ(JobOf(indexes[6]), no_deadline);
+}
+
+TEST_F(TaskTablePriorityTest, PICK_SHORTEST_JOB_FIRST) {
+    auto big = PutJob(100);
+    auto small = PutJob(2);
+
+    auto indexes = table_.PickToLoad(2);
+    ASSERT_EQ(indexes.size(), 2);
+    ASSERT_EQ(JobOf(indexes[0]), small);
+    ASSERT_EQ(JobOf(indexes[1]), small);
+
+    for (uint64_t i = 0; i < table_.size(); ++i) {
+        if (JobOf(i) == small) {
+            table_[i]->state = milvus::scheduler::TaskTableItemState::LOADED;
+        }
+    }
+    indexes = table_.PickToExecute(std::numeric_limits<uint64_t>::max());
+    ASSERT_EQ(indexes.size(), 2);
+    ASSERT_EQ(JobOf(indexes[0]), small);
+}
+
+TEST_F(TaskTablePriorityTest, BUILD_NOT_STARVED) {
+    PutJob(5);
+    table_.Put(std::make_shared<milvus::scheduler::XBuildIndexTask>(nullptr, nullptr));
+    PutJob(5);
+    auto is_build = [&](uint64_t index) {
+        return table_[index]->task->Type() == milvus::scheduler::TaskType::BuildIndexTask;
+    };
+
+    // a waiting build takes one slot ahead of the searches
+    auto indexes = table_.PickToLoad(3);
+    ASSERT_EQ(indexes.size(), 3);
+    ASSERT_TRUE(is_build(indexes[0]));
+    ASSERT_FALSE(is_build(indexes[1]));
+    ASSERT_FALSE(is_build(indexes[2]));
+    auto build = indexes[0];
+
+    // while it loads, a second build waits for the searches
+    table_.Load(build);
+    table_.Put(std::make_shared<milvus::scheduler::XBuildIndexTask>(nullptr, nullptr));
+    indexes = table_.PickToLoad(20);
+    ASSERT_EQ(indexes.size(), 10);
+    for (auto index : indexes) {
+        ASSERT_FALSE(is_build(index));
+    }
+
+    // and gets the slot once the first one is done
+    table_.Loaded(build);
+    table_.Execute(build);
+    table_.Executed(build);
+    indexes = table_.PickToLoad(1);
+    ASSERT_EQ(indexes.size(), 1);
+    ASSERT_TRUE(is_build(indexes[0]));
+}
+
+TEST_F(TaskTablePriorityTest, DROP_CANCELLED) {
+    auto cancelled = PutJob(5);
+    auto live = PutJob(3);
+    std::static_pointer_cast<milvus::scheduler::SearchJob>(cancelled)->Cancel();
+
+    // deadline already passed
+    auto context = std::make_shared<milvus::server::Context>("dummy_request_id");
+    context->SetDeadline(1);
+    ASSERT_TRUE(context->IsCancelled());
+    milvus::engine::VectorsData vectors;
+    auto expired = std::make_shared<milvus::scheduler::SearchJob>(context, 1, milvus::json(), vectors);
+    auto from = std::make_shared<milvus::scheduler::TaskTableItem>();
+    from->state = milvus::scheduler::TaskTableItemState::MOVING;
+    milvus::scheduler::SegmentSchemaPtr dummy = nullptr;
+    auto task = std::make_shared<milvus::scheduler::TestTask>(context, dummy, nullptr);
+    task->job_ = expired;
+    table_.Put(task, from);
+
+    auto indexes = table_.PickToLoad(10);
+    ASSERT_EQ(indexes.size(), 3);
+    for (auto index : indexes) {
+        ASSERT_EQ(JobOf(index), live);
+    }
+    for (uint64_t i = 0; i < table_.size(); ++i) {
+        if (JobOf(i) != live) {
+            ASSERT_EQ(table_[i]->state, milvus::scheduler::TaskTableItemState::EXECUTED);
+        }
+    }
+    ASSERT_EQ(from->state, milvus::scheduler::TaskTableItemState::MOVED);
+    ASSERT_FALSE(live->IsCancelled());
+}
+
+TEST_F(TaskTablePriorityTest, MIXED_LOAD_BENCHMARK) {
+    // one analytic search over many segments queued first, small interactive searches keep
+    // arriving behind it; a single loader executes one task per step
+    const uint64_t BIG_JOB_TASKS = 2000;
+    const uint64_t SMALL_JOB_TASKS = 10;
+    const uint64_t SMALL_JOB_NUM = 100;
+    const uint64_t ARRIVAL_INTERVAL = 20;
+
+    PutJob(BIG_JOB_TASKS);
+    std::vector<std::pair<milvus::scheduler::JobPtr, uint64_t>> small_jobs;  // job, arrival step
+    std::unordered_map<milvus::scheduler::JobId, uint64_t> left_tasks;
+    std::vector<uint64_t> latencies;
+
+    uint64_t total_tasks = BIG_JOB_TASKS + SMALL_JOB_TASKS * SMALL_JOB_NUM;
+    double pick_cost = 0;
+    for (uint64_t step = 0; step < total_tasks; ++step) {
+        if (step % ARRIVAL_INTERVAL == 0 && small_jobs.size() < SMALL_JOB_NUM) {
+            auto job = PutJob(SMALL_JOB_TASKS);
+            small_jobs.emplace_back(job, step);
+            left_tasks[job->id()] = SMALL_JOB_TASKS;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        auto indexes = table_.PickToLoad(1);
+        pick_cost += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+        ASSERT_EQ(indexes.size(), 1);
+
+        auto index = indexes[0];
+        table_.Load(index);
+        table_.Loaded(index);
+        table_.Execute(index);
+        table_.Executed(index);
+
+        auto job = JobOf(index);
+        auto iter = left_tasks.find(job->id());
+        if (iter != left_tasks.end() && --iter->second == 0) {
+            for (auto& pair : small_jobs) {
+                if (pair.first == job) {
+                    latencies.push_back(step + 1 - pair.second);
+                }
+            }
+        }
+    }
+    ASSERT_EQ(latencies.size(), SMALL_JOB_NUM);
+
+    std::sort(latencies.begin(), latencies.end());
+    auto p99 = latencies[latencies.size() * 99 / 100 - 1];
+    // in arrival order the first small job alone waits for the whole analytic search
+    std::cout << "small search p99 latency: " << p99 << " steps (fifo >= " << BIG_JOB_TASKS << "), "
+              << "average pick cost: " << pick_cost / total_tasks << " us" << std::endl;
+    ASSERT_LE(p99, SMALL_JOB_TASKS * 2);
+}
+
 /************ TaskTableAdvanceTest ************/
 
 class TaskTableAdvanceTest : public ::testing::Test {
@@ -33,6 +33,13 @@ class LessItemCacheMgr : public milvus::cache::CacheMgr<milvus::cache::DataObjPt
     }
 };
 
+class ManifestCacheMgr : public milvus::cache::CacheMgr<milvus::cache::DataObjPtr> {
+ public:
+    ManifestCacheMgr() {
+        cache_ = std::make_shared<milvus::cache::Cache<milvus::cache::DataObjPtr>>(1UL << 20, 10);
+    }
+};
+
 class MockVecIndex : public milvus::knowhere::VecIndex {
  public:
     MockVecIndex(int64_t dim, int64_t total) : dim_(dim), ntotal_(total) {
@@ -253,3 +260,43 @@ TEST(CacheTest, PARTIAL_LRU_TEST) {
 
     ASSERT_ANY_THROW(lru.get(-1));
 }
+
+TEST(CacheTest, MANIFEST_TEST) {
+    ManifestCacheMgr mgr;
+    for (int i = 0; i < 3; i++) {
+        milvus::knowhere::VecIndexPtr mock_index = std::make_shared<MockVecIndex>(256, 2);
+        milvus::cache::DataObjPtr data_obj = std::static_pointer_cast<milvus::cache::DataObj>(mock_index);
+        mgr.InsertItem("index_" + std::to_string(i), data_obj);
+    }
+    mgr.GetItem("index_1");
+    mgr.GetItem("index_1");
+    mgr.GetItem("index_0");
+
+    auto hot_keys = mgr.HotKeys();
+    ASSERT_EQ(hot_keys.size(), 3);
+    ASSERT_EQ(hot_keys[0].first, "index_1");
+    ASSERT_EQ(hot_keys[0].second, 3);
+    ASSERT_EQ(hot_keys[1].first, "index_0");
+    ASSERT_EQ(hot_keys[2].first, "index_2");
+
+    std::string path = "/tmp/milvus_test_cache_manifest";
+    ASSERT_TRUE(mgr.SaveManifest(path).ok());
+    milvus::cache::CacheManifest manifest;
+    ASSERT_TRUE(ManifestCacheMgr::LoadManifest(path, manifest).ok());
+    ASSERT_EQ(manifest, hot_keys);
+    std::remove(path.c_str());
+
+    ASSERT_FALSE(ManifestCacheMgr::LoadManifest(path, manifest).ok());
+    ASSERT_TRUE(manifest.empty());
+
+    // items dropped by lru are dropped from the manifest too
+    for (int i = 3; i < 20; i++) {
+        milvus::knowhere::VecIndexPtr mock_index = std::make_shared<MockVecIndex>(256, 2);
+        milvus::cache::DataObjPtr data_obj = std::static_pointer_cast<milvus::cache::DataObj>(mock_index);
+        mgr.InsertItem("index_" + std::to_string(i), data_obj);
+    }
+    ASSERT_EQ(mgr.HotKeys().size(), mgr.ItemCount());
+
+    mgr.ClearCache();
+    ASSERT_TRUE(mgr.HotKeys().empty());
+}
@@ -189,6 +189,30 @@ TEST_F(ConfigTest, SERVER_CONFIG_VALID_TEST) {
     ASSERT_TRUE(config.GetStorageConfigPath(str_val).ok());
     ASSERT_TRUE(str_val == storage_primary_path);
 
+    ASSERT_TRUE(config.SetStorageConfigMergeIORateLimit("100MB").ok());
+    ASSERT_TRUE(config.GetStorageConfigMergeIORateLimit(int64_val).ok());
+    ASSERT_TRUE(int64_val == 100 * 1024 * 1024);
+
+    ASSERT_TRUE(config.SetStorageConfigMergeStrategy("cost").ok());
+    ASSERT_TRUE(config.GetStorageConfigMergeStrategy(str_val).ok());
+    ASSERT_TRUE(str_val == "cost");
+
+    ASSERT_TRUE(config.SetStorageConfigS3CacheCapacity("1GB").ok());
+    ASSERT_TRUE(config.GetStorageConfigS3CacheCapacity(int64_val).ok());
+    ASSERT_TRUE(int64_val == 1024 * 1024 * 1024);
+
+    ASSERT_TRUE(config.SetStorageConfigIOEngine("uring").ok());
+    ASSERT_TRUE(config.GetStorageConfigIOEngine(str_val).ok());
+    ASSERT_TRUE(str_val == "uring");
+
+    ASSERT_TRUE(config.SetStorageConfigDirectIO("true").ok());
+    ASSERT_TRUE(config.GetStorageConfigDirectIO(bool_val).ok());
+    ASSERT_TRUE(bool_val);
+
+    ASSERT_TRUE(config.SetStorageConfigCodec("container").ok());
+    ASSERT_TRUE(config.GetStorageConfigCodec(str_val).ok());
+    ASSERT_TRUE(str_val == "container");
+
 //    bool storage_s3_enable = true;
 //    ASSERT_TRUE(config.SetStorageConfigS3Enable(std::to_string(storage_s3_enable)).ok());
 //    ASSERT_TRUE(config.GetStorageConfigS3Enable(bool_val).ok());
@@ -256,6 +280,11 @@ TEST_F(ConfigTest, SERVER_CONFIG_VALID_TEST) {
     ASSERT_TRUE(config.GetCacheConfigCacheInsertData(bool_val).ok());
     ASSERT_TRUE(bool_val == cache_insert_data);
 
+    int64_t cache_preload_parallelism = 8;
+    ASSERT_TRUE(config.SetCacheConfigPreloadParallelism(std::to_string(cache_preload_parallelism)).ok());
+    ASSERT_TRUE(config.GetCacheConfigPreloadParallelism(int64_val).ok());
+    ASSERT_TRUE(int64_val == cache_preload_parallelism);
+
     {
         // #2564
         int64_t total_mem = 0, free_mem = 0;
@@ -296,6 +325,21 @@ TEST_F(ConfigTest, SERVER_CONFIG_VALID_TEST) {
     ASSERT_TRUE(config.GetEngineConfigSimdType(str_val).ok());
     ASSERT_TRUE(str_val == engine_simd_type);
 
+    int64_t engine_search_batch_window = 2000;
+    ASSERT_TRUE(config.SetEngineConfigSearchBatchWindow(std::to_string(engine_search_batch_window)).ok());
+    ASSERT_TRUE(config.GetEngineConfigSearchBatchWindow(int64_val).ok());
+    ASSERT_TRUE(int64_val == engine_search_batch_window);
+
+    int64_t engine_search_batch_max_nq = 64;
+    ASSERT_TRUE(config.SetEngineConfigSearchBatchMaxNq(std::to_string(engine_search_batch_max_nq)).ok());
+    ASSERT_TRUE(config.GetEngineConfigSearchBatchMaxNq(int64_val).ok());
+    ASSERT_TRUE(int64_val == engine_search_batch_max_nq);
+
+    int64_t engine_max_load_depth = 8;
+    ASSERT_TRUE(config.SetEngineConfigMaxLoadDepth(std::to_string(engine_max_load_depth)).ok());
+    ASSERT_TRUE(config.GetEngineConfigMaxLoadDepth(int64_val).ok());
+    ASSERT_TRUE(int64_val == engine_max_load_depth);
+
 #ifdef MILVUS_GPU_VERSION
     int64_t engine_gpu_search_threshold = 800;
     auto status = config.SetGpuResourceConfigGpuSearchThreshold(std::to_string(engine_gpu_search_threshold));
@@ -376,6 +420,11 @@ TEST_F(ConfigTest, SERVER_CONFIG_VALID_TEST) {
     ASSERT_TRUE(config.GetLogsTraceEnable(bool_val).ok());
     ASSERT_TRUE(bool_val == logs_trace_enable);
 
+    int64_t logs_trace_sample_interval = 10;
+    ASSERT_TRUE(config.SetLogsTraceSampleInterval(std::to_string(logs_trace_sample_interval)).ok());
+    ASSERT_TRUE(config.GetLogsTraceSampleInterval(int64_val).ok());
+    ASSERT_TRUE(int64_val == logs_trace_sample_interval);
+
     std::string logs_path = "/tmp/aaa/logs";
     ASSERT_TRUE(config.SetLogsPath(logs_path).ok());
     ASSERT_TRUE(config.GetLogsPath(str_val).ok());
@@ -657,6 +706,17 @@ TEST_F(ConfigTest, SERVER_CONFIG_INVALID_TEST) {
 
     ASSERT_FALSE(config.SetStorageConfigAutoFlushInterval("0.1").ok());
 
+    ASSERT_FALSE(config.SetStorageConfigMergeIORateLimit("-1").ok());
+    ASSERT_FALSE(config.SetStorageConfigMergeIORateLimit("abc").ok());
+
+    ASSERT_FALSE(config.SetStorageConfigMergeStrategy("tiered").ok());
+
+    ASSERT_FALSE(config.SetStorageConfigS3CacheCapacity("-1").ok());
+
+    ASSERT_FALSE(config.SetStorageConfigIOEngine("aio").ok());
+    ASSERT_FALSE(config.SetStorageConfigDirectIO("10").ok());
+    ASSERT_FALSE(config.SetStorageConfigCodec("lucene").ok());
+
 //    ASSERT_FALSE(config.SetStorageConfigS3Enable("10").ok());
 //
 //    ASSERT_FALSE(config.SetStorageConfigS3Address("127.0.0").ok());
@@ -693,6 +753,9 @@ TEST_F(ConfigTest, SERVER_CONFIG_INVALID_TEST) {
     ASSERT_FALSE(config.SetCacheConfigInsertBufferSize("-1").ok());
 
     ASSERT_FALSE(config.SetCacheConfigCacheInsertData("N").ok());
+    ASSERT_FALSE(config.SetCacheConfigPreloadParallelism("0").ok());
+    ASSERT_FALSE(config.SetCacheConfigPreloadParallelism("65").ok());
+    ASSERT_FALSE(config.SetCacheConfigPreloadParallelism("a").ok());
 
     /* engine config */
     ASSERT_FALSE(config.SetEngineConfigUseBlasThreshold("0xff").ok());
@@ -703,6 +766,12 @@ TEST_F(ConfigTest, SERVER_CONFIG_INVALID_TEST) {
 
     ASSERT_FALSE(config.SetEngineConfigSimdType("None").ok());
 
+    ASSERT_FALSE(config.SetEngineConfigSearchBatchWindow("-1").ok());
+    ASSERT_FALSE(config.SetEngineConfigSearchBatchMaxNq("0").ok());
+    ASSERT_FALSE(config.SetEngineConfigSearchBatchMaxNq("a").ok());
+    ASSERT_FALSE(config.SetEngineConfigMaxLoadDepth("0").ok());
+    ASSERT_FALSE(config.SetEngineConfigMaxLoadDepth("33").ok());
+
 #ifdef MILVUS_GPU_VERSION
     ASSERT_FALSE(config.SetGpuResourceConfigGpuSearchThreshold("-1").ok());
 #endif
@@ -736,6 +805,7 @@ TEST_F(ConfigTest, SERVER_CONFIG_INVALID_TEST) {
     /* wal config */
     ASSERT_FALSE(config.SetLogsLevel("invalid").ok());
     ASSERT_FALSE(config.SetLogsTraceEnable("invalid").ok());
+    ASSERT_FALSE(config.SetLogsTraceSampleInterval("-1").ok());
     ASSERT_FALSE(config.SetLogsPath("").ok());
     ASSERT_FALSE(config.SetLogsMaxLogFileSize("-1").ok());
     ASSERT_FALSE(config.SetLogsMaxLogFileSize("511MB").ok());
@@ -13,6 +13,7 @@
 #include <opentracing/mocktracer/tracer.h>
 
 #include <boost/filesystem.hpp>
+#include <deque>
 #include <thread>
 
 #include "config/Config.h"
@@ -20,6 +21,9 @@
 #include "server/delivery/RequestHandler.h"
 #include "server/delivery/RequestScheduler.h"
 #include "server/delivery/request/BaseRequest.h"
+#include "server/delivery/request/SearchCombineRequest.h"
+#include "server/delivery/request/SearchRequest.h"
+#include "server/delivery/strategy/SearchReqStrategy.h"
 #include "server/grpc_impl/GrpcRequestHandler.h"
 #include "src/version.h"
 
@@ -628,6 +632,97 @@ TEST_F(RpcHandlerTest, COMBINE_SEARCH_BINARY_TEST) {
     }
 }
 
+TEST_F(RpcHandlerTest, COMBINE_SEARCH_WINDOW_TEST) {
+    ::grpc::ServerContext context;
+    handler->SetContext(&context, dummy_context);
+    handler->RegisterRequestHandler(milvus::server::RequestHandler());
+
+    // create collection
+    std::string collection_name = "search_batch_window";
+    ::milvus::grpc::CollectionSchema collection_schema;
+    collection_schema.set_collection_name(collection_name);
+    collection_schema.set_dimension(COLLECTION_DIM);
+    collection_schema.set_index_file_size(INDEX_FILE_SIZE);
+    collection_schema.set_metric_type(1);  // L2 metric
+    ::milvus::grpc::Status status;
+    handler->CreateCollection(&context, &collection_schema, &status);
+    ASSERT_EQ(status.error_code(), 0) << status.reason();
+
+    // insert vectors
+    std::vector<std::vector<float>> record_array;
+    BuildVectors(0, VECTOR_COUNT, record_array);
+    ::milvus::grpc::InsertParam insert_param;
+    int64_t vec_id = 0;
+    for (auto& record : record_array) {
+        ::milvus::grpc::RowRecord* grpc_record = insert_param.add_row_record_array();
+        CopyRowRecord(grpc_record, record);
+        insert_param.add_row_id_array(++vec_id);
+    }
+
+    insert_param.set_collection_name(collection_name);
+    ::milvus::grpc::VectorIds vector_ids;
+    handler->Insert(&context, &insert_param, &vector_ids);
+
+    // flush
+    ::milvus::grpc::Status grpc_status;
+    ::milvus::grpc::FlushParam flush_param;
+    flush_param.add_collection_name_array(collection_name);
+    handler->Flush(&context, &flush_param, &grpc_status);
+
+    // requests with different topk and nprobe in one bucket are held and combined
+    milvus::server::Config& config = milvus::server::Config::GetInstance();
+    ASSERT_TRUE(config.SetEngineConfigSearchBatchWindow("50000").ok());
+
+    int QUERY_COUNT = 8;
+    int64_t NQ = 2;
+    using RequestPtr = std::shared_ptr<::milvus::grpc::SearchParam>;
+    std::vector<RequestPtr> request_array;
+    for (int i = 0; i < QUERY_COUNT; i++) {
+        RequestPtr request = std::make_shared<::milvus::grpc::SearchParam>();
+        request->set_collection_name(collection_name);
+        request->set_topk(i % 2 == 0 ? 5 : 10);
+        milvus::grpc::KeyValuePair* kv = request->add_extra_params();
+        kv->set_key(milvus::server::grpc::EXTRA_PARAM_KEY);
+        kv->set_value(i % 2 == 0 ? "{\"nprobe\": 10}" : "{\"nprobe\": 14}");
+
+        BuildVectors(i * NQ, (i + 1) * NQ, record_array);
+        for (auto& record : record_array) {
+            ::milvus::grpc::RowRecord* row_record = request->add_query_record_array();
+            CopyRowRecord(row_record, record);
+        }
+        request_array.emplace_back(request);
+    }
+
+    using ResultPtr = std::shared_ptr<::milvus::grpc::TopKQueryResult>;
+    std::vector<ResultPtr> result_array;
+    using ThreadPtr = std::shared_ptr<std::thread>;
+    std::vector<ThreadPtr> thread_list;
+    for (int i = 0; i < QUERY_COUNT; i++) {
+        ResultPtr result_ptr = std::make_shared<::milvus::grpc::TopKQueryResult>();
+        result_array.push_back(result_ptr);
+        ThreadPtr thread = std::make_shared<std::thread>(SearchFunc, handler, &context, request_array[i], result_ptr);
+        thread_list.emplace_back(thread);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    for (auto& iter : thread_list) {
+        iter->join();
+    }
+    ASSERT_TRUE(config.SetEngineConfigSearchBatchWindow("0").ok());
+
+    // each request gets its own topk, the nearest one is the query vector itself
+    for (int i = 0; i < QUERY_COUNT; i++) {
+        auto& result_ptr = result_array[i];
+        int64_t topk = request_array[i]->topk();
+        ASSERT_EQ(result_ptr->row_num(), NQ);
+        ASSERT_EQ(result_ptr->ids_size(), NQ * topk);
+        for (int64_t j = 0; j < NQ; j++) {
+            ASSERT_EQ(result_ptr->ids(j * topk), i * NQ + j + 1);
+            ASSERT_LT(result_ptr->distances(j * topk), 0.00001);
+        }
+    }
+}
+
 TEST_F(RpcHandlerTest, TABLES_TEST) {
     ::grpc::ServerContext context;
     handler->SetContext(&context, dummy_context);
@@ -1728,6 +1823,40 @@ TEST_F(RpcSchedulerTest, BASE_TASK_TEST) {
     milvus::server::RequestScheduler::GetInstance().Stop();
 }
 
+TEST(SearchReqStrategyTest, COMBINE_IN_QUEUE_TEST) {
+    milvus::engine::VectorsData vectors;
+    vectors.vector_count_ = 1;
+    std::vector<milvus::server::TopKQueryResult> results(5);
+    std::vector<std::string> empty_list;
+    auto create = [&](int64_t topk, const milvus::json& params, milvus::server::TopKQueryResult& result) {
+        return milvus::server::SearchRequest::Create(nullptr, "collection", vectors, topk, params, empty_list,
+                                                     empty_list, result);
+    };
+
+    std::deque<milvus::server::BaseRequestPtr> queue;
+    milvus::server::SearchReqStrategy strategy;
+    queue.push_back(create(10, {{"nprobe", 10}}, results[0]));
+
+    // nprobe 10 and 16 fall in the same bucket
+    ASSERT_TRUE(strategy.ReScheduleQueue(create(20, {{"nprobe", 16}}, results[1]), queue).ok());
+    ASSERT_EQ(queue.size(), 1);
+    ASSERT_EQ(queue.back()->GetRequestType(), milvus::server::BaseRequest::kSearchCombine);
+
+    ASSERT_TRUE(strategy.ReScheduleQueue(create(10, {{"nprobe", 64}}, results[2]), queue).ok());
+    ASSERT_EQ(queue.size(), 2);
+
+    // joins the first batch even though it is no longer the tail
+    ASSERT_TRUE(strategy.ReScheduleQueue(create(10, {{"nprobe", 12}}, results[3]), queue).ok());
+    ASSERT_EQ(queue.size(), 2);
+    auto combine_request = std::static_pointer_cast<milvus::server::SearchCombineRequest>(queue.front());
+    ASSERT_EQ(combine_request->RequestCount(), 3);
+    ASSERT_EQ(combine_request->CombinedNq(), 3);
+
+    // topk too far away
+    ASSERT_TRUE(strategy.ReScheduleQueue(create(1000, {{"nprobe", 12}}, results[4]), queue).ok());
+    ASSERT_EQ(queue.size(), 3);
+}
+
 TEST(RpcTest, RPC_SERVER_TEST) {
     using GrpcServer = milvus::server::grpc::GrpcServer;
     GrpcServer& server = GrpcServer::GetInstance();
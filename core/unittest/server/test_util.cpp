@@ -13,7 +13,9 @@
 #include "utils/BlockingQueue.h"
 #include "utils/CommonUtil.h"
 #include "utils/Error.h"
+#include "utils/Log.h"
 #include "utils/LogUtil.h"
+#include "utils/RateLimiter.h"
 #include "utils/SignalUtil.h"
 #include "utils/StringHelpFunctions.h"
 #include "utils/TimeRecorder.h"
@@ -299,6 +301,33 @@ TEST(UtilTest, LOG_TEST) {
     boost::filesystem::remove("/tmp/config.yaml");
 }
 
+TEST(UtilTest, ASYNC_LOG_TEST) {
+    int64_t evaluated = 0;
+    auto count = [&evaluated]() { return ++evaluated; };
+
+    milvus::SetLogLevelEnabled(el::Level::Debug, false);
+    ASSERT_FALSE(milvus::LogLevelEnabled(el::Level::Debug));
+    LOG_ASYNC_(Debug) << "skipped " << count();
+    ASSERT_EQ(evaluated, 0);
+
+    milvus::SetLogLevelEnabled(el::Level::Debug, true);
+    ASSERT_TRUE(milvus::LogLevelEnabled(el::Level::Debug));
+    std::vector<std::thread> threads;
+    for (int64_t i = 0; i < 4; ++i) {
+        threads.emplace_back([&]() {
+            for (int64_t j = 0; j < 10000; ++j) {
+                LOG_ASYNC_(Debug) << "async record " << j << std::endl;
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    LOG_ASYNC_(Debug) << "written " << count();
+    ASSERT_EQ(evaluated, 1);
+    milvus::FlushAsyncLog();
+}
+
 TEST(UtilTest, TIMERECORDER_TEST) {
     for (int64_t log_level = 0; log_level <= 6; log_level++) {
         if (log_level == 5) {
@@ -314,6 +343,23 @@ TEST(UtilTest, TIMERECOREDRAUTO_TEST) {
     rc.RecordSection("end");
 }
 
+TEST(UtilTest, RATE_LIMITER_TEST) {
+    milvus::RateLimiter limiter;
+    auto start = std::chrono::steady_clock::now();
+    limiter.Acquire(1LL << 30);
+    limiter.Acquire(1LL << 30);
+    ASSERT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(100));
+
+    // 1MB per second, the third half MB has to wait for the first two
+    limiter.SetRate(1LL << 20);
+    ASSERT_EQ(limiter.Rate(), 1LL << 20);
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 3; ++i) {
+        limiter.Acquire(1LL << 19);
+    }
+    ASSERT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(900));
+}
+
 TEST(UtilTest, STATUS_TEST) {
     auto status = milvus::Status::OK();
     std::string str = status.ToString();
@@ -0,0 +1,109 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "easyloggingpp/easylogging++.h"
+#include "storage/disk/DirectIOReader.h"
+#include "storage/disk/DirectIOWriter.h"
+#include "storage/disk/DiskIOReader.h"
+#include "storage/utils.h"
+
+INITIALIZE_EASYLOGGINGPP
+
+namespace {
+
+constexpr int64_t FILE_SIZE = 256 * 1024 * 1024;
+constexpr int64_t REGION_SIZE = 512;  // one 128-dim float vector
+constexpr int64_t REGION_COUNT = 4096;
+const char* BENCHMARK_FILE = "/tmp/milvus_test/storage_benchmark.rv";
+
+double
+ElapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+void
+PrintResult(const std::string& name, int64_t bytes, double ms) {
+    std::cout << name << ": " << ms << " ms, " << (bytes / 1048576.0) / (ms / 1000.0) << " MB/s" << std::endl;
+}
+
+std::vector<milvus::storage::IORegion>
+RandomRegions(std::vector<uint8_t>& buffer) {
+    std::mt19937_64 rng(42);
+    std::uniform_int_distribution<int64_t> dist(0, FILE_SIZE / REGION_SIZE - 1);
+    buffer.resize(REGION_COUNT * REGION_SIZE);
+    std::vector<milvus::storage::IORegion> regions;
+    for (int64_t i = 0; i < REGION_COUNT; ++i) {
+        regions.push_back(milvus::storage::IORegion{dist(rng) * REGION_SIZE, REGION_SIZE, &buffer[i * REGION_SIZE]});
+    }
+    return regions;
+}
+
+}  // namespace
+
+// compares the fstream reader with the io_uring/pread reader, buffered and with O_DIRECT;
+// numbers for buffered reads depend on whether the file is still in the page cache
+TEST_F(StorageTest, DISK_IO_BENCHMARK) {
+    {
+        std::vector<uint8_t> chunk(16 * 1024 * 1024, 7);
+        milvus::storage::DirectIOWriter writer(true);
+        ASSERT_TRUE(writer.open(BENCHMARK_FILE));
+        auto start = std::chrono::steady_clock::now();
+        for (int64_t written = 0; written < FILE_SIZE; written += chunk.size()) {
+            writer.write(chunk.data(), chunk.size());
+        }
+        writer.close();
+        PrintResult("write O_DIRECT", FILE_SIZE, ElapsedMs(start));
+    }
+
+    std::vector<uint8_t> data(FILE_SIZE);
+    std::vector<milvus::storage::IOReaderPtr> readers = {
+        std::make_shared<milvus::storage::DiskIOReader>(),
+        std::make_shared<milvus::storage::DirectIOReader>(false),
+        std::make_shared<milvus::storage::DirectIOReader>(true),
+    };
+    std::vector<std::string> names = {"fstream", "uring", "uring O_DIRECT"};
+
+    for (size_t i = 0; i < readers.size(); ++i) {
+        auto& reader = readers[i];
+        ASSERT_TRUE(reader->open(BENCHMARK_FILE));
+
+        auto start = std::chrono::steady_clock::now();
+        reader->seekg(0);
+        reader->read(data.data(), FILE_SIZE);
+        PrintResult(names[i] + " sequential", FILE_SIZE, ElapsedMs(start));
+
+        std::vector<uint8_t> buffer;
+        auto regions = RandomRegions(buffer);
+        start = std::chrono::steady_clock::now();
+        for (auto& region : regions) {
+            reader->seekg(region.offset_);
+            reader->read(region.ptr_, region.size_);
+        }
+        PrintResult(names[i] + " random read", REGION_COUNT * REGION_SIZE, ElapsedMs(start));
+
+        start = std::chrono::steady_clock::now();
+        reader->readv(regions);
+        PrintResult(names[i] + " random readv", REGION_COUNT * REGION_SIZE, ElapsedMs(start));
+
+        reader->close();
+    }
+    std::remove(BENCHMARK_FILE);
+}
@@ -12,12 +12,25 @@
 #include <fiu-control.h>
 #include <fiu-local.h>
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <boost/filesystem.hpp>
+#include <fstream>
+#include <string>
+#include <vector>
 
+#include "codecs/CodecFactory.h"
+#include "codecs/container/SegmentContainer.h"
 #include "easyloggingpp/easylogging++.h"
+#include "segment/DeletedDocs.h"
+#include "segment/Vectors.h"
+#include "storage/disk/DirectIOReader.h"
+#include "storage/disk/DirectIOWriter.h"
+#include "storage/disk/DiskIOFactory.h"
 #include "storage/disk/DiskIOReader.h"
 #include "storage/disk/DiskIOWriter.h"
 #include "storage/disk/DiskOperation.h"
 #include "storage/utils.h"
+#include "utils/Exception.h"
 
 INITIALIZE_EASYLOGGINGPP
 
@@ -64,6 +77,234 @@ TEST_F(StorageTest, DISK_RW_TEST) {
     }
 }
 
+TEST_F(StorageTest, DIRECT_IO_RW_TEST) {
+    const std::string index_name = "/tmp/milvus_test/test_direct_io";
+    std::string content(3 * milvus::storage::DISK_IO_CHUNK_SIZE + 333, '\0');
+    for (size_t i = 0; i < content.size(); ++i) {
+        content[i] = static_cast<char>(i % 251);
+    }
+
+    fiu_init(0);
+    for (bool direct_io : {false, true}) {
+        milvus::storage::DirectIOWriter writer(direct_io);
+        ASSERT_TRUE(writer.open(index_name));
+        const size_t step = 77777;
+        for (size_t pos = 0; pos < content.size(); pos += step) {
+            writer.write(&content[pos], std::min(step, content.size() - pos));
+        }
+        ASSERT_EQ(writer.length(), static_cast<int64_t>(content.size()));
+        writer.close();
+
+        milvus::storage::DirectIOReader reader(direct_io);
+        ASSERT_FALSE(reader.open("/tmp/notexist"));
+        ASSERT_TRUE(reader.open(index_name));
+        ASSERT_EQ(reader.length(), static_cast<int64_t>(content.size()));
+
+        // sequential reads advance the position
+        char header[8];
+        reader.read(header, sizeof(header));
+        ASSERT_EQ(std::string(header, sizeof(header)), content.substr(0, sizeof(header)));
+        std::string body(content.size() - sizeof(header), '\0');
+        reader.read(&body[0], body.size());
+        ASSERT_EQ(body, content.substr(sizeof(header)));
+
+        // unaligned regions spread over the file, with io_uring and with the pread pool
+        std::vector<int64_t> offsets = {4095, 1, static_cast<int64_t>(content.size()) - 100, 2 * 1024 * 1024 + 7};
+        for (bool uring : {true, false}) {
+            if (!uring) {
+                fiu_enable("DirectIOReader.readv.uring_disable", 1, NULL, 0);
+            }
+            std::vector<std::string> buffers(offsets.size(), std::string(100, '\0'));
+            std::vector<milvus::storage::IORegion> regions;
+            for (size_t i = 0; i < offsets.size(); ++i) {
+                regions.push_back(milvus::storage::IORegion{offsets[i], 100, &buffers[i][0]});
+            }
+            reader.readv(regions);
+            for (size_t i = 0; i < offsets.size(); ++i) {
+                ASSERT_EQ(buffers[i], content.substr(offsets[i], 100));
+            }
+            fiu_disable("DirectIOReader.readv.uring_disable");
+        }
+
+        // failed reads throw instead of leaving the buffers partly filled
+        std::vector<std::string> buffers(offsets.size(), std::string(100, '\0'));
+        std::vector<milvus::storage::IORegion> regions;
+        for (size_t i = 0; i < offsets.size(); ++i) {
+            regions.push_back(milvus::storage::IORegion{offsets[i], 100, &buffers[i][0]});
+        }
+        fiu_enable("DirectIOReader.ReadByUring.read_fail", 1, NULL, 0);
+        fiu_enable("DirectIOReader.PreadChunk.fail", 1, NULL, 0);
+        ASSERT_THROW(reader.readv(regions), milvus::Exception);
+        fiu_disable("DirectIOReader.ReadByUring.read_fail");
+        fiu_enable("DirectIOReader.readv.uring_disable", 1, NULL, 0);
+        ASSERT_THROW(reader.readv(regions), milvus::Exception);
+        fiu_disable("DirectIOReader.readv.uring_disable");
+        fiu_disable("DirectIOReader.PreadChunk.fail");
+        reader.close();
+    }
+
+    // the factory follows the configured engine
+    milvus::storage::DiskIOOptions options;
+    options.engine_ = milvus::storage::DiskIOEngine::URING;
+    milvus::storage::SetDiskIOOptions(options);
+    ASSERT_NE(std::dynamic_pointer_cast<milvus::storage::DirectIOReader>(milvus::storage::CreateDiskIOReader()),
+              nullptr);
+    milvus::storage::SetDiskIOOptions(milvus::storage::DiskIOOptions());
+    ASSERT_NE(std::dynamic_pointer_cast<milvus::storage::DiskIOReader>(milvus::storage::CreateDiskIOReader()),
+              nullptr);
+}
+
+TEST_F(StorageTest, SEGMENT_CONTAINER_TEST) {
+    namespace codec = milvus::codec;
+    const std::string dir = "/tmp/milvus_test/segment_container";
+    const std::string path = codec::ContainerPath(dir);
+    boost::filesystem::remove_all(dir);
+    boost::filesystem::create_directories(dir);
+
+    std::string vectors(3 * codec::CONTAINER_ALIGNMENT + 17, '\0');
+    for (size_t i = 0; i < vectors.size(); ++i) {
+        vectors[i] = static_cast<char>(i % 253);
+    }
+    const std::string uids = "0123456789abcdef";
+    {
+        codec::ContainerWriter writer(path);
+        writer.Open();
+        writer.BeginComponent(codec::CONTAINER_VECTORS);
+        writer.Write(vectors.data(), 1000);
+        writer.Write(vectors.data() + 1000, vectors.size() - 1000);
+        writer.EndComponent();
+        writer.Put(codec::CONTAINER_UIDS, uids.data(), uids.size());
+        writer.Commit();
+    }
+
+    // an uncommitted append leaves the container as it was
+    auto size = boost::filesystem::file_size(path);
+    {
+        codec::ContainerWriter writer(path);
+        writer.Open();
+        writer.Put("garbage", vectors.data(), vectors.size());
+    }
+    ASSERT_EQ(boost::filesystem::file_size(path), size);
+
+    milvus::storage::DiskIOReader reader;
+    {
+        codec::ContainerReader container(reader, path);
+        ASSERT_EQ(container.Index().size(), 2);
+        ASSERT_FALSE(container.Has("garbage"));
+        ASSERT_EQ(container.Entry(codec::CONTAINER_VECTORS).offset_ % codec::CONTAINER_ALIGNMENT, 0);
+        ASSERT_EQ(container.Entry(codec::CONTAINER_UIDS).offset_ % codec::CONTAINER_ALIGNMENT, 0);
+        ASSERT_ANY_THROW(container.Entry("not_exist"));
+
+        std::string whole(vectors.size(), '\0');
+        container.Read(codec::CONTAINER_VECTORS, &whole[0]);
+        ASSERT_EQ(whole, vectors);
+
+        std::string part1(10, '\0'), part2(20, '\0');
+        container.ReadRanges(codec::CONTAINER_VECTORS, {milvus::storage::IORegion{5000, 10, &part1[0]},
+                                                        milvus::storage::IORegion{7, 20, &part2[0]}});
+        ASSERT_EQ(part1, vectors.substr(5000, 10));
+        ASSERT_EQ(part2, vectors.substr(7, 20));
+        ASSERT_ANY_THROW(container.ReadRanges(codec::CONTAINER_UIDS,
+                                              {milvus::storage::IORegion{10, 10, &part1[0]}}));
+
+        auto mapped = container.Map(codec::CONTAINER_UIDS, true);
+        ASSERT_EQ(std::string(reinterpret_cast<const char*>(mapped->data()), mapped->size()), uids);
+    }
+
+    // appended components replace older ones, the old bytes stay untouched
+    const std::string new_uids = "fedcba9876543210";
+    {
+        codec::ContainerWriter writer(path);
+        writer.Open();
+        writer.Put(codec::CONTAINER_UIDS, new_uids.data(), new_uids.size());
+        writer.Commit();
+    }
+    int64_t vectors_offset = 0;
+    {
+        codec::ContainerReader container(reader, path);
+        std::string out(new_uids.size(), '\0');
+        container.Read(codec::CONTAINER_UIDS, &out[0]);
+        ASSERT_EQ(out, new_uids);
+        vectors_offset = container.Entry(codec::CONTAINER_VECTORS).offset_;
+    }
+
+    // a torn trailer falls back to the last intact footer
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::app);
+        out << std::string(codec::CONTAINER_ALIGNMENT + 5, 'x');
+    }
+    {
+        codec::ContainerReader container(reader, path);
+        ASSERT_EQ(container.Index().size(), 2);
+    }
+
+    // checksums catch corrupted components
+    {
+        std::fstream out(path, std::ios::binary | std::ios::in | std::ios::out);
+        out.seekp(vectors_offset + 100);
+        out.put('!');
+    }
+    {
+        codec::ContainerReader container(reader, path);
+        std::string whole(vectors.size(), '\0');
+        ASSERT_ANY_THROW(container.Read(codec::CONTAINER_VECTORS, &whole[0]));
+        ASSERT_ANY_THROW(container.Map(codec::CONTAINER_VECTORS, true));
+    }
+
+    // segments written by the container codec
+    boost::filesystem::remove_all(dir);
+    milvus::storage::IOReaderPtr reader_ptr = std::make_shared<milvus::storage::DiskIOReader>();
+    milvus::storage::IOWriterPtr writer_ptr = std::make_shared<milvus::storage::DiskIOWriter>();
+    milvus::storage::OperationPtr operation_ptr = std::make_shared<milvus::storage::DiskOperation>(dir);
+    auto fs_ptr = std::make_shared<milvus::storage::FSHandler>(reader_ptr, writer_ptr, operation_ptr);
+    operation_ptr->CreateDirectory();
+
+    ASSERT_EQ(codec::DetectCodecType(dir), codec::CodecType::DEFAULT);
+    codec::SetCodecType(codec::CodecType::CONTAINER);
+    ASSERT_EQ(codec::DetectCodecType(dir), codec::CodecType::CONTAINER);
+    auto container_codec = codec::CreateCodec(dir);
+
+    auto vectors_ptr = std::make_shared<milvus::segment::Vectors>();
+    std::vector<uint8_t> data(vectors.begin(), vectors.begin() + 64 * 8);
+    std::vector<milvus::segment::doc_id_t> ids(64);
+    for (size_t i = 0; i < ids.size(); ++i) {
+        ids[i] = 1000 + i;
+    }
+    vectors_ptr->AddData(data);
+    vectors_ptr->AddUids(ids);
+    vectors_ptr->SetName("segment_1");
+    container_codec->GetVectorsFormat()->write(fs_ptr, vectors_ptr);
+
+    auto deleted_docs = std::make_shared<milvus::segment::DeletedDocs>(std::vector<milvus::segment::offset_t>{3, 5});
+    container_codec->GetDeletedDocsFormat()->write(fs_ptr, deleted_docs);
+    deleted_docs = std::make_shared<milvus::segment::DeletedDocs>(std::vector<milvus::segment::offset_t>{7});
+    container_codec->GetDeletedDocsFormat()->write(fs_ptr, deleted_docs);
+
+    // readers pick the container codec from the segment itself
+    codec::SetCodecType(codec::CodecType::DEFAULT);
+    ASSERT_EQ(codec::DetectCodecType(dir), codec::CodecType::CONTAINER);
+    auto read_codec = codec::CreateCodec(dir);
+
+    auto vectors_read = std::make_shared<milvus::segment::Vectors>();
+    read_codec->GetVectorsFormat()->read(fs_ptr, vectors_read);
+    ASSERT_EQ(vectors_read->GetData(), data);
+    ASSERT_EQ(vectors_read->GetUids(), ids);
+    ASSERT_EQ(vectors_read->GetName(), "segment_1");
+
+    std::vector<uint8_t> raw;
+    read_codec->GetVectorsFormat()->read_vectors(fs_ptr, std::vector<off_t>{8 * 9, 8 * 2}, 8, raw);
+    ASSERT_EQ(raw.size(), 16);
+    ASSERT_TRUE(std::equal(raw.begin(), raw.begin() + 8, data.begin() + 8 * 9));
+    ASSERT_TRUE(std::equal(raw.begin() + 8, raw.end(), data.begin() + 8 * 2));
+
+    milvus::segment::DeletedDocsPtr deleted_read;
+    read_codec->GetDeletedDocsFormat()->read(fs_ptr, deleted_read);
+    ASSERT_EQ(deleted_read->GetDeletedDocs(), (std::vector<milvus::segment::offset_t>{3, 5, 7}));
+    size_t deleted_size = 0;
+    read_codec->GetDeletedDocsFormat()->readSize(fs_ptr, deleted_size);
+    ASSERT_EQ(deleted_size, 3);
+}
+
 TEST_F(StorageTest, DISK_OPERATION_TEST) {
     auto disk_operation = milvus::storage::DiskOperation("/tmp/milvus_test/milvus_disk_operation_test");
 
@@ -11,6 +11,7 @@
 
 
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <fstream>
 #include <memory>
 #include <fiu-local.h>
@@ -18,10 +19,12 @@
 
 #include "config/Config.h"
 #include "easyloggingpp/easylogging++.h"
+#include "storage/s3/S3BlockCache.h"
 #include "storage/s3/S3ClientWrapper.h"
 #include "storage/s3/S3IOReader.h"
 #include "storage/s3/S3IOWriter.h"
 #include "storage/utils.h"
+#include "utils/Exception.h"
 
 INITIALIZE_EASYLOGGINGPP
 
@@ -129,6 +132,151 @@ TEST_F(StorageTest, S3_RW_TEST) {
     storage_inst.StopService();
 }
 
+TEST_F(StorageTest, S3_RANGE_READ_TEST) {
+    fiu_init(0);
+
+    const std::string index_name = "/tmp/test_index_range";
+    const std::string cache_path = "/tmp/milvus_test/s3_cache";
+    const int64_t block_size = milvus::storage::S3_BLOCK_SIZE;
+    std::string content(block_size * 2 + 1024, '\0');
+    for (size_t i = 0; i < content.size(); ++i) {
+        content[i] = static_cast<char>(i % 251);
+    }
+
+    auto& storage_inst = milvus::storage::S3ClientWrapper::GetInstance();
+    fiu_enable("S3ClientWrapper.StartService.mock_enable", 1, NULL, 0);
+    ASSERT_TRUE(storage_inst.StartService().ok());
+    auto& cache = milvus::storage::S3BlockCache::GetInstance();
+    cache.Init(cache_path, block_size * 2);
+
+    ASSERT_TRUE(storage_inst.PutObjectStr(index_name, content).ok());
+
+    milvus::storage::S3IOReader reader;
+    ASSERT_TRUE(reader.open(index_name));
+    ASSERT_EQ(reader.length(), static_cast<int64_t>(content.size()));
+
+    // a small header read only touches the first block
+    char header = 0;
+    reader.read(&header, sizeof(header));
+    ASSERT_EQ(header, content[0]);
+    ASSERT_EQ(cache.usage(), block_size);
+
+    // a read across blocks is fetched in parts and advances the position
+    std::string out(block_size + 20, '\0');
+    reader.seekg(block_size - 10);
+    reader.read(&out[0], out.size());
+    ASSERT_EQ(out, content.substr(block_size - 10, out.size()));
+    ASSERT_LE(cache.usage(), cache.capacity());
+
+    // cached blocks are served locally
+    fiu_enable("S3ClientWrapper.GetObjectRange.outcome.fail", 1, NULL, 0);
+    std::string cached(16, '\0');
+    reader.seekg(block_size + 5);
+    reader.read(&cached[0], cached.size());
+    ASSERT_EQ(cached, content.substr(block_size + 5, cached.size()));
+    fiu_disable("S3ClientWrapper.GetObjectRange.outcome.fail");
+
+    // the least recently used block is evicted to stay within capacity
+    reader.seekg(block_size * 2);
+    reader.read(&cached[0], cached.size());
+    ASSERT_EQ(cached, content.substr(block_size * 2, cached.size()));
+    ASSERT_EQ(cache.usage(), block_size + 1024);
+
+    // a failed ranged read is reported instead of leaving the buffer unfilled
+    fiu_enable("S3ClientWrapper.GetObjectRange.outcome.fail", 1, NULL, 0);
+    reader.seekg(0);
+    ASSERT_THROW(reader.read(&cached[0], cached.size()), milvus::Exception);
+    fiu_disable("S3ClientWrapper.GetObjectRange.outcome.fail");
+
+    // overwriting the object drops its cached blocks, a reader opened before fails instead of mixing versions
+    ASSERT_TRUE(storage_inst.PutObjectStr(index_name, "abc").ok());
+    ASSERT_EQ(cache.usage(), 0);
+    reader.seekg(0);
+    ASSERT_THROW(reader.read(&cached[0], cached.size()), milvus::Exception);
+
+    // blocks cached for another version of the object are never served
+    cache.PutBlock(index_name, "\"stale\"", 0, "xyz");
+    ASSERT_TRUE(reader.open(index_name));
+    ASSERT_EQ(reader.length(), 3);
+    char fresh[3];
+    reader.read(fresh, sizeof(fresh));
+    ASSERT_EQ(std::string(fresh, sizeof(fresh)), "abc");
+
+    // without the cache only the requested bytes are fetched
+    cache.Init(cache_path, 0);
+    char tail[2];
+    reader.seekg(1);
+    reader.read(tail, sizeof(tail));
+    ASSERT_EQ(std::string(tail, sizeof(tail)), "bc");
+    ASSERT_EQ(cache.usage(), 0);
+    reader.close();
+
+    ASSERT_TRUE(storage_inst.DeleteObject(index_name).ok());
+    storage_inst.StopService();
+}
+
+TEST_F(StorageTest, S3_MULTIPART_WRITE_TEST) {
+    fiu_init(0);
+
+    const std::string index_name = "/tmp/test_index_multipart";
+    std::string content(20 * 1024 * 1024 + 7, '\0');
+    for (size_t i = 0; i < content.size(); ++i) {
+        content[i] = static_cast<char>(i % 253);
+    }
+
+    auto& storage_inst = milvus::storage::S3ClientWrapper::GetInstance();
+    fiu_enable("S3ClientWrapper.StartService.mock_enable", 1, NULL, 0);
+    ASSERT_TRUE(storage_inst.StartService().ok());
+
+    // large objects are streamed in parts while they are written
+    {
+        milvus::storage::S3IOWriter writer;
+        writer.open(index_name);
+        const size_t chunk = 1000 * 1000;
+        for (size_t pos = 0; pos < content.size(); pos += chunk) {
+            writer.write(&content[pos], std::min(chunk, content.size() - pos));
+        }
+        ASSERT_EQ(writer.length(), static_cast<int64_t>(content.size()));
+        writer.close();
+
+        std::string content_out;
+        ASSERT_TRUE(storage_inst.GetObjectStr(index_name, content_out).ok());
+        ASSERT_EQ(content_out, content);
+    }
+
+    // a failing upload aborts and throws, leaving the old object untouched
+    for (auto& point : {"S3ClientWrapper.CreateMultipartUpload.outcome.fail", "S3ClientWrapper.UploadPart.outcome.fail",
+                        "S3ClientWrapper.CompleteMultipartUpload.outcome.fail"}) {
+        fiu_enable(point, 1, NULL, 0);
+        milvus::storage::S3IOWriter writer;
+        writer.open(index_name);
+        ASSERT_THROW(
+            {
+                writer.write(&content[0], content.size());
+                writer.close();
+            },
+            milvus::Exception);
+        fiu_disable(point);
+
+        std::string content_out;
+        ASSERT_TRUE(storage_inst.GetObjectStr(index_name, content_out).ok());
+        ASSERT_EQ(content_out, content);
+    }
+
+    // so does a small object that is put in one go
+    {
+        fiu_enable("S3ClientWrapper.PutObjectStr.outcome.fail", 1, NULL, 0);
+        milvus::storage::S3IOWriter writer;
+        writer.open(index_name);
+        writer.write(&content[0], 100);
+        ASSERT_THROW(writer.close(), milvus::Exception);
+        fiu_disable("S3ClientWrapper.PutObjectStr.outcome.fail");
+    }
+
+    ASSERT_TRUE(storage_inst.DeleteObject(index_name).ok());
+    storage_inst.StopService();
+}
+
 TEST_F(StorageTest, S3_FAIL_TEST) {
     fiu_init(0);
 